@@ -26,6 +26,7 @@
 /* USER CODE BEGIN Includes */
 
 #include "buttonMatrix.h"
+#include "profiler.h"
 #include <stdbool.h>
 
 /* USER CODE END Includes */
@@ -151,13 +152,20 @@ int main(void)
 
   ButtonMatrix_start(&ButtonMatrix);
 
+#if PROFILER_ENABLE == 1
+  /* cycles of ButtonMatrix_update(), see ProfilerInternal in the debugger */
+  Profiler_init();
+#endif
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
+		PROFILER_ENTER(PROFILER_REGION_MATRIX);
 		ButtonMatrix_update(&ButtonMatrix);
+		PROFILER_EXIT(PROFILER_REGION_MATRIX);
 		for(uint8_t i = 0; i < NUM_INTERRUPT_LINES; i++)
 		{
 			if(ButtonMatrix_check_ButtonPushed(&ButtonMatrix, &ButtonSolo[i]) == true)
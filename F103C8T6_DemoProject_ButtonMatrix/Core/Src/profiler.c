@@ -0,0 +1,239 @@
+/***************************************************************************//**
+ * @defgroup        Profiler_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      Profiler
+ * @{
+ *
+ * @addtogroup      Profiler_Source
+ * @{
+ *
+ * @file            profiler.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <profiler.h>
+
+#if PROFILER_ENABLE == 1
+
+#include <stdio.h>
+
+/**
+ * @brief     Names of the regions, same order as @ref Profiler_Region_enumTd
+ */
+const char* const ProfilerRegionNames[PROFILER_NUM_REGIONS] =
+{
+  "matrix"
+};
+
+/**
+ * @brief     Internal data of the profiler
+ */
+typedef struct
+{
+  Profiler_Region_structTd Regions[PROFILER_NUM_REGIONS]; /**< Results */
+}Profiler_internal_structTd;
+
+Profiler_internal_structTd ProfilerInternal = {0};
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void Profiler_init(void)
+{
+#if __CORTEX_M >= 3
+  /** @internal     1.  Cortex-M3 and higher: start the DWT cycle counter */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  /** @internal     2.  Cortex-M0+: SysTick is running already (HAL tick) */
+  Profiler_reset();
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void Profiler_reset(void)
+{
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < PROFILER_NUM_REGIONS; Index++)
+  {
+    Profiler_Region_structTd* Region = &ProfilerInternal.Regions[Index];
+    Region->Count = 0;
+    Region->TotalCycles = 0;
+    Region->MinCycles = UINT32_MAX;
+    Region->MaxCycles = 0;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void Profiler_enter(Profiler_Region_enumTd Region)
+{
+  ProfilerInternal.Regions[Region].StartCycles = Profiler_get_Cycles();
+}
+
+/* Description in .h */
+void Profiler_exit(Profiler_Region_enumTd Region)
+{
+  uint32_t EndCycles = Profiler_get_Cycles();
+  Profiler_Region_structTd* Results = &ProfilerInternal.Regions[Region];
+  uint32_t Cycles = EndCycles - Results->StartCycles;
+
+  Results->Count++;
+  Results->TotalCycles += Cycles;
+  if(Cycles < Results->MinCycles)
+  {
+    Results->MinCycles = Cycles;
+  }
+  if(Cycles > Results->MaxCycles)
+  {
+    Results->MaxCycles = Cycles;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void pack_ProfilerValue(uint32_t Value, uint8_t* Buffer);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+uint32_t Profiler_get_Cycles(void)
+{
+#if __CORTEX_M >= 3
+  return DWT->CYCCNT;
+#else
+  uint32_t Tick = 0;
+  uint32_t Value = 0;
+  bool Wrapped = false;
+
+  /** @internal     1.  Read HAL tick and SysTick counter. Read again if the
+   *                    tick changed in between (SysTick interrupt). */
+  do
+  {
+    Tick = HAL_GetTick();
+    Value = SysTick->VAL;
+    /** @internal     2.  If SysTick wrapped, but its interrupt did not
+     *                    increment the tick yet (e.g. called in an interrupt
+     *                    with higher priority), the tick is one behind. */
+    Wrapped = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0);
+    if(Wrapped == true)
+    {
+      Value = SysTick->VAL;
+    }
+  }while(Tick != HAL_GetTick());
+  if(Wrapped == true)
+  {
+    Tick++;
+  }
+
+  /** @internal     3.  SysTick counts down from LOAD to 0 once per tick */
+  uint32_t Reload = SysTick->LOAD;
+  return Tick * (Reload + 1) + (Reload - Value);
+#endif
+}
+
+/* Description in .h */
+const Profiler_Region_structTd* Profiler_get_Region(Profiler_Region_enumTd Region)
+{
+  return &ProfilerInternal.Regions[Region];
+}
+
+/* Description in .h */
+const char* Profiler_get_RegionName(Profiler_Region_enumTd Region)
+{
+  return ProfilerRegionNames[Region];
+}
+
+/* Description in .h */
+uint16_t Profiler_format_Region(Profiler_Region_enumTd Region, char* Buffer, uint16_t Size)
+{
+  const Profiler_Region_structTd* Results = &ProfilerInternal.Regions[Region];
+  uint32_t Count = Results->Count;
+  uint32_t Min = (Count == 0) ? 0 : Results->MinCycles;
+  uint32_t Mean = (Count == 0) ? 0 : (uint32_t)(Results->TotalCycles / Count);
+
+  int Length = snprintf(Buffer, Size, "%s %lu %lu %lu %lu\r\n", ProfilerRegionNames[Region],
+      (unsigned long)Count, (unsigned long)Min, (unsigned long)Results->MaxCycles, (unsigned long)Mean);
+  if(Length < 0)
+  {
+    return 0;
+  }
+  return (Length >= Size) ? Size - 1 : (uint16_t)Length;
+}
+
+/* Description in .h */
+void Profiler_pack_SysEx(Profiler_Region_enumTd Region, uint8_t* Buffer)
+{
+  const Profiler_Region_structTd* Results = &ProfilerInternal.Regions[Region];
+  uint32_t Min = (Results->Count == 0) ? 0 : Results->MinCycles;
+
+  Buffer[0] = 0xF0;
+  Buffer[1] = 0x7D;
+  Buffer[2] = (uint8_t)Region & 0x7F;
+  pack_ProfilerValue(Results->Count, &Buffer[3]);
+  pack_ProfilerValue((uint32_t)Results->TotalCycles, &Buffer[8]);
+  pack_ProfilerValue(Min, &Buffer[13]);
+  pack_ProfilerValue(Results->MaxCycles, &Buffer[18]);
+  Buffer[PROFILER_SYSEX_LENGTH - 1] = 0xF7;
+}
+
+/**
+ * @brief     Pack a 32 bit value into 5 SysEx data bytes of 7 bit, least
+ *            significant first.
+ * @param     Value     to pack
+ * @param     Buffer    for the 5 data bytes
+ * @return    none
+ */
+void pack_ProfilerValue(uint32_t Value, uint8_t* Buffer)
+{
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < 5; Index++)
+  {
+    Buffer[Index] = (uint8_t)(Value & 0x7F);
+    Value >>= 7;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+#endif /* PROFILER_ENABLE */
+
+/**@}*//* end of defgroup "Profiler_Source" */
+/**@}*//* end of defgroup "Profiler" */
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <MIDI_UART.h>
+#include <profiler.h>
 
 typedef struct
 {
@@ -298,8 +299,12 @@ MIDI_error_Td MIDI_update_Transmission(MIDI_structTd* MIDIPort)
 {
   MIDI_error_Td Error = MIDI_ERROR_NONE;
 
+  PROFILER_ENTER(PROFILER_REGION_RX);
   Error = update_RxData(MIDIPort);
+  PROFILER_EXIT(PROFILER_REGION_RX);
+  PROFILER_ENTER(PROFILER_REGION_TX);
   Error = update_TxData(MIDIPort);
+  PROFILER_EXIT(PROFILER_REGION_TX);
 
   return Error;
 }
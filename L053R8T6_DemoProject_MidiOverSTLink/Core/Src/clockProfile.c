@@ -0,0 +1,516 @@
+/***************************************************************************//**
+ * @defgroup        ClockProfile_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      ClockProfile
+ * @{
+ *
+ * @addtogroup      ClockProfile_Source
+ * @{
+ *
+ * @file            clockProfile.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <clockProfile.h>
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/**
+ * @brief     Timer and the tick rate to keep
+ */
+typedef struct
+{
+  TIM_HandleTypeDef* htim;  /**< HAL-handle of the timer */
+  uint32_t  TickHz;         /**< Tick rate when added */
+}ClockProfile_Timer_structTd;
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+/**
+ * @brief     SPI and the bit rate to keep
+ */
+typedef struct
+{
+  SPI_HandleTypeDef* hspi;  /**< HAL-handle of the SPI */
+  uint32_t  BitRate;        /**< Bit rate when added (upper limit) */
+}ClockProfile_SPI_structTd;
+#endif
+
+/**
+ * @brief     Internal data of the clock profiles
+ */
+typedef struct
+{
+  ClockProfile_enumTd Profile;  /**< Active profile */
+  bool      KeepHSI;            /**< HSI16 runs in all profiles */
+#ifdef HAL_TIM_MODULE_ENABLED
+  ClockProfile_Timer_structTd Timers[CLOCKPROFILE_MAX_TIMERS];
+  uint8_t   NumTimers;
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  ClockProfile_SPI_structTd SPIs[CLOCKPROFILE_MAX_SPIS];
+  uint8_t   NumSPIs;
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  UART_HandleTypeDef* UARTs[CLOCKPROFILE_MAX_UARTS];
+  uint8_t   NumUARTs;
+#endif
+}ClockProfile_internal_structTd;
+
+ClockProfile_internal_structTd ClockProfileInternal = {0};
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+HAL_StatusTypeDef start_ProfileHSI(void);
+void set_ProfileVoltage(ClockProfile_enumTd Profile);
+uint32_t get_ProfileTimerClock(TIM_TypeDef* Instance);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+HAL_StatusTypeDef ClockProfile_init(ClockProfile_enumTd Profile)
+{
+  HAL_StatusTypeDef Status = HAL_OK;
+
+  ClockProfileInternal.Profile = Profile;
+  ClockProfileInternal.KeepHSI = (CLOCKPROFILE_LOW_POWER_MSI == 0);
+
+  /** @internal     1.  Without MSI, HSI16 runs in all profiles. Otherwise it
+   *                    is started when a profile needs it. */
+  if(ClockProfileInternal.KeepHSI == true || Profile == CLOCKPROFILE_BALANCED)
+  {
+    Status = start_ProfileHSI();
+  }
+
+  /** @internal     2.  SystemClock_Config() may have set a higher voltage */
+  set_ProfileVoltage(Profile);
+  return Status;
+}
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/* Description in .h */
+bool ClockProfile_add_Timer(TIM_HandleTypeDef* htim)
+{
+  if(ClockProfileInternal.NumTimers >= CLOCKPROFILE_MAX_TIMERS)
+  {
+    return false;
+  }
+
+  ClockProfile_Timer_structTd* Timer = &ClockProfileInternal.Timers[ClockProfileInternal.NumTimers];
+  Timer->htim = htim;
+  Timer->TickHz = get_ProfileTimerClock(htim->Instance) / (htim->Instance->PSC + 1);
+  ClockProfileInternal.NumTimers++;
+  return true;
+}
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+/* Description in .h */
+bool ClockProfile_add_SPI(SPI_HandleTypeDef* hspi)
+{
+  if(ClockProfileInternal.NumSPIs >= CLOCKPROFILE_MAX_SPIS)
+  {
+    return false;
+  }
+
+  /** @internal     1.  SPI1 is connected to APB2, SPI2 to APB1. The bit rate
+   *                    is the bus clock / 2^(BR + 1). */
+  uint32_t BusClock = (hspi->Instance == SPI1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+  uint32_t BR = (hspi->Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
+  ClockProfile_SPI_structTd* SPI = &ClockProfileInternal.SPIs[ClockProfileInternal.NumSPIs];
+  SPI->hspi = hspi;
+  SPI->BitRate = BusClock >> (BR + 1);
+  ClockProfileInternal.NumSPIs++;
+  return true;
+}
+#endif
+
+#ifdef HAL_UART_MODULE_ENABLED
+/* Description in .h */
+bool ClockProfile_add_UART(UART_HandleTypeDef* huart)
+{
+  if(ClockProfileInternal.NumUARTs >= CLOCKPROFILE_MAX_UARTS)
+  {
+    return false;
+  }
+
+  ClockProfileInternal.UARTs[ClockProfileInternal.NumUARTs] = huart;
+  ClockProfileInternal.NumUARTs++;
+  return true;
+}
+#endif
+
+#ifdef HAL_ADC_MODULE_ENABLED
+/* Description in .h */
+HAL_StatusTypeDef ClockProfile_add_ADC(ADC_HandleTypeDef* hadc)
+{
+  HAL_StatusTypeDef Status = HAL_OK;
+
+  /** @internal     1.  The clock can only be changed while the ADC is off */
+  if(ADC_IS_ENABLE(hadc) != RESET)
+  {
+    return HAL_ERROR;
+  }
+
+  /** @internal     2.  HSI16 clocks the ADC from now on, in all profiles.
+   *                    Voltage range 3 is not allowed any more. */
+  ClockProfileInternal.KeepHSI = true;
+  Status = start_ProfileHSI();
+  if(Status != HAL_OK)
+  {
+    return Status;
+  }
+  set_ProfileVoltage(ClockProfileInternal.Profile);
+
+  /** @internal     3.  Asynchronous clock: HSI16 / 2 = 8 MHz (maximum of
+   *                    voltage range 2) */
+  hadc->Init.ClockPrescaler = ADC_CLOCK_ASYNC_DIV2;
+  hadc->Init.LowPowerFrequencyMode = DISABLE;
+  return HAL_ADC_Init(hadc);
+}
+#endif
+
+/**
+ * @brief     Start HSI16 and wait until it is ready.
+ * @param     none
+ * @return    HAL status
+ */
+HAL_StatusTypeDef start_ProfileHSI(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+  return HAL_RCC_OscConfig(&RCC_OscInitStruct);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+HAL_StatusTypeDef switch_ProfileClock(ClockProfile_enumTd Profile);
+void stop_ProfileOscillators(ClockProfile_enumTd Profile);
+void adjust_ProfilePeripherals(void);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+HAL_StatusTypeDef ClockProfile_set_Profile(ClockProfile_enumTd Profile)
+{
+  ClockProfile_enumTd OldProfile = ClockProfileInternal.Profile;
+  HAL_StatusTypeDef Status = HAL_OK;
+
+  if(Profile == OldProfile)
+  {
+    return HAL_OK;
+  }
+
+  /** @internal     1.  Faster: raise the core voltage before the clock */
+  if(Profile > OldProfile)
+  {
+    set_ProfileVoltage(Profile);
+  }
+
+  /** @internal     2.  Switch the system clock. HAL_RCC_ClockConfig() sets
+   *                    the flash latency and restarts SysTick. */
+  Status = switch_ProfileClock(Profile);
+  if(Status != HAL_OK)
+  {
+    set_ProfileVoltage(OldProfile);
+    return Status;
+  }
+  ClockProfileInternal.Profile = Profile;
+  stop_ProfileOscillators(Profile);
+
+  /** @internal     3.  Slower: lower the core voltage after the clock */
+  if(Profile < OldProfile)
+  {
+    set_ProfileVoltage(Profile);
+  }
+
+  /** @internal     4.  Keep the rates of the peripherals */
+  adjust_ProfilePeripherals();
+  return HAL_OK;
+}
+
+/**
+ * @brief     Start the oscillator of a profile and switch the system clock
+ *            to it.
+ * @param     Profile   new profile
+ * @return    HAL status. The system clock is not changed on error.
+ */
+HAL_StatusTypeDef switch_ProfileClock(ClockProfile_enumTd Profile)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+  HAL_StatusTypeDef Status = HAL_OK;
+  uint32_t Latency = FLASH_LATENCY_1;
+
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+
+  if(Profile == CLOCKPROFILE_PERFORMANCE)
+  {
+    /** @internal     1.  Performance: start the PLL and its source */
+    if(CLOCKPROFILE_PLL_SOURCE == RCC_PLLSOURCE_HSE)
+    {
+      RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+      RCC_OscInitStruct.HSEState = CLOCKPROFILE_HSE_STATE;
+    }
+    else
+    {
+      RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+      RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+      RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    }
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+    RCC_OscInitStruct.PLL.PLLSource = CLOCKPROFILE_PLL_SOURCE;
+    RCC_OscInitStruct.PLL.PLLMUL = CLOCKPROFILE_PLL_MUL;
+    RCC_OscInitStruct.PLL.PLLDIV = CLOCKPROFILE_PLL_DIV;
+    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  }
+  else if(Profile == CLOCKPROFILE_LOW_POWER && CLOCKPROFILE_LOW_POWER_MSI != 0)
+  {
+    /** @internal     2.  Low power from MSI range 5 (2.097 MHz, no wait
+     *                    state) */
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_MSI;
+    RCC_OscInitStruct.MSIState = RCC_MSI_ON;
+    RCC_OscInitStruct.MSICalibrationValue = 0;
+    RCC_OscInitStruct.MSIClockRange = RCC_MSIRANGE_5;
+    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_MSI;
+    Latency = FLASH_LATENCY_0;
+  }
+  else
+  {
+    /** @internal     3.  Balanced and low power from HSI16. Divide it by 8
+     *                    for low power (2 MHz needs no wait state). */
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+    RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    if(Profile == CLOCKPROFILE_LOW_POWER)
+    {
+      RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV8;
+      Latency = FLASH_LATENCY_0;
+    }
+    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+  }
+
+  Status = HAL_RCC_OscConfig(&RCC_OscInitStruct);
+  if(Status != HAL_OK)
+  {
+    return Status;
+  }
+  return HAL_RCC_ClockConfig(&RCC_ClkInitStruct, Latency);
+}
+
+/**
+ * @brief     Stop the oscillators that the active profile does not need.
+ *            An error here does not change the system clock, so it is
+ *            ignored.
+ * @param     Profile   active profile
+ * @return    none
+ */
+void stop_ProfileOscillators(ClockProfile_enumTd Profile)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+
+  /** @internal     1.  PLL and HSE: only used by the performance profile.
+   *                    The PLL first, it may run from HSE or HSI16. */
+  if(Profile != CLOCKPROFILE_PERFORMANCE)
+  {
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+    HAL_RCC_OscConfig(&RCC_OscInitStruct);
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+    if(CLOCKPROFILE_PLL_SOURCE == RCC_PLLSOURCE_HSE)
+    {
+      RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+      RCC_OscInitStruct.HSEState = RCC_HSE_OFF;
+      HAL_RCC_OscConfig(&RCC_OscInitStruct);
+    }
+  }
+
+  if(CLOCKPROFILE_LOW_POWER_MSI != 0)
+  {
+    /** @internal     2.  MSI: only used by the low power profile. HSI16:
+     *                    not used by it, unless the ADC needs it. */
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    if(Profile != CLOCKPROFILE_LOW_POWER)
+    {
+      RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_MSI;
+      RCC_OscInitStruct.MSIState = RCC_MSI_OFF;
+    }
+    else if(ClockProfileInternal.KeepHSI == false)
+    {
+      RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+      RCC_OscInitStruct.HSIState = RCC_HSI_OFF;
+    }
+    HAL_RCC_OscConfig(&RCC_OscInitStruct);
+  }
+}
+
+/**
+ * @brief     Set the core voltage of a profile and wait until it is stable.
+ *            Range 3 (up to 4.2 MHz) only if HSI16 is off.
+ * @param     Profile   profile
+ * @return    none
+ */
+void set_ProfileVoltage(ClockProfile_enumTd Profile)
+{
+  uint32_t Scale = PWR_REGULATOR_VOLTAGE_SCALE2;
+
+  if(Profile == CLOCKPROFILE_PERFORMANCE)
+  {
+    Scale = PWR_REGULATOR_VOLTAGE_SCALE1;
+  }
+  else if(Profile == CLOCKPROFILE_LOW_POWER && ClockProfileInternal.KeepHSI == false)
+  {
+    Scale = PWR_REGULATOR_VOLTAGE_SCALE3;
+  }
+
+  __HAL_PWR_VOLTAGESCALING_CONFIG(Scale);
+  while(__HAL_PWR_GET_FLAG(PWR_FLAG_VOS) != RESET)
+  {
+  }
+}
+
+/**
+ * @brief     Set prescalers and baud rates of all added peripherals for the
+ *            new bus clocks.
+ * @param     none
+ * @return    none
+ */
+void adjust_ProfilePeripherals(void)
+{
+  uint8_t Index = 0;
+
+#ifdef HAL_TIM_MODULE_ENABLED
+  /** @internal     1.  Timers: the nearest prescaler for the tick rate. The
+   *                    prescaler is loaded with the next update event. */
+  for(Index = 0; Index < ClockProfileInternal.NumTimers; Index++)
+  {
+    ClockProfile_Timer_structTd* Timer = &ClockProfileInternal.Timers[Index];
+    uint32_t TimerClock = get_ProfileTimerClock(Timer->htim->Instance);
+    uint32_t Divider = (TimerClock + Timer->TickHz / 2) / Timer->TickHz;
+    if(Divider == 0)
+    {
+      Divider = 1;
+    }
+    if(Divider > 65536)
+    {
+      Divider = 65536;
+    }
+    __HAL_TIM_SET_PRESCALER(Timer->htim, Divider - 1);
+    Timer->htim->Init.Prescaler = Divider - 1;
+  }
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+  /** @internal     2.  SPI: the smallest prescaler (2 ... 256) that does not
+   *                    exceed the bit rate. BR can only be changed while the
+   *                    SPI is disabled, the HAL enables it again with the
+   *                    next transfer. */
+  for(Index = 0; Index < ClockProfileInternal.NumSPIs; Index++)
+  {
+    ClockProfile_SPI_structTd* SPI = &ClockProfileInternal.SPIs[Index];
+    uint32_t BusClock = (SPI->hspi->Instance == SPI1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    uint32_t BR = 0;
+    while(BR < 7 && (BusClock >> (BR + 1)) > SPI->BitRate)
+    {
+      BR++;
+    }
+    __HAL_SPI_DISABLE(SPI->hspi);
+    MODIFY_REG(SPI->hspi->Instance->CR1, SPI_CR1_BR, BR << SPI_CR1_BR_Pos);
+    SPI->hspi->Init.BaudRatePrescaler = BR << SPI_CR1_BR_Pos;
+  }
+#endif
+
+#ifdef HAL_UART_MODULE_ENABLED
+  /** @internal     3.  UART: UART_SetConfig() computes BRR from the clock
+   *                    source of the UART (PCLK, HSI16, SYSCLK or LSE). It
+   *                    can only be changed while the UART is disabled. DMA
+   *                    and interrupt enable bits are kept. The ISR pointers
+   *                    of a running transfer are cleared by the HAL and
+   *                    restored here. On error BRR is not changed. */
+  for(Index = 0; Index < ClockProfileInternal.NumUARTs; Index++)
+  {
+    UART_HandleTypeDef* huart = ClockProfileInternal.UARTs[Index];
+    void (*RxISR)(struct __UART_HandleTypeDef* huart) = huart->RxISR;
+    void (*TxISR)(struct __UART_HandleTypeDef* huart) = huart->TxISR;
+    __HAL_UART_DISABLE(huart);
+    UART_SetConfig(huart);
+    huart->RxISR = RxISR;
+    huart->TxISR = TxISR;
+    __HAL_UART_ENABLE(huart);
+  }
+#endif
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+ClockProfile_enumTd ClockProfile_get_Profile(void)
+{
+  return ClockProfileInternal.Profile;
+}
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/**
+ * @brief     Get the clock of a timer. TIM21 and TIM22 are connected to
+ *            APB2, all other timers to APB1. If the APB clock is divided,
+ *            the timer clock is doubled (see reference manual, clock tree).
+ * @param     Instance  timer
+ * @return    timer clock in Hz
+ */
+uint32_t get_ProfileTimerClock(TIM_TypeDef* Instance)
+{
+  uint32_t TimerClock = 0;
+  uint32_t APBDivided = 0;
+
+  if(Instance == TIM21 || Instance == TIM22)
+  {
+    TimerClock = HAL_RCC_GetPCLK2Freq();
+    APBDivided = RCC->CFGR & RCC_CFGR_PPRE2_2;
+  }
+  else
+  {
+    TimerClock = HAL_RCC_GetPCLK1Freq();
+    APBDivided = RCC->CFGR & RCC_CFGR_PPRE1_2;
+  }
+  return (APBDivided != 0) ? 2 * TimerClock : TimerClock;
+}
+#endif
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "ClockProfile_Source" */
+/**@}*//* end of defgroup "ClockProfile" */
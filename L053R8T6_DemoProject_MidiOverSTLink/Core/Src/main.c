@@ -25,6 +25,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "MIDI_UART.h"
+#include "clockProfile.h"
+#include "profiler.h"
 #include <string.h>
 /* USER CODE END Includes */
 
@@ -35,6 +37,8 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* time without received MIDI data until the clock drops to low power */
+#define MIDI_IDLE_TIME_MS 1000
 
 /* USER CODE END PD */
 
@@ -83,6 +87,12 @@ MIDI_structTd MIDIPort1;
 /* used to read nucleo user button */
 GPIO_PinState PrevButtonState = GPIO_PIN_SET;
 
+/* HAL tick of the last received MIDI data, selects the clock profile */
+volatile uint32_t LastRxTick = 0;
+
+/* set by the SysEx request F0 7D 7F F7, the results are sent in the loop */
+bool ProfilerDumpRequested = false;
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -90,6 +100,7 @@ void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 void HUI_send_SwitchCommandOn(MIDI_structTd* MIDIPort, uint8_t Zone, uint8_t Port);
 void HUI_send_SwitchCommandOff(MIDI_structTd* MIDIPort, uint8_t Zone, uint8_t Port);
+void send_ProfilerResults(MIDI_structTd* MIDIPort);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -132,6 +143,14 @@ int main(void)
   MIDI_init_UART(&MIDIPort1, &huart2);
   MIDI_init_DMARxHandle(&MIDIPort1, &hdma_usart2_rx);
   MIDI_start_Transmission(&MIDIPort1);
+
+  /* SystemClock_Config() runs from MSI range 5: the low power profile */
+  ClockProfile_init(CLOCKPROFILE_LOW_POWER);
+  ClockProfile_add_UART(&huart2);
+
+#if PROFILER_ENABLE == 1
+  Profiler_init();
+#endif
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -140,6 +159,12 @@ int main(void)
   {
     MIDI_update_Transmission(&MIDIPort1);
 
+    if(ProfilerDumpRequested == true)
+    {
+      ProfilerDumpRequested = false;
+      send_ProfilerResults(&MIDIPort1);
+    }
+
     GPIO_PinState ButtonState = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
     if(ButtonState == GPIO_PIN_RESET)
     {
@@ -169,6 +194,18 @@ int main(void)
       HAL_GPIO_WritePin(LED_ON_BOARD_GPIO_Port, LED_ON_BOARD_Pin, GPIO_PIN_RESET);
       SoloCh1.ToggleOff = false;
     }
+
+    /* Performance while MIDI data is received, low power when idle. Switch
+     * only while nothing is sent, the baud rate changes. */
+    ClockProfile_enumTd Profile = CLOCKPROFILE_LOW_POWER;
+    if(HAL_GetTick() - LastRxTick < MIDI_IDLE_TIME_MS)
+    {
+      Profile = CLOCKPROFILE_PERFORMANCE;
+    }
+    if(Profile != ClockProfile_get_Profile() && huart2.gState == HAL_UART_STATE_READY)
+    {
+      ClockProfile_set_Profile(Profile);
+    }
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -312,8 +349,33 @@ void MIDI_callback_ControlChange(MIDI_structTd* MIDIPort, uint8_t Channel, uint8
   }
 }
 
+void MIDI_callback_SystemExclusive(MIDI_structTd* MIDIPort, uint8_t* Data, uint16_t Size)
+{
+  /* Profiler request: F0 7D 7F F7 (Data includes start and end byte) */
+  if(MIDIPort == &MIDIPort1 && Size == 4 && Data[1] == 0x7D && Data[2] == PROFILER_SYSEX_ALL)
+  {
+    ProfilerDumpRequested = true;
+  }
+}
+
+void send_ProfilerResults(MIDI_structTd* MIDIPort)
+{
+#if PROFILER_ENABLE == 1
+  /* One SysEx message for each region, queued without start and end byte */
+  uint8_t Message[PROFILER_SYSEX_LENGTH];
+  uint8_t Region = 0;
+
+  for(Region = 0; Region < PROFILER_NUM_REGIONS; Region++)
+  {
+    Profiler_pack_SysEx((Profiler_Region_enumTd)Region, Message);
+    MIDI_queue_SystemExclusive(MIDIPort, &Message[1], PROFILER_SYSEX_LENGTH - 2);
+  }
+#endif
+}
+
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
+  LastRxTick = HAL_GetTick();
   MIDI_manage_RxInterrupt(&MIDIPort1, huart, Size);
 }
 
@@ -7,8 +7,10 @@
  * 1. Initialize Pin In1, Pin In2, Pin STBY
  * 2. Initialize PWM (check MotorDriver_init_PWM() for information about the TIM
  *    settings.)
- * 3. Start PWM -> The PWM will be generated continuous now.
- * 4. Use move, stop or standby functions to control the motor.
+ * 3. Optional: set carrier and resolution with MotorDriver_init_PWMCarrier()
+ *    and the dither with MotorDriver_init_Dither().
+ * 4. Start PWM -> The PWM will be generated continuous now.
+ * 5. Use move, stop or standby functions to control the motor.
  *
  *
  * # General information
@@ -22,6 +24,31 @@
  *    Until ARR is reached, the PWM pulse will be low.
  *    For this module: The most relevant value is CCR, as it is used to control
  *    the PWM duty cycle in the running program.
+ * -  @anchor PWM_Carrier_Resolution Carrier and Resolution
+ *  - With prescaler 0 the resolution (ARR + 1 steps) is the timer clock
+ *    divided by the carrier frequency. The carrier and the resolution can not
+ *    be chosen independently: 32 MHz and 64 kHz give 500 steps, 20 kHz (the
+ *    lowest carrier above the audible range) gives 1600 steps. All CCR values
+ *    (limits, start force, stop range) scale with the resolution.
+ *  - The dither adds fractional bits below one CCR step. A first order
+ *    sigma-delta modulator carries the remainder from one CCR write to the
+ *    next, so the mean duty cycle has the resolution of the fine CCR. The
+ *    mechanical time constant of the motor averages the dither.
+ *  - The modulator steps once per CCR write, i.e. with the control rate, not
+ *    once per PWM period. The pattern of N bits repeats after up to 2^N
+ *    writes, so its lowest tone is the control rate / 2^N (e.g. 750 Hz with
+ *    3 kHz and 2 bits) with an amplitude of one CCR step. This is in the
+ *    audible range. The bits are limited to
+ *    @ref MOTORDRIVER_DITHER_BITS_MAX, so the tone stays in the upper part of
+ *    the control band and the motor filters it well. A dither per PWM
+ *    period would need an update interrupt with the carrier frequency (too
+ *    slow on a Cortex-M0+) or a DMA of the CCR on the update event, neither
+ *    is set up here.
+ *  - The output compare preload (OCxPE) is set by HAL_TIM_PWM_ConfigChannel()
+ *    in the Cube code, the driver does not set it. A new CCR is taken at the
+ *    next update event, so a period never switches with two different CCR
+ *    values (e.g. no missed switch-off if the new CCR is below the counter).
+ *    The dither relies on it.
  *
  * # Links:
  * @anchor          TB6612FNG_Datasheet [Datasheet](https://toshiba.semicon-storage.com/info/TB6612FNG_datasheet_en_20141001.pdf?did=10660&prodName=TB6612FNG)
@@ -48,6 +75,29 @@
 #define INC_TB6612FNG_MOTORDC_H_
 
 #include "stm32l0xx_hal.h"
+#include <stdbool.h>
+
+/***************************************************************************//**
+ * @name      Settings
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Lowest carrier frequency in Hz that is not audible. Used by
+ *            MotorDriver_init_PWMCarrier() with the ultrasonic option.
+ */
+#define MOTORDRIVER_ULTRASONIC_HZ     20000
+
+/**
+ * @brief     Maximum number of dither bits below one CCR step. The dither
+ *            pattern repeats after up to 2^Bits CCR writes (see
+ *            @ref PWM_Carrier_Resolution "Carrier and Resolution").
+ */
+#define MOTORDRIVER_DITHER_BITS_MAX   2
+
+/** @} ************************************************************************/
+/* end of name "Settings"
+ ******************************************************************************/
 
 
 /***************************************************************************//**
@@ -83,6 +133,8 @@ typedef struct
                                     with the other motor on the IC! */
 
   uint16_t      CCR;          /**<  current CCR value for the PWM  */
+  uint8_t       DitherBits;   /**<  fractional bits of the fine CCR. 0: off */
+  uint16_t      DitherAccu;   /**<  remainder of the sigma-delta dither */
 
 }TB6612FNGMotorDriver_structTd;
 
@@ -185,6 +237,35 @@ void MotorDriver_init_PinSTBY(TB6612FNGMotorDriver_structTd* Motor, GPIO_TypeDef
  */
 void MotorDriver_init_PWM(TB6612FNGMotorDriver_structTd* Motor, TIM_HandleTypeDef* htim, uint16_t Channel);
 
+/**
+ * @brief     Set carrier frequency and resolution of a PWM timer together.
+ *            The prescaler is set to 0 (highest resolution) and ARR to the
+ *            timer clock divided by the carrier. Call it once for each timer
+ *            before the PWM is started. See @ref PWM_Carrier_Resolution
+ *            "Carrier and Resolution".
+ * @param     htim          pointer to the HAL-handle for the timer used for PWM
+ * @param     TimerClockHz  clock of the timer in Hz (usually HCLK)
+ * @param     CarrierHz     wanted carrier frequency in Hz
+ * @param     Ultrasonic    true raises the carrier to at least
+ *                          @ref MOTORDRIVER_ULTRASONIC_HZ
+ * @return    resolution in CCR steps (ARR + 1). The CCR for full duty.
+ */
+uint32_t MotorDriver_init_PWMCarrier(TIM_HandleTypeDef* htim, uint32_t TimerClockHz, uint32_t CarrierHz, bool Ultrasonic);
+
+/**
+ * @brief     Set the number of fractional bits of the fine CCR. The fine move
+ *            functions dither them with a sigma-delta modulator. The other
+ *            move functions are not affected. The modulator steps with each
+ *            CCR write, not with each PWM period, so the dither is audible
+ *            with too many bits (see @ref PWM_Carrier_Resolution).
+ * @param     Motor     pointer to the users motor structure of the motor used
+ *                      with this IC.
+ * @param     Bits      fractional bits (0 - @ref MOTORDRIVER_DITHER_BITS_MAX).
+ *                      0 switches the dither off.
+ * @return    none
+ */
+void MotorDriver_init_Dither(TB6612FNGMotorDriver_structTd* Motor, uint8_t Bits);
+
 /** @} ************************************************************************/
 /* end of name "Initialize"
  ******************************************************************************/
@@ -198,7 +279,8 @@ void MotorDriver_init_PWM(TB6612FNGMotorDriver_structTd* Motor, TIM_HandleTypeDe
 
 /**
  * @brief     Call this function once for each initialized Motor. This will
- *            start the PWM timer with DMA.
+ *            start the PWM timer. The output compare preload is set by
+ *            HAL_TIM_PWM_ConfigChannel().
  * @param     Motor     pointer to the users motor structure of the motor used
  *                      with this IC.
  * @return    none
@@ -243,6 +325,29 @@ void MotorDriver_move_ClockWise(TB6612FNGMotorDriver_structTd* Motor, uint16_t C
  */
 void MotorDriver_move_CounterClockWise(TB6612FNGMotorDriver_structTd* Motor, uint16_t CCR);
 
+/**
+ * @brief     Move the motor clock wise with a fine CCR. The fine CCR has the
+ *            fractional bits set with MotorDriver_init_Dither(). The written
+ *            CCR alternates between the two nearest steps, so the mean duty
+ *            cycle is the fine CCR. The fine CCR is limited to ARR, so the
+ *            written CCR never exceeds the period.
+ * @param     Motor     pointer to the users motor structure of the motor used
+ *                      with this IC.
+ * @param     CCRFine   CCR << dither bits plus the fractional part
+ * @return    none
+ */
+void MotorDriver_move_ClockWiseFine(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine);
+
+/**
+ * @brief     Move the motor counter clock wise with a fine CCR. See
+ *            MotorDriver_move_ClockWiseFine().
+ * @param     Motor     pointer to the users motor structure of the motor used
+ *                      with this IC.
+ * @param     CCRFine   CCR << dither bits plus the fractional part
+ * @return    none
+ */
+void MotorDriver_move_CounterClockWiseFine(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine);
+
 /**
  * @brief     Call this function to stop the motor without active brake. The
  *            output of the driver will be on high impedance (OFF). The CCR
@@ -0,0 +1,249 @@
+/***************************************************************************//**
+ * @defgroup        CascadeController   Cascade controller
+ * @brief           This module is an alternative to the
+ *                  @ref PIDFixed_Controller "PID" with an outer position
+ *                  loop, an inner velocity loop and an alpha-beta estimator.
+ *
+ * The PID only sees the smoothed wiper value. Its D-Term is the low pass
+ * filtered difference of these values, so it lags behind and amplifies the
+ * noise with a bigger Kd. This controller estimates position and velocity
+ * from the raw wiper samples with an alpha-beta filter instead:
+ * - Predict: Position += Velocity
+ * - Correct: Residual = Sample - Position,
+ *   Position += Alpha * Residual, Velocity += Beta * Residual
+ *
+ * Alpha weights the measurement against the prediction of the position,
+ * Beta corrects the velocity. Smaller values filter more noise but follow
+ * changes of the velocity slower. Beta = Alpha^2 / (2 - Alpha) gives a
+ * critically damped filter.
+ *
+ * With these estimates two loops control the fader:
+ * - Position loop: commanded velocity = velocity of the setpoint (feed
+ *   forward) + PositionGain * (setpoint - estimated position), limited to
+ *   the largest velocity.
+ * - Velocity loop: CCR = VelocityKp * velocity error + I-Term. The I-Term
+ *   sums VelocityKi * velocity error * sample time. It is limited to the
+ *   output range and stops while the output is saturated (anti wind-up).
+ *
+ * The calculation only uses integer operations on Q16.16 values, so it can
+ * run in the control timer interrupt.
+ *
+ * # How to use:
+ * 1. Declare an object of CascadeController_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with CascadeController_init().
+ * 3. Set gains, estimator, output limit and sample time.
+ * 4. Call CascadeController_calculate() with a fixed rate and use the
+ *    output as CCR.
+ *
+ * @defgroup        CascadeController_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      CascadeController
+ * @{
+ *
+ * @addtogroup      CascadeController_Header
+ * @{
+ *
+ * @file            cascadeController.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_CASCADECONTROLLER_H_
+#define INC_FADER_CASCADECONTROLLER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Number of fraction bits of all fixed-point values and
+ *            coefficients in this module.
+ */
+#define CASCADECONTROLLER_Q_SHIFT   16
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Main structure of the cascade controller. Declare one object for
+ *            each fader. Positions, velocities and terms are Q16.16 if not
+ *            noted otherwise.
+ */
+typedef struct
+{
+  double    PositionGain;   /**< Position loop gain as set by the user
+                                 (1 / ms) */
+  double    VelocityKp;     /**< Velocity loop P coefficient as set by the
+                                 user (CCR per count/ms) */
+  double    VelocityKi;     /**< Velocity loop I coefficient as set by the
+                                 user (CCR per count) */
+  double    Alpha;          /**< Position weight of the estimator */
+  double    Beta;           /**< Velocity weight of the estimator */
+  uint32_t  MaxVelocity;    /**< Velocity limit as set by the user
+                                 (counts per second) */
+  uint32_t  SampleTimeUs;   /**< Time between two calculations (us) */
+
+  int32_t   CoeffPosition;  /**< PositionGain * SampleTime */
+  int32_t   CoeffVelocityP; /**< VelocityKp / SampleTime */
+  int32_t   CoeffVelocityI; /**< VelocityKi */
+  int32_t   CoeffAlpha;     /**< Alpha */
+  int32_t   CoeffBeta;      /**< Beta */
+  int32_t   VelocityLimit;  /**< Velocity limit (counts per sample) */
+  int32_t   OutputMax;      /**< Output limit */
+
+  bool      Started;        /**< false until the first sample */
+  int32_t   Position;       /**< Estimated position */
+  int32_t   Velocity;       /**< Estimated velocity (counts per sample) */
+  int32_t   ITerm;          /**< I-Term of the velocity loop */
+  int       Output;         /**< Round output of the last calculation */
+}CascadeController_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the controller without gains. The estimator starts
+ *            with Alpha 0.25 and a critically damped Beta.
+ * @param     Controller  pointer to the controller structure
+ * @return    none
+ */
+void CascadeController_init(CascadeController_structTd* Controller);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @brief     The double values are converted here, so do not call them in the
+ *            update cycle.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set the gains of both loops.
+ * @param     Controller    pointer to the controller structure
+ * @param     PositionGain  commanded velocity in counts/ms per count of
+ *                          position error (e.g. 0.05: 20 ms time constant)
+ * @param     VelocityKp    CCR per count/ms of velocity error
+ * @param     VelocityKi    CCR per count of summed velocity error
+ * @param     MaxVelocity   largest commanded velocity in counts per second.
+ *                          0: no limit.
+ * @return    none
+ */
+void CascadeController_set_Gains(CascadeController_structTd* Controller, double PositionGain, double VelocityKp, double VelocityKi, uint32_t MaxVelocity);
+
+/**
+ * @brief     Set the weights of the alpha-beta estimator.
+ * @param     Controller  pointer to the controller structure
+ * @param     Alpha       position weight (0 - 1)
+ * @param     Beta        velocity weight (0 - 4 - 2 * Alpha). 0 uses the
+ *                        critically damped value Alpha^2 / (2 - Alpha).
+ * @return    none
+ */
+void CascadeController_set_Estimator(CascadeController_structTd* Controller, double Alpha, double Beta);
+
+/**
+ * @brief     Set the output range to -Max..Max.
+ * @param     Controller  pointer to the controller structure
+ * @param     Max         largest output (CCR)
+ * @return    none
+ */
+void CascadeController_set_OutputMax(CascadeController_structTd* Controller, int32_t Max);
+
+/**
+ * @brief     Set the time between two calculations. The coefficients are
+ *            converted again.
+ * @param     Controller  pointer to the controller structure
+ * @param     SampleTime  time in microseconds
+ * @return    none
+ */
+void CascadeController_set_SampleTimeInUs(CascadeController_structTd* Controller, uint32_t SampleTime);
+
+/**
+ * @brief     Reset estimator and I-Term. The next sample starts the estimator
+ *            at rest.
+ * @param     Controller  pointer to the controller structure
+ * @return    none
+ */
+void CascadeController_reset(CascadeController_structTd* Controller);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the estimator with a raw sample and calculate the output.
+ *            Call it with the set sample time. Only uses integer operations,
+ *            so it can be called in an interrupt.
+ * @param     Controller  pointer to the controller structure
+ * @param     Setpoint    position setpoint (integer)
+ * @param     SetpointVelocity velocity of the setpoint in counts per sample
+ *                        (Q16.16, see MotionProfile_get_Velocity()). 0 if
+ *                        unknown.
+ * @param     Sample      raw position sample
+ * @return    output (CCR). - is down, + is up
+ */
+int CascadeController_calculate(CascadeController_structTd* Controller, int32_t Setpoint, int32_t SetpointVelocity, int32_t Sample);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the estimated position.
+ * @param     Controller  pointer to the controller structure
+ * @return    position (integer)
+ */
+int32_t CascadeController_get_Position(CascadeController_structTd* Controller);
+
+/**
+ * @brief     Get the estimated velocity.
+ * @param     Controller  pointer to the controller structure
+ * @return    velocity in counts per sample (Q16.16)
+ */
+int32_t CascadeController_get_Velocity(CascadeController_structTd* Controller);
+
+/**
+ * @brief     Get the output of the last calculation.
+ * @param     Controller  pointer to the controller structure
+ * @return    output (CCR)
+ */
+int CascadeController_get_Output(CascadeController_structTd* Controller);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "CascadeController_Header" */
+/**@}*//* end of defgroup "CascadeController" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_CASCADECONTROLLER_H_ */
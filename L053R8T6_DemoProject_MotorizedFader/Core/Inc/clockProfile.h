@@ -0,0 +1,254 @@
+/***************************************************************************//**
+ * @defgroup        ClockProfile    Clock profile
+ * @brief           This module switches the system clock at run time between
+ *                  low power, balanced and performance and keeps the rates
+ *                  of the peripherals.
+ *
+ * # Profiles
+ * | Profile     | SYSCLK             | HCLK      | Voltage     | Flash |
+ * |-------------|--------------------|-----------|-------------|-------|
+ * | Low power   | HSI16, AHB / 8     | 2 MHz     | Range 2     | 0 WS  |
+ * |             | or MSI range 5     | 2.097 MHz | Range 2 / 3 | 0 WS  |
+ * | Balanced    | HSI16              | 16 MHz    | Range 2     | 1 WS  |
+ * | Performance | PLL (HSE or HSI16) | 32 MHz    | Range 1     | 1 WS  |
+ *
+ * HSI16 / 8 runs at whole MHz, so timers that count microseconds stay exact.
+ * The MSI ranges do not (range 5: 2.097 MHz). Select MSI for low power with
+ * @ref CLOCKPROFILE_LOW_POWER_MSI only without such timers, e.g. in the MIDI
+ * demo. MSI stops HSI16 in low power and allows voltage range 3, unless an
+ * ADC is added: HSI16 clocks it.
+ *
+ * # Peripherals
+ * The peripherals are added once. Their rate at that time is kept:
+ * - Timers: the tick rate (timer clock / (PSC + 1)) is kept by a new
+ *   prescaler, ARR and CCR stay. If the prescaler can not reach the tick
+ *   rate (e.g. PWM with PSC 0 and a lower clock), the period is kept by a
+ *   new ARR and the CCRs are scaled with it: PWM carrier, duty cycles and
+ *   compare triggers (e.g. of the ADC) stay, with fewer steps. Code that
+ *   writes CCRs in steps of the old resolution (e.g. the fader PIDs) gets a
+ *   coarser or limited duty cycle, so drive motors in the performance
+ *   profile only. The new values are loaded at once by an update event
+ *   without update interrupt. The counter restarts, the time it counted is
+ *   passed to ClockProfile_TimerRestartCallback() (e.g. for the time base of
+ *   the timer service).
+ * - SPI: the fastest prescaler that does not exceed the bit rate.
+ * - UART: the baud rate of the init structure, set by UART_SetConfig() of
+ *   the HAL for the clock source of the UART (also LPUART).
+ * - ADC: moved to the asynchronous clock HSI16 / 2 (8 MHz), independent of
+ *   the system clock.
+ *
+ * Each type is only compiled if its HAL module is enabled in
+ * stm32l0xx_hal_conf.h (HAL_TIM_MODULE_ENABLED, HAL_SPI_MODULE_ENABLED,
+ * HAL_UART_MODULE_ENABLED, HAL_ADC_MODULE_ENABLED).
+ *
+ * # How to use:
+ * 1. Initialize the module with the profile of SystemClock_Config() with
+ *    ClockProfile_init().
+ * 2. Add the peripherals with ClockProfile_add_Timer(),
+ *    ClockProfile_add_SPI(), ClockProfile_add_UART() and
+ *    ClockProfile_add_ADC(). Add the ADC before it is started.
+ * 3. Switch with ClockProfile_set_Profile(), e.g. to performance under load
+ *    and to low power when idle.
+ *
+ * @warning   Switch in the main loop while SPI and UART do not transfer. A
+ *            byte on the UART may get lost while the baud rate changes. The
+ *            control loop of the faders needs the performance (or
+ *            balanced) profile.
+ *
+ * @defgroup        ClockProfile_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      ClockProfile
+ * @{
+ *
+ * @addtogroup      ClockProfile_Header
+ * @{
+ *
+ * @file            clockProfile.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_CLOCKPROFILE_H_
+#define INC_FADER_CLOCKPROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l0xx_hal.h"
+
+/***************************************************************************//**
+ * @name      Settings
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     PLL of the performance profile (32 MHz). Keep it equal to
+ *            SystemClock_Config(): HSE 8 MHz * 8 / 2 = 32 MHz. The HSE state
+ *            is only used with RCC_PLLSOURCE_HSE.
+ */
+#define CLOCKPROFILE_PLL_SOURCE   RCC_PLLSOURCE_HSE
+#define CLOCKPROFILE_HSE_STATE    RCC_HSE_ON
+#define CLOCKPROFILE_PLL_MUL      RCC_PLLMUL_8
+#define CLOCKPROFILE_PLL_DIV      RCC_PLLDIV_2
+
+/**
+ * @brief     Clock of the low power profile. 0: HSI16 / 8 (2 MHz),
+ *            1: MSI range 5 (2.097 MHz)
+ */
+#define CLOCKPROFILE_LOW_POWER_MSI  0
+
+/**
+ * @brief     Maximum number of peripherals of each type
+ */
+#define CLOCKPROFILE_MAX_TIMERS   4
+#define CLOCKPROFILE_MAX_SPIS     2
+#define CLOCKPROFILE_MAX_UARTS    2
+
+/** @} ************************************************************************/
+/* end of name "Settings"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Clock profiles
+ */
+typedef enum
+{
+  CLOCKPROFILE_LOW_POWER = 0, /**< 2 MHz from HSI16 or MSI */
+  CLOCKPROFILE_BALANCED,      /**< 16 MHz from HSI16 */
+  CLOCKPROFILE_PERFORMANCE    /**< 32 MHz from the PLL */
+}ClockProfile_enumTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the module, switch HSI16 on if the profiles need it
+ *            and set the core voltage of the profile.
+ * @param     Profile   current profile, as set up by SystemClock_Config()
+ * @return    HAL_OK if HSI16 is running or not needed
+ */
+HAL_StatusTypeDef ClockProfile_init(ClockProfile_enumTd Profile);
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/**
+ * @brief     Add a timer. Its current tick rate is kept.
+ * @param     htim      pointer to the HAL-handle of the timer
+ * @return    false if there is no space for another timer
+ */
+bool ClockProfile_add_Timer(TIM_HandleTypeDef* htim);
+#endif
+
+#ifdef HAL_SPI_MODULE_ENABLED
+/**
+ * @brief     Add a SPI. Its current bit rate is the upper limit.
+ * @param     hspi      pointer to the HAL-handle of the SPI
+ * @return    false if there is no space for another SPI
+ */
+bool ClockProfile_add_SPI(SPI_HandleTypeDef* hspi);
+#endif
+
+#ifdef HAL_UART_MODULE_ENABLED
+/**
+ * @brief     Add a UART. The baud rate of its init structure is kept.
+ * @param     huart     pointer to the HAL-handle of the UART or LPUART
+ * @return    false if there is no space for another UART
+ */
+bool ClockProfile_add_UART(UART_HandleTypeDef* huart);
+#endif
+
+#ifdef HAL_ADC_MODULE_ENABLED
+/**
+ * @brief     Move the ADC to the asynchronous clock HSI16 / 2 and keep HSI16
+ *            on in all profiles. Call it before the ADC is started.
+ * @param     hadc      pointer to the HAL-handle of the ADC
+ * @return    HAL status of the ADC init. HAL_ERROR if the ADC is enabled.
+ */
+HAL_StatusTypeDef ClockProfile_add_ADC(ADC_HandleTypeDef* hadc);
+#endif
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Switch to another profile and adjust the added peripherals.
+ *            Does nothing if the profile is active already.
+ * @param     Profile   new profile
+ * @return    HAL_OK if switched. Otherwise the old profile is kept (if the
+ *            new oscillator did not start) or the status of the HAL.
+ */
+HAL_StatusTypeDef ClockProfile_set_Profile(ClockProfile_enumTd Profile);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the active profile.
+ * @param     none
+ * @return    active profile
+ */
+ClockProfile_enumTd ClockProfile_get_Profile(void);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/***************************************************************************//**
+ * @name      Callbacks
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Called when a profile switch restarted the counter of an added
+ *            timer. Overwrite it (weak) to correct a time base that is
+ *            extended in the update interrupt, e.g. with
+ *            TimerService_manage_CounterReset(). Runs with interrupts
+ *            disabled.
+ * @param     htim      pointer to the HAL-handle of the timer
+ * @param     ElapsedUs time the counter counted since its last update event
+ * @return    none
+ */
+void ClockProfile_TimerRestartCallback(TIM_HandleTypeDef* htim, uint32_t ElapsedUs);
+
+/** @} ************************************************************************/
+/* end of name "Callbacks"
+ ******************************************************************************/
+#endif
+
+/**@}*//* end of defgroup "ClockProfile_Header" */
+/**@}*//* end of defgroup "ClockProfile" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_CLOCKPROFILE_H_ */
@@ -0,0 +1,235 @@
+/***************************************************************************//**
+ * @defgroup        FaderEvents   Fader events
+ * @brief           This module turns fader positions and touch states into
+ *                  timestamped events in a ring buffer.
+ *
+ * Instead of polling the position and touch state of each fader in every
+ * loop, a consumer (e.g. MIDI output) reads only real changes:
+ * - @ref FADEREVENTS_TOUCH and @ref FADEREVENTS_RELEASE on each edge of the
+ *   touch state.
+ * - @ref FADEREVENTS_POSITION if the position changed by the resolution
+ *   since the last reported position.
+ * - Other modules can write their own events with FaderEvents_write_Event()
+ *   (e.g. @ref FADEREVENTS_STALL).
+ *
+ * Each event contains the position, a filtered velocity and the time of
+ * detection in microseconds. When an event is read, the time since its
+ * detection is stored as latency. The largest latency is kept.
+ *
+ * The ring buffer has one producer (the tracker update, usually in the
+ * control timer interrupt) and one consumer (the main loop). If the buffer is
+ * full, new events are dropped and counted.
+ *
+ * # How to use:
+ * 1. Declare one FaderEvents_Queue_structTd and one
+ *    FaderEvents_Tracker_structTd for each fader (usually done by the
+ *    motorized fader module).
+ * 2. Initialize them with FaderEvents_init_Queue() and
+ *    FaderEvents_init_Tracker().
+ * 3. Call FaderEvents_update_Tracker() with each new position.
+ * 4. Read the events with FaderEvents_read_Event().
+ *
+ * @defgroup        FaderEvents_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FaderEvents
+ * @{
+ *
+ * @addtogroup      FaderEvents_Header
+ * @{
+ *
+ * @file            faderEvents.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_FADEREVENTS_H_
+#define INC_FADER_FADEREVENTS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Number of events in the ring buffer. Must be a power of 2.
+ */
+#define FADEREVENTS_BUFFER_SIZE   32
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Types of events
+ */
+typedef enum
+{
+  FADEREVENTS_TOUCH,      /**< The fader was touched */
+  FADEREVENTS_RELEASE,    /**< The fader was released */
+  FADEREVENTS_POSITION,   /**< The position changed by the resolution */
+  FADEREVENTS_STALL       /**< The motor stalled (see StallDetector) */
+}FaderEvents_Type_enumTd;
+
+/**
+ * @brief     One event
+ */
+typedef struct
+{
+  uint32_t  TimeUs;       /**< Time of detection (us) */
+  uint32_t  LatencyUs;    /**< Time from detection to reading (us) */
+  FaderEvents_Type_enumTd Type;
+  uint8_t   Fader;        /**< Index of the fader */
+  uint16_t  Position;     /**< Position at detection */
+  int32_t   Velocity;     /**< Filtered velocity (counts per s) */
+}FaderEvents_Event_structTd;
+
+/**
+ * @brief     Ring buffer for the events. Declare one object for all faders.
+ */
+typedef struct
+{
+  FaderEvents_Event_structTd Events[FADEREVENTS_BUFFER_SIZE];
+  volatile uint16_t Head;   /**< Next event to write (producer) */
+  volatile uint16_t Tail;   /**< Next event to read (consumer) */
+  uint32_t  Overflows;      /**< Number of dropped events */
+  uint32_t  LatencyMaxUs;   /**< Largest latency of a read event */
+}FaderEvents_Queue_structTd;
+
+/**
+ * @brief     Tracker for the events of one fader. Declare one object for
+ *            each fader.
+ */
+typedef struct
+{
+  uint16_t  Resolution;     /**< Position change for an event. 0: no events */
+  uint8_t   VelocityShift;  /**< Weight of a new velocity is 1 / 2^Shift */
+  bool      Started;        /**< false until the first update */
+  bool      Touched;        /**< Touch state of the last update */
+  uint16_t  LastPosition;   /**< Position of the last update */
+  uint16_t  ReportedPosition; /**< Position of the last event */
+  uint32_t  LastTimeUs;     /**< Time of the last update */
+  int32_t   Velocity;       /**< Filtered velocity (counts per s) */
+}FaderEvents_Tracker_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize queue and trackers
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize an empty queue.
+ * @param     Queue     pointer to the queue structure
+ * @return    none
+ */
+void FaderEvents_init_Queue(FaderEvents_Queue_structTd* Queue);
+
+/**
+ * @brief     Initialize the tracker of a fader.
+ * @param     Tracker       pointer to the tracker structure
+ * @param     Resolution    position change in counts for a position event.
+ *                          0 switches off all events of this fader.
+ * @param     VelocityShift weight of a new velocity is 1 / 2^VelocityShift
+ *                          (0 - 8). With 333 us updates, 4 gives a time
+ *                          constant of about 5 ms.
+ * @return    none
+ */
+void FaderEvents_init_Tracker(FaderEvents_Tracker_structTd* Tracker, uint16_t Resolution, uint8_t VelocityShift);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the tracker with a new position and touch state. Writes
+ *            the events into the queue. Only uses integer operations, so it
+ *            can be called in an interrupt.
+ * @param     Queue     pointer to the queue structure
+ * @param     Tracker   pointer to the tracker structure
+ * @param     Fader     index of the fader, stored in the events
+ * @param     Position  current position
+ * @param     Touched   current touch state
+ * @param     TimeUs    current time in microseconds
+ * @return    none
+ */
+void FaderEvents_update_Tracker(FaderEvents_Queue_structTd* Queue, FaderEvents_Tracker_structTd* Tracker, uint8_t Fader, uint16_t Position, bool Touched, uint32_t TimeUs);
+
+/**
+ * @brief     Write an event into the queue. If the queue is full, the event
+ *            is dropped and counted. The velocity is taken from the tracker.
+ *            Call it in the same context as FaderEvents_update_Tracker(), as
+ *            the queue has only one producer.
+ * @param     Queue     pointer to the queue structure
+ * @param     Tracker   pointer to the tracker structure
+ * @param     Type      type of the event
+ * @param     Fader     index of the fader, stored in the event
+ * @param     Position  current position
+ * @param     TimeUs    current time in microseconds
+ * @return    none
+ */
+void FaderEvents_write_Event(FaderEvents_Queue_structTd* Queue, FaderEvents_Tracker_structTd* Tracker, FaderEvents_Type_enumTd Type, uint8_t Fader, uint16_t Position, uint32_t TimeUs);
+
+/**
+ * @brief     Read the oldest event of the queue.
+ * @param     Queue     pointer to the queue structure
+ * @param     Event     pointer where the event is copied to
+ * @param     TimeUs    current time in microseconds, used for the latency
+ * @return    true if an event was read, false if the queue is empty
+ */
+bool FaderEvents_read_Event(FaderEvents_Queue_structTd* Queue, FaderEvents_Event_structTd* Event, uint32_t TimeUs);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the filtered velocity of a fader.
+ * @param     Tracker   pointer to the tracker structure
+ * @return    velocity in counts per second
+ */
+int32_t FaderEvents_get_Velocity(FaderEvents_Tracker_structTd* Tracker);
+
+/**
+ * @brief     Get the number of dropped events.
+ * @param     Queue     pointer to the queue structure
+ * @return    number of events dropped because the queue was full
+ */
+uint32_t FaderEvents_get_Overflows(FaderEvents_Queue_structTd* Queue);
+
+/**
+ * @brief     Get the largest latency of all read events.
+ * @param     Queue     pointer to the queue structure
+ * @return    latency in microseconds
+ */
+uint32_t FaderEvents_get_LatencyMaxUs(FaderEvents_Queue_structTd* Queue);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderEvents_Header" */
+/**@}*//* end of defgroup "FaderEvents" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_FADEREVENTS_H_ */
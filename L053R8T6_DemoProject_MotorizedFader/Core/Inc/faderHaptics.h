@@ -0,0 +1,252 @@
+/***************************************************************************//**
+ * @defgroup        FaderHaptics    Fader haptics
+ * @brief           This module calculates a position dependent force field,
+ *                  that the motor renders while the fader is touched.
+ *
+ * The force is the sum of:
+ * - Detents: wells around a position (e.g. 0 dB, pan center). Within the
+ *   width of a detent the force pulls to its center. It rises linearly to
+ *   the detent force at half the width and falls back to 0 at the width, so
+ *   the fader clicks into the detent and can be pushed out of it.
+ * - Soft end stops: below the low or above the high position the force
+ *   pushes back with the end stop stiffness (a spring).
+ * - Spring: pulls to a target with the spring stiffness (e.g. a return to
+ *   center).
+ * - Damping: against the velocity, so the fader does not oscillate in a
+ *   detent or at an end stop.
+ *
+ * The sum is limited to the largest force. All positions are in the same
+ * units as the fader target. The calculation only uses integer operations
+ * on Q16.16 values, so it can run in the control timer interrupt.
+ *
+ * # How to use:
+ * 1. Declare an object of FaderHaptics_structTd (usually done by the
+ *    motorized fader module) and a table of FaderHaptics_Detent_structTd
+ *    for each fader that needs detents.
+ * 2. Initialize it with FaderHaptics_init() and set the largest force with
+ *    FaderHaptics_set_ForceMax(). A largest force of 0 switches the
+ *    haptics off.
+ * 3. Set detents, end stops, spring, damping and sample time.
+ * 4. While the fader is touched, call FaderHaptics_calculate() with a fixed
+ *    rate and use the output as CCR. Call FaderHaptics_reset() when it is
+ *    released.
+ *
+ * @defgroup        FaderHaptics_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FaderHaptics
+ * @{
+ *
+ * @addtogroup      FaderHaptics_Header
+ * @{
+ *
+ * @file            faderHaptics.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_FADERHAPTICS_H_
+#define INC_FADER_FADERHAPTICS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Number of fraction bits of the fixed-point coefficients.
+ */
+#define FADERHAPTICS_Q_SHIFT    16
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     One detent. Declare a table of them for each fader.
+ */
+typedef struct
+{
+  uint16_t  Position;     /**< Center of the detent */
+  uint16_t  Width;        /**< Distance from the center where the detent
+                               ends (counts) */
+  uint16_t  Force;        /**< Largest force of the detent (CCR) */
+}FaderHaptics_Detent_structTd;
+
+/**
+ * @brief     Main structure of the haptics. Declare one object for each
+ *            fader. Coefficients are Q16.16.
+ */
+typedef struct
+{
+  const FaderHaptics_Detent_structTd* Detents; /**< Detent table */
+  uint8_t   NumDetents;     /**< Number of detents in the table */
+  bool      Started;        /**< false until the first sample */
+
+  uint16_t  EndLow;         /**< Low end stop position */
+  uint16_t  EndHigh;        /**< High end stop position */
+  uint16_t  SpringTarget;   /**< Target of the spring */
+  int32_t   ForceMax;       /**< Largest force (CCR). 0: off */
+
+  double    EndStiffness;   /**< End stop stiffness as set by the user (CCR
+                                 per count) */
+  double    SpringStiffness;/**< Spring stiffness as set by the user (CCR per
+                                 count) */
+  double    Damping;        /**< Damping as set by the user (CCR per
+                                 count/ms) */
+  uint32_t  SampleTimeUs;   /**< Time between two calculations (us) */
+
+  int32_t   CoeffEnd;       /**< EndStiffness */
+  int32_t   CoeffSpring;    /**< SpringStiffness */
+  int32_t   CoeffDamping;   /**< Damping / SampleTime */
+
+  int32_t   LastPosition;   /**< Position of the last calculation */
+  int       Force;          /**< Force of the last calculation (CCR) */
+}FaderHaptics_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the haptics. All forces are off afterwards.
+ * @param     Haptics   pointer to the haptics structure
+ * @return    none
+ */
+void FaderHaptics_init(FaderHaptics_structTd* Haptics);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @brief     The double values are converted here, so do not call them in the
+ *            update cycle.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set the largest force.
+ * @param     Haptics   pointer to the haptics structure
+ * @param     ForceMax  largest force (CCR). 0 switches the haptics off.
+ * @return    none
+ */
+void FaderHaptics_set_ForceMax(FaderHaptics_structTd* Haptics, uint16_t ForceMax);
+
+/**
+ * @brief     Set the detent table. The table is not copied, so it has to stay
+ *            valid (e.g. const or static).
+ * @param     Haptics     pointer to the haptics structure
+ * @param     Detents     detent table. NULL: no detents.
+ * @param     NumDetents  number of detents in the table
+ * @return    none
+ */
+void FaderHaptics_set_Detents(FaderHaptics_structTd* Haptics, const FaderHaptics_Detent_structTd* Detents, uint8_t NumDetents);
+
+/**
+ * @brief     Set the soft end stops.
+ * @param     Haptics   pointer to the haptics structure
+ * @param     Low       low end stop position
+ * @param     High      high end stop position
+ * @param     Stiffness CCR per count behind the end stop. 0: off.
+ * @return    none
+ */
+void FaderHaptics_set_EndStops(FaderHaptics_structTd* Haptics, uint16_t Low, uint16_t High, double Stiffness);
+
+/**
+ * @brief     Set the spring.
+ * @param     Haptics   pointer to the haptics structure
+ * @param     Target    position the spring pulls to
+ * @param     Stiffness CCR per count of distance to the target. 0: off.
+ * @return    none
+ */
+void FaderHaptics_set_Spring(FaderHaptics_structTd* Haptics, uint16_t Target, double Stiffness);
+
+/**
+ * @brief     Set the damping.
+ * @param     Haptics   pointer to the haptics structure
+ * @param     Damping   CCR per count/ms of velocity. 0: off.
+ * @return    none
+ */
+void FaderHaptics_set_Damping(FaderHaptics_structTd* Haptics, double Damping);
+
+/**
+ * @brief     Set the time between two calculations. The damping is converted
+ *            again.
+ * @param     Haptics     pointer to the haptics structure
+ * @param     SampleTime  time in microseconds
+ * @return    none
+ */
+void FaderHaptics_set_SampleTimeInUs(FaderHaptics_structTd* Haptics, uint32_t SampleTime);
+
+/**
+ * @brief     Reset the velocity. The next calculation starts at rest.
+ * @param     Haptics   pointer to the haptics structure
+ * @return    none
+ */
+void FaderHaptics_reset(FaderHaptics_structTd* Haptics);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Calculate the force at a position. Call it with the set sample
+ *            time. Only uses integer operations, so it can be called in an
+ *            interrupt.
+ * @param     Haptics   pointer to the haptics structure
+ * @param     Position  current position
+ * @return    force (CCR). - is down, + is up
+ */
+int FaderHaptics_calculate(FaderHaptics_structTd* Haptics, int32_t Position);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Check if the haptics are switched on.
+ * @param     Haptics   pointer to the haptics structure
+ * @return    true if the largest force is bigger than 0
+ */
+bool FaderHaptics_check_Enabled(FaderHaptics_structTd* Haptics);
+
+/**
+ * @brief     Get the force of the last calculation.
+ * @param     Haptics   pointer to the haptics structure
+ * @return    force (CCR)
+ */
+int FaderHaptics_get_Force(FaderHaptics_structTd* Haptics);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderHaptics_Header" */
+/**@}*//* end of defgroup "FaderHaptics" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_FADERHAPTICS_H_ */
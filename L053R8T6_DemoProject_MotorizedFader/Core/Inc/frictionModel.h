@@ -0,0 +1,298 @@
+/***************************************************************************//**
+ * @defgroup        FrictionModel   Friction model
+ * @brief           This module measures the friction of a motorized fader and
+ *                  compensates it with a feed-forward added to the PID output.
+ *
+ * A fader needs a higher CCR to break away from standstill (static friction)
+ * than to keep moving (Coulomb friction). Both are different for up and down
+ * and change along the travel. The model stores both values for each
+ * direction and for @ref FRICTIONMODEL_NUM_ZONES zones of the travel.
+ *
+ * # Calibration sweep
+ * The fader is moved to the bottom, then it walks up step by step:
+ * 1. Rest for @ref FRICTIONMODEL_REST_US.
+ * 2. Increase the CCR from 0 until the fader moved
+ *    @ref FRICTIONMODEL_MOVE_THRESHOLD counts: breakaway CCR.
+ * 3. Decrease the CCR until the fader stops: Coulomb CCR.
+ * 4. Repeat until the top is reached, then walk down the same way.
+ *
+ * All measurements of a zone are averaged. Zones without measurement use the
+ * values of the next measured zone.
+ *
+ * # Feed-forward
+ * The feed-forward is added in the direction of the setpoint velocity (from
+ * the motion profile) or, if the setpoint does not move, in the direction of
+ * the PID output. If the fader stands still, the breakaway CCR is added,
+ * while it moves the Coulomb CCR. If the setpoint does not move and the
+ * fader is within the rest band around it, the motor is switched off. It
+ * starts again, when the error is bigger than twice the rest band. This
+ * hysteresis avoids hunting around the target.
+ *
+ * # How to use:
+ * 1. Declare an object of FrictionModel_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with FrictionModel_init().
+ * 3. Start the calibration with FrictionModel_start_Calibration() and call
+ *    FrictionModel_update_Calibration() with a fixed rate. Use its return
+ *    value as CCR for the motor, until the state is
+ *    @ref FRICTIONMODEL_CALIBRATED.
+ * 4. Call FrictionModel_compensate() with the PID output with a fixed rate.
+ *    Use its return value as CCR for the motor.
+ *
+ * @defgroup        FrictionModel_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FrictionModel
+ * @{
+ *
+ * @addtogroup      FrictionModel_Header
+ * @{
+ *
+ * @file            frictionModel.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_FRICTIONMODEL_H_
+#define INC_FADER_FRICTIONMODEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Number of zones along the travel of the fader.
+ */
+#define FRICTIONMODEL_NUM_ZONES       4
+
+/**
+ * @brief     Range of the wiper values (12 bit ADC).
+ */
+#define FRICTIONMODEL_POSITION_RANGE  4096
+
+/**
+ * @brief     Distance from the ends of the travel, where the sweep stops.
+ */
+#define FRICTIONMODEL_END_MARGIN      200
+
+/**
+ * @brief     Distance the fader has to move to detect the breakaway.
+ */
+#define FRICTIONMODEL_MOVE_THRESHOLD  8
+
+/**
+ * @brief     The fader stands still, if it moves less than this distance
+ *            within @ref FRICTIONMODEL_WINDOW_US.
+ */
+#define FRICTIONMODEL_STOP_THRESHOLD  2
+
+/**
+ * @brief     Time window to detect if the fader moves.
+ */
+#define FRICTIONMODEL_WINDOW_US       10000
+
+/**
+ * @brief     Time to increase the CCR by 1 while searching the breakaway.
+ */
+#define FRICTIONMODEL_RAMP_UP_US      500
+
+/**
+ * @brief     Time to decrease the CCR by 1 while searching the Coulomb
+ *            friction.
+ */
+#define FRICTIONMODEL_RAMP_DOWN_US    2000
+
+/**
+ * @brief     Rest time between two measurements.
+ */
+#define FRICTIONMODEL_REST_US         50000
+
+/**
+ * @brief     Time to move the fader to the bottom before the sweep.
+ */
+#define FRICTIONMODEL_HOME_US         500000
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Directions of the fader
+ */
+typedef enum
+{
+  FRICTIONMODEL_UP,         /**< Positive CCR, increasing wiper value */
+  FRICTIONMODEL_DOWN,       /**< Negative CCR, decreasing wiper value */
+  FRICTIONMODEL_NUM_DIRECTIONS
+}FrictionModel_Direction_enumTd;
+
+/**
+ * @brief     States of the friction model
+ */
+typedef enum
+{
+  FRICTIONMODEL_UNCALIBRATED, /**< No friction values available */
+  FRICTIONMODEL_HOME,         /**< Calibration: move to the bottom */
+  FRICTIONMODEL_REST,         /**< Calibration: wait until the fader stopped */
+  FRICTIONMODEL_BREAKAWAY,    /**< Calibration: search breakaway CCR */
+  FRICTIONMODEL_COULOMB,      /**< Calibration: search Coulomb CCR */
+  FRICTIONMODEL_CALIBRATED,   /**< Friction values are available */
+  FRICTIONMODEL_FAILED        /**< Calibration failed or aborted */
+}FrictionModel_State_enumTd;
+
+/**
+ * @brief     Main structure of the friction model. The user has to declare
+ *            one object for each fader.
+ */
+typedef struct
+{
+  volatile FrictionModel_State_enumTd State; /**< Current state. Set last,
+                                                as the calibration is
+                                                updated in an interrupt. */
+  FrictionModel_Direction_enumTd Direction; /**< Direction of the sweep */
+
+  /** Breakaway CCR for each direction and zone (sum while calibrating) */
+  uint16_t  Breakaway[FRICTIONMODEL_NUM_DIRECTIONS][FRICTIONMODEL_NUM_ZONES];
+  /** Coulomb CCR for each direction and zone (sum while calibrating) */
+  uint16_t  Coulomb[FRICTIONMODEL_NUM_DIRECTIONS][FRICTIONMODEL_NUM_ZONES];
+  /** Number of measurements for each direction and zone */
+  uint8_t   Count[FRICTIONMODEL_NUM_DIRECTIONS][FRICTIONMODEL_NUM_ZONES];
+
+  uint16_t  RestBand;       /**< Error where the motor is switched off */
+  bool      Resting;        /**< true while the motor is switched off */
+  bool      Moving;         /**< true if the fader moved in the last window */
+  int32_t   MaxCCR;         /**< Largest CCR of the motor */
+  uint32_t  SampleTimeUs;   /**< Time between two updates (us) */
+
+  int32_t   CCR;            /**< Calibration: current CCR (without sign) */
+  int32_t   BreakawayCCR;   /**< Calibration: breakaway CCR of the current
+                                 measurement */
+  uint32_t  Ticks;          /**< Calibration: samples in the current state */
+  uint8_t   Zone;           /**< Calibration: zone of the measurement */
+  int32_t   RestPosition;   /**< Calibration: position before breakaway */
+  int32_t   WindowStart;    /**< Position at the start of the window */
+  uint32_t  WindowTick;     /**< Samples in the current window */
+}FrictionModel_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and calibrate the model
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the friction model. The model is uncalibrated
+ *            afterwards.
+ * @param     Model     pointer to the friction model structure
+ * @param     RestBand  error in wiper counts, where the motor is switched off
+ *                      if the setpoint does not move.
+ * @return    none
+ */
+void FrictionModel_init(FrictionModel_structTd* Model, uint16_t RestBand);
+
+/**
+ * @brief     Start the calibration sweep.
+ * @param     Model       pointer to the friction model structure
+ * @param     MaxCCR      largest CCR of the motor
+ * @param     SampleTime  time between two updates in microseconds
+ * @return    none
+ */
+void FrictionModel_start_Calibration(FrictionModel_structTd* Model, int32_t MaxCCR, uint32_t SampleTime);
+
+/**
+ * @brief     Stop a running calibration. The state is set to
+ *            @ref FRICTIONMODEL_FAILED.
+ * @param     Model     pointer to the friction model structure
+ * @return    none
+ */
+void FrictionModel_abort(FrictionModel_structTd* Model);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calibrate and compensate the friction
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the calibration sweep with a new sample. Call this
+ *            function with the sample time while the calibration is running.
+ *            It only uses integer operations and can be used inside an
+ *            interrupt.
+ * @param     Model     pointer to the friction model structure
+ * @param     Sample    current wiper value
+ * @return    CCR for the motor. Positive values move up, negative down.
+ */
+int32_t FrictionModel_update_Calibration(FrictionModel_structTd* Model, int32_t Sample);
+
+/**
+ * @brief     Add the friction feed-forward to the PID output. Call this
+ *            function with the sample time. It only uses integer operations.
+ * @param     Model     pointer to the friction model structure
+ * @param     Output    PID output (CCR, positive is up)
+ * @param     Error     setpoint - sample
+ * @param     SetpointVelocity  velocity of the setpoint (any unit, only the
+ *                      sign is used). 0 if the setpoint does not move.
+ * @param     Sample    current wiper value
+ * @return    CCR for the motor. 0 while the motor rests.
+ */
+int32_t FrictionModel_compensate(FrictionModel_structTd* Model, int32_t Output, int32_t Error, int32_t SetpointVelocity, int32_t Sample);
+
+/**
+ * @brief     Restart the compensation of a fader that rested without calling
+ *            FrictionModel_compensate() (e.g. parked). The fader counts as
+ *            standing still at the sample, so the next start uses the
+ *            breakaway CCR.
+ * @param     Model     pointer to the friction model structure
+ * @param     Sample    current wiper value
+ * @return    none
+ */
+void FrictionModel_restart(FrictionModel_structTd* Model, int32_t Sample);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the model
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the state of the model.
+ * @param     Model     pointer to the friction model structure
+ * @return    state
+ */
+FrictionModel_State_enumTd FrictionModel_get_State(FrictionModel_structTd* Model);
+
+/**
+ * @brief     Check if the motor rests within the rest band.
+ * @param     Model     pointer to the friction model structure
+ * @return    true if the motor is switched off
+ */
+bool FrictionModel_check_Resting(FrictionModel_structTd* Model);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FrictionModel_Header" */
+/**@}*//* end of defgroup "FrictionModel" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_FRICTIONMODEL_H_ */
@@ -0,0 +1,245 @@
+/***************************************************************************//**
+ * @defgroup        MotionProfile   Motion profile
+ * @brief           This module moves a setpoint to a new target with limited
+ *                  velocity and acceleration. It is used between the target of
+ *                  a fader and its PID controller, so a large jump of the
+ *                  target does not saturate the PID.
+ *
+ * The setpoint is updated once per sample (e.g. in the control timer
+ * interrupt) with integer operations only. All positions and velocities are
+ * stored as Q16.16 fixed-point numbers, so very slow moves are possible, too.
+ *
+ * # Available profiles:
+ * - @ref MOTIONPROFILE_STEP "Step": The setpoint jumps to the target (no
+ *   profile).
+ * - @ref MOTIONPROFILE_TRAPEZOID "Trapezoid": The setpoint accelerates with
+ *   the maximum acceleration up to the maximum velocity and brakes with the
+ *   maximum acceleration, so it stops exactly at the target. If the target
+ *   changes while moving, the profile continues with the current velocity.
+ * - @ref MOTIONPROFILE_SCURVE "S-Curve": The trapezoid is smoothed with a
+ *   running average over 2^Shift samples. The acceleration then rises and
+ *   falls linear within 2^Shift samples (limited jerk). The move takes
+ *   2^Shift samples longer, but never overshoots the target.
+ *
+ * # How to use:
+ * 1. Declare an object of MotionProfile_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with MotionProfile_init().
+ * 3. Set the limits with MotionProfile_set_Limits() and the sample time with
+ *    MotionProfile_set_SampleTimeInUs().
+ * 4. Set the target with MotionProfile_set_Target().
+ * 5. Call MotionProfile_update() once per sample. It returns the new setpoint.
+ *
+ * @defgroup        MotionProfile_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      MotionProfile
+ * @{
+ *
+ * @addtogroup      MotionProfile_Header
+ * @{
+ *
+ * @file            motionProfile.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_MOTIONPROFILE_H_
+#define INC_FADER_MOTIONPROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Largest shift for the S-curve smoothing. The S-curve needs
+ *            2^MOTIONPROFILE_SMOOTH_MAX_SHIFT positions of RAM for each
+ *            profile.
+ */
+#define MOTIONPROFILE_SMOOTH_MAX_SHIFT  4
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Available profile types
+ */
+typedef enum
+{
+  MOTIONPROFILE_STEP,       /**< Setpoint jumps to the target */
+  MOTIONPROFILE_TRAPEZOID,  /**< Limited velocity and acceleration */
+  MOTIONPROFILE_SCURVE      /**< Trapezoid smoothed over 2^Shift samples */
+}MotionProfile_Type_enumTd;
+
+/**
+ * @brief     Main structure of a motion profile. Positions and velocities are
+ *            Q16.16 if not noted otherwise.
+ */
+typedef struct
+{
+  MotionProfile_Type_enumTd Type; /**< Used profile type */
+  uint8_t   Shift;                /**< S-curve smoothing over 2^Shift samples */
+  uint8_t   Index;                /**< Index of the oldest smoothing position */
+  bool      Started;              /**< false until the first update */
+
+  uint32_t  MaxVelocity;          /**< Velocity limit as set by the user
+                                       (counts per second) */
+  uint32_t  MaxAcceleration;      /**< Acceleration limit as set by the user
+                                       (counts per second^2) */
+  uint32_t  SampleTimeUs;         /**< Time between two updates (us) */
+
+  int32_t   VelocityLimit;        /**< Velocity limit (counts per sample) */
+  int32_t   Acceleration;         /**< Acceleration (counts per sample^2) */
+
+  int32_t   Target;               /**< Final position (integer) */
+  int32_t   Position;             /**< Position of the trapezoid */
+  int32_t   Velocity;             /**< Velocity of the trapezoid (counts per
+                                       sample) */
+  int32_t   Setpoint;             /**< Current setpoint (integer) */
+
+  int32_t   Positions[1 << MOTIONPROFILE_SMOOTH_MAX_SHIFT]; /**< Last positions
+                                                                 for the
+                                                                 S-curve */
+  int64_t   PositionSum;          /**< Sum of all smoothing positions */
+}MotionProfile_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the motion profile
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the motion profile with type and smoothing.
+ * @param     Profile   pointer to the profile structure
+ * @param     Type      of the profile
+ * @param     Shift     S-curve only: the acceleration rises within 2^Shift
+ *                      samples (limited to
+ *                      @ref MOTIONPROFILE_SMOOTH_MAX_SHIFT)
+ * @return    none
+ */
+void MotionProfile_init(MotionProfile_structTd* Profile, MotionProfile_Type_enumTd Type, uint8_t Shift);
+
+/**
+ * @brief     Set the limits of the profile. The limits are converted to the
+ *            sample time here, so this function is slow and should not be
+ *            called in the update cycle.
+ * @param     Profile         pointer to the profile structure
+ * @param     MaxVelocity     in counts per second (e.g. ADC counts)
+ * @param     MaxAcceleration in counts per second^2
+ * @return    none
+ */
+void MotionProfile_set_Limits(MotionProfile_structTd* Profile, uint32_t MaxVelocity, uint32_t MaxAcceleration);
+
+/**
+ * @brief     Set the time between two calls of MotionProfile_update(). The
+ *            limits are converted again automatically.
+ * @param     Profile     pointer to the profile structure
+ * @param     SampleTime  in microseconds
+ * @return    none
+ */
+void MotionProfile_set_SampleTimeInUs(MotionProfile_structTd* Profile, uint32_t SampleTime);
+
+/**
+ * @brief     Reset the profile. The next update starts the profile at the
+ *            current position of the system with velocity 0.
+ * @param     Profile   pointer to the profile structure
+ * @return    none
+ */
+void MotionProfile_reset(MotionProfile_structTd* Profile);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to move the setpoint
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set a new target. The setpoint moves there with the next updates.
+ * @param     Profile   pointer to the profile structure
+ * @param     Target    new final position
+ * @return    none
+ */
+void MotionProfile_set_Target(MotionProfile_structTd* Profile, int32_t Target);
+
+/**
+ * @brief     Move the setpoint one sample further. Call this function with the
+ *            sample time set with MotionProfile_set_SampleTimeInUs(). It only
+ *            uses integer operations and can be used inside an interrupt.
+ * @param     Profile   pointer to the profile structure
+ * @param     Sample    current position of the system. It is only used as
+ *                      start position after init or reset.
+ * @return    new setpoint
+ */
+int32_t MotionProfile_update(MotionProfile_structTd* Profile, int32_t Sample);
+
+/**
+ * @brief     Set target and setpoint to a position given by someone else
+ *            (e.g. another fader), without limits. Call it instead of
+ *            MotionProfile_update() as long as the setpoint follows. The next
+ *            update afterwards starts the profile at the current position of
+ *            the system.
+ * @param     Profile   pointer to the profile structure
+ * @param     Target    new target and setpoint
+ * @return    none
+ */
+void MotionProfile_follow(MotionProfile_structTd* Profile, int32_t Target);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the profile
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the final position of the profile.
+ * @param     Profile   pointer to the profile structure
+ * @return    target
+ */
+int32_t MotionProfile_get_Target(MotionProfile_structTd* Profile);
+
+/**
+ * @brief     Get the setpoint of the last update.
+ * @param     Profile   pointer to the profile structure
+ * @return    setpoint
+ */
+int32_t MotionProfile_get_Setpoint(MotionProfile_structTd* Profile);
+
+/**
+ * @brief     Get the velocity of the trapezoid of the last update. It is 0,
+ *            if the profile does not move or the type is
+ *            @ref MOTIONPROFILE_STEP.
+ * @param     Profile   pointer to the profile structure
+ * @return    velocity in counts per sample (Q16.16)
+ */
+int32_t MotionProfile_get_Velocity(MotionProfile_structTd* Profile);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "MotionProfile_Header" */
+/**@}*//* end of defgroup "MotionProfile" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_MOTIONPROFILE_H_ */
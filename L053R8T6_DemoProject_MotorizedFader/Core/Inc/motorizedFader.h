@@ -11,9 +11,11 @@
  *      - MotorizedFader_init_StopRange()
  *    - Wiper:
  *      - MotorizedFader_init_Wiper()
+ *      - MotorizedFader_init_WiperFilter() (optional)
  *    - Touch Sense:
  *      - MotorizedFader_init_TouchTSC()
- *      - MotorizedFader_init_TouchThreshold()
+ *      - MotorizedFader_init_TouchThreshold() or
+ *        MotorizedFader_init_TouchAdaptive()
  *      - MotorizedFader_init_TouchDischargeTimeMsAll() (initialize this once
  *        for all faders)
  *    - Motor:
@@ -21,23 +23,240 @@
  *      - MotorizedFader_init_MotorPinIn2()
  *      - MotorizedFader_init_MotorPinSTBY()
  *      - MotorizedFader_init_MotorPWM()
+ *      - MotorizedFader_init_PWMCarrier() (optional, once for each timer)
+ *      - MotorizedFader_init_MotorDither() (optional)
+ *      - MotorizedFader_init_ADCTrigger() (optional, once for all faders)
  *    - PID:
  *      - MotorizedFader_init_PID();
  *      - MotorizedFader_init_PIDMaxCCR()
  *      - MotorizedFader_init_PIDKpKiKd()
  *      - MotorizedFader_init_PIDLowPass()
  *      - MotorizedFader_init_PIDSampleTimeInMs()
+ *      - MotorizedFader_init_PIDGainSchedule() (optional)
+ *      - MotorizedFader_init_PIDGainScaleDown() (optional)
+ *      - MotorizedFader_init_PIDBackCalculation() (optional, needs the
+ *        control timer)
+ *    - Control Timer (optional):
+ *      - MotorizedFader_init_ControlTimer()
+ *      - MotorizedFader_init_ControlStagger() (optional, many faders)
+ *    - Motion Profile (optional, needs the control timer):
+ *      - MotorizedFader_init_MotionProfile()
+ *      - MotorizedFader_init_MotionLimits()
+ *    - Cascade Controller (optional, needs the control timer):
+ *      - MotorizedFader_init_Cascade()
+ *      - MotorizedFader_init_CascadeEstimator()
+ *    - Auto Tuning (optional, needs the control timer):
+ *      - MotorizedFader_init_Autotune()
+ *    - Friction Compensation (optional, needs the control timer):
+ *      - MotorizedFader_init_Friction()
+ *    - Events (optional):
+ *      - MotorizedFader_init_Events()
+ *    - Settle detection (optional):
+ *      - MotorizedFader_init_Settle()
+ *    - Haptics (optional, needs the control timer):
+ *      - MotorizedFader_init_Haptics()
+ *      - MotorizedFader_init_HapticDetents()
+ *      - MotorizedFader_init_HapticEndStops()
+ *    - Stall detection (optional, needs the control timer):
+ *      - MotorizedFader_init_Stall()
+ *      - MotorizedFader_init_StallBackoff()
  * 3. Setup Interrupt functions:
  *    - MotorizedFader_manage_WiperInterrupt()
+ *    - MotorizedFader_manage_WiperHalfInterrupt() (only with circular DMA)
  *    - MotorizedFader_manage_TSCInterrupt()
+ *    - MotorizedFader_manage_ControlTimerInterrupt() (only with control timer)
  * 4. Start all faders:
  *    - MotorizedFader_start_All()
- * 5. In while Loop: update all faders
+ * 5. In while Loop: update the timer service and all faders
+ *    - TimerService_update() (see @ref TimerService)
  *    - MotorizedFader_update_All()
  * 6. Use these functions to access a fader in the running program:
  *    - MotorizedFader_get_WiperValue()
  *    - MotorizedFader_get_TSCState()
  *    - MotorizedFader_set_Target()
+ *    - MotorizedFader_start_Autotune()
+ *    - MotorizedFader_get_AutotuneState()
+ *    - MotorizedFader_get_AutotuneResult()
+ *    - MotorizedFader_start_FrictionCalibration()
+ *    - MotorizedFader_get_FrictionState()
+ *    - MotorizedFader_start_WiperCalibration()
+ *    - MotorizedFader_get_WiperCalibrationState()
+ *    - MotorizedFader_get_Event()
+ *    - MotorizedFader_set_Gang()
+ *    - MotorizedFader_set_HapticSpring()
+ *
+ * # Control modes
+ * - Without control timer: The wipers and PIDs are updated in
+ *   MotorizedFader_update_All(). The PID sample time is a periodic
+ *   timer of the timer service, so it has the resolution of one tick
+ *   (@ref TIMERSERVICE_TICK_US) and jitters with the load of the while loop.
+ * - With control timer: The wipers, PIDs and PWMs are updated in the period
+ *   elapsed interrupt of a dedicated timer. The sample time is constant and
+ *   can be much shorter (e.g. 2-5 kHz). MotorizedFader_update_All() only
+ *   updates the touch sense controller in this mode. Use
+ *   MotorizedFader_get_ControlOverruns() and
+ *   MotorizedFader_get_ControlLoadMax() to check if the interrupt is fast
+ *   enough for the chosen rate.
+ *
+ * # Many faders
+ * All wipers are converted by one ADC scan and the touch lines of different
+ * TSC groups are acquired in parallel, so the number of faders mostly adds
+ * CPU time in the control timer interrupt. With
+ * MotorizedFader_init_ControlStagger() the faders are split into groups that
+ * are updated in turns, one group per control period. This divides the
+ * longest interrupt by the number of groups and keeps the load of all
+ * periods the same, while wipers, gangs and events still run in each period.
+ * MotorizedFader_get_ControlCapacity() estimates how many faders fit at the
+ * current clock and control rate from the longest measured interrupt.
+ *
+ * # Motion profile
+ * Without motion profile, a new target is a step for the PID. A large step
+ * saturates the PID at the maximum CCR, the fader overshoots and the I-Term
+ * has to correct it. With a @ref MotionProfile "motion profile", the PID
+ * setpoint moves to the target with limited velocity and acceleration. It is
+ * updated in every period of the control timer. Without control timer the
+ * target is always a step.
+ *
+ * # Cascade controller
+ * Instead of the PID, a fader can be controlled by a
+ * @ref CascadeController "cascade" of a position and a velocity loop (see
+ * MotorizedFader_init_Cascade()). Position and velocity are estimated from
+ * the raw wiper samples, so there is no lag of the wiper filter and no
+ * noisy D-Term. The velocity of the motion profile is fed forward, so fast
+ * moves follow the setpoint closer. The cascade runs with the control timer
+ * only. Without control timer and during the auto tuning, the PID is used.
+ * Friction feed-forward, start force and stop range are applied to the
+ * output of both controllers.
+ *
+ * # Gain scheduling
+ * With one set of PID coefficients, large moves saturate the output and
+ * small corrections crawl, as the P-Term of a small error stays in the stop
+ * range. MotorizedFader_init_PIDGainSchedule() sets a second set of
+ * coefficients for large errors, in between they are interpolated. The down
+ * direction can get its own factor with MotorizedFader_init_PIDGainScaleDown().
+ * With the control timer, MotorizedFader_init_PIDBackCalculation() feeds the
+ * CCR that was really applied after MaxCCR, start force and stop range back
+ * to the I-Term, so it does not wind up while the output has no effect.
+ * The auto tuning only sets the coefficients for small errors.
+ *
+ * # Auto tuning
+ * Each fader can find its own PID coefficients with
+ * MotorizedFader_start_Autotune(). The motor is driven by a
+ * @ref PIDAutotune "relay" around a center position until the fader
+ * oscillates. Kp, Ki and Kd are calculated from period and amplitude of the
+ * oscillation and set to the PID of this fader. Afterwards the fader moves
+ * to a step target with the new coefficients and rise time, overshoot and
+ * settle time are measured. The coefficients are calculated in
+ * MotorizedFader_update_All(), as they need double operations. Touching the
+ * fader aborts the auto tuning. The coefficients are not stored permanently,
+ * so read them with MotorizedFader_get_AutotuneResult() and use them with
+ * MotorizedFader_init_PIDKpKiKd() in the next start.
+ *
+ * # Friction compensation
+ * Start force and stop range are one fixed dead band for the whole fader.
+ * The real friction is different for up and down, along the travel and
+ * between standstill and motion. MotorizedFader_start_FrictionCalibration()
+ * measures it with a slow @ref FrictionModel "sweep" over the travel. When
+ * the calibration is done, the measured friction is added to the PID output
+ * as feed-forward and start force and stop range are not used anymore.
+ * Close to a resting target, the motor is switched off within the rest band
+ * (see MotorizedFader_init_Friction()). The calibration takes a few seconds
+ * and is not stored permanently, so start it after each power up. Touching
+ * the fader aborts it and the fader falls back to start force and stop
+ * range.
+ *
+ * # Wiper linearization
+ * The wiper value of a fader track is not linear to the travel.
+ * MotorizedFader_start_WiperCalibration() moves the fader with a constant
+ * CCR from end to end and builds a @ref WiperLinear "lookup table" from the
+ * time the wiper needs for each segment. This assumes a constant speed. Run
+ * the friction calibration first: its feed-forward is then added to the
+ * sweep CCR, so the friction zones change the speed less. Afterwards
+ * MotorizedFader_get_WiperValue() returns the linear position and
+ * MotorizedFader_set_Target() converts the linear target back to the wiper
+ * value. The PID still controls the wiper value. Run only one calibration
+ * of a fader at a time and set the targets again when it is done. The
+ * linearization is optional and not verified on hardware yet, the demo does
+ * not start it.
+ *
+ * # Events
+ * Instead of polling MotorizedFader_get_WiperValue() and
+ * MotorizedFader_get_TSCState() of each fader, read the changes with
+ * MotorizedFader_get_Event(). Touch, release and position changes by the
+ * resolution (see MotorizedFader_init_Events()) are written into one
+ * @ref FaderEvents "ring buffer" for all faders. They are detected in each
+ * control period (or in MotorizedFader_update_All() without control timer)
+ * and carry the time of detection from TimerService_get_TimeUs() (share the
+ * control timer as time base for microsecond resolution), the position
+ * (linear, if calibrated) and a filtered velocity. Reading an event measures
+ * its latency, MotorizedFader_get_EventLatencyMaxUs() returns the largest
+ * one.
+ *
+ * # Settle detection
+ * Without settle detection, the PID of a fader at its target runs in every
+ * sample and the motor driver stays enabled. With
+ * MotorizedFader_init_Settle() a @ref SettleDetector "settle detector"
+ * checks if the fader rests within a window around the target. Then the PID
+ * is skipped and the motor driver is parked in coast or standby until the
+ * target changes or the fader is pushed out of twice the window. The STBY
+ * pin is shared by the two motors of a TB6612FNG: it is only pulled low, if
+ * all faders on this pin are settled. This saves CPU time and motor current
+ * and avoids a humming motor at rest.
+ *
+ * # Gangs
+ * Faders can be linked to a gang with MotorizedFader_set_Gang(). The touched
+ * member of a gang (the leader) drives the setpoints of the other members in
+ * the control period, so they follow with one period of lag and without
+ * polling in the while loop. The followers skip their motion profile while
+ * they follow. When the leader is released, it stays where it was released
+ * and the followers move to their last targets with their profiles.
+ * - @ref MOTORIZEDFADER_GANG_MASTER_SLAVE: only the first fader of the gang
+ *   (the master) leads. The slaves take its position. A touched slave does
+ *   not move the others and returns to the master position when released.
+ * - @ref MOTORIZEDFADER_GANG_RELATIVE: any touched member leads. The others
+ *   keep the distance to the leader they had at the time of the touch.
+ * - @ref MOTORIZEDFADER_GANG_ABSOLUTE: any touched member leads. The others
+ *   take its position.
+ * Gangs can be changed at any time. A fader is member of only one gang.
+ * Without control timer, the gangs are updated in
+ * MotorizedFader_update_All().
+ *
+ * # Haptics
+ * Without haptics, the motor is switched off while the fader is touched.
+ * With MotorizedFader_init_Haptics(), the motor renders a
+ * @ref FaderHaptics "force field" instead: detent wells from a table of
+ * each fader (e.g. 0 dB or pan center), soft end stops and a spring to a
+ * target (MotorizedFader_set_HapticSpring()). The force is calculated from
+ * the wiper value in the control timer interrupt, so the detents feel crisp.
+ * Positions are in the same units as MotorizedFader_set_Target(). Start
+ * with forces a bit above the start force and some damping.
+ *
+ * # Stall detection
+ * A blocked fader, or a fader held without the TSC noticing it, keeps the
+ * controller at full duty. This wastes power, heats the driver and wears
+ * the belt. With MotorizedFader_init_Stall(), a
+ * @ref StallDetector "stall detector" watches the CCR and the wiper in each
+ * control period. If the CCR stays high while the wiper does not move, the
+ * power is backed off (motor stopped by default), the controller is reset
+ * and the fader retries after the back off time. After the last retry it
+ * stays backed off until it gets a new target or is touched. Each stall is
+ * written as @ref FADEREVENTS_STALL event, if the events of the fader are
+ * enabled. MotorizedFader_get_StallState() returns the current state.
+ *
+ * # PWM resolution and dither
+ * MotorizedFader_init_PWMCarrier() sets carrier and resolution of a PWM
+ * timer together (see @ref PWM_Carrier_Resolution "Carrier and Resolution").
+ * A lower carrier gives more CCR steps, the ultrasonic option keeps it above
+ * the audible range. All CCR settings (PID max CCR, start force, stop range,
+ * ADC trigger delay, friction, haptics and stall CCRs) are in steps of this
+ * resolution, so scale them when the resolution changes.
+ * With MotorizedFader_init_MotorDither(), the PID output keeps fractional
+ * bits below one CCR step and the motor driver dithers them, so the mean
+ * force near the stop range is finer than one step. The dither works with
+ * the PID result only, start force and the other controllers move with
+ * whole steps. It steps with the control rate, not with the carrier, so its
+ * tone is in the audible range; the bits are limited for this reason (see
+ * @ref PWM_Carrier_Resolution "Carrier and Resolution").
  *
  * # Hardware (as used for testing)
  * -  Code was tested with an 100mm linear 10k ALPS motorized fader
@@ -58,10 +277,19 @@
  *    problem gets bigger and the faders need different regulation (if
  *    regulation is still possible. Very old faders have to be replaced)
  * -  If you hear high frequency noise, check your PWM frequency in
- *    Cube MX (PWM-Freuqency = (TIM-CLK / AutoReloadRegister)).
+ *    Cube MX (PWM-Freuqency = (TIM-CLK / AutoReloadRegister)) or use
+ *    MotorizedFader_init_PWMCarrier() with the ultrasonic option.
  * -  Take your time to find the right threshold for each Touch line. If the
  *    threshold is not accurate, it my get tricky to get the faders stable
- *    because the motor stops always when the fader is touched.
+ *    because the motor stops always when the fader is touched. The adaptive
+ *    detection (MotorizedFader_init_TouchAdaptive()) follows slow changes
+ *    of the released value and reacts faster than the fixed threshold.
+ * -  The control timer counts microseconds, so it can be shared as time base
+ *    of the timer service (see @ref TimerService). The sample timer of the
+ *    PID in loop mode and the discharge wait of the TSC run on service
+ *    timers, so TimerService_update() has to run in the while loop in any
+ *    case. The timer is started by MotorizedFader_start_All(), not by the
+ *    service.
  *
  * # Links
  * - @ref TB6612FNG_Datasheet "TB6612FNG Motor Driver data sheet"
@@ -96,7 +324,18 @@
 #include "tscButton.h"
 #include "TB6612FNG_MotorDriver.h"
 #include "wiper.h"
-#include "pidController.h"
+#include "pidControllerFixed.h"
+#include "motionProfile.h"
+#include "pidAutotune.h"
+#include "frictionModel.h"
+#include "wiperLinear.h"
+#include "faderEvents.h"
+#include "settleDetector.h"
+#include "cascadeController.h"
+#include "faderHaptics.h"
+#include "stallDetector.h"
+#include "profiler.h"
+#include "timerService.h"
 
 /**
  * @brief     This number can be changed according to the users requirements.
@@ -104,11 +343,50 @@
  */
 #define NUMBER_OF_MOTORIZED_FADERS 8
 
+/**
+ * @brief     Number of gangs that can be used at the same time.
+ */
+#define NUMBER_OF_FADER_GANGS 4
+
 /***************************************************************************//**
  * @name      Structures and Enumerations
  * @{
  ******************************************************************************/
 
+/**
+ * @brief     How the motor driver is parked while the fader is settled
+ */
+typedef enum
+{
+  MOTORIZEDFADER_PARK_COAST,    /**< IN1 and IN2 low (stop mode) */
+  MOTORIZEDFADER_PARK_STANDBY   /**< STBY low, if all faders on the same STBY
+                                     pin are settled. Coast otherwise. */
+}MotorizedFader_Park_enumTd;
+
+/**
+ * @brief     Controller of a fader
+ */
+typedef enum
+{
+  MOTORIZEDFADER_CONTROLLER_PID,      /**< PID on the smoothed wiper value */
+  MOTORIZEDFADER_CONTROLLER_CASCADE   /**< Position and velocity loop with
+                                           estimator (control timer only) */
+}MotorizedFader_Controller_enumTd;
+
+/**
+ * @brief     Modes of a gang
+ */
+typedef enum
+{
+  MOTORIZEDFADER_GANG_OFF,          /**< No gang */
+  MOTORIZEDFADER_GANG_MASTER_SLAVE, /**< The first fader leads, the others
+                                         take its position */
+  MOTORIZEDFADER_GANG_RELATIVE,     /**< Any touched fader leads, the others
+                                         keep their distance to it */
+  MOTORIZEDFADER_GANG_ABSOLUTE      /**< Any touched fader leads, the others
+                                         take its position */
+}MotorizedFader_Gang_enumTd;
+
 /**
  * @brief     Main structure to store all data for the fader. The user has to
  *            declare one object of this data type for each fader.
@@ -117,10 +395,26 @@ typedef struct
 {
   Wiper_structTd  Wiper;
   TB6612FNGMotorDriver_structTd Motor;
-  PID_structTd PID;
+  PIDFixed_structTd PID;
+  CascadeController_structTd Cascade;
+  MotorizedFader_Controller_enumTd Controller;
+  MotionProfile_structTd Profile;
+  PIDAutotune_structTd Autotune;
+  FrictionModel_structTd Friction;
+  WiperLinear_structTd Linear;
+  FaderEvents_Tracker_structTd Events;
+  SettleDetector_structTd Settle;
+  FaderHaptics_structTd Haptics;
+  StallDetector_structTd Stall;
+  MotorizedFader_Park_enumTd Park;
+  bool Following;           /**< true while the setpoint is set by the leader
+                                 of a gang */
   TSCButton_structTd TouchSense;
   int CCRStartForce;
   int CCRStopRange;
+  uint16_t CCRMax;
+  int16_t CCRFraction;      /**< Fractional part of the PID result in dither
+                                 bits. Used by the next move. */
 }MotorizedFader_structTd;
 
 /** @} ************************************************************************/
@@ -135,7 +429,9 @@ typedef struct
  ******************************************************************************/
 
 /**
- * @brief     Link the Fader to the internal structure for internal use.
+ * @brief     Link the Fader to the internal structure for internal use. The
+ *            motion profile is initialized as step (no profile) and the auto
+ *            tuning as idle.
  * @param     Fader   pointer to the users fader structure
  * @return    none
  */
@@ -146,7 +442,8 @@ void MotorizedFader_init_Structure(MotorizedFader_structTd* Fader);
  *            To find the CCR value needed to move the motor, you can use
  *            MotorDriver_move_ClockWise() with the &Fader->Motor and increase
  *            the CCR until the fader starts moving up. Sometimes trial and
- *            error will also lead to a working value.
+ *            error will also lead to a working value. It is not used
+ *            while the friction compensation is calibrated.
  * @param     Fader   pointer to the users fader structure
  * @param     CCR     value where the fader starts to move
  * @return    none
@@ -159,7 +456,8 @@ void MotorizedFader_init_StartForce(MotorizedFader_structTd* Fader, int CCR);
  *            is caused because the fader will always move at least with the
  *            start force. As the ADC value will never be completely stable and
  *            reached on point, the fader would always try to correct. This
- *            stop range is a simple approach to resolve this problem.
+ *            stop range is a simple approach to resolve this problem. It
+ *            is not used while the friction compensation is calibrated.
  * @param     Fader   pointer to the users fader structure
  * @param     CCR     value where the fader does not move. The range will be
  *                    from -CCR to +CCr.
@@ -195,6 +493,17 @@ void MotorizedFader_init_StopRange(MotorizedFader_structTd* Fader, int CCR);
  */
 void MotorizedFader_init_Wiper(MotorizedFader_structTd* Fader, ADC_HandleTypeDef* Handle);
 
+/**
+ * @brief     Select the filter used to smooth the wiper values.
+ *            For details please look at the documentation of
+ *            Wiper_init_Filter().
+ * @param     Fader     pointer to the users fader structure
+ * @param     Type      of the filter
+ * @param     Shift     depth of the filter
+ * @return    none
+ */
+void MotorizedFader_init_WiperFilter(MotorizedFader_structTd* Fader, WiperFilter_Type_enumTd Type, uint8_t Shift);
+
 /** @} ************************************************************************/
 /* end of name "Initialize Wiper"
  ******************************************************************************/
@@ -235,6 +544,19 @@ void MotorizedFader_init_TouchTSC(MotorizedFader_structTd* Fader, TSC_HandleType
  */
 void MotorizedFader_init_TouchThreshold(MotorizedFader_structTd* Fader, uint16_t Threshold);
 
+/**
+ * @brief     Use the adaptive baseline instead of the fixed threshold.
+ *            For details please look at the documentation of
+ *            TSCButton_init_Adaptive().
+ * @param     Fader         pointer to the users fader structure
+ * @param     TouchDelta    drop below the baseline to detect a touch
+ * @param     ReleaseDelta  drop below the baseline to detect a release
+ * @param     ConfirmCount  number of acquisitions in a row to change the
+ *                          state
+ * @return    none
+ */
+void MotorizedFader_init_TouchAdaptive(MotorizedFader_structTd* Fader, uint16_t TouchDelta, uint16_t ReleaseDelta, uint8_t ConfirmCount);
+
 /**
  * @brief     Initialize the discharge time for the sample capacitor of the
  *            TSC group. This value is used fop all TSC sample capacitors and
@@ -307,6 +629,70 @@ void MotorizedFader_init_MotorPinSTBY(MotorizedFader_structTd* Fader, GPIO_TypeD
  */
 void MotorizedFader_init_MotorPWM(MotorizedFader_structTd* Fader, TIM_HandleTypeDef* htim, uint16_t Channel);
 
+/**
+ * @brief     Set carrier frequency and resolution of a PWM timer. Call it once
+ *            for each timer used for PWM, before MotorizedFader_start().
+ *            See MotorDriver_init_PWMCarrier() for details.
+ * @note      All CCR settings are in steps of the returned resolution.
+ * @param     htim          pointer to the HAL-handle for the timer used for PWM
+ * @param     TimerClockHz  clock of the timer in Hz (usually HCLK)
+ * @param     CarrierHz     wanted carrier frequency in Hz
+ * @param     Ultrasonic    true raises the carrier to at least
+ *                          @ref MOTORDRIVER_ULTRASONIC_HZ
+ * @return    resolution in CCR steps. The CCR for full duty.
+ */
+uint32_t MotorizedFader_init_PWMCarrier(TIM_HandleTypeDef* htim, uint32_t TimerClockHz, uint32_t CarrierHz, bool Ultrasonic);
+
+/**
+ * @brief     Dither the fractional part of the PID result below one CCR step.
+ *            The motor driver writes the two nearest CCRs with a sigma-delta
+ *            modulator, so the mean duty cycle gets the finer resolution.
+ * @param     Fader     pointer to the users fader structure
+ * @param     Bits      fractional bits (0 - @ref MOTORDRIVER_DITHER_BITS_MAX).
+ *                      0 switches the dither off (default).
+ * @return    none
+ */
+void MotorizedFader_init_MotorDither(MotorizedFader_structTd* Fader, uint8_t Bits);
+
+/**
+ * @brief     Use a free channel of the PWM timer to trigger the wiper ADC
+ *            between the motor switching edges. The edges are then never
+ *            inside a sample, so less filtering is needed.
+ *
+ * All PWM channels switch on at counter = 0 and switch off at counter = CCR.
+ * These edges split the PWM period into quiet windows. After each control
+ * update the trigger is moved into the widest window of the running motors
+ * of the timer and the next conversion is centered in it. In multi trigger
+ * oversampling each trigger starts one conversion, so the window has to hold
+ * one conversion: sampling time + 12.5 ADC cycles, converted to timer ticks
+ * with the current timer clock (e.g. 3.5 + 12.5 cycles at 8 MHz = 2 us = 64
+ * ticks at 32 MHz). This holds for any CCR (start force, friction feed
+ * forward, haptics, dither, stall back off): with n motor channels on the
+ * timer there are at most n + 1 edges, so the widest window is at least
+ * (ARR + 1) / (n + 1) ticks long. If it is shorter than one conversion, the
+ * conversion overlaps an edge. At CCR = 0 and at full CCR there are no edges
+ * at all.
+ *
+ * # How to setup the timer and ADC (as tested):
+ * - PWM timer: configure the trigger channel as "PWM Generation CHx No
+ *   Output" with PWM mode 2 (rising edge of OCxREF at the compare value).
+ *   Keep the output compare preload of all channels enabled (Cube default),
+ *   so trigger and motor CCRs change at the same update event.
+ * - ADC: External Trigger Conversion Source = Timer x Capture Compare x event,
+ *   Edge = Rising, Continuous Conversion Mode = Disabled, oversampling with
+ *   multi trigger mode. See Wiper_init_ADC().
+ *
+ * @param     htim        pointer to the HAL-handle of the PWM timer
+ * @param     Channel     free channel of the timer used as trigger (e.g.
+ *                        TIM_CHANNEL_4 for "Timer 2 Capture Compare 4 event")
+ * @param     ADCClockHz  clock of the ADC (e.g. 8000000 for HSI16 / 2, see
+ *                        ClockProfile_add_ADC())
+ * @param     SamplingTime sampling time of the ADC (ADC_SAMPLETIME_xCYCLES_x,
+ *                        e.g. hadc.Init.SamplingTime)
+ * @return    none
+ */
+void MotorizedFader_init_ADCTrigger(TIM_HandleTypeDef* htim, uint32_t Channel, uint32_t ADCClockHz, uint32_t SamplingTime);
+
 /** @} ************************************************************************/
 /* end of name "Initialize Motor"
  ******************************************************************************/
@@ -346,13 +732,16 @@ void MotorizedFader_init_MotorPWM(MotorizedFader_structTd* Fader, TIM_HandleType
  *              anywhere in the dimension of Kp = 0.x | Ki = 0.000x and
  *              Kd = 0.0x.
  *            - More calibration tips in the @ref PID_Controller "PID module".
+ *            - The fader uses the @ref PIDFixed_Controller "fixed-point PID",
+ *              because the MCU has no FPU. The coefficients are the same as for
+ *              the double version.
  * @{
  ******************************************************************************/
 
 /**
  * @brief     Initialize the PID structure used by the fader.
  *            For details please look at the documentation of
- *            PID_init().
+ *            PIDFixed_init().
  * @param     Fader     pointer to the users fader structure
  * @return    none
  */
@@ -361,7 +750,7 @@ void MotorizedFader_init_PID(MotorizedFader_structTd* Fader);
 /**
  * @brief     Initialize PID Output range
  *            For details please look at the documentation of
- *            PID_set_OutputMinMax().
+ *            PIDFixed_set_OutputMinMax().
  * @param     Fader     pointer to the users fader structure
  * @paramm    MaxCCR    largest possible CCR value for PWM
  * @return    none
@@ -371,7 +760,7 @@ void MotorizedFader_init_PIDMaxCCR(MotorizedFader_structTd* Fader, uint16_t MaxC
 /**
  * @brief     Initialize PID coefficients for tuning the PIT-Terms.
  *            For details please look at the documentation of
- *            PID_set_KpKiKd().
+ *            PIDFixed_set_KpKiKd().
  * @param     Fader     pointer to the users fader structure
  * @param     Kp      coefficient for the proportional term
  * @param     Ki      coefficient for the integral term
@@ -383,7 +772,7 @@ void MotorizedFader_init_PIDKpKiKd(MotorizedFader_structTd* Fader, double Kp, do
 /**
  * @brief     Initialize the low pass for the PID D-Term.
  *            For details please look at the documentation of
- *            PID_set_LowPass().
+ *            PIDFixed_set_LowPass().
  * @param     Fader     pointer to the users fader structure
  * @param     Tau       time constant of the low pass filter
  * @return    none
@@ -393,18 +782,378 @@ void MotorizedFader_init_PIDLowPass(MotorizedFader_structTd* Fader, double Tau);
 /**
  * @brief     Initialize the sample to control the PID update frequency.
  *            For details please look at the documentation of
- *            PID_set_SampleTimeInMs().
+ *            PIDFixed_set_SampleTimeInMs().
  * @param     Fader     pointer to the users fader structure
  * @param     Threshold of the sample time in milliseconds
  * @return    none
  */
 void MotorizedFader_init_PIDSampleTimeInMs(MotorizedFader_structTd* Fader, uint32_t SampleTime);
 
+/**
+ * @brief     Initialize the PID coefficients for large errors.
+ *            For details please look at the documentation of
+ *            PIDFixed_set_GainSchedule().
+ * @param     Fader       pointer to the users fader structure
+ * @param     Kp          coefficient for the proportional term
+ * @param     Ki          coefficient for the integral term
+ * @param     Kd          coefficient for the derivative term
+ * @param     ErrorSmall  largest error with the coefficients of
+ *                        MotorizedFader_init_PIDKpKiKd()
+ * @param     ErrorLarge  smallest error with these coefficients. 0: off.
+ * @return    none
+ */
+void MotorizedFader_init_PIDGainSchedule(MotorizedFader_structTd* Fader, double Kp, double Ki, double Kd, uint16_t ErrorSmall, uint16_t ErrorLarge);
+
+/**
+ * @brief     Initialize the factor of the PID coefficients for the down
+ *            direction. For details please look at the documentation of
+ *            PIDFixed_set_GainScaleDown().
+ * @param     Fader     pointer to the users fader structure
+ * @param     Scale     factor. 1.0: same as up.
+ * @return    none
+ */
+void MotorizedFader_init_PIDGainScaleDown(MotorizedFader_structTd* Fader, double Scale);
+
+/**
+ * @brief     Initialize the back-calculation anti wind-up. With the control
+ *            timer, the CCR applied after MaxCCR, start force and stop range
+ *            is fed back to the PID. For details please look at the
+ *            documentation of PIDFixed_set_BackCalculation().
+ * @param     Fader     pointer to the users fader structure
+ * @param     Kb        back-calculation coefficient (1 / ms). 0: off.
+ * @return    none
+ */
+void MotorizedFader_init_PIDBackCalculation(MotorizedFader_structTd* Fader, double Kb);
+
 /** @} ************************************************************************/
 /* end of name "Initialize PID"
  ******************************************************************************/
 
 
+/***************************************************************************//**
+ * @name      Initialize Control Timer
+ * @brief     Use this function to run the control loop of all faders in a
+ *            timer interrupt with a fixed rate.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Link a HAL timer handle that triggers the control loop of all
+ *            faders. The rate is set in Cube MX with prescaler and counter
+ *            period of the timer. The PID sample time of all faders is derived
+ *            from this setting in MotorizedFader_start_All(), so
+ *            MotorizedFader_init_PIDSampleTimeInMs() has no effect in this
+ *            mode.
+ *
+ * # How to setup the timer (as tested):
+ *
+ * - HCLK: 32MHz
+ *
+ * - Use a basic timer, e.g. TIM6
+ *
+ * - Parameter Settings
+ *  - Prescaler:          32-1 (1 MHz timer clock, 1 tick = 1 us)
+ *  - Counter Period:     333-1 (3 kHz control rate)
+ *  - auto-reload preload: Enable
+ *
+ * - NVIC Settings
+ *  - TIM6 global interrupt: enable. Use a lower priority than the ADC DMA
+ *    and the TSC interrupts.
+ *
+ * @note      The duration of the interrupt is measured in timer ticks. The
+ *            counter is not stopped during the interrupt, so the counter value
+ *            at the end of the interrupt is the time since the period elapsed.
+ *
+ * @param     htim      pointer to the HAL generated timer handle
+ * @return    none
+ */
+void MotorizedFader_init_ControlTimer(TIM_HandleTypeDef* htim);
+
+/**
+ * @brief     Update the faders in turns instead of all in each control
+ *            period. The faders are split into Groups groups by their index
+ *            (index modulo Groups), one group is updated in each period. PID,
+ *            motion profile, calibrations and settle detection of a fader run
+ *            with Groups times the control period as sample time, so choose
+ *            a Groups times faster control timer to keep the fader rate.
+ *            Wipers, gangs and events are still updated in every period.
+ *            Call it before MotorizedFader_start_All().
+ * @param     Groups    number of groups (1: all faders in each period)
+ * @return    none
+ */
+void MotorizedFader_init_ControlStagger(uint8_t Groups);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Control Timer"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Motion Profile
+ * @brief     Use these functions to move the PID setpoint to a new target with
+ *            limited velocity and acceleration. The profile is updated with
+ *            the control timer, so MotorizedFader_init_ControlTimer() is
+ *            required.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Select the motion profile of the fader.
+ *            For details please look at the documentation of
+ *            MotionProfile_init().
+ * @param     Fader     pointer to the users fader structure
+ * @param     Type      of the profile
+ * @param     Shift     S-curve only: the acceleration rises within 2^Shift
+ *                      control periods
+ * @return    none
+ */
+void MotorizedFader_init_MotionProfile(MotorizedFader_structTd* Fader, MotionProfile_Type_enumTd Type, uint8_t Shift);
+
+/**
+ * @brief     Initialize the limits of the motion profile.
+ *            For details please look at the documentation of
+ *            MotionProfile_set_Limits().
+ *
+ * A 12 bit wiper of a 100mm fader has about 41 counts per mm. Start with
+ * limits below the speed the fader reaches with full CCR, otherwise the PID
+ * still saturates while following the profile.
+ *
+ * @param     Fader           pointer to the users fader structure
+ * @param     MaxVelocity     in wiper counts per second
+ * @param     MaxAcceleration in wiper counts per second^2
+ * @return    none
+ */
+void MotorizedFader_init_MotionLimits(MotorizedFader_structTd* Fader, uint32_t MaxVelocity, uint32_t MaxAcceleration);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Motion Profile"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Cascade Controller
+ * @brief     Use these functions to control the fader with position and
+ *            velocity loop instead of the PID. The cascade is updated with
+ *            the control timer, so MotorizedFader_init_ControlTimer() is
+ *            required. The output limit is set with
+ *            MotorizedFader_init_PIDMaxCCR().
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Select the cascade controller for the fader and set its gains.
+ *            For details please look at the documentation of
+ *            CascadeController_set_Gains().
+ *
+ * Start with the velocity loop: increase VelocityKp until the fader follows
+ * a slow motion profile without jitter, then add VelocityKi to remove the
+ * remaining error. PositionGain sets how fast a position error is reduced.
+ *
+ * @param     Fader         pointer to the users fader structure
+ * @param     PositionGain  velocity in counts/ms per count of position error
+ * @param     VelocityKp    CCR per count/ms of velocity error
+ * @param     VelocityKi    CCR per count of summed velocity error
+ * @param     MaxVelocity   largest commanded velocity in counts per second.
+ *                          0: no limit.
+ * @return    none
+ */
+void MotorizedFader_init_Cascade(MotorizedFader_structTd* Fader, double PositionGain, double VelocityKp, double VelocityKi, uint32_t MaxVelocity);
+
+/**
+ * @brief     Set the weights of the estimator of the cascade controller.
+ *            For details please look at the documentation of
+ *            CascadeController_set_Estimator().
+ * @param     Fader     pointer to the users fader structure
+ * @param     Alpha     position weight (0 - 1). Smaller values filter more
+ *                      wiper noise.
+ * @param     Beta      velocity weight. 0: critically damped.
+ * @return    none
+ */
+void MotorizedFader_init_CascadeEstimator(MotorizedFader_structTd* Fader, double Alpha, double Beta);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Cascade Controller"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Auto Tuning
+ * @brief     Use this function to prepare the PID auto tuning of a fader.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the auto tuning of the fader.
+ *            For details please look at the documentation of
+ *            PIDAutotune_init().
+ * @param     Fader       pointer to the users fader structure
+ * @param     RelayCCR    CCR of the relay. It has to be bigger than the start
+ *                        force, e.g. 2 * start force.
+ * @param     Hysteresis  of the relay in wiper counts. Choose it a bit bigger
+ *                        than the wiper noise.
+ * @param     Rule        to calculate the coefficients
+ * @return    none
+ */
+void MotorizedFader_init_Autotune(MotorizedFader_structTd* Fader, uint16_t RelayCCR, uint16_t Hysteresis, PIDAutotune_Rule_enumTd Rule);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Auto Tuning"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Friction Compensation
+ * @brief     Use this function to prepare the friction compensation of a fader.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the friction model of the fader. It is uncalibrated
+ *            afterwards. For details please look at the documentation of
+ *            FrictionModel_init().
+ * @param     Fader     pointer to the users fader structure
+ * @param     RestBand  error in wiper counts, where the motor is switched off
+ *                      at a resting target. Choose it a bit bigger than the
+ *                      wiper noise.
+ * @return    none
+ */
+void MotorizedFader_init_Friction(MotorizedFader_structTd* Fader, uint16_t RestBand);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Friction Compensation"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Events
+ * @brief     Use this function to enable the events of a fader.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Enable the events of a fader. Without this, the fader does not
+ *            write events. For details please look at the documentation of
+ *            FaderEvents_init_Tracker().
+ * @param     Fader         pointer to the users fader structure
+ * @param     Resolution    position change in counts for a position event
+ *                          (1 - 4095)
+ * @param     VelocityShift weight of a new velocity is 1 / 2^VelocityShift
+ * @return    none
+ */
+void MotorizedFader_init_Events(MotorizedFader_structTd* Fader, uint16_t Resolution, uint8_t VelocityShift);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Events"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Settle Detection
+ * @brief     Use this function to park a fader at rest.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Enable the settle detection of a fader. For details please look
+ *            at the documentation of SettleDetector_init().
+ * @param     Fader       pointer to the users fader structure
+ * @param     Window      largest error in wiper counts to settle. Choose it
+ *                        bigger than the stop range or rest band, otherwise
+ *                        the fader may never settle.
+ * @param     MotionBand  largest motion in wiper counts while settling
+ * @param     Count       number of control samples in a row to settle
+ * @param     Park        how the motor driver is parked
+ * @return    none
+ */
+void MotorizedFader_init_Settle(MotorizedFader_structTd* Fader, uint16_t Window, uint16_t MotionBand, uint16_t Count, MotorizedFader_Park_enumTd Park);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Settle Detection"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Haptics
+ * @brief     Use these functions to render a force field while a fader is
+ *            touched. The force is updated with the control timer, so
+ *            MotorizedFader_init_ControlTimer() is required.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Enable the haptics of a fader. For details please look at the
+ *            documentation of FaderHaptics_init().
+ * @param     Fader     pointer to the users fader structure
+ * @param     ForceMax  largest force (CCR). 0 switches the haptics off and
+ *                      the motor stops while the fader is touched.
+ * @param     Damping   CCR per count/ms of wiper velocity
+ * @return    none
+ */
+void MotorizedFader_init_Haptics(MotorizedFader_structTd* Fader, uint16_t ForceMax, double Damping);
+
+/**
+ * @brief     Set the detent table of a fader. The table is not copied, so
+ *            declare it const or static.
+ * @param     Fader       pointer to the users fader structure
+ * @param     Detents     detent table. Positions in the units of
+ *                        MotorizedFader_set_Target().
+ * @param     NumDetents  number of detents in the table
+ * @return    none
+ */
+void MotorizedFader_init_HapticDetents(MotorizedFader_structTd* Fader, const FaderHaptics_Detent_structTd* Detents, uint8_t NumDetents);
+
+/**
+ * @brief     Set soft end stops of a fader.
+ * @param     Fader     pointer to the users fader structure
+ * @param     Low       low end stop position
+ * @param     High      high end stop position
+ * @param     Stiffness CCR per count behind the end stop
+ * @return    none
+ */
+void MotorizedFader_init_HapticEndStops(MotorizedFader_structTd* Fader, uint16_t Low, uint16_t High, double Stiffness);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Haptics"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Stall Detection
+ * @brief     Use these functions to back off the motor of a blocked fader.
+ *            The detector runs with the control timer, so
+ *            MotorizedFader_init_ControlTimer() is required.
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Enable the stall detection of a fader. For details please look
+ *            at the documentation of StallDetector_init().
+ * @param     Fader         pointer to the users fader structure
+ * @param     DutyThreshold smallest CCR that counts as high duty. Choose it
+ *                          well above the start force.
+ * @param     MotionBand    largest motion in wiper counts of a stalled fader
+ * @param     Count         number of control samples in a row to stall.
+ *                          0 switches the detection off.
+ * @return    none
+ */
+void MotorizedFader_init_Stall(MotorizedFader_structTd* Fader, uint16_t DutyThreshold, uint16_t MotionBand, uint16_t Count);
+
+/**
+ * @brief     Set the back off after a stall. For details please look at the
+ *            documentation of StallDetector_set_Backoff().
+ * @param     Fader         pointer to the users fader structure
+ * @param     BackoffCCR    largest CCR while backing off. 0 stops the motor.
+ * @param     BackoffCount  number of control samples until the next retry
+ * @param     Retries       number of retries before the fader gives up
+ * @return    none
+ */
+void MotorizedFader_init_StallBackoff(MotorizedFader_structTd* Fader, uint16_t BackoffCCR, uint16_t BackoffCount, uint8_t Retries);
+
+/** @} ************************************************************************/
+/* end of name "Initialize Stall Detection"
+ ******************************************************************************/
+
+
 /***************************************************************************//**
  * @name      Process
  * @brief     Use these functions to process all faders
@@ -420,7 +1169,8 @@ void MotorizedFader_start_All(void);
 
 /**
  * @brief     Call this function periodically in the main while loop to update
- *            all faders
+ *            all faders. If a control timer is used, only the touch sense
+ *            controller is updated here.
  * @param     none
  * @return    none
  */
@@ -446,6 +1196,26 @@ void MotorizedFader_update_All(void);
  */
 void MotorizedFader_manage_WiperInterrupt(ADC_HandleTypeDef* hadc);
 
+/**
+ * @brief     Call this function in the HAL ADC half transfer interrupt. It is
+ *            only needed if the ADC DMA runs in circular mode.
+ *            For details please look at the documentation of
+ *            Wiper_manage_HalfInterrupt().
+ *
+ * Here is an example:
+ * @code
+ * void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+ * {
+ *   MotorizedFader_manage_WiperHalfInterrupt(hadc);
+ * }
+ * @endcode
+ *
+ * @param     hadc      pointer to the HAL generated ADC-handle of the ADC
+ *                      that is used for the wiper
+ * @return    none
+ */
+void MotorizedFader_manage_WiperHalfInterrupt(ADC_HandleTypeDef* hadc);
+
 /**
  * @brief     Call this funciton in the HAL TSC Interrupt
  *            For details please look at the documentation of
@@ -464,6 +1234,26 @@ void MotorizedFader_manage_WiperInterrupt(ADC_HandleTypeDef* hadc);
  */
 void MotorizedFader_manage_TSCInterrupt(void);
 
+/**
+ * @brief     Call this function in the HAL timer period elapsed interrupt.
+ *            If the timer is the control timer linked with
+ *            MotorizedFader_init_ControlTimer(), the wipers are updated with
+ *            the newest ADC samples, the PID of each fader is calculated and
+ *            the PWM of each motor is set.
+ *
+ * Here is an example:
+ * @code
+ * void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+ * {
+ *   MotorizedFader_manage_ControlTimerInterrupt(htim);
+ * }
+ * @endcode
+ *
+ * @param     htim      pointer to the HAL generated timer handle
+ * @return    none
+ */
+void MotorizedFader_manage_ControlTimerInterrupt(TIM_HandleTypeDef* htim);
+
 /** @} ************************************************************************/
 /* end of name "Process"
  ******************************************************************************/
@@ -477,13 +1267,83 @@ void MotorizedFader_manage_TSCInterrupt(void);
 
 /**
  * @brief     Use this function to set a Target value for the fader. It will
- *            move to this value automatically.
+ *            move to this value automatically. If a motion profile is used,
+ *            the fader moves along the profile. With calibrated wiper, the
+ *            target is a linear position.
  * @param     Fader     pointer to the users fader structure
  * @param     Target    value where the fader should move to.
  * @return    none
  */
 void MotorizedFader_set_Target(MotorizedFader_structTd* fader, uint16_t Target);
 
+/**
+ * @brief     Start the PID auto tuning of the fader. The fader oscillates
+ *            around the center and moves to the step target afterwards. When
+ *            the auto tuning is done, the fader stays at the step target
+ *            until a new target is set. The control timer is required, the
+ *            function does nothing without it.
+ * @param     Fader       pointer to the users fader structure
+ * @param     Center      wiper value of the relay oscillation (e.g. middle
+ *                        of the fader)
+ * @param     StepTarget  wiper value of the step response. Use a step about
+ *                        as large as typical moves of the fader.
+ * @return    none
+ */
+void MotorizedFader_start_Autotune(MotorizedFader_structTd* Fader, uint16_t Center, uint16_t StepTarget);
+
+/**
+ * @brief     Start the friction calibration of the fader. The fader moves to
+ *            the bottom and sweeps up and down slowly. Afterwards the PID
+ *            starts again at the current position. The control timer and
+ *            MotorizedFader_init_PIDMaxCCR() are required, the function does
+ *            nothing without control timer.
+ * @param     Fader       pointer to the users fader structure
+ * @return    none
+ */
+void MotorizedFader_start_FrictionCalibration(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Start the wiper calibration of the fader. The fader moves to
+ *            the bottom, up to the top and down again with a constant CCR.
+ *            Afterwards wiper values and targets are linear. The control
+ *            timer is required, the function does nothing without it.
+ * @param     Fader       pointer to the users fader structure
+ * @param     SweepCCR    CCR of the sweep. Choose it a bit bigger than the
+ *                        start force, so the fader moves slow but steady.
+ *                        With a calibrated friction model it is added to
+ *                        the feed-forward. Choose about the Coulomb CCR
+ *                        then, very small values stick and slip.
+ * @return    none
+ */
+void MotorizedFader_start_WiperCalibration(MotorizedFader_structTd* Fader, uint16_t SweepCCR);
+
+/**
+ * @brief     Link faders to a gang or dissolve it. Faders that are member of
+ *            another gang are removed from it. The gang can be changed while
+ *            the faders are running.
+ * @param     Gang      index of the gang (0 - @ref NUMBER_OF_FADER_GANGS - 1)
+ * @param     Mode      of the gang. @ref MOTORIZEDFADER_GANG_OFF dissolves
+ *                      it.
+ * @param     Faders    array of pointers to the members. With
+ *                      @ref MOTORIZEDFADER_GANG_MASTER_SLAVE the first one is
+ *                      the master. Only initialized faders can be members.
+ * @param     NumFaders number of faders in the array
+ * @return    false if the gang index or a fader is invalid. The gang is
+ *            dissolved then.
+ */
+bool MotorizedFader_set_Gang(uint8_t Gang, MotorizedFader_Gang_enumTd Mode, MotorizedFader_structTd** Faders, uint8_t NumFaders);
+
+/**
+ * @brief     Set the haptic spring of a fader. It pulls the touched fader to
+ *            the target, e.g. back to the pan center. Converts a double, so
+ *            call it from the main loop, not from an interrupt.
+ * @param     Fader     pointer to the users fader structure
+ * @param     Target    in the units of MotorizedFader_set_Target()
+ * @param     Stiffness CCR per count of distance to the target. 0: off.
+ * @return    none
+ */
+void MotorizedFader_set_HapticSpring(MotorizedFader_structTd* Fader, uint16_t Target, double Stiffness);
+
 /** @} ************************************************************************/
 /* end of name "Set Functions"
  ******************************************************************************/
@@ -500,7 +1360,8 @@ void MotorizedFader_set_Target(MotorizedFader_structTd* fader, uint16_t Target);
  *            to control something else, e.g. a protocol value to mode a
  *            DAW fader.
  * @param     Fader     pointer to the users fader structure
- * @return    current ADC value of the wiper
+ * @return    current ADC value of the wiper. With calibrated wiper, the
+ *            linear position.
  */
 uint16_t MotorizedFader_get_WiperValue(MotorizedFader_structTd* Fader);
 
@@ -511,6 +1372,120 @@ uint16_t MotorizedFader_get_WiperValue(MotorizedFader_structTd* Fader);
  */
 TSCButton_State_enumTd MotorizedFader_get_TSCState(MotorizedFader_structTd* Fader);
 
+/**
+ * @brief     Use this function to get the touch confidence with adaptive
+ *            touch detection. For details please look at the documentation
+ *            of TSCButton_get_Confidence().
+ * @param     Fader     pointer to the users fader structure
+ * @return    confidence in percent (0 - 100)
+ */
+uint8_t MotorizedFader_get_TouchConfidence(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to check the progress of the auto tuning.
+ * @param     Fader     pointer to the users fader structure
+ * @return    state of the auto tuning. The results are complete in state
+ *            PIDAUTOTUNE_DONE.
+ */
+PIDAutotune_State_enumTd MotorizedFader_get_AutotuneState(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to get the calculated coefficients and the
+ *            measured step response of the auto tuning.
+ * @param     Fader     pointer to the users fader structure
+ * @return    results of the auto tuning
+ */
+PIDAutotune_Result_structTd MotorizedFader_get_AutotuneResult(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to check the progress of the friction
+ *            calibration.
+ * @param     Fader     pointer to the users fader structure
+ * @return    state of the friction model. The feed-forward is used in state
+ *            FRICTIONMODEL_CALIBRATED.
+ */
+FrictionModel_State_enumTd MotorizedFader_get_FrictionState(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to check the progress of the wiper
+ *            calibration.
+ * @param     Fader     pointer to the users fader structure
+ * @return    state of the linearization. Wiper values and targets are linear
+ *            in state WIPERLINEAR_CALIBRATED.
+ */
+WiperLinear_State_enumTd MotorizedFader_get_WiperCalibrationState(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to check if the control timer interrupt missed
+ *            a period. An overrun is counted, if the next period elapsed
+ *            before the interrupt was finished.
+ * @param     none
+ * @return    number of overruns since start
+ */
+uint32_t MotorizedFader_get_ControlOverruns(void);
+
+/**
+ * @brief     Use this function to get the longest duration of the control
+ *            timer interrupt.
+ * @param     none
+ * @return    longest interrupt duration in percent of the control period
+ */
+uint8_t MotorizedFader_get_ControlLoadMax(void);
+
+/**
+ * @brief     Estimate the largest number of faders the control timer
+ *            interrupt can handle at the current clock, control rate and
+ *            stagger groups. The longest measured interrupt is divided by the
+ *            number of faders updated in one period, so run all faders for a
+ *            while (e.g. moving) before reading it. Fixed costs of the
+ *            interrupt are counted as fader costs, so the estimate is on the
+ *            safe side.
+ * @param     none
+ * @return    number of faders, 0 if nothing was measured yet
+ */
+uint16_t MotorizedFader_get_ControlCapacity(void);
+
+/**
+ * @brief     Use this function to read the oldest event of all faders.
+ *            Events.Fader is the index of the fader in the order of
+ *            MotorizedFader_init_Structure().
+ * @param     Event     pointer where the event is copied to
+ * @return    true if an event was read, false if there is none
+ */
+bool MotorizedFader_get_Event(FaderEvents_Event_structTd* Event);
+
+/**
+ * @brief     Use this function to get the largest latency from detection to
+ *            reading of all events.
+ * @param     none
+ * @return    latency in microseconds
+ */
+uint32_t MotorizedFader_get_EventLatencyMaxUs(void);
+
+/**
+ * @brief     Use this function to check if events were lost, because they
+ *            were not read fast enough.
+ * @param     none
+ * @return    number of dropped events
+ */
+uint32_t MotorizedFader_get_EventOverflows(void);
+
+/**
+ * @brief     Use this function to check if a fader rests at its target.
+ * @param     Fader     pointer to the users fader structure
+ * @return    SETTLEDETECTOR_SETTLED while the PID is skipped and the motor
+ *            is parked
+ */
+SettleDetector_State_enumTd MotorizedFader_get_SettleState(MotorizedFader_structTd* Fader);
+
+/**
+ * @brief     Use this function to check if a fader is blocked.
+ * @param     Fader     pointer to the users fader structure
+ * @return    STALLDETECTOR_BACKOFF or STALLDETECTOR_FAILED while the power
+ *            of the motor is backed off
+ */
+StallDetector_State_enumTd MotorizedFader_get_StallState(MotorizedFader_structTd* Fader);
+
 /** @} ************************************************************************/
 /* end of name "Get Functions"
  ******************************************************************************/
@@ -0,0 +1,315 @@
+/***************************************************************************//**
+ * @defgroup        PIDAutotune   PID auto tuning
+ * @brief           This module finds PID coefficients for a controlled system
+ *                  with a relay feedback experiment and checks them with a
+ *                  step response.
+ *
+ * # Relay feedback experiment (Astrom-Hagglund)
+ * The system is not controlled by the PID, but by a relay: the output is
+ * +RelayOutput if the sample is below the center and -RelayOutput if it is
+ * above (with a hysteresis against noise). The system starts to oscillate
+ * around the center. The first @ref PIDAUTOTUNE_SKIP_CYCLES cycles are
+ * ignored, then period Tu and amplitude a are measured over
+ * @ref PIDAUTOTUNE_MEASURE_CYCLES cycles. The ultimate gain (the P gain where
+ * the system would oscillate on its own) is:
+ *
+ * Ku = 4 * RelayOutput / (pi * sqrt(a^2 - Hysteresis^2))
+ *
+ * Kp, Ki and Kd are calculated from Ku and Tu with the selected rule:
+ *
+ * | Rule                                          | Kp       | Ti      | Td       |
+ * |-----------------------------------------------|----------|---------|----------|
+ * | @ref PIDAUTOTUNE_RULE_CLASSIC "Classic"       | 0.6 Ku   | 0.5 Tu  | 0.125 Tu |
+ * | @ref PIDAUTOTUNE_RULE_SOME_OVERSHOOT "Some"   | 0.33 Ku  | 0.5 Tu  | 0.33 Tu  |
+ * | @ref PIDAUTOTUNE_RULE_NO_OVERSHOOT "None"     | 0.2 Ku   | 0.5 Tu  | 0.33 Tu  |
+ *
+ * with Ki = Kp / Ti and Kd = Kp * Td. Times are in milliseconds, so the
+ * coefficients can be used directly with PIDFixed_set_KpKiKd().
+ *
+ * # Step response
+ * After the new coefficients are set, the PID moves the system from the
+ * current position to the step target. The module measures:
+ * - Rise time: from 10% to 90% of the step.
+ * - Overshoot: largest deviation behind the target.
+ * - Settle time: from the start of the step until the sample stays within
+ *   2% of the step (at least the hysteresis) for
+ *   @ref PIDAUTOTUNE_SETTLE_HOLD_US.
+ *
+ * # How to use:
+ * 1. Declare an object of PIDAutotune_structTd (usually done by the motorized
+ *    fader module).
+ * 2. Initialize it with PIDAutotune_init().
+ * 3. Start the tuning with PIDAutotune_start().
+ * 4. State @ref PIDAUTOTUNE_RELAY: call PIDAutotune_update_Relay() with a
+ *    fixed rate and use its return value as output for the system.
+ * 5. State @ref PIDAUTOTUNE_CALCULATE: call PIDAutotune_calculate_Gains()
+ *    (not in an interrupt, it uses double operations). Set the coefficients
+ *    to the PID and call PIDAutotune_start_Step().
+ * 6. State @ref PIDAUTOTUNE_STEP: control the system with the PID and the
+ *    step target. Call PIDAutotune_update_Step() with a fixed rate.
+ * 7. State @ref PIDAUTOTUNE_DONE: get the results with
+ *    PIDAutotune_get_Result().
+ *
+ * @defgroup        PIDAutotune_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      PIDAutotune
+ * @{
+ *
+ * @addtogroup      PIDAutotune_Header
+ * @{
+ *
+ * @file            pidAutotune.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_PIDAUTOTUNE_H_
+#define INC_FADER_PIDAUTOTUNE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Number of relay cycles ignored at the beginning of the
+ *            experiment, until the oscillation is stable.
+ */
+#define PIDAUTOTUNE_SKIP_CYCLES     2
+
+/**
+ * @brief     Number of relay cycles used to measure period and amplitude.
+ */
+#define PIDAUTOTUNE_MEASURE_CYCLES  4
+
+/**
+ * @brief     The experiment fails, if the relay does not switch within this
+ *            time (e.g. the motor does not move), or if the step does not
+ *            settle within this time.
+ */
+#define PIDAUTOTUNE_TIMEOUT_US      2000000
+
+/**
+ * @brief     Time the sample has to stay within the band around the step
+ *            target to be settled.
+ */
+#define PIDAUTOTUNE_SETTLE_HOLD_US  200000
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     States of the auto tuning
+ */
+typedef enum
+{
+  PIDAUTOTUNE_IDLE,         /**< Not started */
+  PIDAUTOTUNE_RELAY,        /**< Relay feedback experiment is running */
+  PIDAUTOTUNE_CALCULATE,    /**< Relay finished, coefficients can be
+                                 calculated */
+  PIDAUTOTUNE_STEP,         /**< Step response with new coefficients */
+  PIDAUTOTUNE_DONE,         /**< Finished, results are available */
+  PIDAUTOTUNE_FAILED        /**< Timeout, no oscillation or aborted */
+}PIDAutotune_State_enumTd;
+
+/**
+ * @brief     Rules to calculate the coefficients from the relay experiment
+ */
+typedef enum
+{
+  PIDAUTOTUNE_RULE_CLASSIC,         /**< Ziegler-Nichols, fast with overshoot */
+  PIDAUTOTUNE_RULE_SOME_OVERSHOOT,  /**< Less overshoot than classic */
+  PIDAUTOTUNE_RULE_NO_OVERSHOOT     /**< Slowest, (almost) no overshoot */
+}PIDAutotune_Rule_enumTd;
+
+/**
+ * @brief     Results of the auto tuning
+ */
+typedef struct
+{
+  double    Kp;                 /**< Calculated P coefficient */
+  double    Ki;                 /**< Calculated I coefficient (1/ms) */
+  double    Kd;                 /**< Calculated D coefficient (ms) */
+  double    UltimateGain;       /**< Ku from the relay experiment */
+  uint32_t  UltimatePeriodUs;   /**< Tu from the relay experiment */
+  uint16_t  Amplitude;          /**< Half peak to peak of the oscillation */
+  uint16_t  Overshoot;          /**< Overshoot of the step (counts) */
+  uint32_t  RiseTimeUs;         /**< 10% to 90% of the step */
+  uint32_t  SettleTimeUs;       /**< Start of the step until settled */
+  bool      Settled;            /**< false if the step did not settle within
+                                     @ref PIDAUTOTUNE_TIMEOUT_US */
+}PIDAutotune_Result_structTd;
+
+/**
+ * @brief     Main structure of the auto tuning. The user has to declare one
+ *            object for each tuned system.
+ */
+typedef struct
+{
+  volatile PIDAutotune_State_enumTd State; /**< Current state. Set last, as
+                                                the tuning might be updated
+                                                in an interrupt. */
+  PIDAutotune_Rule_enumTd   Rule;   /**< Rule for the coefficients */
+  int32_t   RelayOutput;        /**< Output amplitude of the relay */
+  int32_t   Hysteresis;         /**< Hysteresis of the relay (counts) */
+  int32_t   Center;             /**< Center of the relay oscillation */
+  int32_t   StepTarget;         /**< Target of the step response */
+  uint32_t  SampleTimeUs;       /**< Time between two updates (us) */
+
+  int32_t   Output;             /**< Current relay output */
+  uint32_t  Ticks;              /**< Samples since start of the state */
+  uint32_t  SwitchTick;         /**< Sample of the last relay switch */
+  uint32_t  MeasureTick;        /**< Sample where the measurement started */
+  uint8_t   Cycles;             /**< Number of relay cycles */
+  int32_t   SampleMax;          /**< Largest sample while measuring */
+  int32_t   SampleMin;          /**< Smallest sample while measuring */
+
+  bool      StepStarted;        /**< false until the first step sample */
+  int32_t   StepStart;          /**< Sample at the start of the step */
+  uint32_t  RiseStartTick;      /**< Sample where 10% were reached */
+  uint32_t  RiseEndTick;        /**< Sample where 90% were reached */
+  uint32_t  OutsideTick;        /**< Last sample outside the settle band */
+
+  PIDAutotune_Result_structTd Result; /**< Results of the auto tuning */
+}PIDAutotune_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and start the auto tuning
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the auto tuning.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     RelayOutput output amplitude of the relay. It has to be strong
+ *                        enough to move the system in both directions.
+ * @param     Hysteresis  of the relay in sample counts. Choose it a bit bigger
+ *                        than the noise of the samples.
+ * @param     Rule        to calculate the coefficients
+ * @return    none
+ */
+void PIDAutotune_init(PIDAutotune_structTd* AT, int32_t RelayOutput, int32_t Hysteresis, PIDAutotune_Rule_enumTd Rule);
+
+/**
+ * @brief     Start the relay feedback experiment.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     Center      of the relay oscillation
+ * @param     StepTarget  target of the step response after the relay
+ *                        experiment. Choose a step about as large as typical
+ *                        moves of the system.
+ * @param     SampleTime  time between two updates in microseconds
+ * @return    none
+ */
+void PIDAutotune_start(PIDAutotune_structTd* AT, int32_t Center, int32_t StepTarget, uint32_t SampleTime);
+
+/**
+ * @brief     Stop the auto tuning. The state is set to
+ *            @ref PIDAUTOTUNE_FAILED, if it was running.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    none
+ */
+void PIDAutotune_abort(PIDAutotune_structTd* AT);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to run the auto tuning
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the relay with a new sample. Call this function with the
+ *            sample time in state @ref PIDAUTOTUNE_RELAY. It only uses integer
+ *            operations and can be used inside an interrupt.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     Sample      current value of the system
+ * @return    output for the system (+-RelayOutput)
+ */
+int32_t PIDAutotune_update_Relay(PIDAutotune_structTd* AT, int32_t Sample);
+
+/**
+ * @brief     Calculate Ku, Tu and the coefficients in state
+ *            @ref PIDAUTOTUNE_CALCULATE. This function uses double operations
+ *            and should not be called in an interrupt.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    true if the coefficients are valid. If not, the state is set to
+ *            @ref PIDAUTOTUNE_FAILED.
+ */
+bool PIDAutotune_calculate_Gains(PIDAutotune_structTd* AT);
+
+/**
+ * @brief     Start the step response. Set the calculated coefficients to the
+ *            PID before.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    none
+ */
+void PIDAutotune_start_Step(PIDAutotune_structTd* AT);
+
+/**
+ * @brief     Update the step response measurement with a new sample. Call
+ *            this function with the sample time in state
+ *            @ref PIDAUTOTUNE_STEP, while the PID controls the system to
+ *            the step target. It only uses integer operations.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     Sample      current value of the system
+ * @return    none
+ */
+void PIDAutotune_update_Step(PIDAutotune_structTd* AT, int32_t Sample);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the auto tuning
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the current state of the auto tuning.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    state
+ */
+PIDAutotune_State_enumTd PIDAutotune_get_State(PIDAutotune_structTd* AT);
+
+/**
+ * @brief     Get the target of the step response.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    step target
+ */
+int32_t PIDAutotune_get_StepTarget(PIDAutotune_structTd* AT);
+
+/**
+ * @brief     Get the results. They are complete in state
+ *            @ref PIDAUTOTUNE_DONE.
+ * @param     AT          pointer to the auto tuning structure
+ * @return    results
+ */
+PIDAutotune_Result_structTd PIDAutotune_get_Result(PIDAutotune_structTd* AT);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "PIDAutotune_Header" */
+/**@}*//* end of defgroup "PIDAutotune" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_PIDAUTOTUNE_H_ */
@@ -13,6 +13,8 @@
  *    - Set Sample Time for controlled update frequency
  * 4. Set Target
  * 5. In while loop:
+ *    - Call TimerService_update() (once for all modules, see
+ *      @ref TimerService), it runs the sample timer of PID_update()
  *    - Get the current value of the controlled system
  *    - Update PID with the current value
  *    - Use Get-Functions to get the PID results and use them to correct the
@@ -53,7 +55,7 @@
 #define INC_PERIPHERALS_FADER_PIDCONTROLLER_H_
 
 #include "main.h"
-#include "timer.h"
+#include "timerService.h"
 
 
 /***************************************************************************//**
@@ -93,7 +95,8 @@ typedef struct
   int       OutputRound;/**< Round value of the result of the PIDS*/
 
   uint32_t  SampleTime; /**< Timer threshold for the update frequency (ms)*/
-  Timer_structTd SampleTimer; /**< Timer for internal use */
+  TimerService_Timer_structTd SampleTimer; /**< Sample timer of
+                              PID_update(), for internal use */
 
 }PID_structTd;
 
@@ -200,12 +203,26 @@ void PID_reset(PID_structTd* PID);
  * @brief     Call this function periodically calculate the newest PID output.
  *            Be careful to call this function faster as the set sample time,
  *            otherwise it might get difficult to calibrate the PID-terms.
+ *            The sample time is a periodic timer of the
+ *            @ref TimerService "timer service", so TimerService_update() has
+ *            to run in the while loop. The first call starts the timer and
+ *            calculates at once.
  * @param     PID     pointer to the users PID structure
  * @param     Sample  is the current process variable
  * @return    result of the PID calculation with the new sample.
  */
 void PID_update(PID_structTd* PID, double sample);
 
+/**
+ * @brief     Calculate the newest PID output without checking the sample time.
+ *            Call this function with the rate of PID_set_SampleTimeInMs(),
+ *            e.g. to compare it with PIDFixed_calculate().
+ * @param     PID     pointer to the users PID structure
+ * @param     Sample  is the current process variable
+ * @return    none
+ */
+void PID_calculate(PID_structTd* PID, double sample);
+
 /** @} ************************************************************************/
 /* end of name "Process"
  ******************************************************************************/
@@ -0,0 +1,400 @@
+/***************************************************************************//**
+ * @defgroup        PIDFixed_Controller Fixed-point PID controller
+ * @brief           This module is the integer variant of the
+ *                  @ref PID_Controller "PID controller". It is made for MCUs
+ *                  without FPU (e.g. Cortex-M0+), where every double operation
+ *                  is emulated in software and costs thousands of cycles.
+ *
+ * The calculation is the same as in the double version (same P-Term, I-Term
+ * with anti wind-up, D-Term with low pass and output limits), but all terms
+ * are stored as Q16.16 fixed-point numbers (16 bit integer part, 16 bit
+ * fraction). The coefficients are stored as Q8.24 numbers, because some of them
+ * are very small (e.g. Ki * SampleTime / 2). All coefficients are converted
+ * once when they are set, so PIDFixed_update() only uses integer
+ * multiplications, additions and shifts.
+ *
+ * # How to use:
+ * 1. Declare an object of PIDFixed_structTd data type
+ * 2. Initialize this object with init functions
+ * 3. Use set functions to tune PID (same values as for the double version).
+ *    - Set Kp, Ki, Kd
+ *    - Set Low Pass
+ *    - Set Limits for output value
+ *    - Set Sample Time for controlled update frequency
+ * 4. Set Target
+ * 5. In while loop:
+ *    - Call TimerService_update() (once for all modules, see
+ *      @ref TimerService), it runs the sample timer of PIDFixed_update()
+ *    - Get the current value of the controlled system
+ *    - Update PID with the current value
+ *    - Use Get-Functions to get the PID results and use them to correct the
+ *      system that is controlled.
+ *
+ * # Value ranges:
+ * - Samples and set points are integers (e.g. ADC values). Errors up to
+ *   +-32767 can be processed.
+ * - The output limits must be smaller than 32768.
+ * - All combined coefficients (see PIDFixed_structTd) must be smaller than 128.
+ * - Coefficients smaller than 2^-24 are rounded to 0. Ki is combined with the
+ *   sample time before the conversion, so Ki * SampleTime / 2 has to be bigger
+ *   than 2^-24 (e.g. Ki = 0.0001 with 3 ms is fine).
+ *
+ * # Gain scheduling:
+ * One set of gains is a compromise: gains that make small corrections fast
+ * saturate the output on large moves, gains for large moves let small
+ * corrections crawl. With PIDFixed_set_GainSchedule() a second set of gains
+ * is used for large errors:
+ * - |Error| <= ErrorSmall: Kp, Ki, Kd from PIDFixed_set_KpKiKd()
+ * - |Error| >= ErrorLarge: the large error gains
+ * - in between the coefficients are interpolated linearly
+ *
+ * PIDFixed_set_GainScaleDown() scales all coefficients for negative errors
+ * (down), e.g. if the fader is mounted vertically and gravity helps to move
+ * down. The interpolation only uses a multiplication, the factor
+ * 1 / (ErrorLarge - ErrorSmall) is calculated when the schedule is set.
+ *
+ * # Back-calculation anti wind-up:
+ * The output is not always what moves the motor: it is limited, a small
+ * output is raised to the start force or set to 0 in the stop range of the
+ * motor. PIDFixed_track_Output() takes the CCR that was really applied and
+ * moves the I-Term by Kb * SampleTime * (applied - output), so the I-Term
+ * does not wind up against the limits and the stop range. It is off with
+ * Kb = 0 (see PIDFixed_set_BackCalculation()).
+ *
+ * # Accuracy and cycle count:
+ * The check pid_fixed of the host simulation (Simulation/Check) runs
+ * PIDFixed_calculate() and PID_calculate() of the
+ * @ref PID_Controller "double version" on the same sample sequences (steps,
+ * ramps, noise, saturation) and fails if the outputs differ by more than
+ * 0.1. The speed is not verified: there is no cycle count of the
+ * Cortex-M0+ yet, the claim that the fixed-point version is faster there is
+ * an expectation (no FPU, software double emulation). To measure it, enable
+ * the @ref Profiler: PROFILER_REGION_PID records the cycles of the PID of
+ * each fader, i.e. PIDFixed_calculate(). For the reference, call
+ * PID_calculate() with the same sample inside the same region: the increase
+ * of the cycles is its cost.
+ *
+ * @note      Set the sample time before Kp, Ki, Kd and tau are converted. If
+ *            the sample time is changed later, the coefficients are converted
+ *            again automatically.
+ *
+ * @defgroup        PIDFixed_Header      Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      PIDFixed_Controller
+ * @{
+ *
+ * @addtogroup      PIDFixed_Header
+ * @{
+ *
+ * @file            pidControllerFixed.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_PERIPHERALS_FADER_PIDCONTROLLERFIXED_H_
+#define INC_PERIPHERALS_FADER_PIDCONTROLLERFIXED_H_
+
+#include "main.h"
+#include "timerService.h"
+
+/**
+ * @brief     Number of fraction bits of all fixed-point terms in this module.
+ */
+#define PIDFIXED_Q_SHIFT  16
+
+/**
+ * @brief     Number of fraction bits of the fixed-point coefficients.
+ */
+#define PIDFIXED_COEFF_SHIFT  24
+
+/**
+ * @brief     Value of 1.0 in the fixed-point format of this module.
+ */
+#define PIDFIXED_Q_ONE    ((int32_t)1 << PIDFIXED_Q_SHIFT)
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Main structure used to store all data for the fixed-point PID.
+ *            The user has to declare an Object of this type for each used
+ *            PID-controller. All int32_t values are Q16.16 if not noted
+ *            otherwise. Coefficients are Q8.24.
+ */
+typedef struct
+{
+  double    Kp;           /**< P coefficient as set by the user */
+  double    Ki;           /**< I coefficient as set by the user */
+  double    Kd;           /**< D coefficient as set by the user */
+  double    TauLowPass;   /**< Low pass time constant as set by the user */
+
+  int32_t   CoeffP;       /**< Kp */
+  int32_t   CoeffI;       /**< 0.5 * Ki * SampleTime */
+  int32_t   CoeffD;       /**< -2 * Kd / (2 * Tau + SampleTime) */
+  int32_t   CoeffLowPass; /**< (2 * Tau - SampleTime) / (2 * Tau + SampleTime) */
+
+  double    KpLarge;      /**< P coefficient for large errors */
+  double    KiLarge;      /**< I coefficient for large errors */
+  double    KdLarge;      /**< D coefficient for large errors */
+  double    ScaleDown;    /**< Factor of all coefficients for errors < 0 */
+  double    Kb;           /**< Back-calculation coefficient as set by the
+                               user (1 / ms) */
+  int32_t   CoeffPLarge;  /**< KpLarge */
+  int32_t   CoeffILarge;  /**< 0.5 * KiLarge * SampleTime */
+  int32_t   CoeffDLarge;  /**< -2 * KdLarge / (2 * Tau + SampleTime) */
+  int32_t   CoeffScaleDown; /**< ScaleDown */
+  int32_t   CoeffTrack;   /**< Kb * SampleTime */
+  int32_t   ErrorSmall;   /**< Largest error with the normal gains (integer) */
+  int32_t   ErrorLarge;   /**< Smallest error with the large error gains
+                               (integer). 0: no gain scheduling */
+  int32_t   ScheduleSlope;/**< 1 / (ErrorLarge - ErrorSmall), Q16.16 */
+
+  int32_t   PTerm;        /**< P-Term from last calculation */
+  int32_t   ITerm;        /**< I-Term from last calculation */
+  int32_t   DTerm;        /**< D-Term from last calculation */
+
+  int32_t   Setpoint;     /**< Target value of the system (integer) */
+  int32_t   Sample;       /**< Previous sample of the system (integer) */
+
+  int32_t   Error;        /**< Deviation of the current calculation (integer) */
+  int32_t   PrevError;    /**< Deviation of the previous calculation (integer) */
+
+  int32_t   OutputMin;    /**< Minimal limit of the output value */
+  int32_t   OutputMax;    /**< Maximum limit of the output value */
+
+  int32_t   OutputSum;    /**< Sum of the terms before the limitation */
+  int32_t   OutputRaw;    /**< Result of the PID */
+  int       OutputRound;  /**< Round value of the result of the PID */
+
+  uint32_t  SampleTime;   /**< Timer threshold for the update frequency (ms)*/
+  uint32_t  SampleTimeUs; /**< Sample time used for the coefficients (us) */
+  TimerService_Timer_structTd SampleTimer; /**< Sample timer of
+                               PIDFixed_update(), for internal use */
+
+}PIDFixed_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the PID controller
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the users PID-structure to make sure that the start
+ *            values are properly set.
+ * @param     PID     pointer to the users PID structure
+ * @return    none
+ */
+void PIDFixed_init(PIDFixed_structTd* PID);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @brief     Use these functions to set or reset parameters
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set the value range for the PID output.
+ * @param     PID     pointer to the users PID structure
+ * @param     Min     value
+ * @param     Max     value
+ * @return    none
+ */
+void PIDFixed_set_OutputMinMax(PIDFixed_structTd* PID, int32_t Min, int32_t Max);
+
+/**
+ * @brief     Set the coefficients for proportional, integral and derivative
+ *            terms. The values are the same as for PID_set_KpKiKd(). They are
+ *            converted to fixed-point here, so this function is slow and
+ *            should not be called in the update cycle.
+ * @param     PID     pointer to the users PID structure
+ * @param     Kp      coefficient for the proportional term
+ * @param     Ki      coefficient for the integral term
+ * @param     Kd      coefficient for the derivative term
+ * @return    none
+ */
+void PIDFixed_set_KpKiKd(PIDFixed_structTd* PID, double Kp, double Ki, double Kd);
+
+/**
+ * @brief     Set the gains for large errors. Between ErrorSmall and ErrorLarge
+ *            the coefficients are interpolated. The values are converted to
+ *            fixed-point here, so do not call it in the update cycle.
+ * @param     PID         pointer to the users PID structure
+ * @param     Kp          coefficient for the proportional term
+ * @param     Ki          coefficient for the integral term
+ * @param     Kd          coefficient for the derivative term
+ * @param     ErrorSmall  largest error that uses the gains of
+ *                        PIDFixed_set_KpKiKd()
+ * @param     ErrorLarge  smallest error that uses these gains. Must be bigger
+ *                        than ErrorSmall, 0 switches the schedule off.
+ * @return    none
+ */
+void PIDFixed_set_GainSchedule(PIDFixed_structTd* PID, double Kp, double Ki, double Kd, uint16_t ErrorSmall, uint16_t ErrorLarge);
+
+/**
+ * @brief     Set the factor of all coefficients for negative errors (down).
+ * @param     PID     pointer to the users PID structure
+ * @param     Scale   factor (e.g. 0.8). 1.0: same gains in both directions.
+ * @return    none
+ */
+void PIDFixed_set_GainScaleDown(PIDFixed_structTd* PID, double Scale);
+
+/**
+ * @brief     Set the coefficient of the back-calculation anti wind-up. See
+ *            PIDFixed_track_Output().
+ * @param     PID     pointer to the users PID structure
+ * @param     Kb      part of the difference between applied and calculated
+ *                    output that is moved to the I-Term per ms (e.g. 0.1).
+ *                    Kb * SampleTime must not be bigger than 1. 0: off.
+ * @return    none
+ */
+void PIDFixed_set_BackCalculation(PIDFixed_structTd* PID, double Kb);
+
+/**
+ * @brief     Set new set point for the PID Controller as new target of the
+ *            controlled system.
+ * @param     PID     pointer to the users PID structure
+ * @param     setpoint  for the PID controller
+ * @return    none
+ */
+void PIDFixed_set_Target(PIDFixed_structTd* PID, int32_t Setpoint);
+
+/**
+ * @brief     Set tau to tune the low pass used on the D-Term to reduce noise.
+ *            For details look at PID_set_LowPass().
+ * @param     PID     pointer to the users PID structure
+ * @param     Tau     time constant of the low pass filter
+ * @return    none
+ */
+void PIDFixed_set_LowPass(PIDFixed_structTd* PID, double Tau);
+
+/**
+ * @brief     Set the sample time to control the update frequency of the
+ *            PID-controller. For details look at PID_set_SampleTimeInMs().
+ * @param     PID     pointer to the users PID structure
+ * @param     Threshold of the sample time in milliseconds
+ * @return    none
+ */
+void PIDFixed_set_SampleTimeInMs(PIDFixed_structTd* PID, uint32_t Threshold);
+
+/**
+ * @brief     Set the sample time in microseconds. Use this function if
+ *            PIDFixed_calculate() is called with a fixed rate, e.g. from a
+ *            timer interrupt, or for sample times below one millisecond with
+ *            PIDFixed_update() (resolution of one tick of the timer service). The
+ *            coefficients are converted again automatically.
+ * @param     PID     pointer to the users PID structure
+ * @param     SampleTime  time between two calls of PIDFixed_calculate() in
+ *                        microseconds
+ * @return    none
+ */
+void PIDFixed_set_SampleTimeInUs(PIDFixed_structTd* PID, uint32_t SampleTime);
+
+/**
+ * @brief     Reset all values from previous calculations in the structure to
+ *            make the PID-controller ready for a clean start.
+ * @param     PID     pointer to the users PID structure
+ * @return   none
+ */
+void PIDFixed_reset(PIDFixed_structTd* PID);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calculate the PID
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Call this function periodically calculate the newest PID output.
+ *            Be careful to call this function faster as the set sample time,
+ *            otherwise it might get difficult to calibrate the PID-terms.
+ *            The sample time is a periodic timer of the
+ *            @ref TimerService "timer service", so TimerService_update() has
+ *            to run in the while loop. The first call starts the timer and
+ *            calculates at once.
+ * @param     PID     pointer to the users PID structure
+ * @param     Sample  is the current process variable
+ * @return    none
+ */
+void PIDFixed_update(PIDFixed_structTd* PID, int32_t Sample);
+
+/**
+ * @brief     Calculate the newest PID output without checking the sample time.
+ *            Call this function with a fixed rate, e.g. from a timer
+ *            interrupt, and set the rate with PIDFixed_set_SampleTimeInUs().
+ *            The function only uses integer operations and has a constant run
+ *            time, so it can be used inside an interrupt.
+ * @param     PID     pointer to the users PID structure
+ * @param     Sample  is the current process variable
+ * @return    none
+ */
+void PIDFixed_calculate(PIDFixed_structTd* PID, int32_t Sample);
+
+/**
+ * @brief     Tell the PID which output was really applied after the last
+ *            PIDFixed_calculate() (e.g. limited by the motor driver, raised to
+ *            the start force or 0 in the stop range). The I-Term is moved by
+ *            the back-calculation coefficient times the difference. Does
+ *            nothing if the coefficient is 0. Only uses integer operations.
+ * @param     PID     pointer to the users PID structure
+ * @param     Applied output that was applied (integer)
+ * @return    none
+ */
+void PIDFixed_track_Output(PIDFixed_structTd* PID, int32_t Applied);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions get values from the PID
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get raw output value of the last PID calculation.
+ * @param     PID     pointer to the users PID structure
+ * @return    Raw PID output value in Q16.16 format
+ */
+int32_t PIDFixed_get_OutputRaw(PIDFixed_structTd* PID);
+
+/**
+ * @brief     Get round output value of the last PID calculation.
+ * @param     PID     pointer to the users PID structure
+ * @return    Round PID output value
+ */
+int PIDFixed_get_OutputRound(PIDFixed_structTd* PID);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "PIDFixed_Header" */
+/**@}*//* end of defgroup "PIDFixed_Controller" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_PERIPHERALS_FADER_PIDCONTROLLERFIXED_H_ */
@@ -0,0 +1,264 @@
+/***************************************************************************//**
+ * @defgroup        Profiler    Profiler
+ * @brief           This module measures the CPU cycles of code regions with
+ *                  enter and exit probes.
+ *
+ * Each region of @ref Profiler_Region_enumTd counts its runs and the total,
+ * shortest and longest number of cycles between PROFILER_ENTER() and
+ * PROFILER_EXIT(). The probes are placed in the modules, e.g. around the PID
+ * of a fader or in the control timer interrupt.
+ *
+ * # Cycle counter
+ * - Cortex-M3 and higher (e.g. F103): the DWT cycle counter (CYCCNT).
+ * - Cortex-M0+ (e.g. L053): there is no DWT cycle counter. The cycles are
+ *   read from SysTick (counts HCLK down from LOAD to 0) and the HAL tick,
+ *   so SysTick has to run with the HAL default of 1 ms.
+ *
+ * # Switch off
+ * With @ref PROFILER_ENABLE 0 (default) the probes and this module are
+ * compiled out completely: no code, no RAM, no cycles. Set it to 1 here or
+ * with -DPROFILER_ENABLE=1 for a build that is to be profiled.
+ *
+ * # How to use:
+ * 1. Set @ref PROFILER_ENABLE to 1.
+ * 2. Initialize the cycle counter with Profiler_init().
+ * 3. Put PROFILER_ENTER() and PROFILER_EXIT() of a region around the code
+ *    to measure. Add new regions to @ref Profiler_Region_enumTd and their
+ *    names to the table in profiler.c.
+ * 4. Read the results with Profiler_get_Region() in the debugger, or write
+ *    them out with Profiler_format_Region() (text, e.g. UART) or
+ *    Profiler_pack_SysEx() (MIDI) to compare builds.
+ *
+ * @warning   A region must not be entered again before it is exited (no
+ *            recursion, not in main loop and interrupt at the same time).
+ *            Nested different regions are fine. The cycles of interrupts
+ *            during a region count for the region.
+ *
+ * @defgroup        Profiler_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      Profiler
+ * @{
+ *
+ * @addtogroup      Profiler_Header
+ * @{
+ *
+ * @file            profiler.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_PROFILER_H_
+#define INC_FADER_PROFILER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l0xx_hal.h"
+
+/***************************************************************************//**
+ * @name      Settings
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     1: probes are active. 0: the profiler is compiled out.
+ */
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE           0
+#endif
+
+/**
+ * @brief     Length of a SysEx message of Profiler_pack_SysEx()
+ */
+#define PROFILER_SYSEX_LENGTH     24
+
+/** @} ************************************************************************/
+/* end of name "Settings"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Measured regions
+ */
+typedef enum
+{
+  PROFILER_REGION_CONTROL = 0,  /**< Control timer interrupt of the faders */
+  PROFILER_REGION_PID,          /**< PID (or cascade) of one fader */
+  PROFILER_REGION_WIPER,        /**< Filter of one wiper sample */
+  PROFILER_REGION_TSC,          /**< Update of all TSC buttons */
+  PROFILER_NUM_REGIONS          /**< Number of regions, not a region */
+}Profiler_Region_enumTd;
+
+/**
+ * @brief     Results of a region
+ */
+typedef struct
+{
+  uint32_t  Count;          /**< Number of runs */
+  uint64_t  TotalCycles;    /**< Sum of all runs */
+  uint32_t  MinCycles;      /**< Shortest run */
+  uint32_t  MaxCycles;      /**< Longest run */
+  uint32_t  StartCycles;    /**< Counter at the last enter, internal use */
+}Profiler_Region_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Probes
+ * @{
+ ******************************************************************************/
+
+#if PROFILER_ENABLE == 1
+/**
+ * @brief     Start the measurement of a region
+ * @param     Region    of @ref Profiler_Region_enumTd
+ */
+#define PROFILER_ENTER(Region)    Profiler_enter(Region)
+
+/**
+ * @brief     End the measurement of a region
+ * @param     Region    of @ref Profiler_Region_enumTd
+ */
+#define PROFILER_EXIT(Region)     Profiler_exit(Region)
+#else
+#define PROFILER_ENTER(Region)    ((void)0)
+#define PROFILER_EXIT(Region)     ((void)0)
+#endif
+
+/** @} ************************************************************************/
+/* end of name "Probes"
+ ******************************************************************************/
+
+#if PROFILER_ENABLE == 1
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Start the cycle counter and reset all regions. Call it after
+ *            the clock is set up.
+ * @param     none
+ * @return    none
+ */
+void Profiler_init(void);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Reset the results of all regions.
+ * @param     none
+ * @return    none
+ */
+void Profiler_reset(void);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Start the measurement of a region. Use PROFILER_ENTER().
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @return    none
+ */
+void Profiler_enter(Profiler_Region_enumTd Region);
+
+/**
+ * @brief     End the measurement of a region. Use PROFILER_EXIT().
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @return    none
+ */
+void Profiler_exit(Profiler_Region_enumTd Region);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the current value of the cycle counter.
+ * @param     none
+ * @return    cycles since start (wraps)
+ */
+uint32_t Profiler_get_Cycles(void);
+
+/**
+ * @brief     Get the results of a region.
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @return    pointer to the results
+ */
+const Profiler_Region_structTd* Profiler_get_Region(Profiler_Region_enumTd Region);
+
+/**
+ * @brief     Get the name of a region.
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @return    name
+ */
+const char* Profiler_get_RegionName(Profiler_Region_enumTd Region);
+
+/**
+ * @brief     Write the results of a region as one line of text:
+ *            "name count min max mean\r\n" (cycles). 32 bit values only,
+ *            as printf of newlib nano does not support 64 bit.
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @param     Buffer    for the text
+ * @param     Size      size of the buffer
+ * @return    length of the text without the terminating 0
+ */
+uint16_t Profiler_format_Region(Profiler_Region_enumTd Region, char* Buffer, uint16_t Size);
+
+/**
+ * @brief     Pack the results of a region into a SysEx message of
+ *            @ref PROFILER_SYSEX_LENGTH bytes: F0 7D, region, count, total
+ *            (lower 32 bit), min, max and F7. Each value has 5 data bytes
+ *            of 7 bit, least significant first. 7D is the ID for
+ *            non-commercial use.
+ * @param     Region    of @ref Profiler_Region_enumTd
+ * @param     Buffer    for the message
+ * @return    none
+ */
+void Profiler_pack_SysEx(Profiler_Region_enumTd Region, uint8_t* Buffer);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+#endif /* PROFILER_ENABLE */
+
+/**@}*//* end of defgroup "Profiler_Header" */
+/**@}*//* end of defgroup "Profiler" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_PROFILER_H_ */
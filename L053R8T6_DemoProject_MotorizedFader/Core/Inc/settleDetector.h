@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ * @defgroup        SettleDetector    Settle detector
+ * @brief           This module detects when a fader has settled at its target
+ *                  and when it has to wake up again.
+ *
+ * A fader is settled, if for a number of samples in a row
+ * - the setpoint reached the target (the motion profile finished),
+ * - the error is within the settle window and
+ * - the position did not move more than the motion band since the first of
+ *   these samples (velocity near zero).
+ *
+ * While settled, the PID does not need to run and the motor driver can be
+ * parked. The fader wakes up, if the target changes or the error gets bigger
+ * than the wake band (twice the settle window). This hysteresis avoids that
+ * the wiper noise wakes the fader.
+ *
+ * # How to use:
+ * 1. Declare an object of SettleDetector_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with SettleDetector_init().
+ * 3. Call SettleDetector_update() with each new sample. Skip the controller
+ *    while it returns true.
+ * 4. Call SettleDetector_reset() if the fader is moved by someone else (e.g.
+ *    touched).
+ *
+ * @defgroup        SettleDetector_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      SettleDetector
+ * @{
+ *
+ * @addtogroup      SettleDetector_Header
+ * @{
+ *
+ * @file            settleDetector.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_SETTLEDETECTOR_H_
+#define INC_FADER_SETTLEDETECTOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     States of the settle detector
+ */
+typedef enum
+{
+  SETTLEDETECTOR_ACTIVE,    /**< The fader is controlled */
+  SETTLEDETECTOR_SETTLED    /**< The fader rests at its target */
+}SettleDetector_State_enumTd;
+
+/**
+ * @brief     Main structure of the settle detector. Declare one object for
+ *            each fader.
+ */
+typedef struct
+{
+  SettleDetector_State_enumTd State;
+  uint16_t  Window;         /**< Largest error to settle */
+  uint16_t  MotionBand;     /**< Largest motion while settling */
+  uint16_t  Count;          /**< Samples in a row to settle. 0: off */
+  uint16_t  Counter;        /**< Samples in a row that met the conditions */
+  int32_t   Reference;      /**< Position at the first of these samples */
+  int32_t   Target;         /**< Target when the fader settled */
+}SettleDetector_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the settle detector. It is active afterwards.
+ * @param     Detector    pointer to the settle detector structure
+ * @param     Window      largest error in counts to settle. The fader wakes
+ *                        up at twice this error.
+ * @param     MotionBand  largest motion in counts during the settle samples.
+ *                        Choose it a bit bigger than the wiper noise.
+ * @param     Count       number of samples in a row to settle. 0 switches the
+ *                        detector off.
+ * @return    none
+ */
+void SettleDetector_init(SettleDetector_structTd* Detector, uint16_t Window, uint16_t MotionBand, uint16_t Count);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the detector with a new sample. Only uses integer
+ *            operations, so it can be called in an interrupt.
+ * @param     Detector    pointer to the settle detector structure
+ * @param     Target      final target of the fader
+ * @param     Sample      current position
+ * @param     SetpointAtTarget true if the setpoint of the controller reached
+ *                        the target
+ * @return    true if the fader is settled
+ */
+bool SettleDetector_update(SettleDetector_structTd* Detector, int32_t Target, int32_t Sample, bool SetpointAtTarget);
+
+/**
+ * @brief     Set the detector active and restart the settle count.
+ * @param     Detector    pointer to the settle detector structure
+ * @return    none
+ */
+void SettleDetector_reset(SettleDetector_structTd* Detector);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the state of the detector.
+ * @param     Detector    pointer to the settle detector structure
+ * @return    current state
+ */
+SettleDetector_State_enumTd SettleDetector_get_State(SettleDetector_structTd* Detector);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "SettleDetector_Header" */
+/**@}*//* end of defgroup "SettleDetector" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_SETTLEDETECTOR_H_ */
@@ -0,0 +1,202 @@
+/***************************************************************************//**
+ * @defgroup        StallDetector    Stall detector
+ * @brief           This module detects a blocked fader and backs off the motor
+ *                  power.
+ *
+ * If a fader is blocked mechanically or held without the TSC noticing it,
+ * the controller winds up and drives the motor with full duty. A fader is
+ * stalled, if for a number of samples in a row
+ * - the CCR is at least the duty threshold and
+ * - the position did not move more than the motion band since the first of
+ *   these samples.
+ *
+ * A stall starts the back off: the CCR is limited to the back off CCR (0
+ * stops the motor) for a number of samples. Afterwards the fader tries
+ * again with full power. If it stalls more often in a row than the number
+ * of retries, it fails and stays limited until the target changes. Each
+ * stall is reported once with StallDetector_check_Event(). Any motion
+ * bigger than the motion band with high duty clears the stalls in a row.
+ *
+ * The detector only compares and counts, so it can run with each control
+ * sample of every fader.
+ *
+ * # How to use:
+ * 1. Declare an object of StallDetector_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with StallDetector_init() and set the back off with
+ *    StallDetector_set_Backoff().
+ * 3. Call StallDetector_update() with each new CCR and sample and use the
+ *    returned CCR.
+ * 4. Call StallDetector_reset() if the fader is moved by someone else (e.g.
+ *    touched).
+ *
+ * @defgroup        StallDetector_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      StallDetector
+ * @{
+ *
+ * @addtogroup      StallDetector_Header
+ * @{
+ *
+ * @file            stallDetector.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_STALLDETECTOR_H_
+#define INC_FADER_STALLDETECTOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     States of the stall detector
+ */
+typedef enum
+{
+  STALLDETECTOR_RUNNING,    /**< The fader is driven with full power */
+  STALLDETECTOR_BACKOFF,    /**< The fader stalled, the power is limited
+                                 until the next retry */
+  STALLDETECTOR_FAILED      /**< All retries stalled, the power is limited
+                                 until the target changes */
+}StallDetector_State_enumTd;
+
+/**
+ * @brief     Main structure of the stall detector. Declare one object for
+ *            each fader.
+ */
+typedef struct
+{
+  StallDetector_State_enumTd State;
+  uint16_t  DutyThreshold;  /**< Smallest CCR that counts as high duty */
+  uint16_t  MotionBand;     /**< Largest motion of a stalled fader */
+  uint16_t  Count;          /**< Samples in a row to stall. 0: off */
+  uint16_t  Counter;        /**< Samples in a row that met the conditions */
+  uint16_t  BackoffCCR;     /**< Largest CCR while backing off */
+  uint16_t  BackoffCount;   /**< Samples until the next retry */
+  uint16_t  BackoffCounter; /**< Samples since the stall */
+  uint8_t   Retries;        /**< Retries before the detector fails */
+  uint8_t   Stalls;         /**< Stalls in a row */
+  bool      Event;          /**< true after a stall until it is checked */
+  int32_t   Reference;      /**< Position at the first of the samples */
+  int32_t   Target;         /**< Target when the fader stalled */
+}StallDetector_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the stall detector. It is running afterwards and
+ *            stops the motor for 100 samples after a stall, with 3 retries.
+ * @param     Detector      pointer to the stall detector structure
+ * @param     DutyThreshold smallest CCR (magnitude) that counts as high duty
+ * @param     MotionBand    largest motion in counts of a stalled fader.
+ *                          Choose it a bit bigger than the wiper noise.
+ * @param     Count         number of samples in a row to stall. 0 switches
+ *                          the detector off.
+ * @return    none
+ */
+void StallDetector_init(StallDetector_structTd* Detector, uint16_t DutyThreshold, uint16_t MotionBand, uint16_t Count);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set the back off after a stall.
+ * @param     Detector      pointer to the stall detector structure
+ * @param     BackoffCCR    largest CCR while backing off. 0 stops the motor.
+ * @param     BackoffCount  number of samples until the next retry
+ * @param     Retries       number of retries before the detector fails
+ * @return    none
+ */
+void StallDetector_set_Backoff(StallDetector_structTd* Detector, uint16_t BackoffCCR, uint16_t BackoffCount, uint8_t Retries);
+
+/**
+ * @brief     Set the detector running, clear the stalls in a row and restart
+ *            the count.
+ * @param     Detector    pointer to the stall detector structure
+ * @return    none
+ */
+void StallDetector_reset(StallDetector_structTd* Detector);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the detector with the CCR of the controller and a new
+ *            sample. Only uses integer operations, so it can be called in an
+ *            interrupt.
+ * @param     Detector    pointer to the stall detector structure
+ * @param     CCR         output of the controller. - is down, + is up
+ * @param     Target      final target of the fader. A new target ends the
+ *                        back off and a failed state.
+ * @param     Sample      current position
+ * @return    CCR to drive the motor with (limited while backing off)
+ */
+int StallDetector_update(StallDetector_structTd* Detector, int CCR, int32_t Target, int32_t Sample);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the state of the detector.
+ * @param     Detector    pointer to the stall detector structure
+ * @return    current state
+ */
+StallDetector_State_enumTd StallDetector_get_State(StallDetector_structTd* Detector);
+
+/**
+ * @brief     Check if the fader stalled since the last check. The event is
+ *            cleared.
+ * @param     Detector    pointer to the stall detector structure
+ * @return    true once for each stall
+ */
+bool StallDetector_check_Event(StallDetector_structTd* Detector);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "StallDetector_Header" */
+/**@}*//* end of defgroup "StallDetector" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_STALLDETECTOR_H_ */
@@ -55,6 +55,7 @@ void TSC_IRQHandler(void);
 void DMA1_Channel1_IRQHandler(void);
 void DMA1_Channel2_3_IRQHandler(void);
 void ADC1_COMP_IRQHandler(void);
+void TIM6_DAC_IRQHandler(void);
 void SPI1_IRQHandler(void);
 /* USER CODE BEGIN EFP */
 
@@ -0,0 +1,226 @@
+/***************************************************************************//**
+ * @defgroup        TaskScheduler    Task scheduler
+ * @brief           This module replaces the super loop by a cooperative run to
+ *                  completion scheduler with periods, priorities and
+ *                  deadlines.
+ *
+ * Each module registers its update function as a task with a period, a
+ * relative deadline and a priority. A task is released once per period. Of
+ * all released tasks, the task with the highest priority (lowest number) runs
+ * first. Tasks with the same priority run earliest deadline first. A task is
+ * never interrupted by another task, so it should return quickly. Interrupts
+ * are not affected (e.g. the control timer of the faders).
+ *
+ * For each task the scheduler records:
+ * - the number of runs,
+ * - the last, longest and total execution time,
+ * - the overruns: the task finished after its deadline,
+ * - the skipped releases: the task was not started within its period.
+ *
+ * If no task is released, the CPU sleeps (WFI) until the next interrupt. The
+ * time base is the timer service (see @ref TimerService). Its interrupt wakes
+ * the CPU up at least once per timer period, so a release is late by one
+ * timer period at most. The load is the time spent in tasks and can be read
+ * at run time.
+ *
+ * # How to use:
+ * 1. Initialize the time base with TimerService_init().
+ * 2. Initialize the scheduler with TaskScheduler_init().
+ * 3. Declare an object of TaskScheduler_Task_structTd for each task and add
+ *    it with TaskScheduler_add_Task().
+ * 4. Call TaskScheduler_run() instead of the while loop. It does not return.
+ *    Or call TaskScheduler_run_Once() in your own loop.
+ * 5. Read the statistics with TaskScheduler_get_Statistics() and the load
+ *    with TaskScheduler_get_LoadPermille() (e.g. in the debugger).
+ *
+ * @defgroup        TaskScheduler_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      TaskScheduler
+ * @{
+ *
+ * @addtogroup      TaskScheduler_Header
+ * @{
+ *
+ * @file            taskScheduler.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_TASKSCHEDULER_H_
+#define INC_FADER_TASKSCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l0xx_hal.h"
+#include "timerService.h"
+
+/***************************************************************************//**
+ * @name      Settings
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Maximum number of tasks
+ */
+#define TASKSCHEDULER_MAX_TASKS   8
+
+/** @} ************************************************************************/
+/* end of name "Settings"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Function of a task
+ * @param     Context   pointer given to TaskScheduler_add_Task()
+ */
+typedef void (*TaskScheduler_Function_fpTd)(void* Context);
+
+/**
+ * @brief     Statistics of a task. Times in microseconds.
+ */
+typedef struct
+{
+  uint32_t  Runs;           /**< Number of runs */
+  uint32_t  Overruns;       /**< Runs that finished after the deadline */
+  uint32_t  Skipped;        /**< Releases that were not started in time */
+  uint32_t  LastUs;         /**< Execution time of the last run */
+  uint32_t  MaxUs;          /**< Longest execution time */
+  uint64_t  TotalUs;        /**< Sum of all execution times */
+}TaskScheduler_Stats_structTd;
+
+/**
+ * @brief     Task. Declare one object for each task.
+ */
+typedef struct
+{
+  const char* Name;         /**< Name for debugging */
+  TaskScheduler_Function_fpTd Function; /**< Called when released */
+  void*     Context;        /**< Passed to the function */
+  uint32_t  PeriodUs;       /**< Period. 0: released again after each run */
+  uint32_t  DeadlineUs;     /**< Deadline after the release */
+  uint8_t   Priority;       /**< 0 is the highest priority */
+  uint32_t  ReleaseUs;      /**< Time of the next release */
+  TaskScheduler_Stats_structTd Stats; /**< Statistics */
+}TaskScheduler_Task_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the scheduler. All tasks are removed.
+ * @param     Sleep     true: sleep (WFI) if no task is released
+ * @return    none
+ */
+void TaskScheduler_init(bool Sleep);
+
+/**
+ * @brief     Add a task. It is released the first time right away.
+ * @param     Task        pointer to the task structure
+ * @param     Name        name for debugging
+ * @param     Function    called when the task is released
+ * @param     Context     passed to the function
+ * @param     PeriodUs    period in microseconds. 0 releases the task again
+ *                        after each run, so the CPU never sleeps.
+ * @param     DeadlineUs  deadline after the release in microseconds. 0: the
+ *                        period is the deadline.
+ * @param     Priority    0 is the highest priority
+ * @return    false if there is no space for another task
+ */
+bool TaskScheduler_add_Task(TaskScheduler_Task_structTd* Task, const char* Name, TaskScheduler_Function_fpTd Function, void* Context, uint32_t PeriodUs, uint32_t DeadlineUs, uint8_t Priority);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Clear the statistics of all tasks and the load.
+ * @param     none
+ * @return    none
+ */
+void TaskScheduler_reset_Statistics(void);
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Run the released task with the highest priority. Sleep, if no
+ *            task is released (and sleep is enabled).
+ * @param     none
+ * @return    true if a task was run
+ */
+bool TaskScheduler_run_Once(void);
+
+/**
+ * @brief     Run the scheduler forever. Use it instead of the while loop.
+ * @param     none
+ * @return    none
+ */
+void TaskScheduler_run(void);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the statistics of a task.
+ * @param     Task      pointer to the task structure
+ * @return    pointer to the statistics
+ */
+const TaskScheduler_Stats_structTd* TaskScheduler_get_Statistics(TaskScheduler_Task_structTd* Task);
+
+/**
+ * @brief     Get the load since the last reset of the statistics: the time
+ *            spent in tasks (including interrupts during the tasks). The
+ *            elapsed time is summed up in 64 bit in each run, so the load
+ *            stays valid after the wrap of the time base (71 min) without
+ *            a reset.
+ * @param     none
+ * @return    load in permille
+ */
+uint16_t TaskScheduler_get_LoadPermille(void);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "TaskScheduler_Header" */
+/**@}*//* end of defgroup "TaskScheduler" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_TASKSCHEDULER_H_ */
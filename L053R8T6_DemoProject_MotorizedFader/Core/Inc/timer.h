@@ -16,15 +16,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "stm32l0xx_hal.h"
+#include "timerService.h"
 
 /**
  * @name		Structure of a Timer
  * @brief		The user has to declare an object of this structure for each timer.
  */
 typedef struct {
-	unsigned long int now;		/**<HAL_GetTick will be stored here */
-	unsigned long int old;		/**<HAL_GetTick from previous cycle will be stored here */
-	uint16_t threshold;				/**<Threshold of the timer in MS is stored here */
+	uint32_t now;							/**<TimerService_get_TimeUs will be stored here */
+	uint32_t old;							/**<TimerService_get_TimeUs from previous cycle will be stored here */
+	uint32_t threshold;				/**<Threshold of the timer in US is stored here */
 }Timer_structTd;
 
 /**
@@ -36,10 +37,9 @@ typedef struct {
  * 	2. Set the threshold time (The rest of the structure will be set to 0 here)
  * 	3. Check it the timer is elapsed. The Timer will automatically restart if the function returns true.
  *
- * 	@note		This timer is based on the HAL_GetTick() function. It this function is not setup to milliseconds,
- * 					the threshold will have an other unit.
- * 					HAL-Standard is in milliseconds. Only modify this if a smaller interval than milliseconds is needed
- * 					as it my require a deeper dive to the HAL-Drivers.
+ * 	@note		This timer is based on TimerService_get_TimeUs(). Without a hardware time base
+ * 					(see TimerService_init()) it falls back to HAL_GetTick(), so thresholds below one
+ * 					millisecond need the time base.
  *
  * @{
  */
@@ -53,6 +53,15 @@ typedef struct {
  */
 void Timer_set_ThresholdInMs(Timer_structTd* timer, uint32_t threshold);
 
+/**
+ * @brief		Set the threshold time in microseconds here
+ *
+ * @param 	timer: Pointer to the Timer Object of the user
+ * @param		threshold: Threshold time in US
+ * @return  none
+ */
+void Timer_set_ThresholdInUs(Timer_structTd* timer, uint32_t threshold);
+
 /**
  * @brief		Check the timer state. Returns true and restarts timer if timer elapsed.
  *
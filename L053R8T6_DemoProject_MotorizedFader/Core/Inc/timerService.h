@@ -0,0 +1,286 @@
+/***************************************************************************//**
+ * @defgroup        TimerService    Timer service
+ * @brief           This module offers a microsecond time base and software
+ *                  timers on a hierarchical timer wheel, shared by all
+ *                  modules.
+ *
+ * # Time base
+ * A hardware timer that counts microseconds is extended to 32 bit in its
+ * update interrupt. TimerService_get_TimeUs() returns the time with 1 us
+ * resolution and wraps after about 71 min. The control timer of the faders
+ * can be used (it counts microseconds anyway), or any free timer that is
+ * set up as free running with ARR = 0xFFFF. Without timer, the time base
+ * falls back to HAL_GetTick() * 1000 (1 ms resolution).
+ *
+ * # Timer wheel
+ * Software timers are sorted into a wheel of @ref TIMERSERVICE_LEVELS
+ * levels with @ref TIMERSERVICE_SLOTS slots each. A slot of level 0 is one
+ * tick (@ref TIMERSERVICE_TICK_US), a slot of level 1 holds the timers of
+ * 16 ticks and so on. Start and stop are O(1), independent of the number of
+ * timers. Each tick only looks at one slot. Timers of the higher levels
+ * move down one level when the lower level wraps (cascade), so each timer
+ * is moved at most once per level.
+ *
+ * An elapsed timer sets its flag and calls its callback (if any). Periodic
+ * timers restart without drift. The callbacks run in the context of
+ * TimerService_update(), usually the main loop.
+ *
+ * # How to use:
+ * 1. Set up the hardware timer in Cube MX (see TimerService_init()).
+ * 2. Initialize the time base with TimerService_init() and start the
+ *    timer with its update interrupt (once, see TimerService_init()).
+ * 3. Call TimerService_manage_Interrupt() in HAL_TIM_PeriodElapsedCallback().
+ * 4. Declare an object of TimerService_Timer_structTd for each timer and
+ *    start it with TimerService_start_Periodic() or
+ *    TimerService_start_Once().
+ * 5. Call TimerService_update() in the while loop. It reads the time base
+ *    once and expires all due timers.
+ * 6. Check the flag with TimerService_check_Elapsed() or use the callback.
+ *
+ * @warning   Start and stop timers only in the context of
+ *            TimerService_update() (main loop), not in interrupts. The flags
+ *            can be read anywhere.
+ *
+ * @defgroup        TimerService_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      TimerService
+ * @{
+ *
+ * @addtogroup      TimerService_Header
+ * @{
+ *
+ * @file            timerService.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_TIMERSERVICE_H_
+#define INC_FADER_TIMERSERVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l0xx_hal.h"
+
+/***************************************************************************//**
+ * @name      Settings
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Length of one tick of the timer wheel in microseconds. Shortest
+ *            period and resolution of the software timers.
+ */
+#define TIMERSERVICE_TICK_US      100
+
+/**
+ * @brief     Number of bits of the slot index of one level
+ */
+#define TIMERSERVICE_SLOT_BITS    4
+
+/**
+ * @brief     Number of slots of one level
+ */
+#define TIMERSERVICE_SLOTS        (1 << TIMERSERVICE_SLOT_BITS)
+
+/**
+ * @brief     Number of levels. 4 levels of 16 slots cover 65536 ticks
+ *            (6.5 s with 100 us). Longer timers wait in the last level and
+ *            are sorted again when it cascades.
+ */
+#define TIMERSERVICE_LEVELS       4
+
+/** @} ************************************************************************/
+/* end of name "Settings"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Callback of an elapsed timer
+ * @param     Context   pointer given to the start function
+ */
+typedef void (*TimerService_Callback_fpTd)(void* Context);
+
+/**
+ * @brief     Software timer. Declare one object for each timer.
+ */
+typedef struct TimerService_Timer_struct
+{
+  struct TimerService_Timer_struct* Next; /**< Next timer in the slot */
+  struct TimerService_Timer_struct* Prev; /**< Previous timer in the slot */
+  uint32_t  Expiry;         /**< Tick of the next expiry */
+  uint32_t  PeriodTicks;    /**< Period in ticks. 0: one shot */
+  TimerService_Callback_fpTd Callback;  /**< Called when elapsed. NULL: flag
+                                             only */
+  void*     Context;        /**< Passed to the callback */
+  volatile bool Elapsed;    /**< true after expiry until it is checked */
+  bool      Running;        /**< true while the timer is in the wheel */
+  uint8_t   Level;          /**< Level of the wheel while running */
+  uint8_t   Slot;           /**< Slot of the level while running */
+}TimerService_Timer_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Use a hardware timer as time base. The timer is only linked,
+ *            start it once with HAL_TIM_Base_Start_IT() after all modules
+ *            that use its interrupt are initialized. The control timer of
+ *            the faders is started by MotorizedFader_start_All().
+ *
+ * # How to setup the timer in CubeMX (as tested):
+ * - Prescaler: TimerClock / 1 MHz - 1 (e.g. 32-1 at 32 MHz), so it counts
+ *   microseconds
+ * - Counter Mode: Up
+ * - Counter Period: any, e.g. 65536-1 for a free running timer. The
+ *   control timer of the faders (333-1) can be shared.
+ * - NVIC: update interrupt enabled
+ *
+ * @param     htim      pointer to the HAL-handle of the timer. NULL uses
+ *                      HAL_GetTick() instead.
+ * @return    none
+ */
+void TimerService_init(TIM_HandleTypeDef* htim);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Timers
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Start (or restart) a periodic timer. The flag is cleared.
+ * @param     Timer     pointer to the timer structure
+ * @param     PeriodUs  period in microseconds, rounded up to ticks
+ * @param     Callback  called each period. NULL: flag only.
+ * @param     Context   passed to the callback
+ * @return    none
+ */
+void TimerService_start_Periodic(TimerService_Timer_structTd* Timer, uint32_t PeriodUs, TimerService_Callback_fpTd Callback, void* Context);
+
+/**
+ * @brief     Start (or restart) a one shot timer. The flag is cleared.
+ * @param     Timer     pointer to the timer structure
+ * @param     DelayUs   delay in microseconds, rounded up to ticks
+ * @param     Callback  called once. NULL: flag only.
+ * @param     Context   passed to the callback
+ * @return    none
+ */
+void TimerService_start_Once(TimerService_Timer_structTd* Timer, uint32_t DelayUs, TimerService_Callback_fpTd Callback, void* Context);
+
+/**
+ * @brief     Stop a timer. Does nothing if it is not running.
+ * @param     Timer     pointer to the timer structure
+ * @return    none
+ */
+void TimerService_stop(TimerService_Timer_structTd* Timer);
+
+/**
+ * @brief     Check if the timer elapsed since the last check. The flag is
+ *            cleared.
+ * @param     Timer     pointer to the timer structure
+ * @return    true once for each expiry (several expiries between two checks
+ *            count as one)
+ */
+bool TimerService_check_Elapsed(TimerService_Timer_structTd* Timer);
+
+/**
+ * @brief     Check if the timer is running. A one shot timer stops when it
+ *            elapsed.
+ * @param     Timer     pointer to the timer structure
+ * @return    true while the timer is running
+ */
+bool TimerService_check_Running(TimerService_Timer_structTd* Timer);
+
+/** @} ************************************************************************/
+/* end of name "Timers"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Advance the timer wheel to the current time and expire all due
+ *            timers. Call it in the while loop.
+ * @param     none
+ * @return    none
+ */
+void TimerService_update(void);
+
+/**
+ * @brief     Call this function in HAL_TIM_PeriodElapsedCallback(). It
+ *            extends the time base, other timers are ignored.
+ * @param     htim      pointer to the HAL-handle of the elapsed timer
+ * @return    none
+ */
+void TimerService_manage_Interrupt(TIM_HandleTypeDef* htim);
+
+/**
+ * @brief     Call this function if the counter of the time base was reset
+ *            without update interrupt, e.g. by a forced update event after a
+ *            prescaler change (see ClockProfile_TimerRestartCallback()). The
+ *            time the counter had counted is added to the base. Call it with
+ *            interrupts disabled, other timers are ignored.
+ * @param     htim      pointer to the HAL-handle of the timer
+ * @param     ElapsedUs time the counter counted since its last update event
+ * @return    none
+ */
+void TimerService_manage_CounterReset(TIM_HandleTypeDef* htim, uint32_t ElapsedUs);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the time of the time base. Can be called in interrupts with
+ *            lower priority than the time base interrupt.
+ * @param     none
+ * @return    time since start in microseconds (wraps after about 71 min)
+ */
+uint32_t TimerService_get_TimeUs(void);
+
+/**
+ * @brief     Get the number of running timers.
+ * @param     none
+ * @return    number of timers in the wheel
+ */
+uint16_t TimerService_get_RunningTimers(void);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "TimerService_Header" */
+/**@}*//* end of defgroup "TimerService" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_TIMERSERVICE_H_ */
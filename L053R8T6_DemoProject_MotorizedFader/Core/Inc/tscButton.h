@@ -12,12 +12,35 @@
  *    documentation for a more detailed explanation)
  * 5. Initialize start conditions with TSCButton_init_GeneralStartConditions()
  * 4. Setup TSCButton_manage_Interrupt()
- * 5. call TSCButton_updateAll() periodical in the main while loop
+ * 5. call TSCButton_updateAll() periodical in the main while loop, together
+ *    with TimerService_update() (the discharge time of the sampling
+ *    capacitors runs on a timer of the @ref TimerService "timer service")
  * 6. use get functions to read the states.
  *
  * @note  TSCButton_init_GeneralStartConditions() must be the last thing
  *        to initialize before starting to update!
  *
+ * # Parallel acquisition:
+ * The TSC samples one IO of each group at the same time. TSCButton_start_All()
+ * packs the buttons into acquisitions with at most one button per group. Each
+ * acquisition reads the values of all its groups at once. So a full update of
+ * all buttons takes as many acquisitions as the largest number of buttons in
+ * one group (1 - 3), not one acquisition per button. Place the buttons of
+ * different faders in different groups to keep the touch latency low.
+ *
+ * # Adaptive touch detection:
+ * With TSCButton_init_Adaptive() the fixed threshold is replaced:
+ * - A slow baseline follows the released value (temperature, humidity). It
+ *   is only updated while the button is released and the value is close to
+ *   the baseline, so a finger is not learned into the baseline.
+ * - Touch: The raw value is below the baseline by the touch delta for
+ *   ConfirmCount acquisitions in a row. The smooth value is not used, so a
+ *   touch is detected after ConfirmCount acquisitions.
+ * - Release: The raw value is less than the release delta below the baseline
+ *   for ConfirmCount acquisitions in a row (hysteresis).
+ * - TSCButton_get_Confidence() returns how far the value is on the way to
+ *   the touch delta.
+ *
  * # Hardware requirements:
  * - use a serial 10k resistor for each touch line
  * - use a Sampling Capacitor in the range of 22-200nF
@@ -47,7 +70,7 @@
 #define INC_TSC_BUTTON_H_MN
 
 #include "stm32l0xx_hal.h"
-#include "timer.h"
+#include "timerService.h"
 #include <stdbool.h>
 
 /**
@@ -57,8 +80,21 @@
 #define NUM_TSC_GROUPS  8   /**< Number of available TSC groups */
 #define NUM_FREE_IOS    3   /**< 3 because 1 is used by sampling capacitor. */
 #define MAX_TSC_BUTTONS (NUM_TSC_GROUPS * NUM_FREE_IOS)
-#define TSC_NUM_SAMPLES 50  /**< Number of values stored to calculate a
-                                 smooth value */
+
+/**
+ * @brief     Weight of a new sample for the smooth value is
+ *            1 / 2^TSC_SMOOTH_SHIFT. The exponential moving average needs no
+ *            sample array, which saves RAM with many buttons. 5 smooths about
+ *            as much as an average of the last 50 samples.
+ */
+#define TSC_SMOOTH_SHIFT  5
+
+/**
+ * @brief     Weight of a new sample for the adaptive baseline is
+ *            1 / 2^TSC_BASELINE_SHIFT. With 2 - 3 ms per acquisition the
+ *            baseline follows within a few seconds.
+ */
+#define TSC_BASELINE_SHIFT  10
 
 /***************************************************************************//**
  * @name      Structures and Enumerations
@@ -75,12 +111,20 @@ typedef struct
   TSC_HandleTypeDef*      htsc;
   TSC_IOConfigTypeDef     ioConfigTsc;
   TSCButton_State_enumTd  state;
-  uint32_t  Samples[TSC_NUM_SAMPLES];
-  uint8_t   SamplesIndex;
+  uint32_t  SmoothAccu;     /**< Smooth value, shifted by
+                                 @ref TSC_SMOOTH_SHIFT */
   uint32_t  SmoothValue;
   uint32_t  RawValue;
   uint16_t  threshold;
   uint32_t  TSCGroup;
+
+  uint32_t  Baseline;       /**< Adaptive baseline, shifted by
+                                 @ref TSC_BASELINE_SHIFT */
+  uint16_t  TouchDelta;     /**< Adaptive detection off if 0 */
+  uint16_t  ReleaseDelta;
+  uint8_t   ConfirmCount;
+  uint8_t   ConfirmCounter; /**< Acquisitions in a row with changed state */
+  uint8_t   Confidence;     /**< 0 - 100 % of the touch delta */
 }TSCButton_structTd;
 
 /** @} ************************************************************************/
@@ -152,6 +196,24 @@ void TSCButton_init_TSC(TSCButton_structTd* tsc, TSC_HandleTypeDef* htsc, uint32
  */
 void TSCButton_init_Threshold(TSCButton_structTd* tsc, uint16_t value);
 
+/**
+ * @brief     Use the adaptive baseline instead of the fixed threshold.
+ * @note      How to evaluate proper values:
+ *            1. Read the raw value when touched and when released.
+ *            2. Choose a touch delta of about half the difference and a
+ *               release delta of about half the touch delta.
+ *            The baseline starts with the first sample, so do not touch the
+ *            button while starting.
+ * @param     tsc           pointer to the users tsc structure
+ * @param     TouchDelta    drop below the baseline to detect a touch
+ * @param     ReleaseDelta  drop below the baseline to detect a release.
+ *                          Must be smaller than TouchDelta.
+ * @param     ConfirmCount  number of acquisitions in a row to change the
+ *                          state (1 - 255)
+ * @return    none
+ */
+void TSCButton_init_Adaptive(TSCButton_structTd* tsc, uint16_t TouchDelta, uint16_t ReleaseDelta, uint8_t ConfirmCount);
+
 /**
  * @brief     Setup the discharge time in ms, that is required to discharge the
  *            sensing capacitor. Depending
@@ -175,9 +237,10 @@ void TSCButton_init_DischargeTimeMsAll(uint8_t value);
  ******************************************************************************/
 
 /**
- * @brief     This function sets the module to start conditions.
+ * @brief     This function sets the module to start conditions and packs
+ *            all initialized buttons into parallel acquisitions.
  * @note      This function must be called once before updating and after
- *            initialization.
+ *            initialization. All buttons must use the same TSC handle.
  * @param     none
  * @return    none
  */
@@ -240,6 +303,23 @@ uint32_t TSCButton_get_RawValue(TSCButton_structTd* tsc);
  */
 uint32_t TSCButton_get_SmoothValue(TSCButton_structTd* tsc);
 
+/**
+ * @brief     Call this function to get the current baseline of a Button.
+ *            Only available with adaptive detection.
+ * @param     tsc       pointer to the users tsc structure
+ * @return    baseline value (released value)
+ */
+uint32_t TSCButton_get_Baseline(TSCButton_structTd* tsc);
+
+/**
+ * @brief     Call this function to get the touch confidence of a Button.
+ *            Only available with adaptive detection.
+ * @param     tsc       pointer to the users tsc structure
+ * @return    drop below the baseline in percent of the touch delta
+ *            (0 - 100). 100 means the value is at or behind the touch delta.
+ */
+uint8_t TSCButton_get_Confidence(TSCButton_structTd* tsc);
+
 /** @} ************************************************************************/
 /* end of name "Get Functions"
  ******************************************************************************/
@@ -7,11 +7,23 @@
  *
  * # How to use:
  *  1.  Initialize @ref Initialize "ADC and hysteresis"
- *  2.  Setup interrupt function
+ *  2.  Setup interrupt functions
  *  3.  Start all wipers (this starts the ADC)
  *  4.  Update wipers regularly in While loop.
  *  5.  get values with get functions
  *
+ * # Acquisition modes
+ * The mode is selected with the DMA mode of the ADC in Cube MX (see
+ * Wiper_init_ADC()):
+ * - DMA Normal: The ADC converts one scan over all channels. The new samples
+ *   are filtered in Wiper_update_All() and the next scan is started there. The
+ *   sample rate depends on the speed of the while loop.
+ * - DMA Circular: The ADC converts continuously into a double buffer of
+ *   @ref WIPER_DMA_NUM_SCANS scans. The half and full transfer interrupts
+ *   filter the samples of the finished half, so the CPU never restarts the
+ *   ADC. Combined with the hardware oversampler of the ADC, every sample is
+ *   already an average of many conversions.
+ *
  *  # Tip
  *  This module can also be used for regular potentiometers as they work with
  *  the same concept!
@@ -38,6 +50,8 @@
 #define INC_FADER_WIPER_H_MN
 
 #include "stm32l0xx_hal.h"
+#include "wiperFilter.h"
+#include "profiler.h"
 #include <stdbool.h>
 
 /**
@@ -52,11 +66,12 @@
 #define NUM_ALL_ADC_ON_MCU 1
 
 /**
- * @brief			Define for the number of sampled values. If the smooth value
- * 						is not clean enough, increase this number. Be careful that the
- * 						ADC does not get to slow by using to many samples.
+ * @brief     Number of scans in the DMA buffer if the DMA runs in circular
+ *            mode. Must be even, as the buffer is split in two halves. Each
+ *            half transfer interrupt filters WIPER_DMA_NUM_SCANS / 2 scans.
+ *            Increase it to reduce the interrupt rate.
  */
-#define NUMBER_OF_SAMPLES 100
+#define WIPER_DMA_NUM_SCANS 2
 
 /***************************************************************************//**
  * @name			Structures
@@ -69,8 +84,7 @@ typedef struct Wiper_structTd
 {
   uint16_t  ValueSmooth;								/**<	Current smoothed ADC value */
   uint16_t  ValueRaw;                   /**<  Current raw value of the ADC */
-  uint16_t  Samples[NUMBER_OF_SAMPLES];	/**<	Array of measured ADC values.*/
-  uint8_t   SamplesIndex;								/**<	Counter for measured ADC values.*/
+  WiperFilter_structTd Filter;          /**<  Filter to smooth the ADC values */
   uint8_t   Hyst_Threshold;             /**<  Hysteresis Value Range for both
                                               directions. */
   uint16_t  Hyst_NumSmallerValues;      /**<  Counter for values inside the
@@ -116,22 +130,35 @@ typedef struct Wiper_structTd
  *    - Resolution:                       ADC 12-bit resolution
  *    - Data Alignment:                   Right alignment
  *    - Scan Direction:                   Forward
- *    - Continuous Conversation Mode:     Disabled (ADC will be triggered in
+ *    - Continuous Conversation Mode:     Enabled (circular DMA with software
+ *                                        start) or Disabled (PWM triggered or
+ *                                        normal DMA, ADC will be triggered in
  *                                        the update function of this module)
  *    - Discontinuous Conversation Mode:  Disabled
- *    - DMA Continuous Requests:          Disabled
+ *    - DMA Continuous Requests:          Enabled (circular DMA) or Disabled
+ *                                        (normal DMA)
  *    - End Of Conversion Selection:      End of single conversion
- *    - Overrun behaviour:                Overrun data preserved
+ *    - Overrun behaviour:                Overrun data overwritten (circular
+ *                                        DMA) or preserved (normal DMA)
  *    - Low Power Auto Wait:              Disabled
  *    - Low Frequency Mode:               Disabled
  *    - Auto Off:                         Disabled
- *    - Oversampling Mode:                Disabled
+ *    - Oversampling Mode:                Enabled (circular DMA, recommended)
+ *      - Oversampling Ratio:             64 (software start) or 8 (PWM
+ *                                        triggered)
+ *      - Oversampling Right Shift:       6 or 3 (result stays 12 bit)
+ *      - Triggered Oversampling Mode:    Single trigger (software start) or
+ *                                        Multi trigger (PWM triggered, each
+ *                                        conversion waits for its trigger)
  *
  *  - ADC_REGULAR_ConversionMode
  *    - Sampling Time:                    3.5 Cycles
  *    - External Trigger Conversion Source: Regular Conversion launched by
- *                                          software.
- *    - External Trigger Conversion Edge: None
+ *                                          software, or by the compare event
+ *                                          of the PWM timer (e.g. Timer 2
+ *                                          Capture Compare 4 event), see
+ *                                          MotorizedFader_init_ADCTrigger()
+ *    - External Trigger Conversion Edge: None (software) or Rising edge
  *  - WatchDog: Disable
  *
  * - NVIC Settings
@@ -144,7 +171,7 @@ typedef struct Wiper_structTd
  *  - Direction:    Peripheral To Memory
  *  - Priority:     Medium
  *  - DMA Request Settings:
- *    - Mode:                 Normal
+ *    - Mode:                 Circular (recommended) or Normal
  *    - Increment Address:    Memory
  *    - Data Width:           Half Word (because we use 12bit ADC)
  *
@@ -168,6 +195,19 @@ void Wiper_init_ADC(Wiper_structTd* Wiper, ADC_HandleTypeDef* hadc);
  */
 void Wiper_init_Hysteresis(Wiper_structTd* Wiper);
 
+/**
+ * @brief     Select the filter used to smooth the ADC values. For details look
+ *            at the @ref WiperFilter "wiper filter module".
+ *
+ * Default: WIPERFILTER_BOX with Shift = WIPERFILTER_BOX_MAX_SHIFT
+ *
+ * @param     Wiper     pointer to the users wiper structure
+ * @param     Type      of the filter
+ * @param     Shift     depth of the filter, see WiperFilter_init()
+ * @return    none
+ */
+void Wiper_init_Filter(Wiper_structTd* Wiper, WiperFilter_Type_enumTd Type, uint8_t Shift);
+
 /** @} ************************************************************************/
 /* end of name "Initialize"
  ******************************************************************************/
@@ -187,8 +227,8 @@ void Wiper_init_Hysteresis(Wiper_structTd* Wiper);
  *    - HCLK (if it can be changed without affecting other components) and / or
  *      Prescaler to reduce clock of ADC
  *    - Sampling Time
- * 2. Change define of @ref NUMBER_OF_SAMPLES until value is closer to the
- *    preferred result
+ * 2. Change the filter type and depth with Wiper_init_Filter() until the
+ *    value is closer to the preferred result
  * 3. Change hysteresis threshold to reduce noise
  * 4. Change deviation threshold to get closer to the exact value inside the
  *    hysteresis range.
@@ -227,6 +267,19 @@ void Wiper_calibrate_HysteresisThreshold(Wiper_structTd* Wiper, uint8_t Threshol
  */
 void Wiper_calibrate_HysteresisDeviationThreshold(Wiper_structTd* Wiper, uint8_t Threshold);
 
+/**
+ * @brief     Calibrate the speed influence of the one euro filter. Only used
+ *            with WIPERFILTER_ONEEURO. For details look at
+ *            WiperFilter_set_Beta().
+ *
+ * Default: 256
+ *
+ * @param     Wiper     pointer to the users wiper structure
+ * @param     Beta      speed influence
+ * @return    none
+ */
+void Wiper_calibrate_FilterBeta(Wiper_structTd* Wiper, uint16_t Beta);
+
 /** @} ************************************************************************/
 /* end of name "Calibrate"
  ******************************************************************************/
@@ -256,7 +309,8 @@ void Wiper_update_All(void);
 
 /**
  * @brief			Call this function in the HAL-Interrupt handler to set an internal
- * 						interrupt flag for the wiper module.
+ * 						interrupt flag for the wiper module. If the DMA runs in circular
+ * 						mode, the samples of the second buffer half are filtered here.
  *
  * Here is an example:
  * @code
@@ -272,6 +326,24 @@ void Wiper_update_All(void);
  */
 void Wiper_manage_Interrupt(ADC_HandleTypeDef* hadc);
 
+/**
+ * @brief			Call this function in the HAL half transfer interrupt handler. It
+ *            is only needed if the DMA runs in circular mode.
+ *
+ * Here is an example:
+ * @code
+ * void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+ * {
+ *   Wiper_manage_HalfInterrupt(hadc);
+ * }
+ * @endcode
+ *
+ * @param		  hadc			pointer to the HAL generated ADC-handle of the ADC
+ * 											that is used for the wiper
+ * @return		none
+ */
+void Wiper_manage_HalfInterrupt(ADC_HandleTypeDef* hadc);
+
 /** @} ************************************************************************/
 /* end of name "Process ADC"
  ******************************************************************************/
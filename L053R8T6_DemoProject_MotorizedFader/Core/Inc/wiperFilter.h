@@ -0,0 +1,219 @@
+/***************************************************************************//**
+ * @defgroup        WiperFilter   Wiper filter
+ * @brief           This module offers different filters to smooth the ADC
+ *                  values of a wiper. All filters need constant calculation
+ *                  time for each new sample (no loop over all samples) and
+ *                  only a few bytes of RAM.
+ *
+ * # Available filters:
+ * - @ref WIPERFILTER_BOX "Box": Average of the last 2^Shift samples. A running
+ *   sum is used, so only the oldest sample is subtracted and the newest one is
+ *   added. Shift can be up to @ref WIPERFILTER_BOX_MAX_SHIFT.
+ * - @ref WIPERFILTER_EMA "EMA": Exponential moving average. The weight of the
+ *   new sample is 1/2^Shift, so only shifts are used. Shift can be up to
+ *   @ref WIPERFILTER_MAX_SHIFT (also Median and One Euro). Needs only 4 bytes of
+ *   state and has the least lag for the same noise reduction.
+ * - @ref WIPERFILTER_MEDIAN "Median": Median of the last
+ *   @ref WIPERFILTER_MEDIAN_SIZE samples followed by the EMA. Use this if
+ *   single samples are disturbed (e.g. by motor switching spikes).
+ * - @ref WIPERFILTER_ONEEURO "One Euro": Adaptive EMA. If the wiper does not
+ *   move, the weight of the new sample is 1/2^Shift (strong smoothing). If it
+ *   moves, the weight grows with the speed, so the filter has almost no lag
+ *   while the fader moves. Tune the speed influence with
+ *   WiperFilter_set_Beta().
+ *
+ * # How to use:
+ * 1. Declare an object of WiperFilter_structTd (usually done by the wiper
+ *    module).
+ * 2. Initialize it with WiperFilter_init().
+ * 3. Call WiperFilter_update() for each new sample. It returns the filtered
+ *    value.
+ *
+ * @defgroup        WiperFilter_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      WiperMotorFader
+ * @{
+ *
+ * @addtogroup      WiperFilter
+ * @{
+ *
+ * @addtogroup      WiperFilter_Header
+ * @{
+ *
+ * @file            wiperFilter.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_WIPERFILTER_H_
+#define INC_FADER_WIPERFILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Largest shift of all filters. A 12 bit sample shifted by 16
+ *            still fits into the 32 bit accumulators and the one euro
+ *            weight 2^16 >> 16 is not 0.
+ */
+#define WIPERFILTER_MAX_SHIFT       16
+
+/**
+ * @brief     Largest shift for the box filter. The box filter needs
+ *            2^WIPERFILTER_BOX_MAX_SHIFT samples of RAM for each wiper.
+ */
+#define WIPERFILTER_BOX_MAX_SHIFT   4
+
+/**
+ * @brief     Number of samples for the median filter. Must be odd.
+ */
+#define WIPERFILTER_MEDIAN_SIZE     5
+
+/**
+ * @brief     Shift of the EMA used to smooth the speed of the one euro filter.
+ */
+#define WIPERFILTER_ONEEURO_SPEED_SHIFT   3
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Available filter types
+ */
+typedef enum
+{
+  WIPERFILTER_BOX,          /**< Running sum over 2^Shift samples */
+  WIPERFILTER_EMA,          /**< Exponential moving average 1/2^Shift */
+  WIPERFILTER_MEDIAN,       /**< Median of WIPERFILTER_MEDIAN_SIZE + EMA */
+  WIPERFILTER_ONEEURO       /**< Speed adaptive EMA */
+}WiperFilter_Type_enumTd;
+
+/**
+ * @brief     State of the box filter
+ */
+typedef struct
+{
+  uint16_t  Samples[1 << WIPERFILTER_BOX_MAX_SHIFT];  /**< Last samples */
+  uint32_t  Sum;                                      /**< Sum of all samples */
+}WiperFilter_Box_structTd;
+
+/**
+ * @brief     State of the median filter
+ */
+typedef struct
+{
+  uint16_t  Samples[WIPERFILTER_MEDIAN_SIZE]; /**< Last samples */
+  uint32_t  Accu;                             /**< EMA accumulator (<< Shift) */
+}WiperFilter_Median_structTd;
+
+/**
+ * @brief     State of the one euro filter. Values are Q16.16.
+ */
+typedef struct
+{
+  int32_t   Value;          /**< Filtered value */
+  int32_t   Speed;          /**< Smoothed absolute speed (counts per sample) */
+  uint16_t  PrevSample;     /**< Previous sample to calculate the speed */
+  uint16_t  Beta;           /**< Increase of the weight per count/sample of
+                                 speed in 1/65536 */
+}WiperFilter_OneEuro_structTd;
+
+/**
+ * @brief     Main structure of a filter. Only the state of the used filter
+ *            type needs RAM, as all states share the same memory.
+ */
+typedef struct
+{
+  WiperFilter_Type_enumTd Type;   /**< Used filter type */
+  uint8_t   Shift;                /**< Filter depth (see filter types) */
+  uint8_t   Index;                /**< Index of the oldest sample */
+  bool      Started;              /**< false until the first sample arrived */
+  union
+  {
+    WiperFilter_Box_structTd      Box;
+    uint32_t                      EMAAccu;  /**< EMA accumulator (<< Shift) */
+    WiperFilter_Median_structTd   Median;
+    WiperFilter_OneEuro_structTd  OneEuro;
+  }State;                         /**< State of the used filter type */
+}WiperFilter_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the filter
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the filter with type and depth. The filter starts with
+ *            the first sample, so there is no ramp up from 0.
+ * @param     Filter    pointer to the filter structure
+ * @param     Type      of the filter
+ * @param     Shift     depth of the filter. Box: 2^Shift samples (limited to
+ *                      @ref WIPERFILTER_BOX_MAX_SHIFT). EMA, Median and
+ *                      One Euro: weight of a new sample is 1/2^Shift
+ *                      (limited to @ref WIPERFILTER_MAX_SHIFT).
+ * @return    none
+ */
+void WiperFilter_init(WiperFilter_structTd* Filter, WiperFilter_Type_enumTd Type, uint8_t Shift);
+
+/**
+ * @brief     Set the speed influence of the one euro filter.
+ *
+ * Default: 256
+ *
+ * @param     Filter    pointer to the filter structure
+ * @param     Beta      increase of the weight of a new sample for each count
+ *                      per sample of wiper speed, in 1/65536. Bigger values
+ *                      reduce the lag while moving, but let more noise pass.
+ * @return    none
+ */
+void WiperFilter_set_Beta(WiperFilter_structTd* Filter, uint16_t Beta);
+
+/**
+ * @brief     Reset the filter. The next sample starts the filter again.
+ * @param     Filter    pointer to the filter structure
+ * @return    none
+ */
+void WiperFilter_reset(WiperFilter_structTd* Filter);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use this function to filter new samples
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Add a new sample to the filter and calculate the filtered value.
+ * @param     Filter    pointer to the filter structure
+ * @param     Sample    new ADC sample
+ * @return    filtered value
+ */
+uint16_t WiperFilter_update(WiperFilter_structTd* Filter, uint16_t Sample);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "WiperFilter_Header" */
+/**@}*//* end of defgroup "WiperFilter" */
+/**@}*//* end of defgroup "WiperMotorFader" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_WIPERFILTER_H_ */
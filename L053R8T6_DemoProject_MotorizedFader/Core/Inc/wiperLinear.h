@@ -0,0 +1,260 @@
+/***************************************************************************//**
+ * @defgroup        WiperLinear   Wiper linearization
+ * @brief           This module measures the curve of a fader track with a
+ *                  motor sweep and corrects the wiper values with a
+ *                  piecewise linear lookup table.
+ *
+ * The resistance of a fader track does not change linearly with the travel
+ * and the curve differs from fader to fader. The wiper value is therefore
+ * not the real position of the knob.
+ *
+ * # Calibration sweep
+ * The motor moves the fader with a constant CCR, so the knob moves with
+ * about constant speed and the time is a measure for the travel. Friction
+ * that changes along the travel changes the speed and bends the table. The
+ * caller can add a friction feed-forward to the returned CCR (the motorized
+ * fader module does, if its friction model is calibrated):
+ * 1. Move to the bottom until the fader stopped.
+ * 2. Move up until the fader stopped. Store the time when the wiper value
+ *    passes each point of the table.
+ * 3. Move down the same way.
+ *
+ * The travel of each point is its time relative to the start and the end of
+ * the sweep. Both directions are averaged, so a different speed up and down
+ * cancels out.
+ *
+ * # Lookup table
+ * The table has @ref WIPERLINEAR_NUM_POINTS points in a distance of
+ * 2^@ref WIPERLINEAR_SEGMENT_SHIFT wiper counts. So the segment of a value is
+ * found with a shift and the interpolation needs only one multiplication and
+ * no division (O(1)). A second table with the same layout stores the inverse
+ * curve, which converts positions back to wiper values (e.g. targets).
+ * Without calibration both conversions return the value unchanged.
+ *
+ * # How to use:
+ * 1. Declare an object of WiperLinear_structTd (usually done by the
+ *    motorized fader module).
+ * 2. Initialize it with WiperLinear_init().
+ * 3. Start the calibration with WiperLinear_start_Calibration() and call
+ *    WiperLinear_update_Calibration() with a fixed rate. Use its return
+ *    value as CCR for the motor, until the state is
+ *    @ref WIPERLINEAR_CALIBRATED.
+ * 4. Convert wiper values with WiperLinear_convert_RawToLinear() and
+ *    positions with WiperLinear_convert_LinearToRaw().
+ *
+ * @defgroup        WiperLinear_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      WiperMotorFader
+ * @{
+ *
+ * @addtogroup      WiperLinear
+ * @{
+ *
+ * @addtogroup      WiperLinear_Header
+ * @{
+ *
+ * @file            wiperLinear.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef INC_FADER_WIPERLINEAR_H_
+#define INC_FADER_WIPERLINEAR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Distance of two points of the table as power of 2 (wiper
+ *            counts). 8 means 256 counts, 16 segments for 12 bit.
+ */
+#define WIPERLINEAR_SEGMENT_SHIFT     8
+
+/**
+ * @brief     Largest wiper value (12 bit ADC).
+ */
+#define WIPERLINEAR_MAX_VALUE         4095
+
+/**
+ * @brief     Number of points of the table.
+ */
+#define WIPERLINEAR_NUM_POINTS        (((WIPERLINEAR_MAX_VALUE + 1) >> WIPERLINEAR_SEGMENT_SHIFT) + 1)
+
+/**
+ * @brief     Distance the fader has to move to detect the start of a sweep.
+ */
+#define WIPERLINEAR_MOVE_THRESHOLD    8
+
+/**
+ * @brief     Smaller changes of the wiper value are treated as noise.
+ */
+#define WIPERLINEAR_NOISE_THRESHOLD   2
+
+/**
+ * @brief     The fader stopped, if it did not move further for this time.
+ */
+#define WIPERLINEAR_STOP_US           30000
+
+/**
+ * @brief     Longest time for each part of the sweep. Make sure it is
+ *            shorter than 65535 samples.
+ */
+#define WIPERLINEAR_TIMEOUT_US        5000000
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     States of the linearization
+ */
+typedef enum
+{
+  WIPERLINEAR_UNCALIBRATED, /**< No table available, values are unchanged */
+  WIPERLINEAR_HOME,         /**< Calibration: move to the bottom */
+  WIPERLINEAR_SWEEP_UP,     /**< Calibration: move up and store the times */
+  WIPERLINEAR_SWEEP_DOWN,   /**< Calibration: move down and store the
+                                 times */
+  WIPERLINEAR_CALIBRATED,   /**< Table is available */
+  WIPERLINEAR_FAILED        /**< Calibration failed or aborted */
+}WiperLinear_State_enumTd;
+
+/**
+ * @brief     Main structure of the linearization. The user has to declare
+ *            one object for each fader.
+ */
+typedef struct
+{
+  volatile WiperLinear_State_enumTd State; /**< Current state. Set last, as
+                                              the calibration is updated in
+                                              an interrupt. */
+
+  /** Position of each wiper value point (time of the up sweep while
+      calibrating) */
+  uint16_t  ToLinear[WIPERLINEAR_NUM_POINTS];
+  /** Wiper value of each position point (time of the down sweep while
+      calibrating) */
+  uint16_t  ToRaw[WIPERLINEAR_NUM_POINTS];
+
+  int32_t   SweepCCR;       /**< CCR of the sweep */
+  uint32_t  SampleTimeUs;   /**< Time between two updates (us) */
+  uint32_t  Ticks;          /**< Samples in the current state */
+  uint32_t  StartTick;      /**< Sample where the sweep started moving */
+  uint32_t  LastMoveTick;   /**< Sample where the fader moved last */
+  uint16_t  UpStart;        /**< Start of the up sweep */
+  uint16_t  UpEnd;          /**< End of the up sweep */
+  int32_t   RestPosition;   /**< Position before the sweep */
+  int32_t   Extreme;        /**< Furthest position in sweep direction */
+  uint8_t   Next;           /**< Next point to pass */
+  bool      Started;        /**< true after the sweep started moving */
+}WiperLinear_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and calibrate the table
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the linearization. It is uncalibrated afterwards, so
+ *            all values are unchanged.
+ * @param     Linear    pointer to the linearization structure
+ * @return    none
+ */
+void WiperLinear_init(WiperLinear_structTd* Linear);
+
+/**
+ * @brief     Start the calibration sweep. The old table is not used anymore.
+ * @param     Linear      pointer to the linearization structure
+ * @param     SweepCCR    CCR of the sweep. Choose it a bit bigger than the
+ *                        friction, so the fader moves slow but steady.
+ * @param     SampleTime  time between two updates in microseconds
+ * @return    none
+ */
+void WiperLinear_start_Calibration(WiperLinear_structTd* Linear, int32_t SweepCCR, uint32_t SampleTime);
+
+/**
+ * @brief     Stop a running calibration. The state is set to
+ *            @ref WIPERLINEAR_FAILED.
+ * @param     Linear    pointer to the linearization structure
+ * @return    none
+ */
+void WiperLinear_abort(WiperLinear_structTd* Linear);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calibrate and convert values
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Update the calibration sweep with a new sample. Call this
+ *            function with the sample time while the calibration is running.
+ *            It only uses integer operations and can be used inside an
+ *            interrupt.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Sample    current wiper value
+ * @return    CCR for the motor. Positive values move up, negative down.
+ */
+int32_t WiperLinear_update_Calibration(WiperLinear_structTd* Linear, int32_t Sample);
+
+/**
+ * @brief     Convert a wiper value to the linear position.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Raw       wiper value
+ * @return    linear position (0 - @ref WIPERLINEAR_MAX_VALUE)
+ */
+uint16_t WiperLinear_convert_RawToLinear(WiperLinear_structTd* Linear, uint16_t Raw);
+
+/**
+ * @brief     Convert a linear position to the wiper value.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Position  linear position
+ * @return    wiper value (0 - @ref WIPERLINEAR_MAX_VALUE)
+ */
+uint16_t WiperLinear_convert_LinearToRaw(WiperLinear_structTd* Linear, uint16_t Position);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the linearization
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the state of the linearization.
+ * @param     Linear    pointer to the linearization structure
+ * @return    state
+ */
+WiperLinear_State_enumTd WiperLinear_get_State(WiperLinear_structTd* Linear);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "WiperLinear_Header" */
+/**@}*//* end of defgroup "WiperLinear" */
+/**@}*//* end of defgroup "WiperMotorFader" */
+/**@}*//* end of defgroup "MotorFader" */
+
+#endif /* INC_FADER_WIPERLINEAR_H_ */
@@ -54,6 +54,46 @@ void MotorDriver_init_PWM(TB6612FNGMotorDriver_structTd* Motor, TIM_HandleTypeDe
   Motor->channel = Channel;
 }
 
+/* Description in .h */
+uint32_t MotorDriver_init_PWMCarrier(TIM_HandleTypeDef* htim, uint32_t TimerClockHz, uint32_t CarrierHz, bool Ultrasonic)
+{
+  uint32_t Resolution = 0;
+
+  /** @internal     1.  Raise the carrier out of the audible range if
+   *                    required */
+  if(Ultrasonic == true && CarrierHz < MOTORDRIVER_ULTRASONIC_HZ)
+  {
+    CarrierHz = MOTORDRIVER_ULTRASONIC_HZ;
+  }
+
+  /** @internal     2.  Resolution with prescaler 0, limited to the 16 bit
+   *                    ARR. A carrier of 0 gets the lowest frequency. */
+  Resolution = (CarrierHz == 0) ? 0x10000UL : TimerClockHz / CarrierHz;
+  if(Resolution < 2)
+  {
+    Resolution = 2;
+  }
+  else if(Resolution > 0x10000UL)
+  {
+    Resolution = 0x10000UL;
+  }
+
+  /** @internal     3.  Set prescaler and ARR and generate an update event,
+   *                    so the preloaded values are taken immediately */
+  __HAL_TIM_SET_PRESCALER(htim, 0);
+  __HAL_TIM_SET_AUTORELOAD(htim, Resolution - 1);
+  HAL_TIM_GenerateEvent(htim, TIM_EVENTSOURCE_UPDATE);
+
+  return Resolution;
+}
+
+/* Description in .h */
+void MotorDriver_init_Dither(TB6612FNGMotorDriver_structTd* Motor, uint8_t Bits)
+{
+  Motor->DitherBits = (Bits > MOTORDRIVER_DITHER_BITS_MAX) ? MOTORDRIVER_DITHER_BITS_MAX : Bits;
+  Motor->DitherAccu = 0;
+}
+
 /** @} ************************************************************************/
 /* end of name "Initialize"
  ******************************************************************************/
@@ -68,10 +108,9 @@ void MotorDriver_init_PWM(TB6612FNGMotorDriver_structTd* Motor, TIM_HandleTypeDe
 /* Description in .h */
 void MotorDriver_start_PWM(TB6612FNGMotorDriver_structTd* Motor)
 {
-  TIM_HandleTypeDef* htim = Motor->htim;
-  uint16_t channel = Motor->channel;
-
-  HAL_TIM_PWM_Start_IT(htim, channel);
+  /** @internal     1.  Start the PWM. The output compare preload is already
+   *                    set by HAL_TIM_PWM_ConfigChannel(). */
+  HAL_TIM_PWM_Start_IT(Motor->htim, Motor->channel);
 }
 
 /** @} ************************************************************************/
@@ -87,52 +126,61 @@ void MotorDriver_start_PWM(TB6612FNGMotorDriver_structTd* Motor)
 
 /** @cond *//* Function Prototypes */
 void writePin_In1In2STBY(TB6612FNGMotorDriver_structTd* Motor, GPIO_PinState StateIn1, GPIO_PinState StateIn2, GPIO_PinState StateSTBY);
+void write_DitheredCCR(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine);
 /** @endcond *//* Function Prototypes */
 
 /* Description in .h */
 void MotorDriver_move_ClockWise(TB6612FNGMotorDriver_structTd* Motor, uint16_t CCR)
+{
+  /** @internal     1.  Move with a fine CCR without fractional part. The
+   *                    remainder of the dither is kept. */
+  MotorDriver_move_ClockWiseFine(Motor, (uint32_t)CCR << Motor->DitherBits);
+}
+
+/* Description in .h */
+void MotorDriver_move_CounterClockWise(TB6612FNGMotorDriver_structTd* Motor, uint16_t CCR)
+{
+  /** @internal     1.  Move with a fine CCR without fractional part. The
+   *                    remainder of the dither is kept. */
+  MotorDriver_move_CounterClockWiseFine(Motor, (uint32_t)CCR << Motor->DitherBits);
+}
+
+/* Description in .h */
+void MotorDriver_move_ClockWiseFine(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine)
 {
   TB6612FNGMotorDriver_enums CurrentMode = Motor->Mode;
-  uint16_t OldCCR = Motor->CCR;
 
   /** @internal     1.  If motor is not in CW mode, set the pins as required by
-   *                    @ref TB6612FNG_Datasheet "Datasheet" for CW mode. */
+   *                    @ref TB6612FNG_Datasheet "Datasheet" for CW mode. The
+   *                    remainder of the other direction is dropped. */
   if(CurrentMode != MOTORDRIVER_DIRECTION_CW)
   {
     writePin_In1In2STBY(Motor, GPIO_PIN_SET, GPIO_PIN_RESET, GPIO_PIN_SET);
     Motor->Mode = MOTORDRIVER_DIRECTION_CW;
+    Motor->DitherAccu = 0;
   }
 
-  /** @internal     2.  If CCR changed, set the new CCR value to the DMA
-   *                    buffer. */
-  if(CCR != OldCCR)
-  {
-    __HAL_TIM_SetCompare(Motor->htim, Motor->channel, CCR);
-    Motor->CCR = CCR;
-  }
+  /** @internal     2.  Write the dithered CCR */
+  write_DitheredCCR(Motor, CCRFine);
 }
 
 /* Description in .h */
-void MotorDriver_move_CounterClockWise(TB6612FNGMotorDriver_structTd* Motor, uint16_t CCR)
+void MotorDriver_move_CounterClockWiseFine(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine)
 {
   TB6612FNGMotorDriver_enums CurrentMode = Motor->Mode;
-  uint16_t OldCCR = Motor->CCR;
 
   /** @internal     1.  If motor is not in CCW mode, set the pins as required by
-   *                    @ref TB6612FNG_Datasheet "Datasheet" for CCW mode. */
+   *                    @ref TB6612FNG_Datasheet "Datasheet" for CCW mode. The
+   *                    remainder of the other direction is dropped. */
   if(CurrentMode != MOTORDRIVER_DIRECTION_CCW)
   {
     writePin_In1In2STBY(Motor, GPIO_PIN_RESET, GPIO_PIN_SET, GPIO_PIN_SET);
     Motor->Mode = MOTORDRIVER_DIRECTION_CCW;
+    Motor->DitherAccu = 0;
   }
 
-  /** @internal     2.  If CCR changed, set the new CCR value to the DMA
-   *                    buffer. */
-  if(CCR != OldCCR)
-  {
-    __HAL_TIM_SetCompare(Motor->htim, Motor->channel, CCR);
-    Motor->CCR = CCR;
-  }
+  /** @internal     2.  Write the dithered CCR */
+  write_DitheredCCR(Motor, CCRFine);
 }
 
 /* Description in .h */
@@ -196,6 +244,43 @@ void writePin_In1In2STBY(TB6612FNGMotorDriver_structTd* Motor, GPIO_PinState Sta
   HAL_GPIO_WritePin(Motor->GPIOIn2, Motor->PinIn2, StateIn2);
   HAL_GPIO_WritePin(Motor->GPIOSTBY, Motor->PinSTBY, StateSTBY);
 }
+
+/**
+ * @brief     Helper function to write the CCR of a fine CCR. First order
+ *            sigma-delta: the fractional part is added to the remainder of
+ *            the last write, a carry increases the CCR by one step. The fine
+ *            CCR is limited to ARR first: a CCR above ARR gives full duty
+ *            anyway and its remainder would be lost.
+ * @param     Motor     pointer to the users motor structure of the motor used
+ *                      with this IC.
+ * @param     CCRFine   CCR << dither bits plus the fractional part
+ * @return    none
+ */
+void write_DitheredCCR(TB6612FNGMotorDriver_structTd* Motor, uint32_t CCRFine)
+{
+  uint8_t Bits = Motor->DitherBits;
+  uint32_t CCRFineMax = (uint32_t)__HAL_TIM_GET_AUTORELOAD(Motor->htim) << Bits;
+
+  /** @internal     1.  Limit the fine CCR to ARR. With the remainder added,
+   *                    the CCR is at most ARR. */
+  if(CCRFine > CCRFineMax)
+  {
+    CCRFine = CCRFineMax;
+  }
+  uint32_t Sum = CCRFine + Motor->DitherAccu;
+  uint32_t CCR = Sum >> Bits;
+
+  /** @internal     2.  Keep the fractional part for the next write */
+  Motor->DitherAccu = (uint16_t)(Sum - (CCR << Bits));
+
+  /** @internal     3.  If CCR changed, write it to the preloaded compare
+   *                    register */
+  if(CCR != Motor->CCR)
+  {
+    __HAL_TIM_SetCompare(Motor->htim, Motor->channel, CCR);
+    Motor->CCR = (uint16_t)CCR;
+  }
+}
 /** @} ************************************************************************/
 /* end of name "Control"
  ******************************************************************************/
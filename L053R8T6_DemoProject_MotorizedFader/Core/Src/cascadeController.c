@@ -0,0 +1,306 @@
+/***************************************************************************//**
+ * @defgroup        CascadeController_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      CascadeController
+ * @{
+ *
+ * @addtogroup      CascadeController_Source
+ * @{
+ *
+ * @file            cascadeController.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <cascadeController.h>
+#include <math.h>
+
+/**
+ * @brief     Value of 1.0 in the fixed-point format of this module.
+ */
+#define CASCADECONTROLLER_Q_ONE   ((int32_t)1 << CASCADECONTROLLER_Q_SHIFT)
+
+/**
+ * @brief     Default position weight of the estimator.
+ */
+#define CASCADECONTROLLER_ALPHA   0.25
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void convert_CascadeCoefficients(CascadeController_structTd* Controller);
+int32_t convert_DoubleToQ16(double Value);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void CascadeController_init(CascadeController_structTd* Controller)
+{
+  Controller->PositionGain = 0;
+  Controller->VelocityKp = 0;
+  Controller->VelocityKi = 0;
+  Controller->MaxVelocity = 0;
+  Controller->SampleTimeUs = 0;
+  Controller->OutputMax = 0;
+  CascadeController_set_Estimator(Controller, CASCADECONTROLLER_ALPHA, 0);
+  CascadeController_reset(Controller);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void CascadeController_set_Gains(CascadeController_structTd* Controller, double PositionGain, double VelocityKp, double VelocityKi, uint32_t MaxVelocity)
+{
+  Controller->PositionGain = PositionGain;
+  Controller->VelocityKp = VelocityKp;
+  Controller->VelocityKi = VelocityKi;
+  Controller->MaxVelocity = MaxVelocity;
+  convert_CascadeCoefficients(Controller);
+}
+
+/* Description in .h */
+void CascadeController_set_Estimator(CascadeController_structTd* Controller, double Alpha, double Beta)
+{
+  Controller->Alpha = Alpha;
+  Controller->Beta = (Beta > 0) ? Beta : (Alpha * Alpha) / (2.0 - Alpha);
+  convert_CascadeCoefficients(Controller);
+}
+
+/* Description in .h */
+void CascadeController_set_OutputMax(CascadeController_structTd* Controller, int32_t Max)
+{
+  Controller->OutputMax = Max * CASCADECONTROLLER_Q_ONE;
+}
+
+/* Description in .h */
+void CascadeController_set_SampleTimeInUs(CascadeController_structTd* Controller, uint32_t SampleTime)
+{
+  Controller->SampleTimeUs = SampleTime;
+  convert_CascadeCoefficients(Controller);
+}
+
+/* Description in .h */
+void CascadeController_reset(CascadeController_structTd* Controller)
+{
+  Controller->Started = false;
+  Controller->Position = 0;
+  Controller->Velocity = 0;
+  Controller->ITerm = 0;
+  Controller->Output = 0;
+}
+
+/**
+ * @brief     Convert the users double values to the fixed-point coefficients
+ *            used in CascadeController_calculate(). The gains are given per
+ *            ms, so the sample time is combined with them here.
+ * @param     Controller  pointer to the controller structure
+ * @return    none
+ */
+void convert_CascadeCoefficients(CascadeController_structTd* Controller)
+{
+  double SampleTime = (double)Controller->SampleTimeUs / 1000.0;
+
+  /** @internal     1.  Position loop: velocity per sample per count */
+  Controller->CoeffPosition = convert_DoubleToQ16(Controller->PositionGain * SampleTime);
+
+  /** @internal     2.  Velocity loop: the velocity is per sample, so Kp is
+   *                    divided by the sample time. The summed velocity error
+   *                    per sample already is velocity * time. */
+  Controller->CoeffVelocityP = (SampleTime > 0) ? convert_DoubleToQ16(Controller->VelocityKp / SampleTime) : 0;
+  Controller->CoeffVelocityI = convert_DoubleToQ16(Controller->VelocityKi);
+
+  /** @internal     3.  Velocity limit per sample */
+  Controller->VelocityLimit = convert_DoubleToQ16((double)Controller->MaxVelocity * SampleTime / 1000.0);
+
+  /** @internal     4.  Estimator weights */
+  Controller->CoeffAlpha = convert_DoubleToQ16(Controller->Alpha);
+  Controller->CoeffBeta = convert_DoubleToQ16(Controller->Beta);
+}
+
+/**
+ * @brief     Convert a double value to Q16.16 with rounding.
+ * @param     Value   to convert
+ * @return    fixed-point value
+ */
+int32_t convert_DoubleToQ16(double Value)
+{
+  return (int32_t)round(Value * (double)CASCADECONTROLLER_Q_ONE);
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void update_CascadeEstimator(CascadeController_structTd* Controller, int32_t Sample);
+int32_t multiply_Q16(int32_t Coefficient, int32_t Value);
+int32_t limit_CascadeValue(int32_t Value, int32_t Limit);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int CascadeController_calculate(CascadeController_structTd* Controller, int32_t Setpoint, int32_t SetpointVelocity, int32_t Sample)
+{
+  /** @internal     1.  Update position and velocity with the raw sample */
+  update_CascadeEstimator(Controller, Sample);
+
+  /** @internal     2.  Position loop: feed forward plus position error,
+   *                    limited to the largest velocity */
+  int32_t PositionError = Setpoint * CASCADECONTROLLER_Q_ONE - Controller->Position;
+  int32_t VelocityCommand = SetpointVelocity + multiply_Q16(Controller->CoeffPosition, PositionError);
+  if(Controller->VelocityLimit > 0)
+  {
+    VelocityCommand = limit_CascadeValue(VelocityCommand, Controller->VelocityLimit);
+  }
+
+  /** @internal     3.  Velocity loop: P-Term and I-Term. The I-Term only
+   *                    grows if the output is not saturated in the same
+   *                    direction (anti wind-up). */
+  int32_t VelocityError = VelocityCommand - Controller->Velocity;
+  int32_t PTerm = limit_CascadeValue(multiply_Q16(Controller->CoeffVelocityP, VelocityError), INT32_MAX / 4);
+  int32_t ITerm = Controller->ITerm + multiply_Q16(Controller->CoeffVelocityI, VelocityError);
+  ITerm = limit_CascadeValue(ITerm, Controller->OutputMax);
+  int32_t Output = PTerm + ITerm;
+  if((Output > Controller->OutputMax && ITerm > Controller->ITerm)
+     || (Output < -Controller->OutputMax && ITerm < Controller->ITerm))
+  {
+    ITerm = Controller->ITerm;
+    Output = PTerm + ITerm;
+  }
+  Controller->ITerm = ITerm;
+
+  /** @internal     4.  Limit and round the output */
+  Output = limit_CascadeValue(Output, Controller->OutputMax);
+  if(Output >= 0)
+  {
+    Controller->Output = (Output + CASCADECONTROLLER_Q_ONE / 2) >> CASCADECONTROLLER_Q_SHIFT;
+  }
+  else
+  {
+    Controller->Output = -((-Output + CASCADECONTROLLER_Q_ONE / 2) >> CASCADECONTROLLER_Q_SHIFT);
+  }
+  return Controller->Output;
+}
+
+/**
+ * @brief     Update the alpha-beta estimator. The first sample starts it at
+ *            rest.
+ * @param     Controller  pointer to the controller structure
+ * @param     Sample      raw position sample
+ * @return    none
+ */
+void update_CascadeEstimator(CascadeController_structTd* Controller, int32_t Sample)
+{
+  int32_t Measured = Sample * CASCADECONTROLLER_Q_ONE;
+
+  /** @internal     1.  Start at the first sample */
+  if(Controller->Started == false)
+  {
+    Controller->Started = true;
+    Controller->Position = Measured;
+    Controller->Velocity = 0;
+    return;
+  }
+
+  /** @internal     2.  Predict with the velocity, correct with the
+   *                    residual */
+  int32_t Predicted = Controller->Position + Controller->Velocity;
+  int32_t Residual = Measured - Predicted;
+  Controller->Position = Predicted + multiply_Q16(Controller->CoeffAlpha, Residual);
+  Controller->Velocity += multiply_Q16(Controller->CoeffBeta, Residual);
+}
+
+/**
+ * @brief     Multiply a Q16.16 coefficient with a Q16.16 value.
+ * @param     Coefficient Q16.16 coefficient
+ * @param     Value       Q16.16 value
+ * @return    Q16.16 product, limited to 32 bit
+ */
+int32_t multiply_Q16(int32_t Coefficient, int32_t Value)
+{
+  int64_t Product = ((int64_t)Coefficient * Value) >> CASCADECONTROLLER_Q_SHIFT;
+  if(Product > INT32_MAX)
+  {
+    return INT32_MAX;
+  }
+  if(Product < -INT32_MAX)
+  {
+    return -INT32_MAX;
+  }
+  return (int32_t)Product;
+}
+
+/**
+ * @brief     Limit a value to -Limit..Limit.
+ * @param     Value   to limit
+ * @param     Limit   positive limit
+ * @return    limited value
+ */
+int32_t limit_CascadeValue(int32_t Value, int32_t Limit)
+{
+  if(Value > Limit)
+  {
+    return Limit;
+  }
+  if(Value < -Limit)
+  {
+    return -Limit;
+  }
+  return Value;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+int32_t CascadeController_get_Position(CascadeController_structTd* Controller)
+{
+  return Controller->Position >> CASCADECONTROLLER_Q_SHIFT;
+}
+
+/* Description in .h */
+int32_t CascadeController_get_Velocity(CascadeController_structTd* Controller)
+{
+  return Controller->Velocity;
+}
+
+/* Description in .h */
+int CascadeController_get_Output(CascadeController_structTd* Controller)
+{
+  return Controller->Output;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "CascadeController_Source" */
+/**@}*//* end of defgroup "CascadeController" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,247 @@
+/***************************************************************************//**
+ * @defgroup        FaderEvents_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FaderEvents
+ * @{
+ *
+ * @addtogroup      FaderEvents_Source
+ * @{
+ *
+ * @file            faderEvents.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <faderEvents.h>
+#include <stdlib.h>
+
+/**
+ * @brief     Mask to wrap the ring buffer indices.
+ */
+#define FADEREVENTS_INDEX_MASK    (FADEREVENTS_BUFFER_SIZE - 1)
+
+/**
+ * @brief     Largest velocity shift.
+ */
+#define FADEREVENTS_MAX_SHIFT     8
+
+/**
+ * @brief     Shortest time between two updates used for the velocity. With
+ *            this limit the raw velocity fits into 32 bit.
+ */
+#define FADEREVENTS_MIN_DELTA_US  64
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void FaderEvents_init_Queue(FaderEvents_Queue_structTd* Queue)
+{
+  Queue->Head = 0;
+  Queue->Tail = 0;
+  Queue->Overflows = 0;
+  Queue->LatencyMaxUs = 0;
+}
+
+/* Description in .h */
+void FaderEvents_init_Tracker(FaderEvents_Tracker_structTd* Tracker, uint16_t Resolution, uint8_t VelocityShift)
+{
+  Tracker->Resolution = Resolution;
+  Tracker->VelocityShift = (VelocityShift > FADEREVENTS_MAX_SHIFT) ? FADEREVENTS_MAX_SHIFT : VelocityShift;
+  Tracker->Started = false;
+  Tracker->Touched = false;
+  Tracker->LastPosition = 0;
+  Tracker->ReportedPosition = 0;
+  Tracker->LastTimeUs = 0;
+  Tracker->Velocity = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void update_EventsVelocity(FaderEvents_Tracker_structTd* Tracker, uint16_t Position, uint32_t TimeUs);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void FaderEvents_update_Tracker(FaderEvents_Queue_structTd* Queue, FaderEvents_Tracker_structTd* Tracker, uint8_t Fader, uint16_t Position, bool Touched, uint32_t TimeUs)
+{
+  /** @internal     1.  Leave if the events of this fader are switched off */
+  if(Tracker->Resolution == 0)
+  {
+    return;
+  }
+
+  /** @internal     2.  The first update only stores the start values */
+  if(Tracker->Started == false)
+  {
+    Tracker->Started = true;
+    Tracker->Touched = Touched;
+    Tracker->LastPosition = Position;
+    Tracker->ReportedPosition = Position;
+    Tracker->LastTimeUs = TimeUs;
+    Tracker->Velocity = 0;
+    return;
+  }
+
+  /** @internal     3.  Update the filtered velocity */
+  update_EventsVelocity(Tracker, Position, TimeUs);
+
+  /** @internal     4.  Touch and release edges */
+  if(Touched != Tracker->Touched)
+  {
+    Tracker->Touched = Touched;
+    FaderEvents_write_Event(Queue, Tracker, (Touched == true) ? FADEREVENTS_TOUCH : FADEREVENTS_RELEASE, Fader, Position, TimeUs);
+  }
+
+  /** @internal     5.  Position change by the resolution since the last
+   *                    reported position */
+  if(abs((int32_t)Position - (int32_t)Tracker->ReportedPosition) >= Tracker->Resolution)
+  {
+    Tracker->ReportedPosition = Position;
+    FaderEvents_write_Event(Queue, Tracker, FADEREVENTS_POSITION, Fader, Position, TimeUs);
+  }
+}
+
+/**
+ * @brief     Update the filtered velocity with the change since the last
+ *            update. The raw velocity is delta * (10^6 / time), so no
+ *            64 bit operation is needed.
+ * @param     Tracker   pointer to the tracker structure
+ * @param     Position  current position
+ * @param     TimeUs    current time in microseconds
+ * @return    none
+ */
+void update_EventsVelocity(FaderEvents_Tracker_structTd* Tracker, uint16_t Position, uint32_t TimeUs)
+{
+  uint32_t DeltaTime = TimeUs - Tracker->LastTimeUs;
+  int32_t DeltaPosition = (int32_t)Position - (int32_t)Tracker->LastPosition;
+
+  /** @internal     1.  Keep the velocity if no time passed */
+  if(DeltaTime == 0)
+  {
+    Tracker->LastPosition = Position;
+    return;
+  }
+
+  /** @internal     2.  Raw velocity in counts per second. Updates slower
+   *                    than 1 s count as 1 s. */
+  if(DeltaTime < FADEREVENTS_MIN_DELTA_US)
+  {
+    DeltaTime = FADEREVENTS_MIN_DELTA_US;
+  }
+  int32_t Rate = (DeltaTime < 1000000) ? (int32_t)(1000000 / DeltaTime) : 1;
+  int32_t Raw = DeltaPosition * Rate;
+
+  /** @internal     3.  Exponential moving average. The shift is done on the
+   *                    magnitude, so it rounds the same for both directions. */
+  int32_t Difference = Raw - Tracker->Velocity;
+  if(Difference >= 0)
+  {
+    Tracker->Velocity += Difference >> Tracker->VelocityShift;
+  }
+  else
+  {
+    Tracker->Velocity -= (-Difference) >> Tracker->VelocityShift;
+  }
+
+  Tracker->LastPosition = Position;
+  Tracker->LastTimeUs = TimeUs;
+}
+
+/* Description in .h */
+void FaderEvents_write_Event(FaderEvents_Queue_structTd* Queue, FaderEvents_Tracker_structTd* Tracker, FaderEvents_Type_enumTd Type, uint8_t Fader, uint16_t Position, uint32_t TimeUs)
+{
+  uint16_t Head = Queue->Head;
+
+  /** @internal     1.  Drop the event if the queue is full */
+  if((uint16_t)(Head - Queue->Tail) >= FADEREVENTS_BUFFER_SIZE)
+  {
+    Queue->Overflows++;
+    return;
+  }
+
+  /** @internal     2.  Fill the event, then publish it by moving the head */
+  FaderEvents_Event_structTd* Event = &Queue->Events[Head & FADEREVENTS_INDEX_MASK];
+  Event->TimeUs = TimeUs;
+  Event->LatencyUs = 0;
+  Event->Type = Type;
+  Event->Fader = Fader;
+  Event->Position = Position;
+  Event->Velocity = Tracker->Velocity;
+  Queue->Head = Head + 1;
+}
+
+/* Description in .h */
+bool FaderEvents_read_Event(FaderEvents_Queue_structTd* Queue, FaderEvents_Event_structTd* Event, uint32_t TimeUs)
+{
+  uint16_t Tail = Queue->Tail;
+
+  /** @internal     1.  Leave if the queue is empty */
+  if(Tail == Queue->Head)
+  {
+    return false;
+  }
+
+  /** @internal     2.  Copy the event, then free it by moving the tail */
+  *Event = Queue->Events[Tail & FADEREVENTS_INDEX_MASK];
+  Queue->Tail = Tail + 1;
+
+  /** @internal     3.  Measure the latency */
+  Event->LatencyUs = TimeUs - Event->TimeUs;
+  if(Event->LatencyUs > Queue->LatencyMaxUs)
+  {
+    Queue->LatencyMaxUs = Event->LatencyUs;
+  }
+  return true;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+int32_t FaderEvents_get_Velocity(FaderEvents_Tracker_structTd* Tracker)
+{
+  return Tracker->Velocity;
+}
+
+/* Description in .h */
+uint32_t FaderEvents_get_Overflows(FaderEvents_Queue_structTd* Queue)
+{
+  return Queue->Overflows;
+}
+
+/* Description in .h */
+uint32_t FaderEvents_get_LatencyMaxUs(FaderEvents_Queue_structTd* Queue)
+{
+  return Queue->LatencyMaxUs;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderEvents_Source" */
+/**@}*//* end of defgroup "FaderEvents" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,256 @@
+/***************************************************************************//**
+ * @defgroup        FaderHaptics_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FaderHaptics
+ * @{
+ *
+ * @addtogroup      FaderHaptics_Source
+ * @{
+ *
+ * @file            faderHaptics.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <faderHaptics.h>
+#include <stdlib.h>
+#include <math.h>
+
+/**
+ * @brief     Value of 1.0 in the fixed-point format of this module.
+ */
+#define FADERHAPTICS_Q_ONE    ((int32_t)1 << FADERHAPTICS_Q_SHIFT)
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void FaderHaptics_init(FaderHaptics_structTd* Haptics)
+{
+  Haptics->Detents = NULL;
+  Haptics->NumDetents = 0;
+  Haptics->ForceMax = 0;
+  Haptics->SampleTimeUs = 0;
+  FaderHaptics_set_EndStops(Haptics, 0, 0, 0);
+  FaderHaptics_set_Spring(Haptics, 0, 0);
+  FaderHaptics_set_Damping(Haptics, 0);
+  FaderHaptics_reset(Haptics);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+int32_t convert_HapticsCoefficient(double Value);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void FaderHaptics_set_ForceMax(FaderHaptics_structTd* Haptics, uint16_t ForceMax)
+{
+  Haptics->ForceMax = ForceMax;
+}
+
+/* Description in .h */
+void FaderHaptics_set_Detents(FaderHaptics_structTd* Haptics, const FaderHaptics_Detent_structTd* Detents, uint8_t NumDetents)
+{
+  /** @internal     1.  Switch the detents off while the table changes, as
+   *                    the control timer interrupt may read it */
+  Haptics->NumDetents = 0;
+  Haptics->Detents = Detents;
+  Haptics->NumDetents = (Detents != NULL) ? NumDetents : 0;
+}
+
+/* Description in .h */
+void FaderHaptics_set_EndStops(FaderHaptics_structTd* Haptics, uint16_t Low, uint16_t High, double Stiffness)
+{
+  Haptics->EndLow = Low;
+  Haptics->EndHigh = High;
+  Haptics->EndStiffness = Stiffness;
+  Haptics->CoeffEnd = convert_HapticsCoefficient(Stiffness);
+}
+
+/* Description in .h */
+void FaderHaptics_set_Spring(FaderHaptics_structTd* Haptics, uint16_t Target, double Stiffness)
+{
+  Haptics->SpringTarget = Target;
+  Haptics->SpringStiffness = Stiffness;
+  Haptics->CoeffSpring = convert_HapticsCoefficient(Stiffness);
+}
+
+/* Description in .h */
+void FaderHaptics_set_Damping(FaderHaptics_structTd* Haptics, double Damping)
+{
+  double SampleTime = (double)Haptics->SampleTimeUs / 1000.0;
+
+  /** @internal     1.  The velocity is per sample, so the damping per ms is
+   *                    divided by the sample time */
+  Haptics->Damping = Damping;
+  Haptics->CoeffDamping = (SampleTime > 0) ? convert_HapticsCoefficient(Damping / SampleTime) : 0;
+}
+
+/* Description in .h */
+void FaderHaptics_set_SampleTimeInUs(FaderHaptics_structTd* Haptics, uint32_t SampleTime)
+{
+  Haptics->SampleTimeUs = SampleTime;
+  FaderHaptics_set_Damping(Haptics, Haptics->Damping);
+}
+
+/* Description in .h */
+void FaderHaptics_reset(FaderHaptics_structTd* Haptics)
+{
+  Haptics->Started = false;
+  Haptics->Force = 0;
+}
+
+/**
+ * @brief     Convert a double value to a Q16.16 coefficient with rounding.
+ * @param     Value   to convert
+ * @return    fixed-point coefficient
+ */
+int32_t convert_HapticsCoefficient(double Value)
+{
+  return (int32_t)round(Value * (double)FADERHAPTICS_Q_ONE);
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+int32_t calculate_DetentForce(const FaderHaptics_Detent_structTd* Detent, int32_t Position);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int FaderHaptics_calculate(FaderHaptics_structTd* Haptics, int32_t Position)
+{
+  int32_t Force = 0;
+  uint8_t Index = 0;
+
+  /** @internal     1.  Detents (integer CCR) */
+  for(Index = 0; Index < Haptics->NumDetents; Index++)
+  {
+    Force += calculate_DetentForce(&Haptics->Detents[Index], Position);
+  }
+  int64_t ForceQ = (int64_t)Force * FADERHAPTICS_Q_ONE;
+
+  /** @internal     2.  Soft end stops */
+  if(Position < (int32_t)Haptics->EndLow)
+  {
+    ForceQ += (int64_t)Haptics->CoeffEnd * ((int32_t)Haptics->EndLow - Position);
+  }
+  else if(Position > (int32_t)Haptics->EndHigh && Haptics->EndHigh > Haptics->EndLow)
+  {
+    ForceQ -= (int64_t)Haptics->CoeffEnd * (Position - (int32_t)Haptics->EndHigh);
+  }
+
+  /** @internal     3.  Spring to the target */
+  ForceQ += (int64_t)Haptics->CoeffSpring * ((int32_t)Haptics->SpringTarget - Position);
+
+  /** @internal     4.  Damping against the change since the last sample.
+   *                    The first sample after a reset starts at rest. */
+  if(Haptics->Started == true)
+  {
+    ForceQ -= (int64_t)Haptics->CoeffDamping * (Position - Haptics->LastPosition);
+  }
+  Haptics->Started = true;
+  Haptics->LastPosition = Position;
+
+  /** @internal     5.  Limit and round */
+  int64_t LimitQ = (int64_t)Haptics->ForceMax * FADERHAPTICS_Q_ONE;
+  if(ForceQ > LimitQ)
+  {
+    ForceQ = LimitQ;
+  }
+  if(ForceQ < -LimitQ)
+  {
+    ForceQ = -LimitQ;
+  }
+  if(ForceQ >= 0)
+  {
+    Haptics->Force = (int)((ForceQ + FADERHAPTICS_Q_ONE / 2) >> FADERHAPTICS_Q_SHIFT);
+  }
+  else
+  {
+    Haptics->Force = -(int)((-ForceQ + FADERHAPTICS_Q_ONE / 2) >> FADERHAPTICS_Q_SHIFT);
+  }
+  return Haptics->Force;
+}
+
+/**
+ * @brief     Calculate the force of one detent. It pulls to the center,
+ *            rises linearly to the detent force at half the width and falls
+ *            back to 0 at the width.
+ * @param     Detent    pointer to the detent
+ * @param     Position  current position
+ * @return    force (CCR)
+ */
+int32_t calculate_DetentForce(const FaderHaptics_Detent_structTd* Detent, int32_t Position)
+{
+  int32_t Distance = Position - (int32_t)Detent->Position;
+  int32_t Width = Detent->Width;
+  int32_t Half = Width / 2;
+  int32_t Absolute = abs(Distance);
+
+  /** @internal     1.  No force outside of the detent */
+  if(Absolute >= Width || Half == 0)
+  {
+    return 0;
+  }
+
+  /** @internal     2.  Triangle with the peak at half the width */
+  int32_t Force = (Absolute <= Half) ? Absolute : (Width - Absolute);
+  Force = (Force * (int32_t)Detent->Force) / Half;
+
+  /** @internal     3.  Pull to the center */
+  return (Distance > 0) ? -Force : Force;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+bool FaderHaptics_check_Enabled(FaderHaptics_structTd* Haptics)
+{
+  return (Haptics->ForceMax > 0);
+}
+
+/* Description in .h */
+int FaderHaptics_get_Force(FaderHaptics_structTd* Haptics)
+{
+  return Haptics->Force;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderHaptics_Source" */
+/**@}*//* end of defgroup "FaderHaptics" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,481 @@
+/***************************************************************************//**
+ * @defgroup        FrictionModel_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      FrictionModel
+ * @{
+ *
+ * @addtogroup      FrictionModel_Source
+ * @{
+ *
+ * @file            frictionModel.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <frictionModel.h>
+#include <stdlib.h>
+
+/**
+ * @brief     Largest number of measurements per zone. More measurements are
+ *            ignored, so the sums fit into 16 bit for CCRs up to 1023.
+ */
+#define FRICTIONMODEL_MAX_COUNT   64
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and calibrate the model
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void clear_FrictionTables(FrictionModel_structTd* Model);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void FrictionModel_init(FrictionModel_structTd* Model, uint16_t RestBand)
+{
+  Model->State = FRICTIONMODEL_UNCALIBRATED;
+  Model->RestBand = RestBand;
+  Model->Resting = false;
+  Model->Moving = false;
+  clear_FrictionTables(Model);
+}
+
+/* Description in .h */
+void FrictionModel_start_Calibration(FrictionModel_structTd* Model, int32_t MaxCCR, uint32_t SampleTime)
+{
+  /** @internal     1.  Store settings and clear the old values */
+  Model->MaxCCR = MaxCCR;
+  Model->SampleTimeUs = SampleTime;
+  clear_FrictionTables(Model);
+
+  /** @internal     2.  Start with the move to the bottom. The state is set
+   *                    last, as the calibration is updated in an
+   *                    interrupt. */
+  Model->Direction = FRICTIONMODEL_UP;
+  Model->CCR = 0;
+  Model->Ticks = 0;
+  Model->WindowTick = 0;
+  Model->Resting = false;
+  Model->State = FRICTIONMODEL_HOME;
+}
+
+/* Description in .h */
+void FrictionModel_abort(FrictionModel_structTd* Model)
+{
+  FrictionModel_State_enumTd State = Model->State;
+  if(State != FRICTIONMODEL_UNCALIBRATED && State != FRICTIONMODEL_CALIBRATED)
+  {
+    Model->State = FRICTIONMODEL_FAILED;
+  }
+}
+
+/**
+ * @brief     Set all friction values and counters to 0.
+ * @param     Model     pointer to the friction model structure
+ * @return    none
+ */
+void clear_FrictionTables(FrictionModel_structTd* Model)
+{
+  uint8_t Direction = 0;
+  uint8_t Zone = 0;
+  for(Direction = 0; Direction < FRICTIONMODEL_NUM_DIRECTIONS; Direction++)
+  {
+    for(Zone = 0; Zone < FRICTIONMODEL_NUM_ZONES; Zone++)
+    {
+      Model->Breakaway[Direction][Zone] = 0;
+      Model->Coulomb[Direction][Zone] = 0;
+      Model->Count[Direction][Zone] = 0;
+    }
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calibrate and compensate the friction
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+uint32_t convert_FrictionTimeToTicks(FrictionModel_structTd* Model, uint32_t TimeUs);
+void update_FrictionMoving(FrictionModel_structTd* Model, int32_t Sample);
+uint8_t get_FrictionZone(int32_t Sample);
+bool check_FrictionEndReached(FrictionModel_structTd* Model, int32_t Sample);
+void store_FrictionMeasurement(FrictionModel_structTd* Model);
+void finish_FrictionDirection(FrictionModel_structTd* Model);
+bool calculate_FrictionAverages(FrictionModel_structTd* Model);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int32_t FrictionModel_update_Calibration(FrictionModel_structTd* Model, int32_t Sample)
+{
+  int32_t Sign = (Model->Direction == FRICTIONMODEL_UP) ? 1 : -1;
+  int32_t ReturnCCR = 0;
+
+  Model->Ticks++;
+  update_FrictionMoving(Model, Sample);
+
+  switch(Model->State)
+  {
+    /** @internal     1.  Home: move against the sweep direction to the end
+     *                    of the travel */
+    case FRICTIONMODEL_HOME:
+      ReturnCCR = -Sign * (Model->MaxCCR / 2);
+      if(Model->Ticks >= convert_FrictionTimeToTicks(Model, FRICTIONMODEL_HOME_US))
+      {
+        Model->State = FRICTIONMODEL_REST;
+        Model->Ticks = 0;
+      }
+      break;
+
+    /** @internal     2.  Rest: wait until the fader stopped. Finish the
+     *                    direction at the end of the travel, else start the
+     *                    next measurement. */
+    case FRICTIONMODEL_REST:
+      if(Model->Ticks >= convert_FrictionTimeToTicks(Model, FRICTIONMODEL_REST_US))
+      {
+        if(check_FrictionEndReached(Model, Sample) == true)
+        {
+          finish_FrictionDirection(Model);
+        }
+        else
+        {
+          Model->RestPosition = Sample;
+          Model->Zone = get_FrictionZone(Sample);
+          Model->CCR = 0;
+          Model->Ticks = 0;
+          Model->State = FRICTIONMODEL_BREAKAWAY;
+        }
+      }
+      break;
+
+    /** @internal     3.  Breakaway: increase the CCR until the fader moves.
+     *                    If it does not move with the largest CCR, it is
+     *                    blocked at the end of the travel. */
+    case FRICTIONMODEL_BREAKAWAY:
+      if(Model->Ticks >= convert_FrictionTimeToTicks(Model, FRICTIONMODEL_RAMP_UP_US))
+      {
+        Model->CCR++;
+        Model->Ticks = 0;
+      }
+      if(abs(Sample - Model->RestPosition) >= FRICTIONMODEL_MOVE_THRESHOLD)
+      {
+        Model->BreakawayCCR = Model->CCR;
+        Model->Ticks = 0;
+        Model->WindowTick = 0;
+        Model->WindowStart = Sample;
+        Model->Moving = true;
+        Model->State = FRICTIONMODEL_COULOMB;
+      }
+      else if(Model->CCR > Model->MaxCCR)
+      {
+        Model->CCR = 0;
+        finish_FrictionDirection(Model);
+      }
+      ReturnCCR = Sign * Model->CCR;
+      break;
+
+    /** @internal     4.  Coulomb: decrease the CCR until the fader stops.
+     *                    If it reaches the end of the travel before, the
+     *                    measurement is not used. */
+    case FRICTIONMODEL_COULOMB:
+      if(Model->Ticks >= convert_FrictionTimeToTicks(Model, FRICTIONMODEL_RAMP_DOWN_US))
+      {
+        Model->CCR--;
+        Model->Ticks = 0;
+      }
+      if(Model->Moving == false || Model->CCR <= 0)
+      {
+        store_FrictionMeasurement(Model);
+      }
+      if(Model->Moving == false || Model->CCR <= 0 || check_FrictionEndReached(Model, Sample) == true)
+      {
+        Model->CCR = 0;
+        Model->Ticks = 0;
+        Model->State = FRICTIONMODEL_REST;
+      }
+      ReturnCCR = Sign * Model->CCR;
+      break;
+
+    default:
+      break;
+  }
+
+  return ReturnCCR;
+}
+
+/**
+ * @brief     Convert a time to the number of samples (at least 1).
+ * @param     Model     pointer to the friction model structure
+ * @param     TimeUs    time in microseconds
+ * @return    number of samples
+ */
+uint32_t convert_FrictionTimeToTicks(FrictionModel_structTd* Model, uint32_t TimeUs)
+{
+  uint32_t Ticks = 1;
+  if(Model->SampleTimeUs != 0 && TimeUs > Model->SampleTimeUs)
+  {
+    Ticks = TimeUs / Model->SampleTimeUs;
+  }
+  return Ticks;
+}
+
+/**
+ * @brief     Check once per window if the fader moved.
+ * @param     Model     pointer to the friction model structure
+ * @param     Sample    current wiper value
+ * @return    none
+ */
+void update_FrictionMoving(FrictionModel_structTd* Model, int32_t Sample)
+{
+  Model->WindowTick++;
+  if(Model->WindowTick >= convert_FrictionTimeToTicks(Model, FRICTIONMODEL_WINDOW_US))
+  {
+    Model->Moving = (abs(Sample - Model->WindowStart) >= FRICTIONMODEL_STOP_THRESHOLD);
+    Model->WindowStart = Sample;
+    Model->WindowTick = 0;
+  }
+}
+
+/**
+ * @brief     Get the zone of a wiper value.
+ * @param     Sample    wiper value
+ * @return    zone
+ */
+uint8_t get_FrictionZone(int32_t Sample)
+{
+  int32_t Zone = (Sample * FRICTIONMODEL_NUM_ZONES) / FRICTIONMODEL_POSITION_RANGE;
+  if(Zone < 0)
+  {
+    Zone = 0;
+  }
+  else if(Zone >= FRICTIONMODEL_NUM_ZONES)
+  {
+    Zone = FRICTIONMODEL_NUM_ZONES - 1;
+  }
+  return (uint8_t)Zone;
+}
+
+/**
+ * @brief     Check if the fader reached the end of the travel in the
+ *            direction of the sweep.
+ * @param     Model     pointer to the friction model structure
+ * @param     Sample    current wiper value
+ * @return    true if the end is reached
+ */
+bool check_FrictionEndReached(FrictionModel_structTd* Model, int32_t Sample)
+{
+  bool EndReached = false;
+  if(Model->Direction == FRICTIONMODEL_UP)
+  {
+    EndReached = (Sample >= FRICTIONMODEL_POSITION_RANGE - 1 - FRICTIONMODEL_END_MARGIN);
+  }
+  else
+  {
+    EndReached = (Sample <= FRICTIONMODEL_END_MARGIN);
+  }
+  return EndReached;
+}
+
+/**
+ * @brief     Add breakaway and Coulomb CCR to the zone where the fader
+ *            started and count the measurement. The Coulomb CCR is increased
+ *            by 1, as it was the first CCR where the fader did not move
+ *            anymore.
+ * @param     Model     pointer to the friction model structure
+ * @return    none
+ */
+void store_FrictionMeasurement(FrictionModel_structTd* Model)
+{
+  uint8_t Direction = Model->Direction;
+  uint8_t Zone = Model->Zone;
+  if(Model->Count[Direction][Zone] < FRICTIONMODEL_MAX_COUNT)
+  {
+    Model->Breakaway[Direction][Zone] += (uint16_t)Model->BreakawayCCR;
+    Model->Coulomb[Direction][Zone] += (uint16_t)(Model->CCR + 1);
+    Model->Count[Direction][Zone]++;
+  }
+}
+
+/**
+ * @brief     Finish the sweep of the current direction. After the up sweep
+ *            the down sweep starts, after the down sweep the averages are
+ *            calculated.
+ * @param     Model     pointer to the friction model structure
+ * @return    none
+ */
+void finish_FrictionDirection(FrictionModel_structTd* Model)
+{
+  Model->Ticks = 0;
+  if(Model->Direction == FRICTIONMODEL_UP)
+  {
+    Model->Direction = FRICTIONMODEL_DOWN;
+    Model->State = FRICTIONMODEL_REST;
+  }
+  else if(calculate_FrictionAverages(Model) == true)
+  {
+    Model->State = FRICTIONMODEL_CALIBRATED;
+  }
+  else
+  {
+    Model->State = FRICTIONMODEL_FAILED;
+  }
+}
+
+/**
+ * @brief     Divide the sums by the number of measurements. Zones without
+ *            measurement get the values of the next measured zone below, or
+ *            above for the zones below the lowest measured zone.
+ * @param     Model     pointer to the friction model structure
+ * @return    false if one direction has no measurement at all
+ */
+bool calculate_FrictionAverages(FrictionModel_structTd* Model)
+{
+  uint8_t Direction = 0;
+  int8_t Zone = 0;
+
+  for(Direction = 0; Direction < FRICTIONMODEL_NUM_DIRECTIONS; Direction++)
+  {
+    uint16_t* Breakaway = Model->Breakaway[Direction];
+    uint16_t* Coulomb = Model->Coulomb[Direction];
+    uint8_t* Count = Model->Count[Direction];
+    int8_t Measured = -1;
+
+    /** @internal     1.  Average and fill zones upwards */
+    for(Zone = 0; Zone < FRICTIONMODEL_NUM_ZONES; Zone++)
+    {
+      if(Count[Zone] != 0)
+      {
+        Breakaway[Zone] = Breakaway[Zone] / Count[Zone];
+        Coulomb[Zone] = Coulomb[Zone] / Count[Zone];
+        Measured = Zone;
+      }
+      else if(Measured >= 0)
+      {
+        Breakaway[Zone] = Breakaway[Measured];
+        Coulomb[Zone] = Coulomb[Measured];
+      }
+    }
+    if(Measured < 0)
+    {
+      return false;
+    }
+
+    /** @internal     2.  Fill the zones below the lowest measured zone */
+    Measured = 0;
+    while(Count[Measured] == 0)
+    {
+      Measured++;
+    }
+    for(Zone = 0; Zone < Measured; Zone++)
+    {
+      Breakaway[Zone] = Breakaway[Measured];
+      Coulomb[Zone] = Coulomb[Measured];
+    }
+  }
+  return true;
+}
+
+/* Description in .h */
+int32_t FrictionModel_compensate(FrictionModel_structTd* Model, int32_t Output, int32_t Error, int32_t SetpointVelocity, int32_t Sample)
+{
+  update_FrictionMoving(Model, Sample);
+
+  /** @internal     1.  Rest: keep the motor off until the error is bigger
+   *                    than twice the rest band or the setpoint moves. */
+  int32_t ErrorAbs = abs(Error);
+  if(Model->Resting == true)
+  {
+    if(ErrorAbs <= 2 * Model->RestBand && SetpointVelocity == 0)
+    {
+      return 0;
+    }
+    Model->Resting = false;
+  }
+  if(ErrorAbs <= Model->RestBand && SetpointVelocity == 0)
+  {
+    Model->Resting = true;
+    return 0;
+  }
+
+  /** @internal     2.  Direction of the feed-forward: setpoint velocity, or
+   *                    PID output if the setpoint does not move */
+  int32_t Direction = (SetpointVelocity != 0) ? SetpointVelocity : Output;
+  if(Direction == 0)
+  {
+    return Output;
+  }
+  uint8_t Index = (Direction > 0) ? FRICTIONMODEL_UP : FRICTIONMODEL_DOWN;
+  int32_t Sign = (Direction > 0) ? 1 : -1;
+
+  /** @internal     3.  Breakaway CCR if the fader stands still, Coulomb
+   *                    CCR if it moves */
+  uint8_t Zone = get_FrictionZone(Sample);
+  int32_t FeedForward = Model->Coulomb[Index][Zone];
+  if(Model->Moving == false)
+  {
+    FeedForward = Model->Breakaway[Index][Zone];
+  }
+
+  /** @internal     4.  Add the feed-forward and limit the CCR */
+  int32_t CCR = Output + Sign * FeedForward;
+  if(CCR > Model->MaxCCR)
+  {
+    CCR = Model->MaxCCR;
+  }
+  else if(CCR < -Model->MaxCCR)
+  {
+    CCR = -Model->MaxCCR;
+  }
+  return CCR;
+}
+
+/* Description in .h */
+void FrictionModel_restart(FrictionModel_structTd* Model, int32_t Sample)
+{
+  Model->Resting = false;
+  Model->Moving = false;
+  Model->WindowStart = Sample;
+  Model->WindowTick = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the model
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+FrictionModel_State_enumTd FrictionModel_get_State(FrictionModel_structTd* Model)
+{
+  return Model->State;
+}
+
+/* Description in .h */
+bool FrictionModel_check_Resting(FrictionModel_structTd* Model)
+{
+  return Model->Resting;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FrictionModel_Source" */
+/**@}*//* end of defgroup "FrictionModel" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -28,6 +28,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "motorizedFader.h"
+#include "timerService.h"
+#include "taskScheduler.h"
+#include "clockProfile.h"
 #include <string.h>
 /* USER CODE END Includes */
 
@@ -38,7 +41,8 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+/* Number of events kept in the event log */
+#define FADER_EVENT_LOG_SIZE  16
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -52,18 +56,30 @@
 
 MotorizedFader_structTd Fader[2];
 uint8_t NumFaders = 2;
-uint16_t FaderValue[2];
-uint16_t PrevFaderValue[2];
-TSCButton_State_enumTd FaderState[2];
 
-uint32_t timNow = 0;
-uint32_t timOld = 0;
-uint32_t WhileSpeed = 0;
+/* Event log: the last events of both faders and the number of events of
+ * each type and fader. Watch it in the debugger to check touch, release,
+ * position and stall events (e.g. before sending them as MIDI). */
+FaderEvents_Event_structTd FaderEventLog[FADER_EVENT_LOG_SIZE];
+uint8_t FaderEventLogIndex = 0;
+uint32_t FaderEventCount[2][FADEREVENTS_STALL + 1];
+
+/* Tasks of the scheduler. Their statistics replace the loop speed
+ * measurement (see the Stats of each task in the debugger). */
+TaskScheduler_Task_structTd TimerServiceTask;
+TaskScheduler_Task_structTd FaderTask;
+TaskScheduler_Task_structTd FaderEventTask;
+TaskScheduler_Task_structTd ClockProfileTask;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
+void run_TimerServiceTask(void* Context);
+void run_FaderTask(void* Context);
+void run_FaderEventTask(void* Context);
+void run_ClockProfileTask(void* Context);
+bool is_FaderActive(void);
 
 /* USER CODE END PFP */
 
@@ -106,11 +122,20 @@ int main(void)
   MX_ADC_Init();
   MX_TIM2_Init();
   MX_SPI1_Init();
+  MX_TIM6_Init();
   /* USER CODE BEGIN 2 */
 
+#if PROFILER_ENABLE == 1
+  /* Cycles of the regions: see Profiler_get_Region() in the debugger */
+  Profiler_init();
+#endif
+
   /* Fader Values */
-  /* TSC */
-  uint16_t TouchThreshold[2] = {450, 450};
+  /* TSC: adaptive baseline. Touch at 100 counts below the released value,
+   * release within 50 counts, 2 acquisitions in a row to change. */
+  uint16_t TouchDelta = 100;
+  uint16_t ReleaseDelta = 50;
+  uint8_t TouchConfirmCount = 2;
 
   /* PID */
   double Kp = 0.15;   /* old: 0.32 */
@@ -119,11 +144,32 @@ int main(void)
   double TauLowPass = 0.1;
   uint32_t PIDSampelTime = 3;
 
+  /* PWM carrier: 64 kHz gives 500 steps at 32 MHz (as in Cube MX). A lower
+   * carrier gives more steps, scale the CCR values below with it. */
+  uint32_t PWMCarrierHz = 64000;
+
   /* PWM Limits */
   uint16_t CCRLimit = 500;
   int StartForceCCR = 120;
   int StopRangeCCR = 25;
 
+  /* Motion profile (wiper counts per s and per s^2) */
+  uint32_t MaxVelocity = 12000;
+  uint32_t MaxAcceleration = 150000;
+
+  /* Friction compensation: motor off within +-4 counts at a resting target */
+  uint16_t FrictionRestBand = 4;
+
+  /* Events: position event every 4 counts, velocity filter 1/16 */
+  uint16_t EventResolution = 4;
+  uint8_t EventVelocityShift = 4;
+
+  /* Settle detection: within +-12 counts, moving less than 3 counts for
+   * 150 control periods (50 ms), then the driver goes to standby */
+  uint16_t SettleWindow = 12;
+  uint16_t SettleMotionBand = 3;
+  uint16_t SettleCount = 150;
+
   /* Initialize general fader settings */
   MotorizedFader_init_Structure(&Fader[0]);
   MotorizedFader_init_StartForce(&Fader[0], StartForceCCR);
@@ -139,10 +185,10 @@ int main(void)
 
   /* Initialize faders TSC */
   MotorizedFader_init_TouchTSC(&Fader[0], &htsc, TSC_GROUP1_IO2);
-  MotorizedFader_init_TouchThreshold(&Fader[0], TouchThreshold[0]);
+  MotorizedFader_init_TouchAdaptive(&Fader[0], TouchDelta, ReleaseDelta, TouchConfirmCount);
 
   MotorizedFader_init_TouchTSC(&Fader[1], &htsc, TSC_GROUP3_IO3);
-  MotorizedFader_init_TouchThreshold(&Fader[1], TouchThreshold[1]);
+  MotorizedFader_init_TouchAdaptive(&Fader[1], TouchDelta, ReleaseDelta, TouchConfirmCount);
 
   MotorizedFader_init_TouchDischargeTimeMsAll(2);
 
@@ -156,6 +202,17 @@ int main(void)
   MotorizedFader_init_MotorPinIn2(&Fader[1], GPIOA, GPIO_PIN_11);
   MotorizedFader_init_MotorPinSTBY(&Fader[1], GPIOA, GPIO_PIN_12); /* Pin is shared with Fader[0] */
   MotorizedFader_init_MotorPWM(&Fader[1], &htim2, TIM_CHANNEL_2);
+  MotorizedFader_init_PWMCarrier(&htim2, HAL_RCC_GetHCLKFreq(), PWMCarrierHz, true);
+
+  /* Convert the wipers in the widest window between the PWM edges. The ADC
+   * runs at HSI16 / 2 (8 MHz, see ClockProfile_add_ADC()), the window is
+   * derived from its sampling time. */
+  MotorizedFader_init_ADCTrigger(&htim2, TIM_CHANNEL_4, 8000000, hadc.Init.SamplingTime);
+
+  /* Samples are taken away from the motor switching edges, so less smoothing
+   * is needed */
+  MotorizedFader_init_WiperFilter(&Fader[0], WIPERFILTER_EMA, 2);
+  MotorizedFader_init_WiperFilter(&Fader[1], WIPERFILTER_EMA, 2);
 
   /* Initialize faders PID */
   MotorizedFader_init_PID(&Fader[0]);
@@ -170,44 +227,70 @@ int main(void)
   MotorizedFader_init_PIDLowPass(&Fader[1], TauLowPass);
   MotorizedFader_init_PIDSampleTimeInMs(&Fader[1], PIDSampelTime);
 
+  /* Run the control loop of all faders in the TIM6 interrupt (3 kHz) */
+  MotorizedFader_init_ControlTimer(&htim6);
+
+  /* TIM6 counts microseconds: use it as time base of the software timers.
+   * It is started with the control loop in MotorizedFader_start_All(). */
+  TimerService_init(&htim6);
+
+  /* Move to new targets with S-curves instead of steps */
+  MotorizedFader_init_MotionProfile(&Fader[0], MOTIONPROFILE_SCURVE, 4);
+  MotorizedFader_init_MotionLimits(&Fader[0], MaxVelocity, MaxAcceleration);
+
+  MotorizedFader_init_MotionProfile(&Fader[1], MOTIONPROFILE_SCURVE, 4);
+  MotorizedFader_init_MotionLimits(&Fader[1], MaxVelocity, MaxAcceleration);
+
+  /* Replace start force and stop range by the measured friction */
+  MotorizedFader_init_Friction(&Fader[0], FrictionRestBand);
+  MotorizedFader_init_Friction(&Fader[1], FrictionRestBand);
+
+  /* Initialize events */
+  MotorizedFader_init_Events(&Fader[0], EventResolution, EventVelocityShift);
+  MotorizedFader_init_Events(&Fader[1], EventResolution, EventVelocityShift);
+
+  /* Initialize settle detection. Both faders share the STBY pin. */
+  MotorizedFader_init_Settle(&Fader[0], SettleWindow, SettleMotionBand, SettleCount, MOTORIZEDFADER_PARK_STANDBY);
+  MotorizedFader_init_Settle(&Fader[1], SettleWindow, SettleMotionBand, SettleCount, MOTORIZEDFADER_PARK_STANDBY);
+
+  /* Switch the clock at run time: performance while the faders move or
+   * are touched, balanced while they rest. The fader task switches to
+   * performance as soon as a fader wakes up or is touched, the clock task
+   * back to balanced. SystemClock_Config() starts with performance. PWM
+   * carrier, ADC trigger, control timer, SPI and ADC keep their rates. The
+   * PWM has half the steps in the balanced profile, the motors are parked
+   * then. */
+  ClockProfile_init(CLOCKPROFILE_PERFORMANCE);
+  ClockProfile_add_Timer(&htim2);
+  ClockProfile_add_Timer(&htim6);
+  ClockProfile_add_SPI(&hspi1);
+  ClockProfile_add_ADC(&hadc);
+
   MotorizedFader_start_All();
 
+  MotorizedFader_start_FrictionCalibration(&Fader[0]);
+  MotorizedFader_start_FrictionCalibration(&Fader[1]);
+
+  /* Link Faders: the touched fader moves the other one to its position */
+  MotorizedFader_structTd* GangFaders[2] = {&Fader[0], &Fader[1]};
+  MotorizedFader_set_Gang(0, MOTORIZEDFADER_GANG_ABSOLUTE, GangFaders, NumFaders);
+
+  /* Replace the super loop by tasks. The control loop runs in the TIM6
+   * interrupt, so the tasks only need soft deadlines. Sleep if nothing is
+   * due, TIM6 wakes the CPU every 333 us. */
+  TaskScheduler_init(true);
+  TaskScheduler_add_Task(&TimerServiceTask, "timers", run_TimerServiceTask, NULL, 500, 0, 0);
+  TaskScheduler_add_Task(&FaderTask, "faders", run_FaderTask, NULL, 500, 0, 1);
+  TaskScheduler_add_Task(&FaderEventTask, "events", run_FaderEventTask, NULL, 2000, 0, 2);
+  TaskScheduler_add_Task(&ClockProfileTask, "clock", run_ClockProfileTask, NULL, 50000, 0, 3);
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-    /* check loop speed */
-    timNow = HAL_GetTick();
-    WhileSpeed = timNow - timOld;
-    timOld = timNow;
-
-    MotorizedFader_update_All();
-
-    /* Link Faders */
-    for(uint8_t Index = 0; Index < NumFaders;  Index++)
-    {
-      /* store previous fader value */
-      PrevFaderValue[Index] = FaderValue[Index];
-
-      /* Get current fader value */
-      FaderValue[Index] = MotorizedFader_get_WiperValue(&Fader[Index]);
-      FaderState[Index] = MotorizedFader_get_TSCState(&Fader[Index]);
-    }
-
-    if(FaderState[1] == TSCBUTTON_TOUCHED)
-    {
-      MotorizedFader_set_Target(&Fader[0], FaderValue[1]);
-      MotorizedFader_set_Target(&Fader[1], FaderValue[1]);
-    }
-
-    if(FaderState[0] == TSCBUTTON_TOUCHED)
-    {
-      MotorizedFader_set_Target(&Fader[1], FaderValue[0]);
-      MotorizedFader_set_Target(&Fader[0], FaderValue[0]);
-    }
-    /* Link Faders End */
+    TaskScheduler_run_Once();
 
     /* USER CODE END WHILE */
 
@@ -272,14 +355,102 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
   MotorizedFader_manage_WiperInterrupt(hadc);
 }
 
+/* details about this callback in: stm32l0xx_hal_adc.c */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+  MotorizedFader_manage_WiperHalfInterrupt(hadc);
+}
+
 void HAL_TSC_ConvCpltCallback(TSC_HandleTypeDef* htsc)
 {
   MotorizedFader_manage_TSCInterrupt();
 }
 
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+{
+  TimerService_manage_Interrupt(htim);
+  MotorizedFader_manage_ControlTimerInterrupt(htim);
+}
+
+void ClockProfile_TimerRestartCallback(TIM_HandleTypeDef* htim, uint32_t ElapsedUs)
+{
+  TimerService_manage_CounterReset(htim, ElapsedUs);
+}
+
 /** @} ************************************************************************/
 /* end of name "Interrupt Handlers"
  ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name			Tasks
+ * @brief			Here are all tasks of the scheduler.
+ * @{
+ ******************************************************************************/
+
+void run_TimerServiceTask(void* Context)
+{
+  TimerService_update();
+}
+
+void run_FaderTask(void* Context)
+{
+  MotorizedFader_update_All();
+
+  /* A fader woke up or was touched: performance at once, the motor must
+   * not run long with the coarser PWM of the balanced profile */
+  if(is_FaderActive() == true)
+  {
+    ClockProfile_set_Profile(CLOCKPROFILE_PERFORMANCE);
+  }
+}
+
+void run_FaderEventTask(void* Context)
+{
+  FaderEvents_Event_structTd Event;
+
+  /* Write the events of both faders into the event log. A MIDI output
+   * would send them here. Linking is done by the gang in the control timer
+   * interrupt. */
+  while(MotorizedFader_get_Event(&Event) == true)
+  {
+    FaderEventLog[FaderEventLogIndex] = Event;
+    FaderEventLogIndex = (FaderEventLogIndex + 1) % FADER_EVENT_LOG_SIZE;
+    if(Event.Fader < NumFaders && Event.Type <= FADEREVENTS_STALL)
+    {
+      FaderEventCount[Event.Fader][Event.Type]++;
+    }
+  }
+}
+
+void run_ClockProfileTask(void* Context)
+{
+  /* Back to balanced only from this slow task, if all faders rest. The
+   * fader task switches to performance. */
+  if(is_FaderActive() == false)
+  {
+    ClockProfile_set_Profile(CLOCKPROFILE_BALANCED);
+  }
+}
+
+bool is_FaderActive(void)
+{
+  /* Active: not resting at its target or touched */
+  uint8_t Index = 0;
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    if(MotorizedFader_get_SettleState(&Fader[Index]) != SETTLEDETECTOR_SETTLED ||
+       MotorizedFader_get_TSCState(&Fader[Index]) != TSCBUTTON_RELEASED)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** @} ************************************************************************/
+/* end of name "Tasks"
+ ******************************************************************************/
 /* USER CODE END 4 */
 
 /**
@@ -0,0 +1,343 @@
+/***************************************************************************//**
+ * @defgroup        MotionProfile_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      MotionProfile
+ * @{
+ *
+ * @addtogroup      MotionProfile_Source
+ * @{
+ *
+ * @file            motionProfile.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <motionProfile.h>
+#include <stdlib.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the motion profile
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void convert_ProfileLimits(MotionProfile_structTd* Profile);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void MotionProfile_init(MotionProfile_structTd* Profile, MotionProfile_Type_enumTd Type, uint8_t Shift)
+{
+  /** @internal     1.  Limit the smoothing to the available buffer */
+  if(Shift > MOTIONPROFILE_SMOOTH_MAX_SHIFT)
+  {
+    Shift = MOTIONPROFILE_SMOOTH_MAX_SHIFT;
+  }
+
+  /** @internal     2.  Store settings and reset the profile */
+  Profile->Type = Type;
+  Profile->Shift = Shift;
+  Profile->Target = 0;
+  Profile->Setpoint = 0;
+  MotionProfile_reset(Profile);
+}
+
+/* Description in .h */
+void MotionProfile_set_Limits(MotionProfile_structTd* Profile, uint32_t MaxVelocity, uint32_t MaxAcceleration)
+{
+  Profile->MaxVelocity = MaxVelocity;
+  Profile->MaxAcceleration = MaxAcceleration;
+  convert_ProfileLimits(Profile);
+}
+
+/* Description in .h */
+void MotionProfile_set_SampleTimeInUs(MotionProfile_structTd* Profile, uint32_t SampleTime)
+{
+  Profile->SampleTimeUs = SampleTime;
+  convert_ProfileLimits(Profile);
+}
+
+/* Description in .h */
+void MotionProfile_reset(MotionProfile_structTd* Profile)
+{
+  Profile->Velocity = 0;
+  Profile->Index = 0;
+  Profile->Started = false;
+}
+
+/**
+ * @brief     Convert the limits of the user (counts per second) to counts per
+ *            sample in Q16.16 format. A limit of 0 stays 0, all other limits
+ *            are at least 1/65536 count per sample.
+ * @param     Profile   pointer to the profile structure
+ * @return    none
+ */
+void convert_ProfileLimits(MotionProfile_structTd* Profile)
+{
+  uint64_t SampleTime = Profile->SampleTimeUs;
+  uint64_t Microseconds = 1000000;
+
+  /** @internal     1.  Velocity = MaxVelocity * SampleTime */
+  uint64_t Velocity = ((uint64_t)Profile->MaxVelocity * SampleTime << 16) / Microseconds;
+
+  /** @internal     2.  Acceleration = MaxAcceleration * SampleTime^2. The
+   *                    sample time is multiplied in two steps to avoid an
+   *                    overflow. */
+  uint64_t Acceleration = ((uint64_t)Profile->MaxAcceleration * SampleTime << 16) / Microseconds;
+  Acceleration = (Acceleration * SampleTime) / Microseconds;
+
+  /** @internal     3.  Round up very small limits to the smallest step */
+  if(Velocity == 0 && Profile->MaxVelocity != 0 && SampleTime != 0)
+  {
+    Velocity = 1;
+  }
+  if(Acceleration == 0 && Profile->MaxAcceleration != 0 && SampleTime != 0)
+  {
+    Acceleration = 1;
+  }
+
+  Profile->VelocityLimit = (int32_t)Velocity;
+  Profile->Acceleration = (int32_t)Acceleration;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to move the setpoint
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void start_ProfileAtPosition(MotionProfile_structTd* Profile, int32_t Sample);
+void move_TrapezoidPosition(MotionProfile_structTd* Profile);
+bool check_BrakingDistance(int32_t Velocity, int32_t Acceleration, int32_t Distance);
+int32_t smooth_TrapezoidPosition(MotionProfile_structTd* Profile, int32_t Position);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void MotionProfile_set_Target(MotionProfile_structTd* Profile, int32_t Target)
+{
+  Profile->Target = Target;
+}
+
+/* Description in .h */
+int32_t MotionProfile_update(MotionProfile_structTd* Profile, int32_t Sample)
+{
+  /** @internal     1.  Without profile or limits, the setpoint jumps to the
+   *                    target. */
+  if(Profile->Type == MOTIONPROFILE_STEP || Profile->VelocityLimit == 0 || Profile->Acceleration == 0)
+  {
+    Profile->Setpoint = Profile->Target;
+    return Profile->Setpoint;
+  }
+
+  /** @internal     2.  Start at the current position of the system after
+   *                    init or reset */
+  if(Profile->Started == false)
+  {
+    start_ProfileAtPosition(Profile, Sample);
+  }
+
+  /** @internal     3.  Move the trapezoid one sample further */
+  move_TrapezoidPosition(Profile);
+
+  /** @internal     4.  Smooth the trapezoid to get the S-curve */
+  int32_t Position = Profile->Position;
+  if(Profile->Type == MOTIONPROFILE_SCURVE)
+  {
+    Position = smooth_TrapezoidPosition(Profile, Position);
+  }
+
+  /** @internal     5.  Round the position to the integer setpoint */
+  Profile->Setpoint = (Position + 0x8000) >> 16;
+  return Profile->Setpoint;
+}
+
+/* Description in .h */
+void MotionProfile_follow(MotionProfile_structTd* Profile, int32_t Target)
+{
+  Profile->Target = Target;
+  Profile->Setpoint = Target;
+  MotionProfile_reset(Profile);
+}
+
+/**
+ * @brief     Set the position to the current sample with velocity 0 and fill
+ *            the smoothing buffer with this position.
+ * @param     Profile   pointer to the profile structure
+ * @param     Sample    current position of the system (integer)
+ * @return    none
+ */
+void start_ProfileAtPosition(MotionProfile_structTd* Profile, int32_t Sample)
+{
+  int32_t Position = Sample << 16;
+  uint8_t Index = 0;
+
+  Profile->Position = Position;
+  Profile->Velocity = 0;
+
+  for(Index = 0; Index < (1 << Profile->Shift); Index++)
+  {
+    Profile->Positions[Index] = Position;
+  }
+  Profile->PositionSum = (int64_t)Position << Profile->Shift;
+
+  Profile->Index = 0;
+  Profile->Started = true;
+}
+
+/**
+ * @brief     Move the trapezoid position one sample. The velocity changes by
+ *            at most one acceleration step per sample. Braking starts, when
+ *            the remaining distance is just long enough to stop at the
+ *            target.
+ * @param     Profile   pointer to the profile structure
+ * @return    none
+ */
+void move_TrapezoidPosition(MotionProfile_structTd* Profile)
+{
+  int32_t Target = Profile->Target << 16;
+  int32_t Acceleration = Profile->Acceleration;
+  int32_t VelocityLimit = Profile->VelocityLimit;
+
+  /** @internal     1.  Calculate distance and velocity in the direction to
+   *                    the target. Negative velocity moves away from it. */
+  int32_t Distance = Target - Profile->Position;
+  int32_t Direction = (Distance >= 0) ? 1 : -1;
+  int32_t Velocity = Profile->Velocity * Direction;
+  Distance = abs(Distance);
+
+  /** @internal     2.  Close to the target and slow enough to stop within one
+   *                    sample: stop at the target */
+  if(Distance <= Acceleration && abs(Velocity) <= Acceleration)
+  {
+    Profile->Position = Target;
+    Profile->Velocity = 0;
+    return;
+  }
+
+  /** @internal     3.  Calculate the new velocity:
+   *                    - moving away from the target: brake (this is also
+   *                      the acceleration to the target)
+   *                    - faster than allowed: brake to the velocity limit
+   *                    - enough distance left to brake after the next
+   *                      acceleration step: accelerate up to the limit
+   *                    - not enough distance left to brake from the
+   *                      current velocity: brake
+   *                    - else: keep the velocity */
+  int32_t VelocityNext = Velocity + Acceleration;
+  if(VelocityNext > VelocityLimit)
+  {
+    VelocityNext = VelocityLimit;
+  }
+
+  if(Velocity < 0)
+  {
+    Velocity = Velocity + Acceleration;
+  }
+  else if(Velocity > VelocityLimit)
+  {
+    Velocity = Velocity - Acceleration;
+  }
+  else if(check_BrakingDistance(VelocityNext, Acceleration, Distance) == true)
+  {
+    Velocity = VelocityNext;
+  }
+  else if(check_BrakingDistance(Velocity, Acceleration, Distance) == false)
+  {
+    Velocity = Velocity - Acceleration;
+  }
+
+  /** @internal     4.  Move the position with the new velocity */
+  Profile->Velocity = Velocity * Direction;
+  Profile->Position = Profile->Position + Profile->Velocity;
+}
+
+/**
+ * @brief     Check if the profile can stop at the target, if it moves with
+ *            the velocity for one sample and brakes with the acceleration
+ *            afterwards. The braking distance is v/2 + v^2 / (2 * a). The
+ *            check is done without division:
+ *            2 * a * Distance >= v^2 + a * v
+ * @param     Velocity      in the direction to the target (Q16.16)
+ * @param     Acceleration  per sample (Q16.16)
+ * @param     Distance      absolute distance to the target (Q16.16)
+ * @return    true if the distance is long enough
+ */
+bool check_BrakingDistance(int32_t Velocity, int32_t Acceleration, int32_t Distance)
+{
+  int64_t Available = 2 * (int64_t)Acceleration * Distance;
+  int64_t Required = (int64_t)Velocity * Velocity + (int64_t)Acceleration * Velocity;
+  return (Available >= Required);
+}
+
+/**
+ * @brief     Running average of the last 2^Shift trapezoid positions. The
+ *            oldest position is replaced by the new one and the sum is
+ *            corrected by the difference.
+ * @param     Profile   pointer to the profile structure
+ * @param     Position  new trapezoid position (Q16.16)
+ * @return    smoothed position (Q16.16)
+ */
+int32_t smooth_TrapezoidPosition(MotionProfile_structTd* Profile, int32_t Position)
+{
+  uint8_t Shift = Profile->Shift;
+  uint8_t Index = Profile->Index;
+
+  /** @internal     1.  Replace the oldest position in the sum and buffer */
+  Profile->PositionSum = Profile->PositionSum - Profile->Positions[Index] + Position;
+  Profile->Positions[Index] = Position;
+
+  /** @internal     2.  Count up the index. The buffer size is a power of 2,
+   *                    so a mask is enough to wrap around. */
+  Profile->Index = (Index + 1) & ((1 << Shift) - 1);
+
+  /** @internal     3.  Return the average */
+  return (int32_t)(Profile->PositionSum >> Shift);
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the profile
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+int32_t MotionProfile_get_Target(MotionProfile_structTd* Profile)
+{
+  return Profile->Target;
+}
+
+/* Description in .h */
+int32_t MotionProfile_get_Setpoint(MotionProfile_structTd* Profile)
+{
+  return Profile->Setpoint;
+}
+
+/* Description in .h */
+int32_t MotionProfile_get_Velocity(MotionProfile_structTd* Profile)
+{
+  return Profile->Velocity;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "MotionProfile_Source" */
+/**@}*//* end of defgroup "MotionProfile" */
+/**@}*//* end of defgroup "MotorFader" */
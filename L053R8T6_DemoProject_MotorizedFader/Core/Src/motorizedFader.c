@@ -16,12 +16,51 @@
 
 #include <motorizedFader.h>
 
+/**
+ * @brief     Internal data of a gang
+ */
+typedef struct
+{
+  volatile MotorizedFader_Gang_enumTd Mode; /**< Set last, as the gang is
+                                                 updated in an interrupt */
+  volatile uint32_t Members;        /**<  One bit for each internal fader
+                                          index */
+  uint8_t   Master;                 /**<  Internal index of the master */
+  int8_t    Leader;                 /**<  Internal index of the leading
+                                          fader. -1 if no member leads */
+  int16_t   Offsets[NUMBER_OF_MOTORIZED_FADERS]; /**< Distance of each member
+                                          to the leader (linear counts) */
+}MotorizedFader_gang_structTd;
+
 typedef struct
 {
   /** Array to store pointers to all initialized faders */
   MotorizedFader_structTd* InitializedFaders[NUMBER_OF_MOTORIZED_FADERS];
   uint16_t  NumInitializedFaders;   /**<  Number of the actual initialized
                                           faders */
+  TIM_HandleTypeDef* htimControl;   /**<  Timer for the control loop. NULL if
+                                          the control loop runs in
+                                          MotorizedFader_update_All() */
+  uint32_t  ControlOverruns;        /**<  Number of missed control periods */
+  TIM_HandleTypeDef* htimADCTrigger;  /**< PWM timer that triggers the ADC.
+                                          NULL if the ADC is not triggered by
+                                          the PWM timer */
+  uint32_t  ADCTriggerChannel;      /**<  Timer channel used as ADC trigger */
+  uint32_t  ADCClockHz;             /**<  Clock of the ADC */
+  uint32_t  ADCSamplingTime;        /**<  Sampling time of the ADC
+                                          (ADC_SAMPLETIME_xCYCLES_x) */
+  uint16_t  ADCSampleTicks;         /**<  Duration of one conversion in timer
+                                          ticks */
+  uint32_t  ADCTriggerPeriod;       /**<  Period (ARR + 1) ADCSampleTicks was
+                                          calculated for. 0: not yet */
+  uint16_t  ControlTicksMax;        /**<  Longest control interrupt in timer
+                                          ticks */
+  uint8_t   ControlGroups;          /**<  Faders are updated in turns in this
+                                          number of groups. 0 or 1: all in
+                                          each period */
+  uint8_t   ControlGroup;           /**<  Group updated in the next period */
+  FaderEvents_Queue_structTd EventQueue; /**< Events of all faders */
+  MotorizedFader_gang_structTd Gangs[NUMBER_OF_FADER_GANGS];
 }MotorizedFader_internal_structTd;
 
 MotorizedFader_internal_structTd FadersInternal = {0};
@@ -38,6 +77,19 @@ void MotorizedFader_init_Structure(MotorizedFader_structTd* Fader)
   uint16_t Index = FadersInternal.NumInitializedFaders;
   FadersInternal.InitializedFaders[Index] = Fader;
   FadersInternal.NumInitializedFaders++;
+  MotionProfile_init(&Fader->Profile, MOTIONPROFILE_STEP, 0);
+  PIDAutotune_init(&Fader->Autotune, 0, 0, PIDAUTOTUNE_RULE_NO_OVERSHOOT);
+  FrictionModel_init(&Fader->Friction, 0);
+  WiperLinear_init(&Fader->Linear);
+  FaderEvents_init_Tracker(&Fader->Events, 0, 0);
+  SettleDetector_init(&Fader->Settle, 0, 0, 0);
+  FaderHaptics_init(&Fader->Haptics);
+  StallDetector_init(&Fader->Stall, 0, 0, 0);
+  CascadeController_init(&Fader->Cascade);
+  Fader->Controller = MOTORIZEDFADER_CONTROLLER_PID;
+  Fader->Park = MOTORIZEDFADER_PARK_COAST;
+  Fader->Following = false;
+  Fader->CCRFraction = 0;
 }
 
 /* Description in .h */
@@ -73,6 +125,12 @@ void MotorizedFader_init_Wiper(MotorizedFader_structTd* Fader, ADC_HandleTypeDef
   Wiper_init_Hysteresis(&Fader->Wiper);
 }
 
+/* Description in .h */
+void MotorizedFader_init_WiperFilter(MotorizedFader_structTd* Fader, WiperFilter_Type_enumTd Type, uint8_t Shift)
+{
+  Wiper_init_Filter(&Fader->Wiper, Type, Shift);
+}
+
 /** @} ************************************************************************/
 /* end of name "Initialize Wiper"
  ******************************************************************************/
@@ -99,6 +157,14 @@ void MotorizedFader_init_TouchThreshold(MotorizedFader_structTd* fader, uint16_t
   TSCButton_init_Threshold(&fader->TouchSense, threshold);
 }
 
+/* Description in .h */
+void MotorizedFader_init_TouchAdaptive(MotorizedFader_structTd* Fader, uint16_t TouchDelta, uint16_t ReleaseDelta, uint8_t ConfirmCount)
+{
+  /** @internal     1.  init adaptive touch detection. For details look at
+   *                    TSCButton_init_Adaptive() */
+  TSCButton_init_Adaptive(&Fader->TouchSense, TouchDelta, ReleaseDelta, ConfirmCount);
+}
+
 /* Description in .h */
 void MotorizedFader_init_TouchDischargeTimeMsAll(uint8_t value)
 {
@@ -140,6 +206,29 @@ void MotorizedFader_init_MotorPWM(MotorizedFader_structTd* Fader, TIM_HandleType
   MotorDriver_init_PWM(&Fader->Motor, htim, Channel);
 }
 
+/* Description in .h */
+uint32_t MotorizedFader_init_PWMCarrier(TIM_HandleTypeDef* htim, uint32_t TimerClockHz, uint32_t CarrierHz, bool Ultrasonic)
+{
+  return MotorDriver_init_PWMCarrier(htim, TimerClockHz, CarrierHz, Ultrasonic);
+}
+
+/* Description in .h */
+void MotorizedFader_init_MotorDither(MotorizedFader_structTd* Fader, uint8_t Bits)
+{
+  MotorDriver_init_Dither(&Fader->Motor, Bits);
+  Fader->CCRFraction = 0;
+}
+
+/* Description in .h */
+void MotorizedFader_init_ADCTrigger(TIM_HandleTypeDef* htim, uint32_t Channel, uint32_t ADCClockHz, uint32_t SamplingTime)
+{
+  FadersInternal.htimADCTrigger = htim;
+  FadersInternal.ADCTriggerChannel = Channel;
+  FadersInternal.ADCClockHz = ADCClockHz;
+  FadersInternal.ADCSamplingTime = SamplingTime;
+  FadersInternal.ADCTriggerPeriod = 0;
+}
+
 /** @} ************************************************************************/
 /* end of name "Initialize Motor"
  ******************************************************************************/
@@ -155,7 +244,7 @@ void MotorizedFader_init_MotorPWM(MotorizedFader_structTd* Fader, TIM_HandleType
 /* Description in .h */
 void MotorizedFader_init_PID(MotorizedFader_structTd* Fader)
 {
-  PID_init(&Fader->PID);
+  PIDFixed_init(&Fader->PID);
 }
 
 /* Description in .h */
@@ -163,25 +252,46 @@ void MotorizedFader_init_PIDMaxCCR(MotorizedFader_structTd* Fader, uint16_t MaxC
 {
   /** @internal     1.  Setup PID Output limits with -CCR to CCR. "-"
    *                    indicates the down direction. */
-  PID_set_OutputMinMax(&Fader->PID, (double)-MaxCCR, (double)MaxCCR);
+  PIDFixed_set_OutputMinMax(&Fader->PID, -(int32_t)MaxCCR, (int32_t)MaxCCR);
+  CascadeController_set_OutputMax(&Fader->Cascade, (int32_t)MaxCCR);
+  /** @internal     2.  Store the limit for the friction calibration */
+  Fader->CCRMax = MaxCCR;
 }
 
 /* Description in .h */
 void MotorizedFader_init_PIDKpKiKd(MotorizedFader_structTd* Fader, double Kp, double Ki, double Kd)
 {
-  PID_set_KpKiKd(&Fader->PID, Kp, Ki, Kd);
+  PIDFixed_set_KpKiKd(&Fader->PID, Kp, Ki, Kd);
 }
 
 /* Description in .h */
 void MotorizedFader_init_PIDLowPass(MotorizedFader_structTd* Fader, double Tau)
 {
-  PID_set_LowPass(&Fader->PID, Tau);
+  PIDFixed_set_LowPass(&Fader->PID, Tau);
 }
 
 /* Description in .h */
 void MotorizedFader_init_PIDSampleTimeInMs(MotorizedFader_structTd* Fader, uint32_t SampleTime)
 {
-  PID_set_SampleTimeInMs(&Fader->PID, SampleTime);
+  PIDFixed_set_SampleTimeInMs(&Fader->PID, SampleTime);
+}
+
+/* Description in .h */
+void MotorizedFader_init_PIDGainSchedule(MotorizedFader_structTd* Fader, double Kp, double Ki, double Kd, uint16_t ErrorSmall, uint16_t ErrorLarge)
+{
+  PIDFixed_set_GainSchedule(&Fader->PID, Kp, Ki, Kd, ErrorSmall, ErrorLarge);
+}
+
+/* Description in .h */
+void MotorizedFader_init_PIDGainScaleDown(MotorizedFader_structTd* Fader, double Scale)
+{
+  PIDFixed_set_GainScaleDown(&Fader->PID, Scale);
+}
+
+/* Description in .h */
+void MotorizedFader_init_PIDBackCalculation(MotorizedFader_structTd* Fader, double Kb)
+{
+  PIDFixed_set_BackCalculation(&Fader->PID, Kb);
 }
 
 /** @} ************************************************************************/
@@ -190,187 +300,1593 @@ void MotorizedFader_init_PIDSampleTimeInMs(MotorizedFader_structTd* Fader, uint3
 
 
 /***************************************************************************//**
- * @name      Process
- * @brief     Use these functions to process all faders
+ * @name      Initialize Control Timer
+ * @brief     Use this function to run the control loop of all faders in a
+ *            timer interrupt with a fixed rate.
  * @{
  ******************************************************************************/
 
 /* Description in .h */
-void MotorizedFader_start_All()
+void MotorizedFader_init_ControlTimer(TIM_HandleTypeDef* htim)
 {
-  /** @internal     1.  Start TSC for all faders */
-  TSCButton_start_All();
+  FadersInternal.htimControl = htim;
+  FadersInternal.ControlOverruns = 0;
+  FadersInternal.ControlTicksMax = 0;
+}
 
-  /** @internal     2.  Start ADC for all faders */
-  Wiper_start_All();
+/* Description in .h */
+void MotorizedFader_init_ControlStagger(uint8_t Groups)
+{
+  FadersInternal.ControlGroups = Groups;
+  FadersInternal.ControlGroup = 0;
+}
 
-  /** @internal     3.  Start PWM for all faders */
-  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
-  uint16_t Index = 0;
-  for(Index = 0; Index < NumFaders; Index++)
-  {
-    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
-    MotorDriver_start_PWM(&Fader->Motor);
-  }
+/** @} ************************************************************************/
+/* end of name "Initialize Control Timer"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Motion Profile
+ * @brief     Use these functions to move the PID setpoint to a new target with
+ *            limited velocity and acceleration.
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_init_MotionProfile(MotorizedFader_structTd* Fader, MotionProfile_Type_enumTd Type, uint8_t Shift)
+{
+  /** @internal     1.  Keep the target, as the fader might already have one */
+  int32_t Target = MotionProfile_get_Target(&Fader->Profile);
+  MotionProfile_init(&Fader->Profile, Type, Shift);
+  MotionProfile_set_Target(&Fader->Profile, Target);
 }
 
-/** @cond *//* Function Prototypes */
-int get_UpdatedPIDOutput(MotorizedFader_structTd* Fader);
-void move_Fader(MotorizedFader_structTd* Fader, int CCR);
-/** @endcond *//* Function Prototypes */
+/* Description in .h */
+void MotorizedFader_init_MotionLimits(MotorizedFader_structTd* Fader, uint32_t MaxVelocity, uint32_t MaxAcceleration)
+{
+  MotionProfile_set_Limits(&Fader->Profile, MaxVelocity, MaxAcceleration);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize Motion Profile"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Cascade Controller
+ * @{
+ ******************************************************************************/
 
 /* Description in .h */
-void MotorizedFader_update_All()
+void MotorizedFader_init_Cascade(MotorizedFader_structTd* Fader, double PositionGain, double VelocityKp, double VelocityKi, uint32_t MaxVelocity)
 {
-  /** @internal     1.  Update all wipers */
-  Wiper_update_All();
+  CascadeController_set_Gains(&Fader->Cascade, PositionGain, VelocityKp, VelocityKi, MaxVelocity);
+  Fader->Controller = MOTORIZEDFADER_CONTROLLER_CASCADE;
+}
 
-  /** @internal     2.  Update all TSCs */
-  TSCButton_update_All();
+/* Description in .h */
+void MotorizedFader_init_CascadeEstimator(MotorizedFader_structTd* Fader, double Alpha, double Beta)
+{
+  CascadeController_set_Estimator(&Fader->Cascade, Alpha, Beta);
+}
 
-  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
-  uint16_t Index = 0;
+/** @} ************************************************************************/
+/* end of name "Initialize Cascade Controller"
+ ******************************************************************************/
 
-  /** @internal     3.  Loop through all faders. Inside the Loop: */
-  for(Index = 0; Index < NumFaders; Index++)
-  {
-    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
 
-    /** @internal     4.  Get the current TSC state */
-    TSCButton_State_enumTd TSCState;
-    TSCState = TSCButton_get_State(&Fader->TouchSense);
+/***************************************************************************//**
+ * @name      Initialize Auto Tuning
+ * @brief     Use this function to prepare the PID auto tuning of a fader.
+ * @{
+ ******************************************************************************/
 
-    /** @internal     5.  If TSC is not touched, update PID and move fader with
-     *                    the new CCR value. If it is touched, reset PID and
-     *                    stop the motor.*/
-    if(TSCState == TSCBUTTON_TOUCHED)
-    {
-      PID_reset(&Fader->PID);
-      MotorDriver_stop(&Fader->Motor);
-    }
-    else if(TSCState == TSCBUTTON_RELEASED)
-    {
-      int CCR = get_UpdatedPIDOutput(Fader);
-      move_Fader(Fader, CCR);
-    }
-  }
+/* Description in .h */
+void MotorizedFader_init_Autotune(MotorizedFader_structTd* Fader, uint16_t RelayCCR, uint16_t Hysteresis, PIDAutotune_Rule_enumTd Rule)
+{
+  PIDAutotune_init(&Fader->Autotune, (int32_t)RelayCCR, (int32_t)Hysteresis, Rule);
 }
 
-/**
- * @brief     Update PID with the new value
- * @param     Fader   pointer to the users fader structure
- * @return    int CCR value calculated by PID
- */
-int get_UpdatedPIDOutput(MotorizedFader_structTd* Fader)
+/** @} ************************************************************************/
+/* end of name "Initialize Auto Tuning"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Friction Compensation
+ * @brief     Use this function to prepare the friction compensation of a fader.
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_init_Friction(MotorizedFader_structTd* Fader, uint16_t RestBand)
 {
-  int ReturnCCR = 0;
-  /** @intenral     1.  Get current ADC sample */
-  uint16_t ADCSample = Wiper_get_SmoothValue(&Fader->Wiper);
-  /** @internal     2.  Update PID with new sample */
-  PID_update(&Fader->PID, (double)ADCSample);
-  /** @intenral     3.  Get the round PID outout to return */
-  ReturnCCR = PID_get_OutputRound(&Fader->PID);
+  FrictionModel_init(&Fader->Friction, RestBand);
+}
 
-  return ReturnCCR;
+/** @} ************************************************************************/
+/* end of name "Initialize Friction Compensation"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Events
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_init_Events(MotorizedFader_structTd* Fader, uint16_t Resolution, uint8_t VelocityShift)
+{
+  FaderEvents_init_Tracker(&Fader->Events, Resolution, VelocityShift);
 }
 
-/**
- * @brief     Move fader with the new CCR value
- * @param     Fader   pointer to the users fader structure
- * @param     int     CCR value for the motors PWM
- * @returen   none
- */
-void move_Fader(MotorizedFader_structTd* Fader, int CCR)
+/** @} ************************************************************************/
+/* end of name "Initialize Events"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize Settle Detection
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_init_Settle(MotorizedFader_structTd* Fader, uint16_t Window, uint16_t MotionBand, uint16_t Count, MotorizedFader_Park_enumTd Park)
 {
-  int CCRStartForce = Fader->CCRStartForce;
-  int CCRStopRange = Fader->CCRStopRange;
+  SettleDetector_init(&Fader->Settle, Window, MotionBand, Count);
+  Fader->Park = Park;
+}
 
-  /** @internal     1.  Check if CCR is bigger then the required start
-   *                    CCR value. If yes, move the motor according to the CCR
-   *                    sign. - is down, + is up */
-  if(CCR < -CCRStartForce)
-  {
-    /* Move down with PID result */
-    MotorDriver_move_CounterClockWise(&Fader->Motor, -1*CCR);
-  }
-  else if(CCR > CCRStartForce)
-  {
-    /* Move up with PID result */
-    MotorDriver_move_ClockWise(&Fader->Motor, CCR);
-  }
-  /** @internal     2.  If CCR is not in the Stop CCRT range, but lower
-   *                    than the required start force, move the fader with
-   *                    the start force value in the direction according to the
-   *                    CCR sign*/
-  else if(CCR < -CCRStopRange && CCR >= -CCRStartForce)
-  {
-    /* Move down with Start Force (slowest possible) */
-    MotorDriver_move_CounterClockWise(&Fader->Motor, CCRStartForce);
-  }
+/** @} ************************************************************************/
+/* end of name "Initialize Settle Detection"
+ ******************************************************************************/
 
-  else if(CCR > CCRStopRange && CCR <= CCRStartForce)
-  {
-    /* Move up with Start Force (slowest possible) */
-   MotorDriver_move_ClockWise(&Fader->Motor, CCRStartForce);
-  }
-  /** @internal     3.  It the motor is in the Stop CCR range, stop the motor */
-  else
-  {
-   MotorDriver_stop(&Fader->Motor);
-  }
+
+/***************************************************************************//**
+ * @name      Initialize Haptics
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_init_Haptics(MotorizedFader_structTd* Fader, uint16_t ForceMax, double Damping)
+{
+  FaderHaptics_set_Damping(&Fader->Haptics, Damping);
+  FaderHaptics_set_ForceMax(&Fader->Haptics, ForceMax);
 }
 
 /* Description in .h */
-void MotorizedFader_manage_WiperInterrupt(ADC_HandleTypeDef* hadc)
+void MotorizedFader_init_HapticDetents(MotorizedFader_structTd* Fader, const FaderHaptics_Detent_structTd* Detents, uint8_t NumDetents)
 {
-  Wiper_manage_Interrupt(hadc);
+  FaderHaptics_set_Detents(&Fader->Haptics, Detents, NumDetents);
 }
 
 /* Description in .h */
-void MotorizedFader_manage_TSCInterrupt()
+void MotorizedFader_init_HapticEndStops(MotorizedFader_structTd* Fader, uint16_t Low, uint16_t High, double Stiffness)
 {
-  TSCButton_manage_Interrupt();
+  FaderHaptics_set_EndStops(&Fader->Haptics, Low, High, Stiffness);
 }
 
 /** @} ************************************************************************/
-/* end of name "Process"
+/* end of name "Initialize Haptics"
  ******************************************************************************/
 
 
 /***************************************************************************//**
- * @name      Set Functions
- * @brief     Use these functions to set values to the fader
+ * @name      Initialize Stall Detection
  * @{
  ******************************************************************************/
 
 /* Description in .h */
-void MotorizedFader_set_Target(MotorizedFader_structTd* Fader, uint16_t Target)
+void MotorizedFader_init_Stall(MotorizedFader_structTd* Fader, uint16_t DutyThreshold, uint16_t MotionBand, uint16_t Count)
+{
+  StallDetector_init(&Fader->Stall, DutyThreshold, MotionBand, Count);
+}
+
+/* Description in .h */
+void MotorizedFader_init_StallBackoff(MotorizedFader_structTd* Fader, uint16_t BackoffCCR, uint16_t BackoffCount, uint8_t Retries)
 {
-  PID_set_Target(&Fader->PID, (double)Target);
+  StallDetector_set_Backoff(&Fader->Stall, BackoffCCR, BackoffCount, Retries);
 }
+
 /** @} ************************************************************************/
-/* end of name "Set Functions"
+/* end of name "Initialize Stall Detection"
  ******************************************************************************/
 
 
 /***************************************************************************//**
- * @name      Get Functions
- * @brief     Use these functions to get values from the fader
+ * @name      Process
+ * @brief     Use these functions to process all faders
  * @{
  ******************************************************************************/
 
-uint16_t MotorizedFader_get_WiperValue(MotorizedFader_structTd* Fader)
+/** @cond *//* Function Prototypes */
+uint32_t get_TimerClock(TIM_HandleTypeDef* htim);
+uint32_t get_ControlTimerPeriodInUs(TIM_HandleTypeDef* htim);
+uint32_t get_FaderSampleTimeInUs(TIM_HandleTypeDef* htim);
+uint16_t get_ADCConversionTicks(TIM_HandleTypeDef* htim);
+void update_ADCTriggerPhase(void);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void MotorizedFader_start_All()
 {
-  uint16_t Value;
-  Value = Wiper_get_SmoothValue(&Fader->Wiper);
-  return Value;
+  /** @internal     1.  Start TSC for all faders */
+  TSCButton_start_All();
+
+  /** @internal     2.  Start ADC for all faders. If the ADC is triggered by
+   *                    the PWM timer, set the trigger phase (no motor runs
+   *                    yet) and start the trigger channel. */
+  Wiper_start_All();
+  TIM_HandleTypeDef* htimTrigger = FadersInternal.htimADCTrigger;
+  if(htimTrigger != NULL)
+  {
+    update_ADCTriggerPhase();
+    HAL_TIM_PWM_Start(htimTrigger, FadersInternal.ADCTriggerChannel);
+  }
+
+  /** @internal     3.  Start PWM for all faders */
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint16_t Index = 0;
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
+    MotorDriver_start_PWM(&Fader->Motor);
+  }
+
+  /** @internal     4.  If a control timer is used: set the sample time of
+   *                    the faders (timer period times stagger groups) to all
+   *                    PIDs and motion profiles and start the timer
+   *                    interrupt. */
+  FaderEvents_init_Queue(&FadersInternal.EventQueue);
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  if(htim != NULL)
+  {
+    uint32_t SampleTime = get_FaderSampleTimeInUs(htim);
+    for(Index = 0; Index < NumFaders; Index++)
+    {
+      MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
+      PIDFixed_set_SampleTimeInUs(&Fader->PID, SampleTime);
+      CascadeController_set_SampleTimeInUs(&Fader->Cascade, SampleTime);
+      FaderHaptics_set_SampleTimeInUs(&Fader->Haptics, SampleTime);
+      MotionProfile_set_SampleTimeInUs(&Fader->Profile, SampleTime);
+    }
+    FadersInternal.ControlGroup = 0;
+    HAL_TIM_Base_Start_IT(htim);
+  }
 }
 
-TSCButton_State_enumTd MotorizedFader_get_TSCState(MotorizedFader_structTd* Fader)
+/**
+ * @brief     Get the clock of a timer from the clock of its APB bus.
+ * @param     htim      pointer to the HAL generated timer handle
+ * @return    timer clock in Hz
+ */
+uint32_t get_TimerClock(TIM_HandleTypeDef* htim)
 {
-  TSCButton_State_enumTd State;
-  State = TSCButton_get_State(&Fader->TouchSense);
-  return State;
+  uint32_t TimerClock = 0;
+  uint32_t APBDivided = 0;
+
+  /** @internal     1.  Get the clock of the APB bus. TIM21 and TIM22 are
+   *                    connected to APB2, all other timers to APB1. */
+  if(htim->Instance == TIM21 || htim->Instance == TIM22)
+  {
+    TimerClock = HAL_RCC_GetPCLK2Freq();
+    APBDivided = RCC->CFGR & RCC_CFGR_PPRE2_2;
+  }
+  else
+  {
+    TimerClock = HAL_RCC_GetPCLK1Freq();
+    APBDivided = RCC->CFGR & RCC_CFGR_PPRE1_2;
+  }
+
+  /** @internal     2.  If the APB clock is divided, the timer clock is
+   *                    doubled (see reference manual, clock tree). */
+  if(APBDivided != 0)
+  {
+    TimerClock = 2 * TimerClock;
+  }
+  return TimerClock;
+}
+
+/**
+ * @brief     Calculate the period of the control timer from the timer clock,
+ *            prescaler and auto reload register.
+ * @param     htim      pointer to the HAL generated timer handle
+ * @return    period in microseconds
+ */
+uint32_t get_ControlTimerPeriodInUs(TIM_HandleTypeDef* htim)
+{
+  /** @internal     1.  Period = (PSC + 1) * (ARR + 1) / TimerClock */
+  uint64_t Ticks = (uint64_t)(htim->Instance->PSC + 1) * (htim->Instance->ARR + 1);
+  return (uint32_t)((Ticks * 1000000) / get_TimerClock(htim));
+}
+
+/**
+ * @brief     Calculate the sample time of the faders. With stagger groups,
+ *            each fader is updated only in every n-th control period.
+ * @param     htim      pointer to the HAL-handle of the control timer
+ * @return    sample time in us
+ */
+uint32_t get_FaderSampleTimeInUs(TIM_HandleTypeDef* htim)
+{
+  uint32_t Groups = (FadersInternal.ControlGroups > 1) ? FadersInternal.ControlGroups : 1;
+  return get_ControlTimerPeriodInUs(htim) * Groups;
+}
+
+/**
+ * @brief     Calculate the duration of one ADC conversion in ticks of the
+ *            trigger timer. In multi trigger oversampling each trigger starts
+ *            exactly one conversion (one oversample of one wiper), so this is
+ *            the time the motor edges have to keep away from the trigger.
+ *
+ *            Ticks = (sampling time + 12.5) ADC cycles * TickHz / ADCClockHz,
+ *            rounded up, with TickHz = timer clock / (PSC + 1). The 12.5
+ *            cycles are the successive approximation of 12 bits. E.g. 3.5
+ *            cycles sampling at 8 MHz (HSI16 / 2): 16 cycles = 2 us, 64 ticks
+ *            at 32 MHz or 32 ticks at 16 MHz (balanced clock profile).
+ * @param     htim      pointer to the HAL-handle of the trigger timer
+ * @return    conversion time in timer ticks
+ */
+uint16_t get_ADCConversionTicks(TIM_HandleTypeDef* htim)
+{
+  /** @internal     1.  Sampling time in half ADC cycles, indexed by the value
+   *                    of ADC_SAMPLETIME_xCYCLES_x (1.5 to 160.5 cycles) */
+  const uint16_t SamplingHalfCycles[8] = {3, 7, 15, 25, 39, 79, 159, 321};
+  uint32_t HalfCycles = SamplingHalfCycles[FadersInternal.ADCSamplingTime & 0x7] + 25;
+
+  /** @internal     2.  Convert to timer ticks, rounded up */
+  uint64_t TickHz = get_TimerClock(htim) / (htim->Instance->PSC + 1);
+  uint64_t Divider = 2 * (uint64_t)FadersInternal.ADCClockHz;
+  uint64_t Ticks = (HalfCycles * TickHz + Divider - 1) / Divider;
+  return (Ticks > UINT16_MAX) ? UINT16_MAX : (uint16_t)Ticks;
+}
+
+/**
+ * @brief     Move the ADC trigger into the widest quiet window of the PWM
+ *            timer. All motor channels switch on at counter = 0 and off at
+ *            their CCR, so the edges split the PWM period into windows. One
+ *            conversion (ADCSampleTicks long, see get_ADCConversionTicks()) is
+ *            centered in the widest one. The conversion time is calculated
+ *            again if the period of the timer changes (clock profile: the
+ *            same period with fewer ticks).
+ *            Channels of stopped motors and CCRs of 0 or the full period do
+ *            not switch. The compare registers are preloaded, so trigger and
+ *            motor CCRs change at the same update event.
+ * @param     none
+ * @return    none
+ */
+void update_ADCTriggerPhase(void)
+{
+  TIM_HandleTypeDef* htim = FadersInternal.htimADCTrigger;
+  uint32_t Edges[4] = {0};
+  uint8_t NumEdges = 0;
+  uint16_t Index = 0;
+
+  if(htim == NULL)
+  {
+    return;
+  }
+
+  /** @internal     1.  Calculate the conversion time in timer ticks if the
+   *                    period changed since the last time */
+  uint32_t Period = __HAL_TIM_GET_AUTORELOAD(htim) + 1;
+  if(Period != FadersInternal.ADCTriggerPeriod)
+  {
+    FadersInternal.ADCSampleTicks = get_ADCConversionTicks(htim);
+    FadersInternal.ADCTriggerPeriod = Period;
+  }
+
+  /** @internal     2.  Sort the switch off edges of the running motors on
+   *                    this timer */
+  for(Index = 0; Index < FadersInternal.NumInitializedFaders && NumEdges < 4; Index++)
+  {
+    TB6612FNGMotorDriver_structTd* Motor = &FadersInternal.InitializedFaders[Index]->Motor;
+    if(Motor->htim != htim || (Motor->Mode != MOTORDRIVER_DIRECTION_CW && Motor->Mode != MOTORDRIVER_DIRECTION_CCW))
+    {
+      continue;
+    }
+    uint32_t CCR = __HAL_TIM_GET_COMPARE(htim, Motor->channel);
+    if(CCR == 0 || CCR >= Period)
+    {
+      continue;
+    }
+    uint8_t Position = NumEdges;
+    while(Position > 0 && Edges[Position - 1] > CCR)
+    {
+      Edges[Position] = Edges[Position - 1];
+      Position--;
+    }
+    Edges[Position] = CCR;
+    NumEdges++;
+  }
+
+  /** @internal     3.  Find the widest window. Without edges the whole
+   *                    period is quiet. The last window ends with the
+   *                    switch on edge of the next period. */
+  uint32_t Start = 0;
+  uint32_t Width = Period;
+  if(NumEdges > 0)
+  {
+    uint32_t Previous = 0;
+    Width = 0;
+    for(Index = 0; Index <= NumEdges; Index++)
+    {
+      uint32_t Edge = (Index < NumEdges) ? Edges[Index] : Period;
+      if(Edge - Previous > Width)
+      {
+        Start = Previous;
+        Width = Edge - Previous;
+      }
+      Previous = Edge;
+    }
+  }
+
+  /** @internal     4.  Center the conversion in the window. If it does not
+   *                    fit, the trigger is in the middle. Never at 0, as the
+   *                    trigger channel needs a rising edge. */
+  uint32_t SampleTicks = FadersInternal.ADCSampleTicks;
+  uint32_t Trigger = Start + ((Width > SampleTicks) ? (Width - SampleTicks) / 2 : Width / 2);
+  __HAL_TIM_SET_COMPARE(htim, FadersInternal.ADCTriggerChannel, (Trigger == 0) ? 1 : Trigger);
+}
+
+/** @cond *//* Function Prototypes */
+void update_Fader(MotorizedFader_structTd* Fader, bool FixedRate);
+void update_FaderEvents(MotorizedFader_structTd* Fader, uint8_t Index, uint32_t TimeUs);
+void update_FaderGangs(void);
+void update_FaderGang(MotorizedFader_gang_structTd* Gang);
+int8_t get_GangLeader(MotorizedFader_gang_structTd* Gang);
+bool update_FaderSettle(MotorizedFader_structTd* Fader, bool FixedRate);
+void park_Fader(MotorizedFader_structTd* Fader);
+bool check_FaderStandbyAllowed(MotorizedFader_structTd* Fader);
+int get_UpdatedPIDOutput(MotorizedFader_structTd* Fader, bool FixedRate);
+void reset_FaderController(MotorizedFader_structTd* Fader);
+void update_FaderHaptics(MotorizedFader_structTd* Fader, bool FixedRate);
+int move_Fader(MotorizedFader_structTd* Fader, int CCR);
+void move_FaderWithoutStartForce(MotorizedFader_structTd* Fader, int CCR);
+int compensate_FaderFriction(MotorizedFader_structTd* Fader, int CCR);
+int limit_FaderStall(MotorizedFader_structTd* Fader, int CCR);
+int16_t get_FaderCCRFraction(MotorizedFader_structTd* Fader);
+void move_FaderMotorFine(MotorizedFader_structTd* Fader, int CCR);
+bool check_FrictionCalibrationRunning(MotorizedFader_structTd* Fader);
+void update_FaderFrictionCalibration(MotorizedFader_structTd* Fader);
+bool check_WiperCalibrationRunning(MotorizedFader_structTd* Fader);
+void update_FaderWiperCalibration(MotorizedFader_structTd* Fader);
+bool check_AutotuneRunning(MotorizedFader_structTd* Fader);
+void update_FaderAutotune(MotorizedFader_structTd* Fader);
+void calculate_FaderAutotune(MotorizedFader_structTd* Fader);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void MotorizedFader_update_All()
+{
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint16_t Index = 0;
+
+  /** @internal     1.  Update all TSCs */
+  PROFILER_ENTER(PROFILER_REGION_TSC);
+  TSCButton_update_All();
+  PROFILER_EXIT(PROFILER_REGION_TSC);
+
+  /** @internal     2.  Calculate the PID coefficients of finished auto
+   *                    tuning relay experiments. This is done here and not
+   *                    in the control timer interrupt, because it needs
+   *                    double operations. */
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
+    calculate_FaderAutotune(Fader);
+  }
+
+  /** @internal     3.  If a control timer is used, wipers, PIDs and motors
+   *                    are updated in the timer interrupt. Leave here. */
+  if(FadersInternal.htimControl != NULL)
+  {
+    return;
+  }
+
+  /** @internal     4.  Update all wipers */
+  Wiper_update_All();
+
+  /** @internal     5.  The leaders of the gangs set the targets of the
+   *                    other members */
+  update_FaderGangs();
+
+  /** @internal     6.  Loop through all faders and update them and their
+   *                    events. The events get the time of the timer
+   *                    service. */
+  uint32_t TimeUs = TimerService_get_TimeUs();
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
+    update_Fader(Fader, false);
+    update_FaderEvents(Fader, (uint8_t)Index, TimeUs);
+  }
+
+  /** @internal     7.  Move the ADC trigger away from the new PWM edges */
+  update_ADCTriggerPhase();
+}
+
+/**
+ * @brief     Update the settle detector of a fader. The setpoint reached the
+ *            target, if the motion profile finished (fixed rate) or always
+ *            without control timer. After waking up, the PID and the friction
+ *            feed-forward start without old values.
+ * @param     Fader     pointer to the users fader structure
+ * @param     FixedRate true if called by the control timer interrupt
+ * @return    true if the fader is settled
+ */
+bool update_FaderSettle(MotorizedFader_structTd* Fader, bool FixedRate)
+{
+  int32_t Target = MotionProfile_get_Target(&Fader->Profile);
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+  bool SetpointAtTarget = true;
+
+  if(FixedRate == true)
+  {
+    SetpointAtTarget = (MotionProfile_get_Setpoint(&Fader->Profile) == Target && MotionProfile_get_Velocity(&Fader->Profile) == 0);
+  }
+
+  bool WasSettled = (SettleDetector_get_State(&Fader->Settle) == SETTLEDETECTOR_SETTLED);
+  bool Settled = SettleDetector_update(&Fader->Settle, Target, Sample, SetpointAtTarget);
+  if(WasSettled == true && Settled == false)
+  {
+    reset_FaderController(Fader);
+    FrictionModel_restart(&Fader->Friction, Sample);
+  }
+  return Settled;
+}
+
+/**
+ * @brief     Park the motor driver of a settled fader. Standby is only used,
+ *            if all faders on the same STBY pin are settled. Otherwise the
+ *            motor coasts.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void park_Fader(MotorizedFader_structTd* Fader)
+{
+  if(Fader->Park == MOTORIZEDFADER_PARK_STANDBY && check_FaderStandbyAllowed(Fader) == true)
+  {
+    MotorDriver_standby(&Fader->Motor);
+  }
+  else
+  {
+    MotorDriver_stop(&Fader->Motor);
+  }
+}
+
+/**
+ * @brief     Check if all other faders on the same STBY pin are settled.
+ * @param     Fader     pointer to the users fader structure
+ * @return    true if the STBY pin may be pulled low
+ */
+bool check_FaderStandbyAllowed(MotorizedFader_structTd* Fader)
+{
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint16_t Index = 0;
+
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Other = FadersInternal.InitializedFaders[Index];
+    if(Other == Fader || Other->Motor.GPIOSTBY != Fader->Motor.GPIOSTBY || Other->Motor.PinSTBY != Fader->Motor.PinSTBY)
+    {
+      continue;
+    }
+    if(SettleDetector_get_State(&Other->Settle) != SETTLEDETECTOR_SETTLED)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief     Update all gangs. The follow flags of all faders are cleared
+ *            first and set again for the followers of a leading fader.
+ * @return    none
+ */
+void update_FaderGangs(void)
+{
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint16_t Index = 0;
+
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    FadersInternal.InitializedFaders[Index]->Following = false;
+  }
+  for(Index = 0; Index < NUMBER_OF_FADER_GANGS; Index++)
+  {
+    if(FadersInternal.Gangs[Index].Mode != MOTORIZEDFADER_GANG_OFF)
+    {
+      update_FaderGang(&FadersInternal.Gangs[Index]);
+    }
+  }
+}
+
+/**
+ * @brief     Update one gang: find the leader and set the targets of the
+ *            other members to the position of the leader plus their offset.
+ * @param     Gang      pointer to the internal gang structure
+ * @return    none
+ */
+void update_FaderGang(MotorizedFader_gang_structTd* Gang)
+{
+  MotorizedFader_structTd** Faders = FadersInternal.InitializedFaders;
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint32_t Members = Gang->Members;
+  uint16_t Index = 0;
+  int8_t Leader = get_GangLeader(Gang);
+
+  /** @internal     1.  A new leader: the old one stays where it was
+   *                    released. The distances of the members to the new
+   *                    leader are stored (0 for master / slave and
+   *                    absolute). */
+  if(Leader != Gang->Leader)
+  {
+    if(Gang->Leader >= 0 && (Members & (1UL << Gang->Leader)) != 0)
+    {
+      MotorizedFader_structTd* Old = Faders[Gang->Leader];
+      MotorizedFader_set_Target(Old, MotorizedFader_get_WiperValue(Old));
+    }
+    if(Leader >= 0)
+    {
+      int32_t LeaderPosition = (int32_t)MotorizedFader_get_WiperValue(Faders[Leader]);
+      for(Index = 0; Index < NumFaders; Index++)
+      {
+        int32_t Target = WiperLinear_convert_RawToLinear(&Faders[Index]->Linear, (uint16_t)MotionProfile_get_Target(&Faders[Index]->Profile));
+        Gang->Offsets[Index] = (Gang->Mode == MOTORIZEDFADER_GANG_RELATIVE) ? (int16_t)(Target - LeaderPosition) : 0;
+      }
+    }
+    Gang->Leader = Leader;
+  }
+
+  /** @internal     2.  Leave if no member leads */
+  if(Leader < 0)
+  {
+    return;
+  }
+
+  /** @internal     3.  The other members follow the leader. Their setpoints
+   *                    skip the motion profile. */
+  int32_t LeaderPosition = (int32_t)MotorizedFader_get_WiperValue(Faders[Leader]);
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    if(Index == (uint16_t)Leader || (Members & (1UL << Index)) == 0)
+    {
+      continue;
+    }
+    MotorizedFader_structTd* Fader = Faders[Index];
+    int32_t Target = LeaderPosition + Gang->Offsets[Index];
+    if(Target < 0)
+    {
+      Target = 0;
+    }
+    else if(Target > WIPERLINEAR_MAX_VALUE)
+    {
+      Target = WIPERLINEAR_MAX_VALUE;
+    }
+    uint16_t Raw = WiperLinear_convert_LinearToRaw(&Fader->Linear, (uint16_t)Target);
+    MotionProfile_follow(&Fader->Profile, (int32_t)Raw);
+    Fader->Following = true;
+  }
+}
+
+/**
+ * @brief     Find the leader of a gang. With master / slave, only the touched
+ *            master leads. With relative and absolute gangs, the leader
+ *            stays as long as it is touched. Otherwise the first touched
+ *            member leads.
+ * @param     Gang      pointer to the internal gang structure
+ * @return    internal index of the leader, -1 if no member leads
+ */
+int8_t get_GangLeader(MotorizedFader_gang_structTd* Gang)
+{
+  MotorizedFader_structTd** Faders = FadersInternal.InitializedFaders;
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint32_t Members = Gang->Members;
+  uint16_t Index = 0;
+
+  if(Gang->Mode == MOTORIZEDFADER_GANG_MASTER_SLAVE)
+  {
+    Index = Gang->Master;
+    if((Members & (1UL << Index)) != 0 && TSCButton_get_State(&Faders[Index]->TouchSense) == TSCBUTTON_TOUCHED)
+    {
+      return (int8_t)Index;
+    }
+    return -1;
+  }
+
+  if(Gang->Leader >= 0 && (Members & (1UL << Gang->Leader)) != 0 && TSCButton_get_State(&Faders[Gang->Leader]->TouchSense) == TSCBUTTON_TOUCHED)
+  {
+    return Gang->Leader;
+  }
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    if((Members & (1UL << Index)) != 0 && TSCButton_get_State(&Faders[Index]->TouchSense) == TSCBUTTON_TOUCHED)
+    {
+      return (int8_t)Index;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief     Write the events of one fader: touch edges, position changes
+ *            and velocity.
+ * @param     Fader     pointer to the users fader structure
+ * @param     Index     index of the fader in the internal structure
+ * @param     TimeUs    time of detection
+ * @return    none
+ */
+void update_FaderEvents(MotorizedFader_structTd* Fader, uint8_t Index, uint32_t TimeUs)
+{
+  uint16_t Position = MotorizedFader_get_WiperValue(Fader);
+  bool Touched = (TSCButton_get_State(&Fader->TouchSense) == TSCBUTTON_TOUCHED);
+  FaderEvents_update_Tracker(&FadersInternal.EventQueue, &Fader->Events, Index, Position, Touched, TimeUs);
+
+  /** @internal     1.  Stalls are written by the same producer as the other
+   *                    events, if the events of this fader are enabled */
+  if(StallDetector_check_Event(&Fader->Stall) == true && Fader->Events.Resolution != 0)
+  {
+    FaderEvents_write_Event(&FadersInternal.EventQueue, &Fader->Events, FADEREVENTS_STALL, Index, Position, TimeUs);
+  }
+}
+
+/**
+ * @brief     Update PID and motor of one fader depending on the TSC state.
+ * @param     Fader     pointer to the users fader structure
+ * @param     FixedRate "true" if called with the fixed rate of the control
+ *                      timer, "false" if the PID sample timer has to be
+ *                      checked.
+ * @return    none
+ */
+void update_Fader(MotorizedFader_structTd* Fader, bool FixedRate)
+{
+  /** @internal     1.  Get the current TSC state */
+  TSCButton_State_enumTd TSCState;
+  TSCState = TSCButton_get_State(&Fader->TouchSense);
+
+  /** @internal     2.  The haptics start at rest with each touch */
+  if(TSCState != TSCBUTTON_TOUCHED)
+  {
+    FaderHaptics_reset(&Fader->Haptics);
+  }
+
+  /** @internal     3.  If TSC is not touched, update PID and move fader with
+   *                    the new CCR value. If it is touched, reset PID and
+   *                    motion profile and stop the motor or render the
+   *                    haptics. The profile starts again at the released
+   *                    position.*/
+  if(TSCState == TSCBUTTON_TOUCHED)
+  {
+    reset_FaderController(Fader);
+    MotionProfile_reset(&Fader->Profile);
+    PIDAutotune_abort(&Fader->Autotune);
+    FrictionModel_abort(&Fader->Friction);
+    WiperLinear_abort(&Fader->Linear);
+    SettleDetector_reset(&Fader->Settle);
+    StallDetector_reset(&Fader->Stall);
+    update_FaderHaptics(Fader, FixedRate);
+  }
+  /** @internal     4.  While the auto tuning is running (only with fixed
+   *                    rate), it controls the motor instead of the PID. */
+  else if(FixedRate == true && check_AutotuneRunning(Fader) == true)
+  {
+    SettleDetector_reset(&Fader->Settle);
+    update_FaderAutotune(Fader);
+  }
+  /** @internal     5.  The same for the friction and wiper calibration
+   *                    sweeps. The settle detector is reset, so the shared
+   *                    STBY pin is not pulled low while a sweep runs. */
+  else if(FixedRate == true && check_FrictionCalibrationRunning(Fader) == true)
+  {
+    SettleDetector_reset(&Fader->Settle);
+    update_FaderFrictionCalibration(Fader);
+  }
+  else if(FixedRate == true && check_WiperCalibrationRunning(Fader) == true)
+  {
+    SettleDetector_reset(&Fader->Settle);
+    update_FaderWiperCalibration(Fader);
+  }
+  /** @internal     6.  A settled fader skips the PID and parks the motor
+   *                    driver */
+  else if(TSCState == TSCBUTTON_RELEASED && update_FaderSettle(Fader, FixedRate) == true)
+  {
+    park_Fader(Fader);
+  }
+  /** @internal     7.  With fixed rate and calibrated friction, the friction
+   *                    feed-forward replaces start force and stop range.
+   *                    Otherwise the PID gets the CCR applied after start
+   *                    force and stop range (back-calculation). With fixed
+   *                    rate, the stall detector limits the CCR of a blocked
+   *                    fader. The fraction of the PID result is dithered. */
+  else if(TSCState == TSCBUTTON_RELEASED)
+  {
+    PROFILER_ENTER(PROFILER_REGION_PID);
+    int CCR = get_UpdatedPIDOutput(Fader, FixedRate);
+    PROFILER_EXIT(PROFILER_REGION_PID);
+    Fader->CCRFraction = get_FaderCCRFraction(Fader);
+    if(FixedRate == true && FrictionModel_get_State(&Fader->Friction) == FRICTIONMODEL_CALIBRATED)
+    {
+      CCR = compensate_FaderFriction(Fader, CCR);
+      CCR = limit_FaderStall(Fader, CCR);
+      move_FaderWithoutStartForce(Fader, CCR);
+    }
+    else
+    {
+      if(FixedRate == true)
+      {
+        CCR = limit_FaderStall(Fader, CCR);
+      }
+      int AppliedCCR = move_Fader(Fader, CCR);
+      if(FixedRate == true && Fader->Controller == MOTORIZEDFADER_CONTROLLER_PID)
+      {
+        PIDFixed_track_Output(&Fader->PID, AppliedCCR);
+      }
+    }
+  }
+}
+
+/**
+ * @brief     Limit the CCR of a stalled fader. While the power is backed off,
+ *            the controller is reset, so it does not wind up and the retry
+ *            starts without old values.
+ * @param     Fader     pointer to the users fader structure
+ * @param     CCR       CCR of the controller. - is down, + is up
+ * @return    CCR to move the fader with
+ */
+int limit_FaderStall(MotorizedFader_structTd* Fader, int CCR)
+{
+  int32_t Target = MotionProfile_get_Target(&Fader->Profile);
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+
+  int LimitedCCR = StallDetector_update(&Fader->Stall, CCR, Target, Sample);
+  if(StallDetector_get_State(&Fader->Stall) != STALLDETECTOR_RUNNING)
+  {
+    reset_FaderController(Fader);
+  }
+  /* A limited CCR has no fraction to dither */
+  if(LimitedCCR != CCR)
+  {
+    Fader->CCRFraction = 0;
+  }
+  return LimitedCCR;
+}
+
+/**
+ * @brief     Check if the friction calibration of the fader is running.
+ * @param     Fader     pointer to the users fader structure
+ * @return    true if the calibration sweep controls the motor
+ */
+bool check_FrictionCalibrationRunning(MotorizedFader_structTd* Fader)
+{
+  FrictionModel_State_enumTd State = FrictionModel_get_State(&Fader->Friction);
+  return (State == FRICTIONMODEL_HOME || State == FRICTIONMODEL_REST
+          || State == FRICTIONMODEL_BREAKAWAY || State == FRICTIONMODEL_COULOMB);
+}
+
+/**
+ * @brief     Move the fader with the CCR of the friction calibration sweep.
+ *            When the sweep is finished, PID and motion profile start again
+ *            at the current position.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void update_FaderFrictionCalibration(MotorizedFader_structTd* Fader)
+{
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+  int CCR = (int)FrictionModel_update_Calibration(&Fader->Friction, Sample);
+  move_FaderWithoutStartForce(Fader, CCR);
+
+  if(check_FrictionCalibrationRunning(Fader) == false)
+  {
+    reset_FaderController(Fader);
+    MotionProfile_reset(&Fader->Profile);
+  }
+}
+
+/**
+ * @brief     Check if the wiper calibration of the fader is running.
+ * @param     Fader     pointer to the users fader structure
+ * @return    true if the calibration sweep controls the motor
+ */
+bool check_WiperCalibrationRunning(MotorizedFader_structTd* Fader)
+{
+  WiperLinear_State_enumTd State = WiperLinear_get_State(&Fader->Linear);
+  return (State == WIPERLINEAR_HOME || State == WIPERLINEAR_SWEEP_UP || State == WIPERLINEAR_SWEEP_DOWN);
+}
+
+/**
+ * @brief     Move the fader with the CCR of the wiper calibration sweep. If
+ *            the friction model is calibrated, its feed-forward of the zone
+ *            is added, so the speed varies less along the travel. When the
+ *            sweep is finished, PID and motion profile start again at the
+ *            current position.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void update_FaderWiperCalibration(MotorizedFader_structTd* Fader)
+{
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+  int CCR = (int)WiperLinear_update_Calibration(&Fader->Linear, Sample);
+  if(CCR != 0 && FrictionModel_get_State(&Fader->Friction) == FRICTIONMODEL_CALIBRATED)
+  {
+    /* The sweep direction is the setpoint velocity, so the model never
+     * rests and adds breakaway or Coulomb CCR */
+    CCR = (int)FrictionModel_compensate(&Fader->Friction, (int32_t)CCR, 0, (int32_t)CCR, Sample);
+  }
+  move_FaderWithoutStartForce(Fader, CCR);
+
+  if(check_WiperCalibrationRunning(Fader) == false)
+  {
+    reset_FaderController(Fader);
+    MotionProfile_reset(&Fader->Profile);
+  }
+}
+
+/**
+ * @brief     Add the friction feed-forward to the PID output. While the
+ *            fader rests within the rest band, the PID is reset, so the
+ *            integral does not wind up against the static friction.
+ * @param     Fader     pointer to the users fader structure
+ * @param     CCR       PID output
+ * @return    CCR value for the motors PWM
+ */
+int compensate_FaderFriction(MotorizedFader_structTd* Fader, int CCR)
+{
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+  int32_t Error = MotionProfile_get_Setpoint(&Fader->Profile) - Sample;
+  int32_t Velocity = MotionProfile_get_Velocity(&Fader->Profile);
+
+  CCR = (int)FrictionModel_compensate(&Fader->Friction, (int32_t)CCR, Error, Velocity, Sample);
+  if(FrictionModel_check_Resting(&Fader->Friction) == true)
+  {
+    reset_FaderController(Fader);
+  }
+  return CCR;
+}
+
+/**
+ * @brief     Check if the auto tuning of the fader is running.
+ * @param     Fader     pointer to the users fader structure
+ * @return    true if the auto tuning controls the motor
+ */
+bool check_AutotuneRunning(MotorizedFader_structTd* Fader)
+{
+  PIDAutotune_State_enumTd State = PIDAutotune_get_State(&Fader->Autotune);
+  return (State == PIDAUTOTUNE_RELAY || State == PIDAUTOTUNE_CALCULATE || State == PIDAUTOTUNE_STEP);
+}
+
+/**
+ * @brief     Move the fader according to the state of the auto tuning.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void update_FaderAutotune(MotorizedFader_structTd* Fader)
+{
+  PIDAutotune_structTd* Autotune = &Fader->Autotune;
+  int32_t Sample = (int32_t)Wiper_get_SmoothValue(&Fader->Wiper);
+  int CCR = 0;
+
+  switch(PIDAutotune_get_State(Autotune))
+  {
+    /** @internal     1.  Relay: move the fader with the relay output */
+    case PIDAUTOTUNE_RELAY:
+      CCR = (int)PIDAutotune_update_Relay(Autotune, Sample);
+      move_Fader(Fader, CCR);
+      break;
+
+    /** @internal     2.  Step: move the fader to the step target with the
+     *                    new coefficients and measure the step response. When
+     *                    it is done, the fader stays at the step target. */
+    case PIDAUTOTUNE_STEP:
+      PIDFixed_set_Target(&Fader->PID, PIDAutotune_get_StepTarget(Autotune));
+      PIDFixed_calculate(&Fader->PID, Sample);
+      CCR = PIDFixed_get_OutputRound(&Fader->PID);
+      move_Fader(Fader, CCR);
+      PIDAutotune_update_Step(Autotune, Sample);
+      if(PIDAutotune_get_State(Autotune) == PIDAUTOTUNE_DONE)
+      {
+        MotionProfile_reset(&Fader->Profile);
+        MotionProfile_set_Target(&Fader->Profile, PIDAutotune_get_StepTarget(Autotune));
+      }
+      break;
+
+    /** @internal     3.  Calculate: stop the motor until the coefficients are
+     *                    set in MotorizedFader_update_All() */
+    default:
+      MotorDriver_stop(&Fader->Motor);
+      break;
+  }
+}
+
+/**
+ * @brief     Calculate the PID coefficients after the relay experiment, set
+ *            them to the PID of the fader and start the step response.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void calculate_FaderAutotune(MotorizedFader_structTd* Fader)
+{
+  PIDAutotune_structTd* Autotune = &Fader->Autotune;
+
+  if(PIDAutotune_get_State(Autotune) != PIDAUTOTUNE_CALCULATE)
+  {
+    return;
+  }
+
+  /** @internal     1.  The PID is not used by the interrupt in this state,
+   *                    so the coefficients can be set here. */
+  if(PIDAutotune_calculate_Gains(Autotune) == true)
+  {
+    PIDAutotune_Result_structTd Result = PIDAutotune_get_Result(Autotune);
+    PIDFixed_set_KpKiKd(&Fader->PID, Result.Kp, Result.Ki, Result.Kd);
+    reset_FaderController(Fader);
+    PIDAutotune_start_Step(Autotune);
+  }
+}
+
+/**
+ * @brief     Update PID (or the cascade controller with fixed rate) with the
+ *            new value
+ * @param     Fader     pointer to the users fader structure
+ * @param     FixedRate "true" to calculate the PID without checking the sample
+ *                      timer.
+ * @return    int CCR value calculated by PID
+ */
+int get_UpdatedPIDOutput(MotorizedFader_structTd* Fader, bool FixedRate)
+{
+  int ReturnCCR = 0;
+  /** @intenral     1.  Get current ADC sample */
+  uint16_t ADCSample = Wiper_get_SmoothValue(&Fader->Wiper);
+  /** @internal     2.  Update PID with new sample. With fixed rate, the
+   *                    setpoint is moved along the motion profile first
+   *                    (unless it follows the leader of a gang).
+   *                    Otherwise the target is used as setpoint. */
+  if(FixedRate == true)
+  {
+    int32_t Setpoint = MotionProfile_get_Setpoint(&Fader->Profile);
+    int32_t SetpointVelocity = 0;
+    if(Fader->Following == false)
+    {
+      Setpoint = MotionProfile_update(&Fader->Profile, (int32_t)ADCSample);
+      SetpointVelocity = MotionProfile_get_Velocity(&Fader->Profile);
+    }
+    /** @internal     3.  The cascade controller uses the raw sample and the
+     *                    velocity of the profile instead of the PID */
+    if(Fader->Controller == MOTORIZEDFADER_CONTROLLER_CASCADE)
+    {
+      int32_t RawSample = (int32_t)Wiper_get_RawValue(&Fader->Wiper);
+      return CascadeController_calculate(&Fader->Cascade, Setpoint, SetpointVelocity, RawSample);
+    }
+    PIDFixed_set_Target(&Fader->PID, Setpoint);
+    PIDFixed_calculate(&Fader->PID, (int32_t)ADCSample);
+  }
+  else
+  {
+    PIDFixed_set_Target(&Fader->PID, MotionProfile_get_Target(&Fader->Profile));
+    PIDFixed_update(&Fader->PID, (int32_t)ADCSample);
+  }
+  /** @intenral     4.  Get the round PID outout to return */
+  ReturnCCR = PIDFixed_get_OutputRound(&Fader->PID);
+
+  return ReturnCCR;
+}
+
+/**
+ * @brief     Reset PID and cascade controller, so the next update starts
+ *            without old values.
+ * @param     Fader     pointer to the users fader structure
+ * @return    none
+ */
+void reset_FaderController(MotorizedFader_structTd* Fader)
+{
+  PIDFixed_reset(&Fader->PID);
+  CascadeController_reset(&Fader->Cascade);
+}
+
+/**
+ * @brief     Render the haptic force field of a touched fader. Without
+ *            haptics or control timer the motor is stopped.
+ * @param     Fader     pointer to the users fader structure
+ * @param     FixedRate true if called by the control timer interrupt
+ * @return    none
+ */
+void update_FaderHaptics(MotorizedFader_structTd* Fader, bool FixedRate)
+{
+  if(FixedRate == false || FaderHaptics_check_Enabled(&Fader->Haptics) == false)
+  {
+    MotorDriver_stop(&Fader->Motor);
+    return;
+  }
+
+  /** @internal     1.  Force at the current position in the units of the
+   *                    target */
+  uint16_t Position = Wiper_get_SmoothValue(&Fader->Wiper);
+  Position = WiperLinear_convert_RawToLinear(&Fader->Linear, Position);
+  int Force = FaderHaptics_calculate(&Fader->Haptics, (int32_t)Position);
+
+  /** @internal     2.  The force is rendered directly, without start force
+   *                    and stop range */
+  move_FaderWithoutStartForce(Fader, Force);
+}
+
+/**
+ * @brief     Get the fractional part of the PID result in dither bits.
+ * @param     Fader   pointer to the users fader structure
+ * @return    PID result in dither bits minus the round PID result in dither
+ *            bits. 0 without dither or with the cascade controller.
+ */
+int16_t get_FaderCCRFraction(MotorizedFader_structTd* Fader)
+{
+  uint8_t Bits = Fader->Motor.DitherBits;
+  int32_t Raw = 0;
+  int32_t Fine = 0;
+
+  /** @internal     1.  No fraction without dither or from the cascade
+   *                    controller */
+  if(Bits == 0 || Fader->Controller != MOTORIZEDFADER_CONTROLLER_PID)
+  {
+    return 0;
+  }
+
+  /** @internal     2.  Round the magnitude of the raw result to the dither
+   *                    bits (like the round result) and remove the whole CCR
+   *                    steps */
+  Raw = PIDFixed_get_OutputRaw(&Fader->PID);
+  Fine = (((Raw < 0) ? -Raw : Raw) + (((int32_t)1 << (PIDFIXED_Q_SHIFT - Bits)) >> 1)) >> (PIDFIXED_Q_SHIFT - Bits);
+  Fine = (Raw < 0) ? -Fine : Fine;
+  return (int16_t)(Fine - (int32_t)PIDFixed_get_OutputRound(&Fader->PID) * ((int32_t)1 << Bits));
+}
+
+/**
+ * @brief     Move the motor with the CCR plus the fraction of the last
+ *            get_FaderCCRFraction(). The fraction is used once.
+ * @param     Fader   pointer to the users fader structure
+ * @param     CCR     CCR value for the motors PWM. - is down, + is up
+ * @return    none
+ */
+void move_FaderMotorFine(MotorizedFader_structTd* Fader, int CCR)
+{
+  int32_t Fine = (int32_t)CCR * ((int32_t)1 << Fader->Motor.DitherBits) + Fader->CCRFraction;
+
+  Fader->CCRFraction = 0;
+  /** @internal     1.  The direction is given by the CCR, the fraction can
+   *                    not reverse it */
+  if(CCR < 0)
+  {
+    MotorDriver_move_CounterClockWiseFine(&Fader->Motor, (Fine < 0) ? (uint32_t)(-Fine) : 0);
+  }
+  else
+  {
+    MotorDriver_move_ClockWiseFine(&Fader->Motor, (Fine > 0) ? (uint32_t)Fine : 0);
+  }
+}
+
+/**
+ * @brief     Move fader with the new CCR value. The PID result is moved with
+ *            the fraction of the last get_FaderCCRFraction(), start force
+ *            with whole steps.
+ * @param     Fader   pointer to the users fader structure
+ * @param     int     CCR value for the motors PWM
+ * @return    CCR that was applied. - is down, + is up
+ */
+int move_Fader(MotorizedFader_structTd* Fader, int CCR)
+{
+  int CCRStartForce = Fader->CCRStartForce;
+  int CCRStopRange = Fader->CCRStopRange;
+  int AppliedCCR = 0;
+
+  /** @internal     1.  Check if CCR is bigger then the required start
+   *                    CCR value. If yes, move the motor according to the CCR
+   *                    sign. - is down, + is up */
+  if(CCR < -CCRStartForce)
+  {
+    /* Move down with PID result */
+    move_FaderMotorFine(Fader, CCR);
+    AppliedCCR = CCR;
+  }
+  else if(CCR > CCRStartForce)
+  {
+    /* Move up with PID result */
+    move_FaderMotorFine(Fader, CCR);
+    AppliedCCR = CCR;
+  }
+  /** @internal     2.  If CCR is not in the Stop CCRT range, but lower
+   *                    than the required start force, move the fader with
+   *                    the start force value in the direction according to the
+   *                    CCR sign*/
+  else if(CCR < -CCRStopRange && CCR >= -CCRStartForce)
+  {
+    /* Move down with Start Force (slowest possible) */
+    MotorDriver_move_CounterClockWise(&Fader->Motor, CCRStartForce);
+    AppliedCCR = -CCRStartForce;
+  }
+
+  else if(CCR > CCRStopRange && CCR <= CCRStartForce)
+  {
+    /* Move up with Start Force (slowest possible) */
+   MotorDriver_move_ClockWise(&Fader->Motor, CCRStartForce);
+   AppliedCCR = CCRStartForce;
+  }
+  /** @internal     3.  It the motor is in the Stop CCR range, stop the motor */
+  else
+  {
+   MotorDriver_stop(&Fader->Motor);
+  }
+
+  Fader->CCRFraction = 0;
+  return AppliedCCR;
+}
+
+/**
+ * @brief     Move fader with the CCR value without start force and stop
+ *            range. Used with the friction model, which already contains
+ *            the force to start and stop the fader. The fraction of the last
+ *            get_FaderCCRFraction() is added.
+ * @param     Fader   pointer to the users fader structure
+ * @param     CCR     CCR value for the motors PWM. - is down, + is up
+ * @return    none
+ */
+void move_FaderWithoutStartForce(MotorizedFader_structTd* Fader, int CCR)
+{
+  if(CCR != 0)
+  {
+    move_FaderMotorFine(Fader, CCR);
+  }
+  else
+  {
+    MotorDriver_stop(&Fader->Motor);
+    Fader->CCRFraction = 0;
+  }
+}
+
+/* Description in .h */
+void MotorizedFader_manage_WiperInterrupt(ADC_HandleTypeDef* hadc)
+{
+  Wiper_manage_Interrupt(hadc);
+}
+
+/* Description in .h */
+void MotorizedFader_manage_WiperHalfInterrupt(ADC_HandleTypeDef* hadc)
+{
+  Wiper_manage_HalfInterrupt(hadc);
+}
+
+/* Description in .h */
+void MotorizedFader_manage_TSCInterrupt()
+{
+  TSCButton_manage_Interrupt();
+}
+
+/* Description in .h */
+void MotorizedFader_manage_ControlTimerInterrupt(TIM_HandleTypeDef* htim)
+{
+  /** @internal     1.  Leave if this is not the control timer */
+  if(htim != FadersInternal.htimControl || htim == NULL)
+  {
+    return;
+  }
+
+  /** @internal     2.  Take the time of the events from the timer service
+   *                    and hand over the newest ADC samples to the wipers */
+  PROFILER_ENTER(PROFILER_REGION_CONTROL);
+  uint32_t TimeUs = TimerService_get_TimeUs();
+  Wiper_update_All();
+
+  /** @internal     3.  The leaders of the gangs set the setpoints of the
+   *                    other members */
+  update_FaderGangs();
+
+  /** @internal     4.  Update PID and motor of all faders (or of the
+   *                    faders of the current stagger group) with fixed rate.
+   *                    The events of all faders are updated. */
+  uint16_t NumFaders = FadersInternal.NumInitializedFaders;
+  uint16_t Index = 0;
+  uint8_t Groups = FadersInternal.ControlGroups;
+  uint8_t Group = FadersInternal.ControlGroup;
+  for(Index = 0; Index < NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Fader = FadersInternal.InitializedFaders[Index];
+    if(Groups <= 1 || (Index % Groups) == Group)
+    {
+      update_Fader(Fader, true);
+    }
+    update_FaderEvents(Fader, (uint8_t)Index, TimeUs);
+  }
+  if(Groups > 1)
+  {
+    Group++;
+    FadersInternal.ControlGroup = (Group >= Groups) ? 0 : Group;
+  }
+  update_ADCTriggerPhase();
+
+  /** @internal     5.  Measure the duration of this interrupt. The counter
+   *                    started at 0 when the period elapsed. */
+  uint16_t Ticks = (uint16_t)__HAL_TIM_GET_COUNTER(htim);
+  if(Ticks > FadersInternal.ControlTicksMax)
+  {
+    FadersInternal.ControlTicksMax = Ticks;
+  }
+
+  /** @internal     6.  If the update flag is set again, the next period
+   *                    elapsed before this interrupt was finished. */
+  if(__HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE) != RESET)
+  {
+    FadersInternal.ControlOverruns++;
+  }
+  PROFILER_EXIT(PROFILER_REGION_CONTROL);
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Set Functions
+ * @brief     Use these functions to set values to the fader
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void MotorizedFader_set_Target(MotorizedFader_structTd* Fader, uint16_t Target)
+{
+  /** @internal     1.  The PID controls the wiper value, so the linear
+   *                    target is converted back to the wiper value. */
+  uint16_t Raw = WiperLinear_convert_LinearToRaw(&Fader->Linear, Target);
+  MotionProfile_set_Target(&Fader->Profile, (int32_t)Raw);
+}
+
+/* Description in .h */
+void MotorizedFader_start_Autotune(MotorizedFader_structTd* Fader, uint16_t Center, uint16_t StepTarget)
+{
+  /** @internal     1.  The auto tuning needs the fixed rate of the control
+   *                    timer. Leave if there is none. */
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  if(htim == NULL)
+  {
+    return;
+  }
+
+  /** @internal     2.  Start the relay experiment with the control period as
+   *                    sample time */
+  reset_FaderController(Fader);
+  Center = WiperLinear_convert_LinearToRaw(&Fader->Linear, Center);
+  StepTarget = WiperLinear_convert_LinearToRaw(&Fader->Linear, StepTarget);
+  PIDAutotune_start(&Fader->Autotune, (int32_t)Center, (int32_t)StepTarget, get_FaderSampleTimeInUs(htim));
+}
+
+/* Description in .h */
+void MotorizedFader_start_FrictionCalibration(MotorizedFader_structTd* Fader)
+{
+  /** @internal     1.  The calibration needs the fixed rate of the control
+   *                    timer. Leave if there is none. */
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  if(htim == NULL)
+  {
+    return;
+  }
+
+  /** @internal     2.  Start the sweep with the PID output limit as largest
+   *                    CCR and the control period as sample time */
+  reset_FaderController(Fader);
+  FrictionModel_start_Calibration(&Fader->Friction, (int32_t)Fader->CCRMax, get_FaderSampleTimeInUs(htim));
+}
+
+/* Description in .h */
+void MotorizedFader_start_WiperCalibration(MotorizedFader_structTd* Fader, uint16_t SweepCCR)
+{
+  /** @internal     1.  The calibration needs the fixed rate of the control
+   *                    timer. Leave if there is none. */
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  if(htim == NULL)
+  {
+    return;
+  }
+
+  /** @internal     2.  Start the sweep with the control period as sample
+   *                    time */
+  reset_FaderController(Fader);
+  WiperLinear_start_Calibration(&Fader->Linear, (int32_t)SweepCCR, get_FaderSampleTimeInUs(htim));
+}
+
+/* Description in .h */
+bool MotorizedFader_set_Gang(uint8_t Gang, MotorizedFader_Gang_enumTd Mode, MotorizedFader_structTd** Faders, uint8_t NumFaders)
+{
+  uint16_t NumInitialized = FadersInternal.NumInitializedFaders;
+  uint32_t Members = 0;
+  uint8_t Master = 0;
+  uint16_t Index = 0;
+  uint16_t Member = 0;
+
+  if(Gang >= NUMBER_OF_FADER_GANGS)
+  {
+    return false;
+  }
+
+  /** @internal     1.  Switch the gang off, so the interrupt does not use
+   *                    it while it is changed */
+  MotorizedFader_gang_structTd* Internal = &FadersInternal.Gangs[Gang];
+  Internal->Mode = MOTORIZEDFADER_GANG_OFF;
+  if(Mode == MOTORIZEDFADER_GANG_OFF)
+  {
+    Internal->Members = 0;
+    return true;
+  }
+
+  /** @internal     2.  Collect the internal indices of the members. The
+   *                    first one is the master. */
+  for(Member = 0; Member < NumFaders; Member++)
+  {
+    for(Index = 0; Index < NumInitialized; Index++)
+    {
+      if(FadersInternal.InitializedFaders[Index] == Faders[Member])
+      {
+        break;
+      }
+    }
+    if(Index >= NumInitialized)
+    {
+      Internal->Members = 0;
+      return false;
+    }
+    if(Member == 0)
+    {
+      Master = (uint8_t)Index;
+    }
+    Members |= (1UL << Index);
+  }
+
+  /** @internal     3.  A fader is member of only one gang */
+  for(Index = 0; Index < NUMBER_OF_FADER_GANGS; Index++)
+  {
+    if(Index != Gang)
+    {
+      FadersInternal.Gangs[Index].Members &= ~Members;
+    }
+  }
+
+  /** @internal     4.  Store the gang. The mode is set last. */
+  Internal->Members = Members;
+  Internal->Master = Master;
+  Internal->Leader = -1;
+  Internal->Mode = Mode;
+  return true;
+}
+
+/* Description in .h */
+void MotorizedFader_set_HapticSpring(MotorizedFader_structTd* Fader, uint16_t Target, double Stiffness)
+{
+  FaderHaptics_set_Spring(&Fader->Haptics, Target, Stiffness);
+}
+
+/** @} ************************************************************************/
+/* end of name "Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the fader
+ * @{
+ ******************************************************************************/
+
+uint16_t MotorizedFader_get_WiperValue(MotorizedFader_structTd* Fader)
+{
+  uint16_t Value;
+  Value = Wiper_get_SmoothValue(&Fader->Wiper);
+  Value = WiperLinear_convert_RawToLinear(&Fader->Linear, Value);
+  return Value;
+}
+
+TSCButton_State_enumTd MotorizedFader_get_TSCState(MotorizedFader_structTd* Fader)
+{
+  TSCButton_State_enumTd State;
+  State = TSCButton_get_State(&Fader->TouchSense);
+  return State;
+}
+
+/* Description in .h */
+uint8_t MotorizedFader_get_TouchConfidence(MotorizedFader_structTd* Fader)
+{
+  return TSCButton_get_Confidence(&Fader->TouchSense);
+}
+
+/* Description in .h */
+PIDAutotune_State_enumTd MotorizedFader_get_AutotuneState(MotorizedFader_structTd* Fader)
+{
+  return PIDAutotune_get_State(&Fader->Autotune);
+}
+
+/* Description in .h */
+PIDAutotune_Result_structTd MotorizedFader_get_AutotuneResult(MotorizedFader_structTd* Fader)
+{
+  return PIDAutotune_get_Result(&Fader->Autotune);
+}
+
+/* Description in .h */
+FrictionModel_State_enumTd MotorizedFader_get_FrictionState(MotorizedFader_structTd* Fader)
+{
+  return FrictionModel_get_State(&Fader->Friction);
+}
+
+/* Description in .h */
+WiperLinear_State_enumTd MotorizedFader_get_WiperCalibrationState(MotorizedFader_structTd* Fader)
+{
+  return WiperLinear_get_State(&Fader->Linear);
+}
+
+/* Description in .h */
+uint32_t MotorizedFader_get_ControlOverruns(void)
+{
+  return FadersInternal.ControlOverruns;
+}
+
+/* Description in .h */
+uint8_t MotorizedFader_get_ControlLoadMax(void)
+{
+  uint8_t Load = 0;
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  if(htim != NULL)
+  {
+    uint32_t PeriodTicks = __HAL_TIM_GET_AUTORELOAD(htim) + 1;
+    Load = (uint8_t)(((uint32_t)FadersInternal.ControlTicksMax * 100) / PeriodTicks);
+  }
+  return Load;
+}
+
+/* Description in .h */
+uint16_t MotorizedFader_get_ControlCapacity(void)
+{
+  TIM_HandleTypeDef* htim = FadersInternal.htimControl;
+  uint32_t TicksMax = FadersInternal.ControlTicksMax;
+  uint32_t NumFaders = FadersInternal.NumInitializedFaders;
+  if(htim == NULL || TicksMax == 0 || NumFaders == 0)
+  {
+    return 0;
+  }
+
+  /** @internal     1.  Faders updated in one period: all faders divided by
+   *                    the stagger groups, rounded up */
+  uint32_t Groups = (FadersInternal.ControlGroups > 1) ? FadersInternal.ControlGroups : 1;
+  uint32_t FadersPerPeriod = (NumFaders + Groups - 1) / Groups;
+
+  /** @internal     2.  Faders that fit into one period, times the groups */
+  uint32_t PeriodTicks = __HAL_TIM_GET_AUTORELOAD(htim) + 1;
+  uint32_t Capacity = ((PeriodTicks * FadersPerPeriod) / TicksMax) * Groups;
+  return (Capacity > 0xFFFF) ? 0xFFFF : (uint16_t)Capacity;
+}
+
+/* Description in .h */
+bool MotorizedFader_get_Event(FaderEvents_Event_structTd* Event)
+{
+  uint32_t TimeUs = TimerService_get_TimeUs();
+  return FaderEvents_read_Event(&FadersInternal.EventQueue, Event, TimeUs);
+}
+
+/* Description in .h */
+uint32_t MotorizedFader_get_EventLatencyMaxUs(void)
+{
+  return FaderEvents_get_LatencyMaxUs(&FadersInternal.EventQueue);
+}
+
+/* Description in .h */
+uint32_t MotorizedFader_get_EventOverflows(void)
+{
+  return FaderEvents_get_Overflows(&FadersInternal.EventQueue);
+}
+
+/* Description in .h */
+SettleDetector_State_enumTd MotorizedFader_get_SettleState(MotorizedFader_structTd* Fader)
+{
+  return SettleDetector_get_State(&Fader->Settle);
+}
+
+/* Description in .h */
+StallDetector_State_enumTd MotorizedFader_get_StallState(MotorizedFader_structTd* Fader)
+{
+  return StallDetector_get_State(&Fader->Stall);
 }
 /** @} ************************************************************************/
 /* end of name "Get Functions"
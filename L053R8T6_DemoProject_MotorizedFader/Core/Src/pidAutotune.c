@@ -0,0 +1,339 @@
+/***************************************************************************//**
+ * @defgroup        PIDAutotune_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      PIDAutotune
+ * @{
+ *
+ * @addtogroup      PIDAutotune_Source
+ * @{
+ *
+ * @file            pidAutotune.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <pidAutotune.h>
+#include <stdlib.h>
+#include <math.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and start the auto tuning
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void PIDAutotune_init(PIDAutotune_structTd* AT, int32_t RelayOutput, int32_t Hysteresis, PIDAutotune_Rule_enumTd Rule)
+{
+  AT->State = PIDAUTOTUNE_IDLE;
+  AT->RelayOutput = abs(RelayOutput);
+  AT->Hysteresis = abs(Hysteresis);
+  AT->Rule = Rule;
+}
+
+/* Description in .h */
+void PIDAutotune_start(PIDAutotune_structTd* AT, int32_t Center, int32_t StepTarget, uint32_t SampleTime)
+{
+  PIDAutotune_Result_structTd ResultEmpty = {0};
+
+  /** @internal     1.  Store the settings of this run */
+  AT->Center = Center;
+  AT->StepTarget = StepTarget;
+  AT->SampleTimeUs = SampleTime;
+
+  /** @internal     2.  Reset the relay measurement and the results. The
+   *                    relay output is set with the first sample. */
+  AT->Output = 0;
+  AT->Ticks = 0;
+  AT->SwitchTick = 0;
+  AT->MeasureTick = 0;
+  AT->Cycles = 0;
+  AT->Result = ResultEmpty;
+
+  /** @internal     3.  Start the relay. The state is set last, as the
+   *                    relay might be updated in an interrupt. */
+  AT->State = PIDAUTOTUNE_RELAY;
+}
+
+/* Description in .h */
+void PIDAutotune_abort(PIDAutotune_structTd* AT)
+{
+  if(AT->State != PIDAUTOTUNE_IDLE && AT->State != PIDAUTOTUNE_DONE)
+  {
+    AT->State = PIDAUTOTUNE_FAILED;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to run the auto tuning
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void count_RelayCycle(PIDAutotune_structTd* AT, int32_t Sample);
+uint32_t convert_AutotuneTimeToTicks(PIDAutotune_structTd* AT, uint32_t TimeUs);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int32_t PIDAutotune_update_Relay(PIDAutotune_structTd* AT, int32_t Sample)
+{
+  AT->Ticks++;
+
+  /** @internal     1.  Switch the relay down above the center (one relay
+   *                    cycle is complete) and up below the center. */
+  if(Sample > AT->Center + AT->Hysteresis && AT->Output >= 0)
+  {
+    AT->Output = -AT->RelayOutput;
+    count_RelayCycle(AT, Sample);
+  }
+  else if(Sample < AT->Center - AT->Hysteresis && AT->Output <= 0)
+  {
+    AT->Output = AT->RelayOutput;
+    AT->SwitchTick = AT->Ticks;
+  }
+  else if(AT->Output == 0)
+  {
+    AT->Output = AT->RelayOutput;
+  }
+
+  /** @internal     2.  Store the peaks while measuring */
+  if(AT->Cycles > PIDAUTOTUNE_SKIP_CYCLES)
+  {
+    if(Sample > AT->SampleMax)
+    {
+      AT->SampleMax = Sample;
+    }
+    if(Sample < AT->SampleMin)
+    {
+      AT->SampleMin = Sample;
+    }
+  }
+
+  /** @internal     3.  Fail, if the relay did not switch for too long */
+  if(AT->Ticks - AT->SwitchTick > convert_AutotuneTimeToTicks(AT, PIDAUTOTUNE_TIMEOUT_US))
+  {
+    AT->Output = 0;
+    AT->State = PIDAUTOTUNE_FAILED;
+  }
+
+  return AT->Output;
+}
+
+/**
+ * @brief     Count a relay cycle. After the skipped cycles the measurement
+ *            starts, after the measured cycles the relay experiment is
+ *            finished.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     Sample      current value of the system
+ * @return    none
+ */
+void count_RelayCycle(PIDAutotune_structTd* AT, int32_t Sample)
+{
+  AT->Cycles++;
+  AT->SwitchTick = AT->Ticks;
+
+  /** @internal     1.  Start the measurement */
+  if(AT->Cycles == PIDAUTOTUNE_SKIP_CYCLES + 1)
+  {
+    AT->MeasureTick = AT->Ticks;
+    AT->SampleMax = Sample;
+    AT->SampleMin = Sample;
+  }
+  /** @internal     2.  Finish the measurement: store period and amplitude */
+  else if(AT->Cycles == PIDAUTOTUNE_SKIP_CYCLES + PIDAUTOTUNE_MEASURE_CYCLES + 1)
+  {
+    uint32_t PeriodTicks = AT->Ticks - AT->MeasureTick;
+    AT->Result.UltimatePeriodUs = (PeriodTicks * AT->SampleTimeUs) / PIDAUTOTUNE_MEASURE_CYCLES;
+    AT->Result.Amplitude = (uint16_t)((AT->SampleMax - AT->SampleMin) / 2);
+    AT->Output = 0;
+    AT->State = PIDAUTOTUNE_CALCULATE;
+  }
+}
+
+/**
+ * @brief     Convert a time to the number of samples.
+ * @param     AT          pointer to the auto tuning structure
+ * @param     TimeUs      time in microseconds
+ * @return    number of samples
+ */
+uint32_t convert_AutotuneTimeToTicks(PIDAutotune_structTd* AT, uint32_t TimeUs)
+{
+  uint32_t Ticks = TimeUs;
+  if(AT->SampleTimeUs != 0)
+  {
+    Ticks = TimeUs / AT->SampleTimeUs;
+  }
+  return Ticks;
+}
+
+/* Description in .h */
+bool PIDAutotune_calculate_Gains(PIDAutotune_structTd* AT)
+{
+  PIDAutotune_Result_structTd* Result = &AT->Result;
+  double KpFactor = 0.2;
+  double TiFactor = 0.5;
+  double TdFactor = 0.33;
+
+  /** @internal     1.  The oscillation has to be bigger than the
+   *                    hysteresis, otherwise Ku is undefined. */
+  double Amplitude = (double)Result->Amplitude;
+  double Hysteresis = (double)AT->Hysteresis;
+  if(Amplitude <= Hysteresis || Result->UltimatePeriodUs == 0)
+  {
+    AT->State = PIDAUTOTUNE_FAILED;
+    return false;
+  }
+
+  /** @internal     2.  Ku = 4 * d / (pi * sqrt(a^2 - e^2)), Tu in ms */
+  double Ku = (4.0 * AT->RelayOutput) / (M_PI * sqrt(Amplitude * Amplitude - Hysteresis * Hysteresis));
+  double Tu = Result->UltimatePeriodUs / 1000.0;
+  Result->UltimateGain = Ku;
+
+  /** @internal     3.  Select the factors of the rule */
+  switch(AT->Rule)
+  {
+    case PIDAUTOTUNE_RULE_CLASSIC:
+      KpFactor = 0.6;
+      TdFactor = 0.125;
+      break;
+    case PIDAUTOTUNE_RULE_SOME_OVERSHOOT:
+      KpFactor = 0.33;
+      break;
+    case PIDAUTOTUNE_RULE_NO_OVERSHOOT:
+    default:
+      break;
+  }
+
+  /** @internal     4.  Kp = x * Ku, Ki = Kp / Ti, Kd = Kp * Td */
+  Result->Kp = KpFactor * Ku;
+  Result->Ki = Result->Kp / (TiFactor * Tu);
+  Result->Kd = Result->Kp * (TdFactor * Tu);
+
+  return true;
+}
+
+/* Description in .h */
+void PIDAutotune_start_Step(PIDAutotune_structTd* AT)
+{
+  AT->Ticks = 0;
+  AT->StepStarted = false;
+  AT->State = PIDAUTOTUNE_STEP;
+}
+
+/* Description in .h */
+void PIDAutotune_update_Step(PIDAutotune_structTd* AT, int32_t Sample)
+{
+  PIDAutotune_Result_structTd* Result = &AT->Result;
+
+  /** @internal     1.  Store the start of the step with the first sample */
+  if(AT->StepStarted == false)
+  {
+    AT->StepStart = Sample;
+    AT->RiseStartTick = 0;
+    AT->RiseEndTick = 0;
+    AT->OutsideTick = 0;
+    AT->StepStarted = true;
+  }
+  AT->Ticks++;
+
+  /** @internal     2.  Calculate the progress in the direction of the
+   *                    step */
+  int32_t Step = AT->StepTarget - AT->StepStart;
+  int32_t Direction = (Step >= 0) ? 1 : -1;
+  int32_t StepSize = abs(Step);
+  int32_t Progress = (Sample - AT->StepStart) * Direction;
+
+  /** @internal     3.  Rise time from 10% to 90% of the step */
+  if(AT->RiseStartTick == 0 && Progress * 10 >= StepSize)
+  {
+    AT->RiseStartTick = AT->Ticks;
+  }
+  if(AT->RiseEndTick == 0 && Progress * 10 >= StepSize * 9)
+  {
+    AT->RiseEndTick = AT->Ticks;
+    Result->RiseTimeUs = (AT->RiseEndTick - AT->RiseStartTick) * AT->SampleTimeUs;
+  }
+
+  /** @internal     4.  Overshoot behind the target */
+  if(Progress - StepSize > (int32_t)Result->Overshoot)
+  {
+    Result->Overshoot = (uint16_t)(Progress - StepSize);
+  }
+
+  /** @internal     5.  Settle band: 2% of the step, at least the
+   *                    hysteresis */
+  int32_t Band = StepSize / 50;
+  if(Band < AT->Hysteresis)
+  {
+    Band = AT->Hysteresis;
+  }
+  if(abs(Sample - AT->StepTarget) > Band)
+  {
+    AT->OutsideTick = AT->Ticks;
+  }
+
+  /** @internal     6.  Finish, if the sample stayed in the band long enough
+   *                    or the step did not settle within the timeout */
+  uint32_t HoldTicks = convert_AutotuneTimeToTicks(AT, PIDAUTOTUNE_SETTLE_HOLD_US);
+  uint32_t TimeoutTicks = convert_AutotuneTimeToTicks(AT, PIDAUTOTUNE_TIMEOUT_US);
+  if(AT->Ticks - AT->OutsideTick >= HoldTicks)
+  {
+    Result->SettleTimeUs = AT->OutsideTick * AT->SampleTimeUs;
+    Result->Settled = true;
+    AT->State = PIDAUTOTUNE_DONE;
+  }
+  else if(AT->Ticks >= TimeoutTicks)
+  {
+    Result->SettleTimeUs = AT->Ticks * AT->SampleTimeUs;
+    Result->Settled = false;
+    AT->State = PIDAUTOTUNE_DONE;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the auto tuning
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+PIDAutotune_State_enumTd PIDAutotune_get_State(PIDAutotune_structTd* AT)
+{
+  return AT->State;
+}
+
+/* Description in .h */
+int32_t PIDAutotune_get_StepTarget(PIDAutotune_structTd* AT)
+{
+  return AT->StepTarget;
+}
+
+/* Description in .h */
+PIDAutotune_Result_structTd PIDAutotune_get_Result(PIDAutotune_structTd* AT)
+{
+  return AT->Result;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "PIDAutotune_Source" */
+/**@}*//* end of defgroup "PIDAutotune" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -32,6 +32,7 @@ void PID_init(PID_structTd* pid)
   pid->DTerm = 0.0;
   pid->ITerm = 0.0;
   pid->OutputRaw = 0.0;
+  pid->SampleTimer.Running = false;
 }
 
 /** @} ************************************************************************/
@@ -69,8 +70,9 @@ void PID_set_LowPass(PID_structTd* PID, double Tau)
 /* Description in .h */
 void PID_set_SampleTimeInMs(PID_structTd* PID, uint32_t Threshold)
 {
-  /** @internal     1.  Set Threshold to the Timer */
-  Timer_set_ThresholdInMs(&PID->SampleTimer, Threshold);
+  /** @internal     1.  Stop the sample timer, PID_update() restarts it with
+   *                    the new period */
+  TimerService_stop(&PID->SampleTimer);
   /** @internal     2.  Store threshold value local for PID calculations */
   PID->SampleTime = Threshold;
 }
@@ -114,35 +116,56 @@ double limit_Output(double Output, double Min, double Max);
 /* Description in .h */
 void PID_update(PID_structTd* pid, double sample)
 {
-  /** @internal     1. Check it Sample-Time elapsed. Leave function if not!*/
-  if(Timer_check_TimerElapsed(&pid->SampleTimer))
+  bool Calculate = false;
+
+  /** @internal     1.  Start the sample timer with the first call and
+   *                    calculate at once. Later check if the sample time
+   *                    elapsed. */
+  if(TimerService_check_Running(&pid->SampleTimer) == false)
+  {
+    TimerService_start_Periodic(&pid->SampleTimer, pid->SampleTime * 1000, NULL, NULL);
+    Calculate = true;
+  }
+  else
+  {
+    Calculate = TimerService_check_Elapsed(&pid->SampleTimer);
+  }
+
+  /** @internal     2.  Calculate only if the sample time elapsed */
+  if(Calculate == true)
   {
-    double OutputMin = pid->OutputMin;
-    double OutputMax = pid->OutputMax;
+    PID_calculate(pid, sample);
+  }
+}
+
+/* Description in .h */
+void PID_calculate(PID_structTd* pid, double sample)
+{
+  double OutputMin = pid->OutputMin;
+  double OutputMax = pid->OutputMax;
 
-    /** @internal     2.  Calculate error between set point and current sample */
-    double Error = calculate_Error(pid, sample);
+  /** @internal     1.  Calculate error between set point and current sample */
+  double Error = calculate_Error(pid, sample);
 
-    /** @internal     3.  Calculate proportional Term */
-    double PTerm = calculate_PTerm(pid, Error);
+  /** @internal     2.  Calculate proportional Term */
+  double PTerm = calculate_PTerm(pid, Error);
 
-    /** @internal     4.  Calculate integral Term with anti wind up */
-    double ITerm =  calculate_ITermWithAntiWindup(pid, PTerm, Error);
+  /** @internal     3.  Calculate integral Term with anti wind up */
+  double ITerm =  calculate_ITermWithAntiWindup(pid, PTerm, Error);
 
-    /** @internal     5.  Calculate derivative Term with low pass to avoid
-     *                    noise */
-    double DTerm =  calculate_DTermWithLowPass(pid, sample);
+  /** @internal     4.  Calculate derivative Term with low pass to avoid
+   *                    noise */
+  double DTerm =  calculate_DTermWithLowPass(pid, sample);
 
-    /** @internal     6.  calculate output value */
-    double Output = PTerm + ITerm + DTerm;
+  /** @internal     5.  calculate output value */
+  double Output = PTerm + ITerm + DTerm;
 
-    /** @internal     7.  limit output value */
-    Output = limit_Output(Output, OutputMin, OutputMax);
+  /** @internal     6.  limit output value */
+  Output = limit_Output(Output, OutputMin, OutputMax);
 
-    /** @internal     8.  save output to users PID structure (raw and round) */
-    pid->OutputRaw = Output;
-    pid->OutputRound = round(Output);
-  }
+  /** @internal     7.  save output to users PID structure (raw and round) */
+  pid->OutputRaw = Output;
+  pid->OutputRound = round(Output);
 }
 
 /**
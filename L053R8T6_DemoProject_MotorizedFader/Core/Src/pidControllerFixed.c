@@ -0,0 +1,561 @@
+/***************************************************************************//**
+ * @defgroup        PIDFixed_Source      Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      PIDFixed_Controller
+ * @{
+ *
+ * @addtogroup      PIDFixed_Source
+ * @{
+ *
+ * @file            pidControllerFixed.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <pidControllerFixed.h>
+#include <math.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the PID controller
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void PIDFixed_init(PIDFixed_structTd* pid)
+{
+  pid->DTerm = 0;
+  pid->ITerm = 0;
+  pid->OutputSum = 0;
+  pid->OutputRaw = 0;
+  pid->OutputRound = 0;
+  pid->ErrorLarge = 0;
+  pid->Kb = 0;
+  pid->CoeffTrack = 0;
+  pid->SampleTimer.Running = false;
+  PIDFixed_set_GainScaleDown(pid, 1.0);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @brief     Use these functions to set or reset parameters
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void convert_FixedCoefficients(PIDFixed_structTd* pid);
+int32_t convert_DoubleToCoefficient(double Value);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void PIDFixed_set_OutputMinMax(PIDFixed_structTd* PID, int32_t Min, int32_t Max)
+{
+  PID->OutputMin = Min * PIDFIXED_Q_ONE;
+  PID->OutputMax = Max * PIDFIXED_Q_ONE;
+}
+
+/* Description in .h */
+void PIDFixed_set_KpKiKd(PIDFixed_structTd* PID, double Kp, double Ki, double Kd)
+{
+  PID->Kp = Kp;
+  PID->Ki = Ki;
+  PID->Kd = Kd;
+  convert_FixedCoefficients(PID);
+}
+
+/* Description in .h */
+void PIDFixed_set_GainSchedule(PIDFixed_structTd* PID, double Kp, double Ki, double Kd, uint16_t ErrorSmall, uint16_t ErrorLarge)
+{
+  /** @internal     1.  Switch the schedule off while the values change, as
+   *                    the control timer interrupt may use them */
+  PID->ErrorLarge = 0;
+  PID->KpLarge = Kp;
+  PID->KiLarge = Ki;
+  PID->KdLarge = Kd;
+  PID->ErrorSmall = ErrorSmall;
+  convert_FixedCoefficients(PID);
+
+  /** @internal     2.  The interpolation multiplies with the reciprocal of
+   *                    the range, so no division is needed in the update */
+  if(ErrorLarge > ErrorSmall)
+  {
+    PID->ScheduleSlope = (int32_t)round((double)PIDFIXED_Q_ONE / (double)(ErrorLarge - ErrorSmall));
+    PID->ErrorLarge = ErrorLarge;
+  }
+}
+
+/* Description in .h */
+void PIDFixed_set_GainScaleDown(PIDFixed_structTd* PID, double Scale)
+{
+  PID->ScaleDown = Scale;
+  PID->CoeffScaleDown = convert_DoubleToCoefficient(Scale);
+}
+
+/* Description in .h */
+void PIDFixed_set_BackCalculation(PIDFixed_structTd* PID, double Kb)
+{
+  PID->Kb = Kb;
+  convert_FixedCoefficients(PID);
+}
+
+/* Description in .h */
+void PIDFixed_set_LowPass(PIDFixed_structTd* PID, double Tau)
+{
+  PID->TauLowPass = Tau;
+  convert_FixedCoefficients(PID);
+}
+
+/* Description in .h */
+void PIDFixed_set_SampleTimeInMs(PIDFixed_structTd* PID, uint32_t Threshold)
+{
+  /** @internal     1.  Stop the sample timer, PIDFixed_update() restarts
+   *                    it with the new period */
+  TimerService_stop(&PID->SampleTimer);
+  /** @internal     2.  Store threshold value local for PID calculations */
+  PID->SampleTime = Threshold;
+  PID->SampleTimeUs = Threshold * 1000;
+  /** @internal     3.  The sample time is part of the I- and D-coefficients,
+   *                    so they have to be converted again. */
+  convert_FixedCoefficients(PID);
+}
+
+/* Description in .h */
+void PIDFixed_set_SampleTimeInUs(PIDFixed_structTd* PID, uint32_t SampleTime)
+{
+  /** @internal     1.  Stop the sample timer (used by PIDFixed_update()
+   *                    only, it restarts it with the new period) and store
+   *                    the sample time local */
+  TimerService_stop(&PID->SampleTimer);
+  PID->SampleTimeUs = SampleTime;
+  /** @internal     2.  The sample time is part of the I- and D-coefficients,
+   *                    so they have to be converted again. */
+  convert_FixedCoefficients(PID);
+}
+
+/* Description in .h */
+void PIDFixed_set_Target(PIDFixed_structTd* PID, int32_t Setpoint)
+{
+  PID->Setpoint = Setpoint;
+}
+
+/* Description in .h */
+void PIDFixed_reset(PIDFixed_structTd* pid)
+{
+  pid->Sample = 0;
+  pid->PTerm = 0;
+  pid->ITerm = 0;
+  pid->DTerm = 0;
+  pid->Error = 0;
+  pid->OutputSum = 0;
+  pid->OutputRaw = 0;
+}
+
+/**
+ * @brief     Convert the users double coefficients to the fixed-point
+ *            coefficients used in PIDFixed_update(). All parts of the
+ *            calculation that do not change between two updates are combined
+ *            here, so they have to be calculated only once.
+ * @param     pid     pointer to the users PID structure
+ * @return    none
+ */
+void convert_FixedCoefficients(PIDFixed_structTd* pid)
+{
+  /* Tuning values are based on milliseconds, same as in the double PID */
+  double SampleTime = (double)pid->SampleTimeUs / 1000.0;
+  double TauLowPass = pid->TauLowPass;
+  double Denominator = 2.0 * TauLowPass + SampleTime;
+
+  /** @internal     1.  P-Term: Kp * Error */
+  pid->CoeffP = convert_DoubleToCoefficient(pid->Kp);
+  pid->CoeffPLarge = convert_DoubleToCoefficient(pid->KpLarge);
+
+  /** @internal     2.  I-Term: 0.5 * Ki * SampleTime * (Error + PrevError) */
+  pid->CoeffI = convert_DoubleToCoefficient(0.5 * pid->Ki * SampleTime);
+  pid->CoeffILarge = convert_DoubleToCoefficient(0.5 * pid->KiLarge * SampleTime);
+
+  /** @internal     3.  D-Term: -2 * Kd / (2 * Tau + SampleTime) * dSample +
+   *                    (2 * Tau - SampleTime) / (2 * Tau + SampleTime) * DTerm.
+   *                    If the denominator is 0, the D-Term is disabled. */
+  if(Denominator != 0.0)
+  {
+    pid->CoeffD = convert_DoubleToCoefficient(-2.0 * pid->Kd / Denominator);
+    pid->CoeffDLarge = convert_DoubleToCoefficient(-2.0 * pid->KdLarge / Denominator);
+    pid->CoeffLowPass = convert_DoubleToCoefficient((2.0 * TauLowPass - SampleTime) / Denominator);
+  }
+  else
+  {
+    pid->CoeffD = 0;
+    pid->CoeffDLarge = 0;
+    pid->CoeffLowPass = 0;
+  }
+
+  /** @internal     4.  Back-calculation: Kb * SampleTime * (Applied - Output) */
+  pid->CoeffTrack = convert_DoubleToCoefficient(pid->Kb * SampleTime);
+}
+
+/**
+ * @brief     Convert a double value to a Q8.24 coefficient with rounding.
+ * @param     Value   to convert
+ * @return    fixed-point coefficient
+ */
+int32_t convert_DoubleToCoefficient(double Value)
+{
+  return (int32_t)round(Value * (double)((int32_t)1 << PIDFIXED_COEFF_SHIFT));
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calculate the PID
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Coefficients used for one calculation (Q8.24)
+ */
+typedef struct
+{
+  int32_t   P;
+  int32_t   I;
+  int32_t   D;
+}PIDFixed_Gains_structTd;
+
+/** @cond *//* Function Prototypes */
+int32_t calculate_FixedError(PIDFixed_structTd* pid, int32_t Sample);
+void select_FixedGains(PIDFixed_structTd* pid, int32_t Error, PIDFixed_Gains_structTd* Gains);
+int32_t interpolate_FixedCoefficient(int32_t Small, int32_t Large, int32_t Fraction);
+int32_t calculate_FixedPTerm(PIDFixed_structTd* pid, int32_t CoeffP, int32_t Error);
+int32_t calculate_FixedITermWithAntiWindup(PIDFixed_structTd* pid, int32_t CoeffI, int32_t PTerm, int32_t Error);
+int32_t calculate_FixedDTermWithLowPass(PIDFixed_structTd* pid, int32_t CoeffD, int32_t Sample);
+int32_t limit_FixedValue(int64_t Value, int32_t Min, int32_t Max);
+int round_FixedToInt(int32_t Value);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void PIDFixed_update(PIDFixed_structTd* pid, int32_t Sample)
+{
+  /** @internal     1.  Start the sample timer with the first call and
+   *                    calculate at once */
+  if(TimerService_check_Running(&pid->SampleTimer) == false)
+  {
+    TimerService_start_Periodic(&pid->SampleTimer, pid->SampleTimeUs, NULL, NULL);
+    PIDFixed_calculate(pid, Sample);
+  }
+  /** @internal     2.  Check if the sample time elapsed. Leave function if
+   *                    not! */
+  else if(TimerService_check_Elapsed(&pid->SampleTimer))
+  {
+    /** @internal     3.  Calculate the new output. */
+    PIDFixed_calculate(pid, Sample);
+  }
+}
+
+/* Description in .h */
+void PIDFixed_calculate(PIDFixed_structTd* pid, int32_t Sample)
+{
+  /** @internal     1.  Calculate error between set point and current sample */
+  int32_t Error = calculate_FixedError(pid, Sample);
+
+  /** @internal     2.  Select the coefficients for this error (gain
+   *                    scheduling) */
+  PIDFixed_Gains_structTd Gains;
+  select_FixedGains(pid, Error, &Gains);
+
+  /** @internal     3.  Calculate proportional Term */
+  int32_t PTerm = calculate_FixedPTerm(pid, Gains.P, Error);
+
+  /** @internal     4.  Calculate integral Term with anti wind up */
+  int32_t ITerm = calculate_FixedITermWithAntiWindup(pid, Gains.I, PTerm, Error);
+
+  /** @internal     5.  Calculate derivative Term with low pass to avoid
+   *                    noise */
+  int32_t DTerm = calculate_FixedDTermWithLowPass(pid, Gains.D, Sample);
+
+  /** @internal     6.  calculate and limit output value. The sum is
+   *                    calculated with 64 bit to avoid an overflow before
+   *                    the limitation. */
+  int64_t Output = (int64_t)PTerm + ITerm + DTerm;
+  int32_t OutputLimited = limit_FixedValue(Output, pid->OutputMin, pid->OutputMax);
+  pid->OutputSum = limit_FixedValue(Output, -INT32_MAX, INT32_MAX);
+
+  /** @internal     7.  save output to users PID structure (raw and round) */
+  pid->OutputRaw = OutputLimited;
+  pid->OutputRound = round_FixedToInt(OutputLimited);
+}
+
+/* Description in .h */
+void PIDFixed_track_Output(PIDFixed_structTd* pid, int32_t Applied)
+{
+  if(pid->CoeffTrack == 0)
+  {
+    return;
+  }
+
+  /** @internal     1.  Difference between applied and calculated output.
+   *                    Only a smaller applied output in the same direction
+   *                    is tracked (limits). A bigger one (start force)
+   *                    compensates friction, the I-Term would grow with it.
+   *                    A stopped motor (stop range) is not tracked either,
+   *                    otherwise the I-Term holds the output in the stop
+   *                    range and the fader never starts. */
+  int64_t Difference = (int64_t)Applied * PIDFIXED_Q_ONE - pid->OutputSum;
+  if(Applied == 0 || (Applied > 0 && Difference >= 0) || (Applied < 0 && Difference <= 0))
+  {
+    return;
+  }
+
+  /** @internal     2.  Move the I-Term by a part of the difference */
+  int64_t ITerm = pid->ITerm + (((int64_t)pid->CoeffTrack * Difference) >> PIDFIXED_COEFF_SHIFT);
+  pid->ITerm = limit_FixedValue(ITerm, -INT32_MAX / 2, INT32_MAX / 2);
+}
+
+/**
+ * @brief     calculate error of between input value and set point.
+ * @param     pid     pointer to the users PID structure
+ * @param     Sample  of the current input value
+ * @return    Error value (integer)
+ */
+int32_t calculate_FixedError(PIDFixed_structTd* pid, int32_t Sample)
+{
+  /** @internal     1.  Calculate Error */
+  int32_t Error = pid->Setpoint - Sample;
+  /** @internal     2.  Save error for the next calculation cycle. */
+  pid->PrevError = pid->Error;
+  pid->Error = Error;
+
+  return Error;
+}
+
+/**
+ * @brief     Select the coefficients for the error. Without gain schedule
+ *            and down scale these are the coefficients of Kp, Ki and Kd.
+ * @param     pid     pointer to the users PID structure
+ * @param     Error   of the current calculation process
+ * @param     Gains   selected coefficients
+ * @return    none
+ */
+void select_FixedGains(PIDFixed_structTd* pid, int32_t Error, PIDFixed_Gains_structTd* Gains)
+{
+  int32_t Absolute = (Error < 0) ? -Error : Error;
+
+  Gains->P = pid->CoeffP;
+  Gains->I = pid->CoeffI;
+  Gains->D = pid->CoeffD;
+
+  /** @internal     1.  Large error gains above ErrorLarge, interpolated
+   *                    between ErrorSmall and ErrorLarge */
+  if(pid->ErrorLarge > 0 && Absolute > pid->ErrorSmall)
+  {
+    int32_t Fraction = PIDFIXED_Q_ONE;
+    if(Absolute < pid->ErrorLarge)
+    {
+      Fraction = (Absolute - pid->ErrorSmall) * pid->ScheduleSlope;
+    }
+    Gains->P = interpolate_FixedCoefficient(pid->CoeffP, pid->CoeffPLarge, Fraction);
+    Gains->I = interpolate_FixedCoefficient(pid->CoeffI, pid->CoeffILarge, Fraction);
+    Gains->D = interpolate_FixedCoefficient(pid->CoeffD, pid->CoeffDLarge, Fraction);
+  }
+
+  /** @internal     2.  Scale the coefficients for the down direction */
+  if(Error < 0 && pid->CoeffScaleDown != ((int32_t)1 << PIDFIXED_COEFF_SHIFT))
+  {
+    Gains->P = (int32_t)(((int64_t)Gains->P * pid->CoeffScaleDown) >> PIDFIXED_COEFF_SHIFT);
+    Gains->I = (int32_t)(((int64_t)Gains->I * pid->CoeffScaleDown) >> PIDFIXED_COEFF_SHIFT);
+    Gains->D = (int32_t)(((int64_t)Gains->D * pid->CoeffScaleDown) >> PIDFIXED_COEFF_SHIFT);
+  }
+}
+
+/**
+ * @brief     Interpolate linearly between two coefficients.
+ * @param     Small     coefficient at fraction 0
+ * @param     Large     coefficient at fraction 1
+ * @param     Fraction  0 - 1 (Q16.16)
+ * @return    interpolated coefficient
+ */
+int32_t interpolate_FixedCoefficient(int32_t Small, int32_t Large, int32_t Fraction)
+{
+  return Small + (int32_t)(((int64_t)(Large - Small) * Fraction) >> PIDFIXED_Q_SHIFT);
+}
+
+/**
+ * @brief     Calculate the proportional Term of the PID controller.
+ * @param     pid     pointer to the users PID structure
+ * @param     CoeffP  P coefficient of this calculation (Q8.24)
+ * @param     Error   of the current calculation process
+ * @return    P-Term
+ */
+int32_t calculate_FixedPTerm(PIDFixed_structTd* pid, int32_t CoeffP, int32_t Error)
+{
+  /** @internal     1.  Calculate P-Term. Coefficient is Q8.24 and Error is
+   *                    an integer, so the product has to be shifted to
+   *                    Q16.16. */
+  int64_t PTerm = ((int64_t)CoeffP * Error) >> (PIDFIXED_COEFF_SHIFT - PIDFIXED_Q_SHIFT);
+  pid->PTerm = limit_FixedValue(PTerm, -INT32_MAX / 2, INT32_MAX / 2);
+
+  return pid->PTerm;
+}
+
+/**
+ * @brief     Calculate the integral Term of the PID controller with anti wind
+ *            up.
+ * @param     pid     pointer to the users PID structure
+ * @param     CoeffI  I coefficient of this calculation (Q8.24)
+ * @param     PTerm   proportional term of the current calculation cycle
+ * @param     Error   of the current calculation process
+ * @return    I-Term with anti wind-up
+ */
+int32_t calculate_FixedITermWithAntiWindup(PIDFixed_structTd* pid, int32_t CoeffI, int32_t PTerm, int32_t Error)
+{
+  int64_t ITermMin  = 0;
+  int64_t ITermMax  = 0;
+  int64_t OutputMin = pid->OutputMin;
+  int64_t OutputMax = pid->OutputMax;
+
+  /** @internal     1.  Calculate Integral term */
+  int64_t ITerm = ((int64_t)CoeffI * (Error + pid->PrevError)) >> (PIDFIXED_COEFF_SHIFT - PIDFIXED_Q_SHIFT);
+  ITerm = ITerm + pid->ITerm;
+
+  /** @internal     2.  Calculate I-Term limits for anti wind-up (same limits
+   *                    as in the double version of the PID) */
+  if(OutputMin < PTerm)
+  {
+    ITermMin = OutputMin - PTerm;
+  }
+  if(OutputMax > PTerm)
+  {
+    ITermMax = OutputMax + PTerm;
+  }
+
+  /** @internal     3.  Limit I-Term if necessary */
+  if(ITerm < ITermMin)
+  {
+    ITerm = ITermMin;
+  }
+  if(ITerm > ITermMax)
+  {
+    ITerm = ITermMax;
+  }
+
+  /** @internal     4.  Save I-Term for next calculation cycle */
+  pid->ITerm = limit_FixedValue(ITerm, -INT32_MAX / 2, INT32_MAX / 2);
+
+  return pid->ITerm;
+}
+
+/**
+ * @brief     Calculate derivative term with low pass to avoid noise.
+ * @param     pid     pointer to the users PID structure
+ * @param     CoeffD  D coefficient of this calculation (Q8.24)
+ * @param     Sample  of the current input value
+ * @return    D-Term
+ */
+int32_t calculate_FixedDTermWithLowPass(PIDFixed_structTd* pid, int32_t CoeffD, int32_t Sample)
+{
+  /** @internal     1.  Differentiator portion: Q8.24 coefficient * integer
+   *                    shifted to Q16.16 */
+  int64_t DifferentiatorPortion = ((int64_t)CoeffD * (Sample - pid->Sample)) >> (PIDFIXED_COEFF_SHIFT - PIDFIXED_Q_SHIFT);
+  /** @internal     2.  Low pass portion: Q8.24 * Q16.16 shifted to Q16.16 */
+  int64_t LowPassPortion = ((int64_t)pid->CoeffLowPass * pid->DTerm) >> PIDFIXED_COEFF_SHIFT;
+
+  int32_t DTerm = limit_FixedValue(DifferentiatorPortion + LowPassPortion, -INT32_MAX / 2, INT32_MAX / 2);
+
+  pid->Sample = Sample;
+  pid->DTerm = DTerm;
+
+  return DTerm;
+}
+
+/**
+ * @brief     Limit a 64 bit intermediate result to a 32 bit range.
+ * @param     Value   to limit
+ * @param     Min     value
+ * @param     Max     value
+ * @return    limited value
+ */
+int32_t limit_FixedValue(int64_t Value, int32_t Min, int32_t Max)
+{
+  int32_t ValueLimited = 0;
+
+  if(Value < Min)
+  {
+    ValueLimited = Min;
+  }
+  else if(Value > Max)
+  {
+    ValueLimited = Max;
+  }
+  else
+  {
+    ValueLimited = (int32_t)Value;
+  }
+
+  return ValueLimited;
+}
+
+/**
+ * @brief     Round a Q16.16 value to the next integer. Halves are rounded away
+ *            from zero, like round() does in the double version.
+ * @param     Value   Q16.16 value
+ * @return    rounded integer
+ */
+int round_FixedToInt(int32_t Value)
+{
+  int32_t Half = PIDFIXED_Q_ONE / 2;
+  int ReturnValue = 0;
+
+  if(Value >= 0)
+  {
+    ReturnValue = (Value + Half) >> PIDFIXED_Q_SHIFT;
+  }
+  else
+  {
+    ReturnValue = -((-Value + Half) >> PIDFIXED_Q_SHIFT);
+  }
+
+  return ReturnValue;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions get values from the PID
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+int32_t PIDFixed_get_OutputRaw(PIDFixed_structTd* PID)
+{
+  return  PID->OutputRaw;
+}
+
+/* Description in .h */
+int PIDFixed_get_OutputRound(PIDFixed_structTd* PID)
+{
+  return  PID->OutputRound;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "PIDFixed_Source" */
+/**@}*//* end of defgroup "PIDFixed_Controller" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @defgroup        SettleDetector_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      SettleDetector
+ * @{
+ *
+ * @addtogroup      SettleDetector_Source
+ * @{
+ *
+ * @file            settleDetector.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <settleDetector.h>
+#include <stdlib.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void SettleDetector_init(SettleDetector_structTd* Detector, uint16_t Window, uint16_t MotionBand, uint16_t Count)
+{
+  Detector->Window = Window;
+  Detector->MotionBand = MotionBand;
+  Detector->Count = Count;
+  Detector->Target = 0;
+  SettleDetector_reset(Detector);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+bool SettleDetector_update(SettleDetector_structTd* Detector, int32_t Target, int32_t Sample, bool SetpointAtTarget)
+{
+  int32_t Error = abs(Target - Sample);
+
+  /** @internal     1.  Leave if the detector is switched off */
+  if(Detector->Count == 0)
+  {
+    return false;
+  }
+
+  /** @internal     2.  Settled: wake up if the target changed or the error
+   *                    left the wake band */
+  if(Detector->State == SETTLEDETECTOR_SETTLED)
+  {
+    if(Target != Detector->Target || Error > 2 * (int32_t)Detector->Window)
+    {
+      SettleDetector_reset(Detector);
+      return false;
+    }
+    return true;
+  }
+
+  /** @internal     3.  Active: restart the count if a condition is not met.
+   *                    The first sample that meets them is the reference for
+   *                    the motion. */
+  if(SetpointAtTarget == false || Error > (int32_t)Detector->Window)
+  {
+    Detector->Counter = 0;
+    return false;
+  }
+  if(Detector->Counter == 0 || abs(Sample - Detector->Reference) > (int32_t)Detector->MotionBand)
+  {
+    Detector->Reference = Sample;
+    Detector->Counter = 1;
+    return false;
+  }
+
+  /** @internal     4.  Settle after enough samples in a row */
+  Detector->Counter++;
+  if(Detector->Counter >= Detector->Count)
+  {
+    Detector->State = SETTLEDETECTOR_SETTLED;
+    Detector->Target = Target;
+    return true;
+  }
+  return false;
+}
+
+/* Description in .h */
+void SettleDetector_reset(SettleDetector_structTd* Detector)
+{
+  Detector->State = SETTLEDETECTOR_ACTIVE;
+  Detector->Counter = 0;
+  Detector->Reference = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+SettleDetector_State_enumTd SettleDetector_get_State(SettleDetector_structTd* Detector)
+{
+  return Detector->State;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "SettleDetector_Source" */
+/**@}*//* end of defgroup "SettleDetector" */
+/**@}*//* end of defgroup "MotorFader" */
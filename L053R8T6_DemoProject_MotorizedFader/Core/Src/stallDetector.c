@@ -0,0 +1,202 @@
+/***************************************************************************//**
+ * @defgroup        StallDetector_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      StallDetector
+ * @{
+ *
+ * @addtogroup      StallDetector_Source
+ * @{
+ *
+ * @file            stallDetector.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <stallDetector.h>
+#include <stdlib.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void StallDetector_init(StallDetector_structTd* Detector, uint16_t DutyThreshold, uint16_t MotionBand, uint16_t Count)
+{
+  Detector->DutyThreshold = DutyThreshold;
+  Detector->MotionBand = MotionBand;
+  Detector->Count = Count;
+  Detector->Target = 0;
+  Detector->Event = false;
+  StallDetector_set_Backoff(Detector, 0, 100, 3);
+  StallDetector_reset(Detector);
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void StallDetector_set_Backoff(StallDetector_structTd* Detector, uint16_t BackoffCCR, uint16_t BackoffCount, uint8_t Retries)
+{
+  Detector->BackoffCCR = BackoffCCR;
+  Detector->BackoffCount = BackoffCount;
+  Detector->Retries = Retries;
+}
+
+/* Description in .h */
+void StallDetector_reset(StallDetector_structTd* Detector)
+{
+  Detector->State = STALLDETECTOR_RUNNING;
+  Detector->Counter = 0;
+  Detector->BackoffCounter = 0;
+  Detector->Stalls = 0;
+  Detector->Reference = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+int limit_StallCCR(int CCR, int Limit);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int StallDetector_update(StallDetector_structTd* Detector, int CCR, int32_t Target, int32_t Sample)
+{
+  /** @internal     1.  Leave if the detector is switched off */
+  if(Detector->Count == 0)
+  {
+    return CCR;
+  }
+
+  /** @internal     2.  A new target ends back off and failed state */
+  if(Detector->State != STALLDETECTOR_RUNNING && Target != Detector->Target)
+  {
+    StallDetector_reset(Detector);
+  }
+
+  /** @internal     3.  Back off: limit the CCR until the next retry. Failed:
+   *                    limit it until the target changes. */
+  if(Detector->State == STALLDETECTOR_BACKOFF)
+  {
+    Detector->BackoffCounter++;
+    if(Detector->BackoffCounter >= Detector->BackoffCount)
+    {
+      Detector->State = STALLDETECTOR_RUNNING;
+      Detector->Counter = 0;
+    }
+    return limit_StallCCR(CCR, Detector->BackoffCCR);
+  }
+  if(Detector->State == STALLDETECTOR_FAILED)
+  {
+    return limit_StallCCR(CCR, Detector->BackoffCCR);
+  }
+
+  /** @internal     4.  Running: restart the count with low duty. The first
+   *                    sample with high duty is the reference for the
+   *                    motion, a motion bigger than the band clears the
+   *                    stalls in a row. */
+  if(abs(CCR) < (int)Detector->DutyThreshold)
+  {
+    Detector->Counter = 0;
+    return CCR;
+  }
+  if(Detector->Counter == 0 || abs(Sample - Detector->Reference) > (int32_t)Detector->MotionBand)
+  {
+    if(Detector->Counter != 0)
+    {
+      Detector->Stalls = 0;
+    }
+    Detector->Reference = Sample;
+    Detector->Counter = 1;
+    return CCR;
+  }
+
+  /** @internal     5.  Stall after enough samples in a row. Fail if there is
+   *                    no retry left. */
+  Detector->Counter++;
+  if(Detector->Counter < Detector->Count)
+  {
+    return CCR;
+  }
+  Detector->Counter = 0;
+  Detector->BackoffCounter = 0;
+  Detector->Target = Target;
+  Detector->Event = true;
+  if(Detector->Stalls < UINT8_MAX)
+  {
+    Detector->Stalls++;
+  }
+  Detector->State = (Detector->Stalls > Detector->Retries) ? STALLDETECTOR_FAILED : STALLDETECTOR_BACKOFF;
+  return limit_StallCCR(CCR, Detector->BackoffCCR);
+}
+
+/**
+ * @brief     Limit a CCR to -Limit..Limit.
+ * @param     CCR     to limit
+ * @param     Limit   positive limit
+ * @return    limited CCR
+ */
+int limit_StallCCR(int CCR, int Limit)
+{
+  if(CCR > Limit)
+  {
+    return Limit;
+  }
+  if(CCR < -Limit)
+  {
+    return -Limit;
+  }
+  return CCR;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+StallDetector_State_enumTd StallDetector_get_State(StallDetector_structTd* Detector)
+{
+  return Detector->State;
+}
+
+/* Description in .h */
+bool StallDetector_check_Event(StallDetector_structTd* Detector)
+{
+  bool Event = Detector->Event;
+  Detector->Event = false;
+  return Event;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "StallDetector_Source" */
+/**@}*//* end of defgroup "StallDetector" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,268 @@
+/***************************************************************************//**
+ * @defgroup        TaskScheduler_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      TaskScheduler
+ * @{
+ *
+ * @addtogroup      TaskScheduler_Source
+ * @{
+ *
+ * @file            taskScheduler.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <taskScheduler.h>
+
+/**
+ * @brief     Internal data of the scheduler
+ */
+typedef struct
+{
+  TaskScheduler_Task_structTd* Tasks[TASKSCHEDULER_MAX_TASKS]; /**< Added tasks */
+  uint8_t   NumTasks;       /**< Number of added tasks */
+  bool      Sleep;          /**< Sleep if no task is released */
+  uint32_t  LastUs;         /**< Time of the last elapsed time update */
+  uint64_t  ElapsedUs;      /**< Time since the last reset */
+  uint64_t  BusyUs;         /**< Time in tasks since the last reset */
+}TaskScheduler_internal_structTd;
+
+TaskScheduler_internal_structTd TaskSchedulerInternal = {0};
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void TaskScheduler_init(bool Sleep)
+{
+  TaskSchedulerInternal.NumTasks = 0;
+  TaskSchedulerInternal.Sleep = Sleep;
+  TaskScheduler_reset_Statistics();
+}
+
+/* Description in .h */
+bool TaskScheduler_add_Task(TaskScheduler_Task_structTd* Task, const char* Name, TaskScheduler_Function_fpTd Function, void* Context, uint32_t PeriodUs, uint32_t DeadlineUs, uint8_t Priority)
+{
+  if(TaskSchedulerInternal.NumTasks >= TASKSCHEDULER_MAX_TASKS)
+  {
+    return false;
+  }
+
+  Task->Name = Name;
+  Task->Function = Function;
+  Task->Context = Context;
+  Task->PeriodUs = PeriodUs;
+  Task->DeadlineUs = (DeadlineUs == 0) ? PeriodUs : DeadlineUs;
+  Task->Priority = Priority;
+  Task->ReleaseUs = TimerService_get_TimeUs();
+  Task->Stats = (TaskScheduler_Stats_structTd){0};
+  TaskSchedulerInternal.Tasks[TaskSchedulerInternal.NumTasks] = Task;
+  TaskSchedulerInternal.NumTasks++;
+  return true;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      (Re-)Set Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void TaskScheduler_reset_Statistics(void)
+{
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < TaskSchedulerInternal.NumTasks; Index++)
+  {
+    TaskSchedulerInternal.Tasks[Index]->Stats = (TaskScheduler_Stats_structTd){0};
+  }
+  TaskSchedulerInternal.LastUs = TimerService_get_TimeUs();
+  TaskSchedulerInternal.ElapsedUs = 0;
+  TaskSchedulerInternal.BusyUs = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "(Re-)Set Functions"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+TaskScheduler_Task_structTd* get_ReleasedTask(uint32_t NowUs);
+void release_TaskAgain(TaskScheduler_Task_structTd* Task, uint32_t EndUs);
+void update_ElapsedTime(uint32_t NowUs);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+bool TaskScheduler_run_Once(void)
+{
+  /** @internal     1.  Find the released task. Sleep until the next
+   *                    interrupt if there is none. */
+  uint32_t StartUs = TimerService_get_TimeUs();
+  update_ElapsedTime(StartUs);
+  TaskScheduler_Task_structTd* Task = get_ReleasedTask(StartUs);
+  if(Task == NULL)
+  {
+    if(TaskSchedulerInternal.Sleep == true)
+    {
+      HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
+    return false;
+  }
+
+  /** @internal     2.  Run it and measure the execution time */
+  Task->Function(Task->Context);
+  uint32_t EndUs = TimerService_get_TimeUs();
+  uint32_t ExecutionUs = EndUs - StartUs;
+
+  /** @internal     3.  Update the statistics. The deadline counts from the
+   *                    release, not from the start. */
+  TaskScheduler_Stats_structTd* Stats = &Task->Stats;
+  Stats->Runs++;
+  Stats->LastUs = ExecutionUs;
+  Stats->TotalUs += ExecutionUs;
+  if(ExecutionUs > Stats->MaxUs)
+  {
+    Stats->MaxUs = ExecutionUs;
+  }
+  if((int32_t)(EndUs - (Task->ReleaseUs + Task->DeadlineUs)) > 0)
+  {
+    Stats->Overruns++;
+  }
+  TaskSchedulerInternal.BusyUs += ExecutionUs;
+  update_ElapsedTime(EndUs);
+
+  /** @internal     4.  Set the next release */
+  release_TaskAgain(Task, EndUs);
+  return true;
+}
+
+/* Description in .h */
+void TaskScheduler_run(void)
+{
+  while(1)
+  {
+    TaskScheduler_run_Once();
+  }
+}
+
+/**
+ * @brief     Get the released task with the highest priority. Tasks with
+ *            the same priority: the earliest deadline.
+ * @param     NowUs     current time
+ * @return    pointer to the task. NULL if no task is released.
+ */
+TaskScheduler_Task_structTd* get_ReleasedTask(uint32_t NowUs)
+{
+  TaskScheduler_Task_structTd* Selected = NULL;
+  int32_t SelectedSlack = 0;
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < TaskSchedulerInternal.NumTasks; Index++)
+  {
+    TaskScheduler_Task_structTd* Task = TaskSchedulerInternal.Tasks[Index];
+    if((int32_t)(NowUs - Task->ReleaseUs) < 0)
+    {
+      continue;
+    }
+    /* Time left until the deadline. Negative if it is missed already. */
+    int32_t Slack = (int32_t)(Task->ReleaseUs + Task->DeadlineUs - NowUs);
+    if(Selected == NULL || Task->Priority < Selected->Priority || (Task->Priority == Selected->Priority && Slack < SelectedSlack))
+    {
+      Selected = Task;
+      SelectedSlack = Slack;
+    }
+  }
+  return Selected;
+}
+
+/**
+ * @brief     Set the next release of a task one period after the last one.
+ *            Releases that passed already are skipped and counted, so a late
+ *            task does not run several times in a row.
+ * @param     Task      pointer to the task structure
+ * @param     EndUs     end of the run
+ * @return    none
+ */
+void release_TaskAgain(TaskScheduler_Task_structTd* Task, uint32_t EndUs)
+{
+  if(Task->PeriodUs == 0)
+  {
+    Task->ReleaseUs = EndUs;
+    return;
+  }
+
+  Task->ReleaseUs += Task->PeriodUs;
+  if((int32_t)(EndUs - Task->ReleaseUs) >= 0)
+  {
+    uint32_t Missed = (EndUs - Task->ReleaseUs) / Task->PeriodUs + 1;
+    Task->ReleaseUs += Missed * Task->PeriodUs;
+    Task->Stats.Skipped += Missed;
+  }
+}
+
+/**
+ * @brief     Add the time since the last call to the elapsed time. The 64 bit
+ *            sum does not wrap like the 32 bit time base (71 min), as long
+ *            as this is called at least once per wrap.
+ * @param     NowUs     current time
+ * @return    none
+ */
+void update_ElapsedTime(uint32_t NowUs)
+{
+  TaskSchedulerInternal.ElapsedUs += NowUs - TaskSchedulerInternal.LastUs;
+  TaskSchedulerInternal.LastUs = NowUs;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+const TaskScheduler_Stats_structTd* TaskScheduler_get_Statistics(TaskScheduler_Task_structTd* Task)
+{
+  return &Task->Stats;
+}
+
+/* Description in .h */
+uint16_t TaskScheduler_get_LoadPermille(void)
+{
+  update_ElapsedTime(TimerService_get_TimeUs());
+  uint64_t ElapsedUs = TaskSchedulerInternal.ElapsedUs;
+
+  if(ElapsedUs == 0)
+  {
+    return 0;
+  }
+  uint64_t Load = (TaskSchedulerInternal.BusyUs * 1000) / ElapsedUs;
+  return (Load > 1000) ? 1000 : (uint16_t)Load;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "TaskScheduler_Source" */
+/**@}*//* end of defgroup "TaskScheduler" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -8,6 +8,11 @@
 #include "timer.h"
 
 void Timer_set_ThresholdInMs(Timer_structTd* timer, uint32_t threshold)
+{
+	Timer_set_ThresholdInUs(timer, threshold * 1000);
+}
+
+void Timer_set_ThresholdInUs(Timer_structTd* timer, uint32_t threshold)
 {
 	timer->threshold = threshold;
 	timer->now = 0x00;
@@ -19,7 +24,7 @@ void Timer_restart_Timer(Timer_structTd* timer);
 bool Timer_check_TimerElapsed(Timer_structTd* timer)
 {
   bool returnValue = false;
-  timer->now = HAL_GetTick();
+  timer->now = TimerService_get_TimeUs();
   if((timer->now - timer->old) >= timer->threshold)
   {
     returnValue = true;
@@ -30,6 +35,6 @@ bool Timer_check_TimerElapsed(Timer_structTd* timer)
 
 void Timer_restart_Timer(Timer_structTd* timer)
 {
-  timer->now = HAL_GetTick();
+  timer->now = TimerService_get_TimeUs();
   timer->old = timer->now;
 }
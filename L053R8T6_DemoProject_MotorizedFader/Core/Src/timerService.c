@@ -0,0 +1,411 @@
+/***************************************************************************//**
+ * @defgroup        TimerService_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      TimerService
+ * @{
+ *
+ * @addtogroup      TimerService_Source
+ * @{
+ *
+ * @file            timerService.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <timerService.h>
+
+/**
+ * @brief     Mask of the slot index of one level
+ */
+#define TIMERSERVICE_SLOT_MASK    (TIMERSERVICE_SLOTS - 1)
+
+/**
+ * @brief     Largest distance in ticks that fits into the wheel
+ */
+#define TIMERSERVICE_MAX_TICKS    ((1UL << (TIMERSERVICE_SLOT_BITS * TIMERSERVICE_LEVELS)) - 1)
+
+/**
+ * @brief     Internal data of the timer service
+ */
+typedef struct
+{
+  TIM_HandleTypeDef* htim;          /**<  Time base. NULL: HAL_GetTick() */
+  volatile uint32_t BaseUs;         /**<  Time of the last update event (us) */
+  uint32_t  LastUs;                 /**<  Time of the last wheel update */
+  uint32_t  RemainderUs;            /**<  Time since the last tick */
+  uint32_t  Current;                /**<  Last processed tick */
+  uint32_t  Ticks;                  /**<  Ticks of the running update that
+                                          are not processed yet */
+  uint16_t  Running;                /**<  Number of timers in the wheel */
+  /** Slots of all levels. Each slot is a list of timers. */
+  TimerService_Timer_structTd* Wheel[TIMERSERVICE_LEVELS][TIMERSERVICE_SLOTS];
+}TimerService_internal_structTd;
+
+TimerService_internal_structTd TimerServiceInternal = {0};
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void TimerService_init(TIM_HandleTypeDef* htim)
+{
+  TimerServiceInternal.htim = htim;
+  TimerServiceInternal.BaseUs = 0;
+  TimerServiceInternal.LastUs = TimerService_get_TimeUs();
+  TimerServiceInternal.RemainderUs = 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Timers
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void start_ServiceTimer(TimerService_Timer_structTd* Timer, uint32_t TimeUs, bool Periodic, TimerService_Callback_fpTd Callback, void* Context);
+uint32_t convert_UsToTicks(uint32_t TimeUs);
+uint32_t get_PendingTicks(void);
+void insert_ServiceTimer(TimerService_Timer_structTd* Timer);
+void remove_ServiceTimer(TimerService_Timer_structTd* Timer);
+void cascade_ServiceLevel(uint8_t Level);
+void expire_ServiceSlot(void);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void TimerService_start_Periodic(TimerService_Timer_structTd* Timer, uint32_t PeriodUs, TimerService_Callback_fpTd Callback, void* Context)
+{
+  start_ServiceTimer(Timer, PeriodUs, true, Callback, Context);
+}
+
+/* Description in .h */
+void TimerService_start_Once(TimerService_Timer_structTd* Timer, uint32_t DelayUs, TimerService_Callback_fpTd Callback, void* Context)
+{
+  start_ServiceTimer(Timer, DelayUs, false, Callback, Context);
+}
+
+/* Description in .h */
+void TimerService_stop(TimerService_Timer_structTd* Timer)
+{
+  if(Timer->Running == true)
+  {
+    remove_ServiceTimer(Timer);
+  }
+}
+
+/* Description in .h */
+bool TimerService_check_Elapsed(TimerService_Timer_structTd* Timer)
+{
+  bool Elapsed = Timer->Elapsed;
+  Timer->Elapsed = false;
+  return Elapsed;
+}
+
+/* Description in .h */
+bool TimerService_check_Running(TimerService_Timer_structTd* Timer)
+{
+  return Timer->Running;
+}
+
+/**
+ * @brief     Start a timer. The expiry counts from the current time, not
+ *            from the last processed tick.
+ * @param     Timer     pointer to the timer structure
+ * @param     TimeUs    period or delay in microseconds
+ * @param     Periodic  true restarts the timer when it elapsed
+ * @param     Callback  called when elapsed. NULL: flag only.
+ * @param     Context   passed to the callback
+ * @return    none
+ */
+void start_ServiceTimer(TimerService_Timer_structTd* Timer, uint32_t TimeUs, bool Periodic, TimerService_Callback_fpTd Callback, void* Context)
+{
+  uint32_t Ticks = convert_UsToTicks(TimeUs);
+
+  /** @internal     1.  Restart: take it out of the wheel first */
+  TimerService_stop(Timer);
+
+  /** @internal     2.  Set up and sort it into the wheel */
+  Timer->PeriodTicks = (Periodic == true) ? Ticks : 0;
+  Timer->Callback = Callback;
+  Timer->Context = Context;
+  Timer->Elapsed = false;
+  Timer->Expiry = TimerServiceInternal.Current + get_PendingTicks() + Ticks;
+  insert_ServiceTimer(Timer);
+}
+
+/**
+ * @brief     Convert microseconds to ticks, rounded up. At least one tick.
+ * @param     TimeUs    time in microseconds
+ * @return    ticks
+ */
+uint32_t convert_UsToTicks(uint32_t TimeUs)
+{
+  uint32_t Ticks = (TimeUs + TIMERSERVICE_TICK_US - 1) / TIMERSERVICE_TICK_US;
+  return (Ticks == 0) ? 1 : Ticks;
+}
+
+/**
+ * @brief     Get the ticks that passed since the last processed tick. A
+ *            started tick counts, so a timer never elapses before its time.
+ *            In a callback, the ticks the running update has not processed
+ *            yet count as well.
+ * @param     none
+ * @return    ticks not processed yet, rounded up
+ */
+uint32_t get_PendingTicks(void)
+{
+  uint32_t ElapsedUs = TimerService_get_TimeUs() - TimerServiceInternal.LastUs;
+  return TimerServiceInternal.Ticks + (ElapsedUs + TimerServiceInternal.RemainderUs + TIMERSERVICE_TICK_US - 1) / TIMERSERVICE_TICK_US;
+}
+
+/**
+ * @brief     Sort a timer into the slot of its expiry. The level is given by
+ *            the distance to the current tick: level 0 for less than 16
+ *            ticks, level 1 for less than 256 ticks and so on. The slot is
+ *            the part of the expiry that belongs to the level.
+ * @param     Timer     pointer to the timer structure
+ * @return    none
+ */
+void insert_ServiceTimer(TimerService_Timer_structTd* Timer)
+{
+  uint32_t Current = TimerServiceInternal.Current;
+  int32_t Delta = (int32_t)(Timer->Expiry - Current);
+  uint32_t Position = Timer->Expiry;
+  uint8_t Level = 0;
+
+  /** @internal     1.  A due timer expires with the current slot. A timer
+   *                    behind the wheel waits in the last level. */
+  if(Delta < 0)
+  {
+    Delta = 0;
+    Position = Current;
+  }
+  else if((uint32_t)Delta > TIMERSERVICE_MAX_TICKS)
+  {
+    Position = Current + TIMERSERVICE_MAX_TICKS;
+  }
+
+  /** @internal     2.  Find the level */
+  while(Level < TIMERSERVICE_LEVELS - 1 && ((uint32_t)Delta >> (TIMERSERVICE_SLOT_BITS * (Level + 1))) != 0)
+  {
+    Level++;
+  }
+
+  /** @internal     3.  Put it in front of the slot list */
+  uint8_t Slot = (Position >> (TIMERSERVICE_SLOT_BITS * Level)) & TIMERSERVICE_SLOT_MASK;
+  TimerService_Timer_structTd** Head = &TimerServiceInternal.Wheel[Level][Slot];
+  Timer->Prev = NULL;
+  Timer->Next = *Head;
+  if(*Head != NULL)
+  {
+    (*Head)->Prev = Timer;
+  }
+  *Head = Timer;
+  Timer->Level = Level;
+  Timer->Slot = Slot;
+  Timer->Running = true;
+  TimerServiceInternal.Running++;
+}
+
+/**
+ * @brief     Take a timer out of its slot list
+ * @param     Timer     pointer to the timer structure
+ * @return    none
+ */
+void remove_ServiceTimer(TimerService_Timer_structTd* Timer)
+{
+  /** @internal     1.  Unlink it. The first timer of a slot is linked by
+   *                    the slot. */
+  if(Timer->Prev != NULL)
+  {
+    Timer->Prev->Next = Timer->Next;
+  }
+  else
+  {
+    TimerServiceInternal.Wheel[Timer->Level][Timer->Slot] = Timer->Next;
+  }
+  if(Timer->Next != NULL)
+  {
+    Timer->Next->Prev = Timer->Prev;
+  }
+  Timer->Next = NULL;
+  Timer->Prev = NULL;
+  Timer->Running = false;
+  TimerServiceInternal.Running--;
+}
+
+/** @} ************************************************************************/
+/* end of name "Timers"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void TimerService_update(void)
+{
+  /** @internal     1.  Read the time base once and convert the elapsed time
+   *                    to ticks. The remainder is kept for the next update. */
+  uint32_t NowUs = TimerService_get_TimeUs();
+  uint32_t ElapsedUs = NowUs - TimerServiceInternal.LastUs + TimerServiceInternal.RemainderUs;
+  uint32_t Ticks = ElapsedUs / TIMERSERVICE_TICK_US;
+  TimerServiceInternal.LastUs = NowUs;
+  TimerServiceInternal.RemainderUs = ElapsedUs - Ticks * TIMERSERVICE_TICK_US;
+  TimerServiceInternal.Ticks = Ticks;
+
+  /** @internal     2.  Process each tick: cascade the higher levels when the
+   *                    lower level wraps and expire the slot of the tick. An
+   *                    empty wheel jumps to the current tick. The ticks left
+   *                    are kept, so a timer started in a callback counts
+   *                    from now and not from the processed tick. */
+  while(TimerServiceInternal.Ticks > 0)
+  {
+    if(TimerServiceInternal.Running == 0)
+    {
+      TimerServiceInternal.Current += TimerServiceInternal.Ticks;
+      TimerServiceInternal.Ticks = 0;
+      break;
+    }
+    TimerServiceInternal.Current++;
+    TimerServiceInternal.Ticks--;
+    uint8_t Level = 1;
+    while(Level < TIMERSERVICE_LEVELS && (TimerServiceInternal.Current & ((1UL << (TIMERSERVICE_SLOT_BITS * Level)) - 1)) == 0)
+    {
+      cascade_ServiceLevel(Level);
+      Level++;
+    }
+    expire_ServiceSlot();
+  }
+}
+
+/**
+ * @brief     Sort the timers of the current slot of a level again. They get
+ *            into a lower level (or expire with the current tick).
+ * @param     Level     level to cascade (1 ... @ref TIMERSERVICE_LEVELS - 1)
+ * @return    none
+ */
+void cascade_ServiceLevel(uint8_t Level)
+{
+  uint8_t Slot = (TimerServiceInternal.Current >> (TIMERSERVICE_SLOT_BITS * Level)) & TIMERSERVICE_SLOT_MASK;
+  TimerService_Timer_structTd* Timer = TimerServiceInternal.Wheel[Level][Slot];
+
+  /** @internal     1.  Take the whole list and insert each timer again */
+  TimerServiceInternal.Wheel[Level][Slot] = NULL;
+  while(Timer != NULL)
+  {
+    TimerService_Timer_structTd* Next = Timer->Next;
+    TimerServiceInternal.Running--;
+    insert_ServiceTimer(Timer);
+    Timer = Next;
+  }
+}
+
+/**
+ * @brief     Expire all timers of the slot of the current tick. Periodic
+ *            timers are sorted in again, one period after the expiry.
+ * @param     none
+ * @return    none
+ */
+void expire_ServiceSlot(void)
+{
+  uint8_t Slot = TimerServiceInternal.Current & TIMERSERVICE_SLOT_MASK;
+  TimerService_Timer_structTd** Head = &TimerServiceInternal.Wheel[0][Slot];
+
+  /** @internal     1.  Take one timer after the other, as a callback may
+   *                    stop or start other timers of this slot. Restarted
+   *                    timers never get into the current slot. */
+  while(*Head != NULL)
+  {
+    TimerService_Timer_structTd* Timer = *Head;
+    remove_ServiceTimer(Timer);
+    Timer->Elapsed = true;
+    if(Timer->PeriodTicks != 0)
+    {
+      Timer->Expiry += Timer->PeriodTicks;
+      insert_ServiceTimer(Timer);
+    }
+    if(Timer->Callback != NULL)
+    {
+      Timer->Callback(Timer->Context);
+    }
+  }
+}
+
+/* Description in .h */
+void TimerService_manage_Interrupt(TIM_HandleTypeDef* htim)
+{
+  if(htim == TimerServiceInternal.htim)
+  {
+    TimerServiceInternal.BaseUs += __HAL_TIM_GET_AUTORELOAD(htim) + 1;
+  }
+}
+
+/* Description in .h */
+void TimerService_manage_CounterReset(TIM_HandleTypeDef* htim, uint32_t ElapsedUs)
+{
+  if(htim == TimerServiceInternal.htim)
+  {
+    TimerServiceInternal.BaseUs += ElapsedUs;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+uint32_t TimerService_get_TimeUs(void)
+{
+  TIM_HandleTypeDef* htim = TimerServiceInternal.htim;
+  uint32_t BaseUs = 0;
+  uint32_t Ticks = 0;
+
+  /** @internal     1.  Without timer: the HAL tick */
+  if(htim == NULL)
+  {
+    return HAL_GetTick() * 1000;
+  }
+
+  /** @internal     2.  Time of the last update event plus the counter. Read
+   *                    again, if the interrupt changed the base in between. */
+  do
+  {
+    BaseUs = TimerServiceInternal.BaseUs;
+    Ticks = __HAL_TIM_GET_COUNTER(htim);
+  }while(BaseUs != TimerServiceInternal.BaseUs);
+
+  return BaseUs + Ticks;
+}
+
+/* Description in .h */
+uint16_t TimerService_get_RunningTimers(void)
+{
+  return TimerServiceInternal.Running;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "TimerService_Source" */
+/**@}*//* end of defgroup "TimerService" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -16,6 +16,20 @@
 
 #include <tscButton.h>
 
+/**
+ * @brief     One parallel acquisition. It contains at most one button of each
+ *            group, as the TSC can only sample one IO per group at once.
+ */
+typedef struct
+{
+  TSC_IOConfigTypeDef ioConfigTsc;  /**< Channels of all buttons in this
+                                         acquisition */
+  uint8_t     ButtonIndices[NUM_TSC_GROUPS]; /**< Index of the buttons in
+                                         InitializedButtons */
+  uint8_t     NumButtons;           /**< Number of buttons in this
+                                         acquisition */
+}TSCButton_acquisition_structTd;
+
 /**
  * @brief     Structure for internal use. All initialized buttons will be linked
  *            here.
@@ -24,15 +38,19 @@ typedef struct
 {
   TSCButton_structTd* InitializedButtons[MAX_TSC_BUTTONS]; /**< Array with
                                          pointer to all initialized buttons */
-  uint8_t     CurrentButtonIndex;   /**< Active Index of the pointer array*/
   uint8_t     NumButtons;           /**< Number of initialized buttons */
 
-  Timer_structTd  timer;      /**< timer used to give the sampling
-                                         capacitor time to discharge */
+  TSCButton_acquisition_structTd Acquisitions[NUM_FREE_IOS]; /**< Buttons
+                                         packed into parallel acquisitions */
+  uint8_t     CurrentAcquisitionIndex; /**< Active acquisition */
+  uint8_t     NumAcquisitions;      /**< Number of used acquisitions */
+
+  TimerService_Timer_structTd DischargeTimer; /**< one shot timer used to
+                                         give the sampling capacitor time to
+                                         discharge */
   uint8_t     CapacitorDischargeTime; /**< Time the capacitors need to
                                          discharge */
   bool      interrupted;
-  bool      TSCBlocked;
   bool      TSCStarted;
 }TSCButton_internal_structTd;
 
@@ -40,10 +58,10 @@ typedef struct
  * @brief     Object of TSCButton_internal_structTd type to save internal data.
  */
 TSCButton_internal_structTd TSC_Internal = {
-    .CurrentButtonIndex = 0,
     .NumButtons = 0,
+    .CurrentAcquisitionIndex = 0,
+    .NumAcquisitions = 0,
     .interrupted = false,
-    .TSCBlocked = false,
     .TSCStarted = false,
 };
 
@@ -87,10 +105,9 @@ void TSCButton_init_TSC(TSCButton_structTd* tsc, TSC_HandleTypeDef* htsc, uint32
  */
 void link_ButtonToInternalStructure(TSCButton_structTd* tsc)
 {
-  uint8_t Index = TSC_Internal.CurrentButtonIndex;
+  uint8_t Index = TSC_Internal.NumButtons;
 
   TSC_Internal.InitializedButtons[Index] = tsc;
-  TSC_Internal.CurrentButtonIndex++;
   TSC_Internal.NumButtons++;
 }
 
@@ -135,6 +152,21 @@ void TSCButton_init_Threshold(TSCButton_structTd* tsc, uint16_t value)
   tsc->threshold = value;
 }
 
+/* Description in .h */
+void TSCButton_init_Adaptive(TSCButton_structTd* tsc, uint16_t TouchDelta, uint16_t ReleaseDelta, uint8_t ConfirmCount)
+{
+  /** @internal     1.  Save the deltas. The release delta must be smaller
+   *                    than the touch delta for the hysteresis. */
+  tsc->TouchDelta = TouchDelta;
+  tsc->ReleaseDelta = (ReleaseDelta < TouchDelta) ? ReleaseDelta : TouchDelta;
+
+  /** @internal     2.  At least one acquisition is needed to change the
+   *                    state */
+  tsc->ConfirmCount = (ConfirmCount != 0) ? ConfirmCount : 1;
+  tsc->ConfirmCounter = 0;
+  tsc->Baseline = 0;
+}
+
 /* Description in .h */
 void TSCButton_init_DischargeTimeMsAll(uint8_t value)
 {
@@ -152,113 +184,266 @@ void TSCButton_init_DischargeTimeMsAll(uint8_t value)
  * @{
  ******************************************************************************/
 
-/* Description in .h */
-void TSCButton_start_All(void)
-{
-  /** @internal     1.  set button current button index to 0 */
-  TSC_Internal.CurrentButtonIndex = 0;
-}
-
 /** @cond *//* Function Prototypes */
+void pack_TSCAcquisitions(void);
+void update_TSCButtonState(TSCButton_structTd* tsc, uint32_t Sample);
+void update_TSCButtonAdaptive(TSCButton_structTd* tsc, uint32_t Sample);
 void block_TSCForSomeMs(uint32_t BlockingTime);
 bool check_TSCBlocked(void);
 void store_TSCSample(TSCButton_structTd* tsc, uint32_t Sample);
 void calculate_SmoothTSCValue(TSCButton_structTd* tsc);
 /** @endcond *//* Function Prototypes */
 
+/* Description in .h */
+void TSCButton_start_All(void)
+{
+  /** @internal     1.  Pack all buttons into parallel acquisitions */
+  pack_TSCAcquisitions();
+
+  /** @internal     2.  Start with the first acquisition */
+  TSC_Internal.CurrentAcquisitionIndex = 0;
+}
+
+/**
+ * @brief     Pack all initialized buttons into as few parallel acquisitions
+ *            as possible. Each button is added to the first acquisition that
+ *            has no button of its group yet. So the number of acquisitions
+ *            is the largest number of buttons in one group (1 - 3).
+ * @param     none
+ * @return    none
+ */
+void pack_TSCAcquisitions(void)
+{
+  uint8_t ButtonIndex = 0;
+  uint8_t Index = 0;
+
+  /** @internal     1.  Clear all acquisitions */
+  for(Index = 0; Index < NUM_FREE_IOS; Index++)
+  {
+    TSC_Internal.Acquisitions[Index].ioConfigTsc.ChannelIOs = 0;
+    TSC_Internal.Acquisitions[Index].NumButtons = 0;
+  }
+  TSC_Internal.NumAcquisitions = 0;
+
+  /** @internal     2.  Add each button to the first acquisition without a
+   *                    button of the same group */
+  for(ButtonIndex = 0; ButtonIndex < TSC_Internal.NumButtons; ButtonIndex++)
+  {
+    TSCButton_structTd* tsc = TSC_Internal.InitializedButtons[ButtonIndex];
+    uint32_t GroupMask = 0x0FUL << (tsc->TSCGroup * 4);
+
+    for(Index = 0; Index < NUM_FREE_IOS; Index++)
+    {
+      TSCButton_acquisition_structTd* Acquisition = &TSC_Internal.Acquisitions[Index];
+      if((Acquisition->ioConfigTsc.ChannelIOs & GroupMask) == 0)
+      {
+        Acquisition->ioConfigTsc.ChannelIOs |= tsc->ioConfigTsc.ChannelIOs;
+        Acquisition->ioConfigTsc.ShieldIOs = tsc->ioConfigTsc.ShieldIOs;
+        Acquisition->ioConfigTsc.SamplingIOs = tsc->ioConfigTsc.SamplingIOs;
+        Acquisition->ButtonIndices[Acquisition->NumButtons] = ButtonIndex;
+        Acquisition->NumButtons++;
+
+        /** @internal     3.  Count the used acquisitions */
+        if(Index >= TSC_Internal.NumAcquisitions)
+        {
+          TSC_Internal.NumAcquisitions = Index + 1;
+        }
+        break;
+      }
+    }
+  }
+}
+
 /* Description in .h */
 void TSCButton_update_All(void)
 {
-  uint8_t NumButtons = TSC_Internal.NumButtons;
-  uint8_t CurrentButtonIndex = TSC_Internal.CurrentButtonIndex;
-  TSCButton_structTd* ActiveTSCButton = TSC_Internal.InitializedButtons[CurrentButtonIndex];
+  uint8_t NumAcquisitions = TSC_Internal.NumAcquisitions;
+  uint8_t Index = 0;
 
-  /** @internal     1.  Check if TSC is blocked.
+  /** @internal     1.  Leave if there is no button */
+  if(NumAcquisitions == 0)
+  {
+    return;
+  }
+
+  TSCButton_acquisition_structTd* Acquisition = &TSC_Internal.Acquisitions[TSC_Internal.CurrentAcquisitionIndex];
+  TSC_HandleTypeDef* htsc = TSC_Internal.InitializedButtons[Acquisition->ButtonIndices[0]]->htsc;
+
+  /** @internal     2.  Check if TSC is blocked.
    *                    - If yes: leave function*/
 
   if(check_TSCBlocked() == false)
   {
-    /** @internal     2.  Check it TSC is already running
-     *                    - If not: start TSC */
+    /** @internal     3.  Check it TSC is already running
+     *                    - If not: start TSC with the IOs of all buttons of
+     *                      the current acquisition */
     if(TSC_Internal.TSCStarted == false)
     {
-      HAL_TSC_IODischarge(ActiveTSCButton->htsc, DISABLE);
+      HAL_TSC_IODischarge(htsc, DISABLE);
 
 
-      HAL_TSC_IOConfig(ActiveTSCButton->htsc, &ActiveTSCButton->ioConfigTsc);
-      HAL_TSC_Start_IT(ActiveTSCButton->htsc);
+      HAL_TSC_IOConfig(htsc, &Acquisition->ioConfigTsc);
+      HAL_TSC_Start_IT(htsc);
       TSC_Internal.TSCStarted = true;
     }
 
-    /** @internal     3.  Check if TSC was interrupted.
+    /** @internal     4.  Check if TSC was interrupted.
      *                    - If not: leave function */
     if(TSC_Internal.interrupted == true)
     {
       TSC_Internal.interrupted = false;
-      HAL_TSC_Stop_IT(ActiveTSCButton->htsc);
+      HAL_TSC_Stop_IT(htsc);
       TSC_Internal.TSCStarted = false;
 
-      uint32_t  TSC_Value = 0;
-      TSC_Value = HAL_TSC_GroupGetValue(ActiveTSCButton->htsc, ActiveTSCButton->TSCGroup);
-
-      store_TSCSample(ActiveTSCButton, TSC_Value);
-      calculate_SmoothTSCValue(ActiveTSCButton);
-
-      uint32_t  TSC_Smooth = ActiveTSCButton->SmoothValue;
-
-      if(TSC_Smooth >= ActiveTSCButton->threshold)
+      /** @internal     5.  Read the group value of each button of the
+       *                    acquisition and update its state */
+      for(Index = 0; Index < Acquisition->NumButtons; Index++)
       {
-        ActiveTSCButton->state = TSCBUTTON_RELEASED;
+        TSCButton_structTd* tsc = TSC_Internal.InitializedButtons[Acquisition->ButtonIndices[Index]];
+        uint32_t  TSC_Value = 0;
+        TSC_Value = HAL_TSC_GroupGetValue(htsc, tsc->TSCGroup);
+        update_TSCButtonState(tsc, TSC_Value);
       }
-      else if(TSC_Smooth < ActiveTSCButton->threshold)
-      {
-        ActiveTSCButton->state = TSCBUTTON_TOUCHED;
-      }
-      HAL_TSC_IODischarge(ActiveTSCButton->htsc, ENABLE);
+
+      HAL_TSC_IODischarge(htsc, ENABLE);
       block_TSCForSomeMs(TSC_Internal.CapacitorDischargeTime);
 
-      TSC_Internal.CurrentButtonIndex++;
-      if(TSC_Internal.CurrentButtonIndex == NumButtons)
+      TSC_Internal.CurrentAcquisitionIndex++;
+      if(TSC_Internal.CurrentAcquisitionIndex == NumAcquisitions)
       {
-        TSC_Internal.CurrentButtonIndex = 0;
+        TSC_Internal.CurrentAcquisitionIndex = 0;
       }
     }
   }
 }
 
 /**
- * @brief     Function to block the TSC for a specific time in ms. This will
- *            only block the TSC, not the whole program.
- * @param     BlockingTime in milli seconds
+ * @brief     Store a new sample and update the state of a button.
+ * @param     tsc       pointer to the users tsc structure
+ * @param     Sample    of the current TSC measurement
  * @return    none
  */
-void block_TSCForSomeMs(uint32_t BlockingTime)
+void update_TSCButtonState(TSCButton_structTd* tsc, uint32_t Sample)
 {
-  Timer_set_ThresholdInMs(&TSC_Internal.timer, BlockingTime);
-  TSC_Internal.TSCBlocked = true;
+  store_TSCSample(tsc, Sample);
+  calculate_SmoothTSCValue(tsc);
+
+  if(tsc->TouchDelta != 0)
+  {
+    update_TSCButtonAdaptive(tsc, Sample);
+    return;
+  }
+
+  uint32_t  TSC_Smooth = tsc->SmoothValue;
+
+  if(TSC_Smooth >= tsc->threshold)
+  {
+    tsc->state = TSCBUTTON_RELEASED;
+  }
+  else if(TSC_Smooth < tsc->threshold)
+  {
+    tsc->state = TSCBUTTON_TOUCHED;
+  }
 }
 
 /**
- * @brief     Check if TSC is blocked
- * @param     none
- * @return    true if TSC is blocked, false if not
+ * @brief     Update the state of a button with adaptive baseline.
+ * @param     tsc       pointer to the users tsc structure
+ * @param     Sample    of the current TSC measurement
+ * @return    none
  */
-bool check_TSCBlocked(void)
+void update_TSCButtonAdaptive(TSCButton_structTd* tsc, uint32_t Sample)
 {
-  bool ReturnValue = false;
-  if(TSC_Internal.TSCBlocked == true)
+  /** @internal     1.  Start the baseline with the first sample */
+  if(tsc->Baseline == 0)
+  {
+    tsc->Baseline = Sample << TSC_BASELINE_SHIFT;
+  }
+
+  /** @internal     2.  Calculate the drop below the baseline. A touch
+   *                    lowers the TSC value. */
+  int32_t Baseline = (int32_t)(tsc->Baseline >> TSC_BASELINE_SHIFT);
+  int32_t Delta = Baseline - (int32_t)Sample;
+  int32_t TouchDelta = (int32_t)tsc->TouchDelta;
+
+  /** @internal     3.  Calculate the confidence */
+  if(Delta <= 0)
+  {
+    tsc->Confidence = 0;
+  }
+  else if(Delta >= TouchDelta)
+  {
+    tsc->Confidence = 100;
+  }
+  else
   {
-    if(Timer_check_TimerElapsed(&TSC_Internal.timer) == true)
+    tsc->Confidence = (uint8_t)((Delta * 100) / TouchDelta);
+  }
+
+  /** @internal     4.  Count the acquisitions in a row that point to the
+   *                    other state. Touch needs the touch delta, release
+   *                    the smaller release delta (hysteresis). */
+  bool ChangeState = false;
+  if(tsc->state == TSCBUTTON_RELEASED)
+  {
+    ChangeState = (Delta >= TouchDelta);
+  }
+  else
+  {
+    ChangeState = (Delta < (int32_t)tsc->ReleaseDelta);
+  }
+
+  if(ChangeState == true)
+  {
+    tsc->ConfirmCounter++;
+    if(tsc->ConfirmCounter >= tsc->ConfirmCount)
     {
-      ReturnValue = false;
-      TSC_Internal.TSCBlocked = false;
+      tsc->state = (tsc->state == TSCBUTTON_RELEASED) ? TSCBUTTON_TOUCHED : TSCBUTTON_RELEASED;
+      tsc->ConfirmCounter = 0;
+    }
+  }
+  else
+  {
+    tsc->ConfirmCounter = 0;
+  }
+
+  /** @internal     5.  Update the baseline only while released and close to
+   *                    it, so an approaching finger is not learned. A value
+   *                    far above the baseline means the baseline was
+   *                    learned with a finger on the button: restart it. */
+  if(tsc->state == TSCBUTTON_RELEASED && Delta < (int32_t)tsc->ReleaseDelta)
+  {
+    if(Delta <= -TouchDelta)
+    {
+      tsc->Baseline = Sample << TSC_BASELINE_SHIFT;
     }
     else
     {
-      ReturnValue = true;
+      tsc->Baseline = tsc->Baseline - (tsc->Baseline >> TSC_BASELINE_SHIFT) + Sample;
     }
   }
-  return ReturnValue;
+}
+
+/**
+ * @brief     Function to block the TSC for a specific time in ms. This will
+ *            only block the TSC, not the whole program. The time runs on a
+ *            one shot timer of the timer service.
+ * @param     BlockingTime in milli seconds
+ * @return    none
+ */
+void block_TSCForSomeMs(uint32_t BlockingTime)
+{
+  TimerService_start_Once(&TSC_Internal.DischargeTimer, BlockingTime * 1000, NULL, NULL);
+}
+
+/**
+ * @brief     Check if TSC is blocked
+ * @param     none
+ * @return    true if TSC is blocked, false if not
+ */
+bool check_TSCBlocked(void)
+{
+  return TimerService_check_Running(&TSC_Internal.DischargeTimer);
 }
 
 /**
@@ -270,40 +455,32 @@ bool check_TSCBlocked(void)
  */
 void store_TSCSample(TSCButton_structTd* tsc, uint32_t Sample)
 {
-  /** @internal     1.  Copy Sample to Sample Array at current
-   *                    Array-Index */
-  tsc->Samples[tsc->SamplesIndex] = Sample;
+  /** @internal     1.  The first sample starts the average (the raw value
+   *                    is 0 until then). Otherwise the average rises from 0,
+   *                    so the smooth value is below the threshold and the
+   *                    button reads touched for the first samples after
+   *                    start. */
+  if(tsc->RawValue == 0)
+  {
+    tsc->SmoothAccu = Sample << TSC_SMOOTH_SHIFT;
+  }
   /** @internal     2.  Copy Sample to Value Raw to be able
    *                    to return it quick to the user if needed. */
   tsc->RawValue = Sample;
-  /** @internal     3.  Count up the sample array index for the next value. */
-  tsc->SamplesIndex++;
-  /** @internal     4.  If sample array index reaches the defined
-   *                     @ref TSC_NUM_SAMPLES, reset the index. The following
-   *                     values will overwrite the old ones. */
-  if(tsc->SamplesIndex == TSC_NUM_SAMPLES)
-  {
-    tsc->SamplesIndex = 0x00;
-  }
 }
 
 /**
- * @brief     Calculate an average of all available samples
+ * @brief     Calculate the exponential moving average of the samples
  * @param     tsc       pointer to the users tsc structure
  * @return    none
  */
 void calculate_SmoothTSCValue(TSCButton_structTd* tsc)
 {
-  /** @internal     1.  Declare a variable to store the sum of all samples */
-  uint32_t SumOfSamples = 0x00;
-  /** @internal     2.  Calculate the sum of all samples */
-  for(uint8_t i = 0; i < TSC_NUM_SAMPLES; i++)
-  {
-    SumOfSamples = SumOfSamples + tsc->Samples[i];
-  }
-  /** @internal     3.  Divide the sum of all samples by the
-   *                    @ref TSC_NUM_SAMPLES to get the smoothed value. */
-  tsc->SmoothValue = SumOfSamples / TSC_NUM_SAMPLES;
+  /** @internal     1.  Add the new sample with the weight
+   *                    1 / 2^@ref TSC_SMOOTH_SHIFT */
+  tsc->SmoothAccu = tsc->SmoothAccu - (tsc->SmoothAccu >> TSC_SMOOTH_SHIFT) + tsc->RawValue;
+  /** @internal     2.  Remove the shift to get the smoothed value */
+  tsc->SmoothValue = tsc->SmoothAccu >> TSC_SMOOTH_SHIFT;
 }
 
 /* Description in .h */
@@ -339,6 +516,18 @@ uint32_t TSCButton_get_SmoothValue(TSCButton_structTd* tsc)
 {
   return tsc->SmoothValue;
 }
+
+/* Description in .h */
+uint32_t TSCButton_get_Baseline(TSCButton_structTd* tsc)
+{
+  return tsc->Baseline >> TSC_BASELINE_SHIFT;
+}
+
+/* Description in .h */
+uint8_t TSCButton_get_Confidence(TSCButton_structTd* tsc)
+{
+  return tsc->Confidence;
+}
 /** @} ************************************************************************/
 /* end of name "Get Functions"
  ******************************************************************************/
@@ -23,9 +23,13 @@ typedef struct
 {
   ADC_HandleTypeDef*  hadc;         /**<  HAL-handle of the ADC */
   bool            hadcInterrupted;  /**<  Flag to mark an interrupt */
-  uint16_t        BufferDMA[NUM_ALL_ADC_CHANNELS];  /**< DMA will use this
-                                          buffer to store the ADC data of each
-                                          channel. */
+  bool            Circular;         /**<  true if the DMA runs in circular
+                                          mode */
+  uint16_t        BufferDMA[WIPER_DMA_NUM_SCANS * NUM_ALL_ADC_CHANNELS];  /**<
+                                          DMA will use this buffer to store the
+                                          ADC data of each channel. In circular
+                                          mode it contains WIPER_DMA_NUM_SCANS
+                                          scans. */
   Wiper_structTd* InitializedWipers[NUM_ALL_ADC_CHANNELS];  /**< Pointers to all
                                           initialized wipers on this ADC */
   uint8_t         NumUsedChannels;  /**<  Number of used channels of this ADC.
@@ -88,6 +92,9 @@ void Wiper_init_ADC(Wiper_structTd* Wiper, ADC_HandleTypeDef* hadc)
   /** @internal     2.  Link the ADC relevant parts of the Wiper structure to
    *                    the internal structure at the valid ADC index. */
   link_WiperToInternalStructure(Wiper, IndexValidADC);
+
+  /** @internal     3.  Set the default filter */
+  WiperFilter_init(&Wiper->Filter, WIPERFILTER_BOX, WIPERFILTER_BOX_MAX_SHIFT);
 }
 
 /**
@@ -209,6 +216,12 @@ void Wiper_init_Hysteresis(Wiper_structTd* Wiper)
   Wiper->Hyst_DeviationThreshold = NumDeviationThresholdDefault;
 }
 
+/* Description in .h */
+void Wiper_init_Filter(Wiper_structTd* Wiper, WiperFilter_Type_enumTd Type, uint8_t Shift)
+{
+  WiperFilter_init(&Wiper->Filter, Type, Shift);
+}
+
 /** @} ************************************************************************/
 /* end of name "Initialize"
  ******************************************************************************/
@@ -237,6 +250,12 @@ void Wiper_calibrate_HysteresisDeviationThreshold(Wiper_structTd* Wiper, uint8_t
   Wiper->Hyst_DeviationThreshold = Threshold;
 }
 
+/* Description in .h */
+void Wiper_calibrate_FilterBeta(Wiper_structTd* Wiper, uint16_t Beta)
+{
+  WiperFilter_set_Beta(&Wiper->Filter, Beta);
+}
+
 /** @} ************************************************************************/
 /* end of name "Calibrate"
  ******************************************************************************/
@@ -256,12 +275,21 @@ void Wiper_start_All(void)
   /** @internal     1.  Loop through all active ADCs */
   for(IndexLoop = 0; IndexLoop < NumHadcs; IndexLoop++)
   {
-    ADC_HandleTypeDef*  handle = WiperInternal.ADCs[IndexLoop].hadc;
-    uint16_t* Buffer = WiperInternal.ADCs[IndexLoop].BufferDMA;
-    uint8_t UsedChannels = WiperInternal.ADCs[IndexLoop].NumUsedChannels;
+    Wiper_ADCdescriptor_structTd* ActiveADC = &WiperInternal.ADCs[IndexLoop];
+    ADC_HandleTypeDef*  handle = ActiveADC->hadc;
+    uint16_t* Buffer = ActiveADC->BufferDMA;
+    uint32_t Length = ActiveADC->NumUsedChannels;
+
+    /** @internal     2.  Check the DMA mode set in Cube MX. In circular mode,
+     *                    the buffer contains WIPER_DMA_NUM_SCANS scans. */
+    ActiveADC->Circular = (handle->DMA_Handle->Init.Mode == DMA_CIRCULAR);
+    if(ActiveADC->Circular == true)
+    {
+      Length = Length * WIPER_DMA_NUM_SCANS;
+    }
 
-    /** @internal     2. Start ADC on DMA for each active ADC */
-    HAL_ADC_Start_DMA(handle, (uint32_t*) Buffer, UsedChannels);
+    /** @internal     3. Start ADC on DMA for each active ADC */
+    HAL_ADC_Start_DMA(handle, (uint32_t*) Buffer, Length);
   }
 }
 
@@ -280,9 +308,10 @@ void Wiper_update_All(void)
   for(IndexADCs = 0; IndexADCs < NumHadcs; IndexADCs++)
   {
     Wiper_ADCdescriptor_structTd* ActiveADC = &WiperInternal.ADCs[IndexADCs];
-    /** @internal     2.  Check if the current ADC was interrupted.
+    /** @internal     2.  Check if the current ADC was interrupted. ADCs in
+     *                    circular mode are updated in the interrupt.
      *                    - If no: leave function. */
-    if(ActiveADC->hadcInterrupted == true)
+    if(ActiveADC->hadcInterrupted == true && ActiveADC->Circular == false)
     {
       /** @internal      3.  Reset Interrupt Flag of current ADC */
       ActiveADC->hadcInterrupted = false;
@@ -315,28 +344,17 @@ void Wiper_update_All(void)
 }
 
 /**
- * @brief			Copy the current value from the DMA buffer to the Sample Array.
+ * @brief			Copy the current value from the DMA buffer to the wiper.
  * @param			Wiper			pointer to the users wiper structure
  * @return		none
  *
  */
 void store_SampleFromDMABuffer(Wiper_structTd* Wiper, uint16_t Buffer)
 {
-	/** @internal			1.	Copy Value from DMA buffer to Sample Array at current
-	 * 										Array-Index */
-	Wiper->Samples[Wiper->SamplesIndex] = Buffer;
-  /** @internal     2.  Copy Value from DMA buffer to Value Raw to be able
-   *                    to return it quick to the user if needed. */
+  /** @internal     1.  Copy Value from DMA buffer to Value Raw to be able
+   *                    to return it quick to the user if needed and to
+   *                    filter it. */
 	Wiper->ValueRaw = Buffer;
-	/** @internal			3.	Count up the sample array index for the next value. */
-	Wiper->SamplesIndex++;
-	/** @internal			4.	If sample array index reaches the defined
-	 * 										 @ref NUMBER_OF_SAMPLES, reset the index. The following
-	 * 										 values will overwrite the old ones. */
-	if(Wiper->SamplesIndex == NUMBER_OF_SAMPLES)
-	{
-		Wiper->SamplesIndex = 0x00;
-	}
 }
 
 /** @cond *//* Function Prototypes */
@@ -344,25 +362,19 @@ uint16_t get_SmoothedVlaueWithHysteresis(Wiper_structTd* Wiper, uint16_t Samples
 /** @endcond *//* Function Prototypes */
 
 /**
- * @brief			Calculate an average of all available samples
+ * @brief			Filter the newest sample with the selected filter of the wiper.
+ *            The filters need constant time for each sample.
  * @param			Wiper			pointer to the users wiper structure
  * @return		none
  */
 void calculate_SmoothADCValue(Wiper_structTd* Wiper)
 {
-	/** @internal			1.	Declare a variable to store the sum of all samples */
-  uint32_t SumOfSamples = 0x00;
-  uint16_t SamplesAverage = 0x00;
-  /** @internal			2.	Calculate the sum of all samples */
-  for(uint8_t i = 0; i < NUMBER_OF_SAMPLES; i++)
-  {
-    SumOfSamples = SumOfSamples + Wiper->Samples[i];
-  }
-  /** @internal			3.	Divide the sum of all samples by the
-   * 										@ref NUMBER_OF_SAMPLES to get the smoothed value. */
-  SamplesAverage = SumOfSamples / NUMBER_OF_SAMPLES;
-  /** @internal     4.  Calculate hysteresis */
+  PROFILER_ENTER(PROFILER_REGION_WIPER);
+  /** @internal			1.	Add the newest sample to the filter */
+  uint16_t SamplesAverage = WiperFilter_update(&Wiper->Filter, Wiper->ValueRaw);
+  /** @internal     2.  Calculate hysteresis */
   Wiper->ValueSmooth = get_SmoothedVlaueWithHysteresis(Wiper, SamplesAverage);
+  PROFILER_EXIT(PROFILER_REGION_WIPER);
 }
 
 /** @cond *//* Function Prototypes */
@@ -486,6 +498,10 @@ void reset_ValueDeviationCounters(Wiper_structTd* Wiper)
   Wiper->Hyst_NumBiggerValues = 0;
 }
 
+/** @cond *//* Function Prototypes */
+void update_FromCircularBuffer(Wiper_ADCdescriptor_structTd* ActiveADC, uint8_t FirstScan);
+/** @endcond *//* Function Prototypes */
+
 /* Description in .h */
 void Wiper_manage_Interrupt(ADC_HandleTypeDef* hadc)
 {
@@ -493,10 +509,65 @@ void Wiper_manage_Interrupt(ADC_HandleTypeDef* hadc)
   /** @internal     1.  Loop through all active ADCs*/
   for(index = 0; index < WiperInternal.NumADCs; index++)
   {
-    /** @internal     2.  If current ADC matches hadc, set interrupt flag*/
-    if(WiperInternal.ADCs[index].hadc == hadc)
+    Wiper_ADCdescriptor_structTd* ActiveADC = &WiperInternal.ADCs[index];
+    /** @internal     2.  If current ADC matches hadc:
+     *                    - circular mode: filter the second half of the buffer
+     *                    - normal mode: set interrupt flag */
+    if(ActiveADC->hadc == hadc)
+    {
+      if(ActiveADC->Circular == true)
+      {
+        update_FromCircularBuffer(ActiveADC, WIPER_DMA_NUM_SCANS / 2);
+      }
+      else
+      {
+        ActiveADC->hadcInterrupted = true;
+      }
+    }
+  }
+}
+
+/* Description in .h */
+void Wiper_manage_HalfInterrupt(ADC_HandleTypeDef* hadc)
+{
+  uint8_t index = 0;
+  /** @internal     1.  Loop through all active ADCs*/
+  for(index = 0; index < WiperInternal.NumADCs; index++)
+  {
+    Wiper_ADCdescriptor_structTd* ActiveADC = &WiperInternal.ADCs[index];
+    /** @internal     2.  If current ADC matches hadc and runs in circular
+     *                    mode, filter the first half of the buffer. */
+    if(ActiveADC->hadc == hadc && ActiveADC->Circular == true)
+    {
+      update_FromCircularBuffer(ActiveADC, 0);
+    }
+  }
+}
+
+/**
+ * @brief     Filter all scans of one half of the circular DMA buffer. The DMA
+ *            writes to the other half in the meantime.
+ * @param     ActiveADC   pointer to the internal ADC structure
+ * @param     FirstScan   index of the first scan of the finished half
+ * @return    none
+ */
+void update_FromCircularBuffer(Wiper_ADCdescriptor_structTd* ActiveADC, uint8_t FirstScan)
+{
+  uint8_t NumChannels = ActiveADC->NumUsedChannels;
+  uint8_t LastScan = FirstScan + (WIPER_DMA_NUM_SCANS / 2);
+  uint8_t IndexScans = 0;
+  uint8_t IndexChannels = 0;
+
+  /** @internal     1.  Loop through all scans of the finished half */
+  for(IndexScans = FirstScan; IndexScans < LastScan; IndexScans++)
+  {
+    uint16_t* Scan = &ActiveADC->BufferDMA[IndexScans * NumChannels];
+    /** @internal     2.  Store and filter the sample of each channel */
+    for(IndexChannels = 0; IndexChannels < NumChannels; IndexChannels++)
     {
-      WiperInternal.ADCs[index].hadcInterrupted = true;
+      Wiper_structTd* Wiper = ActiveADC->InitializedWipers[IndexChannels];
+      store_SampleFromDMABuffer(Wiper, Scan[IndexChannels]);
+      calculate_SmoothADCValue(Wiper);
     }
   }
 }
@@ -0,0 +1,299 @@
+/***************************************************************************//**
+ * @defgroup        WiperFilter_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      WiperMotorFader
+ * @{
+ *
+ * @addtogroup      WiperFilter
+ * @{
+ *
+ * @addtogroup      WiperFilter_Source
+ * @{
+ *
+ * @file            wiperFilter.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <wiperFilter.h>
+#include <stdlib.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize the filter
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void WiperFilter_init(WiperFilter_structTd* Filter, WiperFilter_Type_enumTd Type, uint8_t Shift)
+{
+  uint16_t BetaDefault = 256;
+
+  /** @internal     1.  Limit the depth of all filters, so the accumulators
+   *                    do not overflow, and of the box filter to the
+   *                    available sample buffer. */
+  if(Shift > WIPERFILTER_MAX_SHIFT)
+  {
+    Shift = WIPERFILTER_MAX_SHIFT;
+  }
+  if(Type == WIPERFILTER_BOX && Shift > WIPERFILTER_BOX_MAX_SHIFT)
+  {
+    Shift = WIPERFILTER_BOX_MAX_SHIFT;
+  }
+
+  /** @internal     2.  Store settings and reset the filter */
+  Filter->Type = Type;
+  Filter->Shift = Shift;
+  WiperFilter_reset(Filter);
+
+  /** @internal     3.  Set default speed influence for the one euro filter */
+  if(Type == WIPERFILTER_ONEEURO)
+  {
+    Filter->State.OneEuro.Beta = BetaDefault;
+  }
+}
+
+/* Description in .h */
+void WiperFilter_set_Beta(WiperFilter_structTd* Filter, uint16_t Beta)
+{
+  Filter->State.OneEuro.Beta = Beta;
+}
+
+/* Description in .h */
+void WiperFilter_reset(WiperFilter_structTd* Filter)
+{
+  Filter->Index = 0;
+  Filter->Started = false;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use this function to filter new samples
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void start_FilterWithSample(WiperFilter_structTd* Filter, uint16_t Sample);
+uint16_t update_BoxFilter(WiperFilter_structTd* Filter, uint16_t Sample);
+uint16_t update_EMAFilter(uint32_t* Accu, uint8_t Shift, uint16_t Sample);
+uint16_t update_MedianFilter(WiperFilter_structTd* Filter, uint16_t Sample);
+uint16_t update_OneEuroFilter(WiperFilter_structTd* Filter, uint16_t Sample);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+uint16_t WiperFilter_update(WiperFilter_structTd* Filter, uint16_t Sample)
+{
+  uint16_t ReturnValue = Sample;
+
+  /** @internal     1.  Fill the filter with the first sample, so it does not
+   *                    ramp up from 0. */
+  if(Filter->Started == false)
+  {
+    start_FilterWithSample(Filter, Sample);
+  }
+
+  /** @internal     2.  Update the filter of the selected type */
+  switch(Filter->Type)
+  {
+    case WIPERFILTER_BOX:
+      ReturnValue = update_BoxFilter(Filter, Sample);
+      break;
+    case WIPERFILTER_EMA:
+      ReturnValue = update_EMAFilter(&Filter->State.EMAAccu, Filter->Shift, Sample);
+      break;
+    case WIPERFILTER_MEDIAN:
+      ReturnValue = update_MedianFilter(Filter, Sample);
+      break;
+    case WIPERFILTER_ONEEURO:
+      ReturnValue = update_OneEuroFilter(Filter, Sample);
+      break;
+    default:
+      break;
+  }
+
+  return ReturnValue;
+}
+
+/**
+ * @brief     Set the state of the filter as if all previous samples had the
+ *            value of the first sample.
+ * @param     Filter    pointer to the filter structure
+ * @param     Sample    first sample
+ * @return    none
+ */
+void start_FilterWithSample(WiperFilter_structTd* Filter, uint16_t Sample)
+{
+  uint8_t Shift = Filter->Shift;
+  uint8_t Index = 0;
+
+  switch(Filter->Type)
+  {
+    case WIPERFILTER_BOX:
+      for(Index = 0; Index < (1 << Shift); Index++)
+      {
+        Filter->State.Box.Samples[Index] = Sample;
+      }
+      Filter->State.Box.Sum = (uint32_t)Sample << Shift;
+      break;
+    case WIPERFILTER_EMA:
+      Filter->State.EMAAccu = (uint32_t)Sample << Shift;
+      break;
+    case WIPERFILTER_MEDIAN:
+      for(Index = 0; Index < WIPERFILTER_MEDIAN_SIZE; Index++)
+      {
+        Filter->State.Median.Samples[Index] = Sample;
+      }
+      Filter->State.Median.Accu = (uint32_t)Sample << Shift;
+      break;
+    case WIPERFILTER_ONEEURO:
+      Filter->State.OneEuro.Value = (int32_t)Sample << 16;
+      Filter->State.OneEuro.Speed = 0;
+      Filter->State.OneEuro.PrevSample = Sample;
+      break;
+    default:
+      break;
+  }
+
+  Filter->Index = 0;
+  Filter->Started = true;
+}
+
+/**
+ * @brief     Box filter with running sum. The oldest sample is replaced by the
+ *            new one and the sum is corrected by the difference.
+ * @param     Filter    pointer to the filter structure
+ * @param     Sample    new sample
+ * @return    average of the last 2^Shift samples
+ */
+uint16_t update_BoxFilter(WiperFilter_structTd* Filter, uint16_t Sample)
+{
+  WiperFilter_Box_structTd* Box = &Filter->State.Box;
+  uint8_t Shift = Filter->Shift;
+  uint8_t Index = Filter->Index;
+
+  /** @internal     1.  Replace the oldest sample in the sum and buffer */
+  Box->Sum = Box->Sum - Box->Samples[Index] + Sample;
+  Box->Samples[Index] = Sample;
+
+  /** @internal     2.  Count up the index. The buffer size is a power of 2,
+   *                    so a mask is enough to wrap around. */
+  Filter->Index = (Index + 1) & ((1 << Shift) - 1);
+
+  /** @internal     3.  Return the rounded average */
+  uint32_t Half = ((uint32_t)1 << Shift) >> 1;
+  return (uint16_t)((Box->Sum + Half) >> Shift);
+}
+
+/**
+ * @brief     Exponential moving average with a weight of 1/2^Shift. The
+ *            accumulator stores the value multiplied by 2^Shift to keep the
+ *            fraction.
+ * @param     Accu      pointer to the accumulator
+ * @param     Shift     depth of the filter
+ * @param     Sample    new sample
+ * @return    filtered value
+ */
+uint16_t update_EMAFilter(uint32_t* Accu, uint8_t Shift, uint16_t Sample)
+{
+  /** @internal     1.  Accu = Accu - Accu / 2^Shift + Sample */
+  *Accu = *Accu - (*Accu >> Shift) + Sample;
+
+  /** @internal     2.  Return the rounded value */
+  uint32_t Half = ((uint32_t)1 << Shift) >> 1;
+  return (uint16_t)((*Accu + Half) >> Shift);
+}
+
+/**
+ * @brief     Median of the last WIPERFILTER_MEDIAN_SIZE samples, smoothed by
+ *            the EMA. Single spikes are removed by the median before they
+ *            reach the EMA.
+ * @param     Filter    pointer to the filter structure
+ * @param     Sample    new sample
+ * @return    filtered value
+ */
+uint16_t update_MedianFilter(WiperFilter_structTd* Filter, uint16_t Sample)
+{
+  WiperFilter_Median_structTd* Median = &Filter->State.Median;
+  uint16_t Sorted[WIPERFILTER_MEDIAN_SIZE];
+  uint8_t Index = 0;
+
+  /** @internal     1.  Replace the oldest sample */
+  Median->Samples[Filter->Index] = Sample;
+  Filter->Index++;
+  if(Filter->Index == WIPERFILTER_MEDIAN_SIZE)
+  {
+    Filter->Index = 0;
+  }
+
+  /** @internal     2.  Sort a copy of the samples (insertion sort, the
+   *                    number of samples is small and fixed) */
+  for(Index = 0; Index < WIPERFILTER_MEDIAN_SIZE; Index++)
+  {
+    uint16_t Value = Median->Samples[Index];
+    int8_t SortIndex = Index - 1;
+    while(SortIndex >= 0 && Sorted[SortIndex] > Value)
+    {
+      Sorted[SortIndex + 1] = Sorted[SortIndex];
+      SortIndex--;
+    }
+    Sorted[SortIndex + 1] = Value;
+  }
+
+  /** @internal     3.  Smooth the median with the EMA */
+  return update_EMAFilter(&Median->Accu, Filter->Shift, Sorted[WIPERFILTER_MEDIAN_SIZE / 2]);
+}
+
+/**
+ * @brief     Speed adaptive EMA (one euro filter with integer math). The weight
+ *            of a new sample is 1/2^Shift + Beta * Speed, so the filter smooths
+ *            strong when the wiper is not moving and follows fast when it
+ *            moves.
+ * @param     Filter    pointer to the filter structure
+ * @param     Sample    new sample
+ * @return    filtered value
+ */
+uint16_t update_OneEuroFilter(WiperFilter_structTd* Filter, uint16_t Sample)
+{
+  WiperFilter_OneEuro_structTd* OneEuro = &Filter->State.OneEuro;
+  uint32_t AlphaOne = (uint32_t)1 << 16;
+
+  /** @internal     1.  Smooth the absolute speed (Q16.16) with a short EMA */
+  int32_t Delta = abs((int32_t)Sample - (int32_t)OneEuro->PrevSample) << 16;
+  OneEuro->Speed = OneEuro->Speed + ((Delta - OneEuro->Speed) >> WIPERFILTER_ONEEURO_SPEED_SHIFT);
+  OneEuro->PrevSample = Sample;
+
+  /** @internal     2.  Calculate the weight of the new sample (Q16) and
+   *                    limit it to 1 */
+  uint32_t Alpha = (AlphaOne >> Filter->Shift);
+  Alpha = Alpha + (uint32_t)(((uint64_t)OneEuro->Beta * (uint32_t)OneEuro->Speed) >> 16);
+  if(Alpha > AlphaOne)
+  {
+    Alpha = AlphaOne;
+  }
+
+  /** @internal     3.  Value = Value + Alpha * (Sample - Value) */
+  int32_t Difference = ((int32_t)Sample << 16) - OneEuro->Value;
+  OneEuro->Value = OneEuro->Value + (int32_t)(((int64_t)Alpha * Difference) >> 16);
+
+  /** @internal     4.  Return the rounded value */
+  return (uint16_t)((OneEuro->Value + 0x8000) >> 16);
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "WiperFilter_Source" */
+/**@}*//* end of defgroup "WiperFilter" */
+/**@}*//* end of defgroup "WiperMotorFader" */
+/**@}*//* end of defgroup "MotorFader" */
@@ -0,0 +1,439 @@
+/***************************************************************************//**
+ * @defgroup        WiperLinear_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      MotorFader
+ * @{
+ *
+ * @addtogroup      WiperMotorFader
+ * @{
+ *
+ * @addtogroup      WiperLinear
+ * @{
+ *
+ * @addtogroup      WiperLinear_Source
+ * @{
+ *
+ * @file            wiperLinear.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <wiperLinear.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @brief     Use these functions to initialize and calibrate the table
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void WiperLinear_init(WiperLinear_structTd* Linear)
+{
+  Linear->State = WIPERLINEAR_UNCALIBRATED;
+  Linear->SweepCCR = 0;
+  Linear->SampleTimeUs = 0;
+}
+
+/* Description in .h */
+void WiperLinear_start_Calibration(WiperLinear_structTd* Linear, int32_t SweepCCR, uint32_t SampleTime)
+{
+  /** @internal     1.  Store the settings */
+  Linear->SweepCCR = (SweepCCR < 0) ? -SweepCCR : SweepCCR;
+  Linear->SampleTimeUs = SampleTime;
+
+  /** @internal     2.  Start with the move to the bottom. The sweep values
+   *                    are set with the first sample. The state is set last,
+   *                    as the calibration is updated in an interrupt. */
+  Linear->Ticks = 0;
+  Linear->State = WIPERLINEAR_HOME;
+}
+
+/* Description in .h */
+void WiperLinear_abort(WiperLinear_structTd* Linear)
+{
+  WiperLinear_State_enumTd State = Linear->State;
+  if(State != WIPERLINEAR_UNCALIBRATED && State != WIPERLINEAR_CALIBRATED)
+  {
+    Linear->State = WIPERLINEAR_FAILED;
+  }
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @brief     Use these functions to calibrate and convert values
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+uint32_t convert_LinearTimeToTicks(WiperLinear_structTd* Linear, uint32_t TimeUs);
+void reset_LinearSweep(WiperLinear_structTd* Linear, int32_t Sample);
+bool check_LinearSweepStopped(WiperLinear_structTd* Linear, int32_t Sample, int32_t Direction);
+void store_LinearPointsUp(WiperLinear_structTd* Linear, int32_t Sample);
+void store_LinearPointsDown(WiperLinear_structTd* Linear, int32_t Sample);
+int32_t get_LinearPointValue(uint8_t Point);
+bool calculate_LinearTables(WiperLinear_structTd* Linear);
+void calculate_LinearInverse(WiperLinear_structTd* Linear);
+uint16_t interpolate_LinearTable(uint16_t* Table, uint16_t Value);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+int32_t WiperLinear_update_Calibration(WiperLinear_structTd* Linear, int32_t Sample)
+{
+  int32_t ReturnCCR = 0;
+
+  /** @internal     1.  Reset the sweep values with the first sample of each
+   *                    state */
+  Linear->Ticks++;
+  if(Linear->Ticks == 1)
+  {
+    reset_LinearSweep(Linear, Sample);
+  }
+
+  switch(Linear->State)
+  {
+    /** @internal     2.  Home: move down until the fader stopped at the
+     *                    bottom */
+    case WIPERLINEAR_HOME:
+      ReturnCCR = -Linear->SweepCCR;
+      if(check_LinearSweepStopped(Linear, Sample, -1) == true)
+      {
+        Linear->Ticks = 0;
+        Linear->State = WIPERLINEAR_SWEEP_UP;
+      }
+      break;
+
+    /** @internal     3.  Sweep up: store the time of each point until the
+     *                    fader stopped at the top. The fader has to move,
+     *                    otherwise the calibration fails. */
+    case WIPERLINEAR_SWEEP_UP:
+      ReturnCCR = Linear->SweepCCR;
+      store_LinearPointsUp(Linear, Sample);
+      if(check_LinearSweepStopped(Linear, Sample, 1) == true)
+      {
+        store_LinearPointsUp(Linear, WIPERLINEAR_MAX_VALUE);
+        Linear->UpStart = (uint16_t)Linear->StartTick;
+        Linear->UpEnd = (uint16_t)Linear->LastMoveTick;
+        Linear->Ticks = 0;
+        Linear->State = (Linear->Started == true) ? WIPERLINEAR_SWEEP_DOWN : WIPERLINEAR_FAILED;
+      }
+      break;
+
+    /** @internal     4.  Sweep down: the same in the other direction.
+     *                    Calculate the tables afterwards. */
+    case WIPERLINEAR_SWEEP_DOWN:
+      ReturnCCR = -Linear->SweepCCR;
+      store_LinearPointsDown(Linear, Sample);
+      if(check_LinearSweepStopped(Linear, Sample, -1) == true)
+      {
+        store_LinearPointsDown(Linear, 0);
+        ReturnCCR = 0;
+        if(Linear->Started == true && calculate_LinearTables(Linear) == true)
+        {
+          Linear->State = WIPERLINEAR_CALIBRATED;
+        }
+        else
+        {
+          Linear->State = WIPERLINEAR_FAILED;
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  /** @internal     5.  Fail, if a part of the sweep takes too long */
+  if(Linear->Ticks > convert_LinearTimeToTicks(Linear, WIPERLINEAR_TIMEOUT_US))
+  {
+    ReturnCCR = 0;
+    Linear->State = WIPERLINEAR_FAILED;
+  }
+
+  return ReturnCCR;
+}
+
+/**
+ * @brief     Convert a time to the number of samples. The result is at least
+ *            1 and at most 65535, so the times fit into the tables.
+ * @param     Linear    pointer to the linearization structure
+ * @param     TimeUs    time in microseconds
+ * @return    number of samples
+ */
+uint32_t convert_LinearTimeToTicks(WiperLinear_structTd* Linear, uint32_t TimeUs)
+{
+  uint32_t Ticks = 1;
+  if(Linear->SampleTimeUs != 0 && TimeUs > Linear->SampleTimeUs)
+  {
+    Ticks = TimeUs / Linear->SampleTimeUs;
+  }
+  if(Ticks > UINT16_MAX)
+  {
+    Ticks = UINT16_MAX;
+  }
+  return Ticks;
+}
+
+/**
+ * @brief     Reset the values of a sweep to the current position.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Sample    current wiper value
+ * @return    none
+ */
+void reset_LinearSweep(WiperLinear_structTd* Linear, int32_t Sample)
+{
+  Linear->RestPosition = Sample;
+  Linear->Extreme = Sample;
+  Linear->StartTick = Linear->Ticks;
+  Linear->LastMoveTick = Linear->Ticks;
+  Linear->Next = 0;
+  Linear->Started = false;
+}
+
+/**
+ * @brief     Detect start and stop of a sweep. The fader moves, while it
+ *            reaches new positions in the sweep direction. Changes smaller
+ *            than @ref WIPERLINEAR_NOISE_THRESHOLD are ignored.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Sample    current wiper value
+ * @param     Direction 1 for up, -1 for down
+ * @return    true if the fader did not move further for
+ *            @ref WIPERLINEAR_STOP_US
+ */
+bool check_LinearSweepStopped(WiperLinear_structTd* Linear, int32_t Sample, int32_t Direction)
+{
+  /** @internal     1.  The sweep started, when the fader left the rest
+   *                    position */
+  if(Linear->Started == false && (Sample - Linear->RestPosition) * Direction > WIPERLINEAR_MOVE_THRESHOLD)
+  {
+    Linear->StartTick = Linear->Ticks;
+    Linear->Started = true;
+  }
+
+  /** @internal     2.  Store the time of the last new position */
+  if((Sample - Linear->Extreme) * Direction > WIPERLINEAR_NOISE_THRESHOLD)
+  {
+    Linear->Extreme = Sample;
+    Linear->LastMoveTick = Linear->Ticks;
+  }
+
+  return (Linear->Ticks - Linear->LastMoveTick >= convert_LinearTimeToTicks(Linear, WIPERLINEAR_STOP_US));
+}
+
+/**
+ * @brief     Store the current time for all points the fader passed while
+ *            moving up. Point 0 is passed first.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Sample    current wiper value
+ * @return    none
+ */
+void store_LinearPointsUp(WiperLinear_structTd* Linear, int32_t Sample)
+{
+  while(Linear->Next < WIPERLINEAR_NUM_POINTS && Sample >= get_LinearPointValue(Linear->Next))
+  {
+    Linear->ToLinear[Linear->Next] = (uint16_t)Linear->Ticks;
+    Linear->Next++;
+  }
+}
+
+/**
+ * @brief     Store the current time for all points the fader passed while
+ *            moving down. The last point is passed first.
+ * @param     Linear    pointer to the linearization structure
+ * @param     Sample    current wiper value
+ * @return    none
+ */
+void store_LinearPointsDown(WiperLinear_structTd* Linear, int32_t Sample)
+{
+  while(Linear->Next < WIPERLINEAR_NUM_POINTS)
+  {
+    uint8_t Point = WIPERLINEAR_NUM_POINTS - 1 - Linear->Next;
+    if(Sample > get_LinearPointValue(Point))
+    {
+      break;
+    }
+    Linear->ToRaw[Point] = (uint16_t)Linear->Ticks;
+    Linear->Next++;
+  }
+}
+
+/**
+ * @brief     Get the wiper value of a point. The last point is limited to the
+ *            largest wiper value.
+ * @param     Point     index of the point
+ * @return    wiper value
+ */
+int32_t get_LinearPointValue(uint8_t Point)
+{
+  int32_t Value = (int32_t)Point << WIPERLINEAR_SEGMENT_SHIFT;
+  if(Value > WIPERLINEAR_MAX_VALUE)
+  {
+    Value = WIPERLINEAR_MAX_VALUE;
+  }
+  return Value;
+}
+
+/**
+ * @brief     Calculate the position of each point from the times of both
+ *            sweeps and the inverse table afterwards.
+ * @param     Linear    pointer to the linearization structure
+ * @return    true if both sweeps were long enough
+ */
+bool calculate_LinearTables(WiperLinear_structTd* Linear)
+{
+  int32_t UpStart = Linear->UpStart;
+  int32_t UpSpan = (int32_t)Linear->UpEnd - UpStart;
+  int32_t DownStart = (int32_t)Linear->StartTick;
+  int32_t DownSpan = (int32_t)Linear->LastMoveTick - DownStart;
+  uint8_t Point = 0;
+
+  if(UpSpan <= 0 || DownSpan <= 0)
+  {
+    return false;
+  }
+
+  for(Point = 0; Point < WIPERLINEAR_NUM_POINTS; Point++)
+  {
+    /** @internal     1.  Limit the times to the sweep. Points passed before
+     *                    the start are at the start, points never passed at
+     *                    the end. */
+    int32_t Up = (int32_t)Linear->ToLinear[Point] - UpStart;
+    int32_t Down = (int32_t)Linear->ToRaw[Point] - DownStart;
+    Up = (Up < 0) ? 0 : ((Up > UpSpan) ? UpSpan : Up);
+    Down = (Down < 0) ? 0 : ((Down > DownSpan) ? DownSpan : Down);
+
+    /** @internal     2.  Position = time / sweep time. The down sweep starts
+     *                    at the top. Average both directions. */
+    int32_t PositionUp = (Up * WIPERLINEAR_MAX_VALUE) / UpSpan;
+    int32_t PositionDown = WIPERLINEAR_MAX_VALUE - (Down * WIPERLINEAR_MAX_VALUE) / DownSpan;
+    Linear->ToLinear[Point] = (uint16_t)((PositionUp + PositionDown + 1) / 2);
+  }
+
+  /** @internal     3.  The times of the down sweep are not needed anymore,
+   *                    so the inverse table can be calculated */
+  calculate_LinearInverse(Linear);
+  return true;
+}
+
+/**
+ * @brief     Calculate the wiper value of each position point. The positions
+ *            of the table increase with the wiper value, so the segment of
+ *            the next point is searched from the segment of the last one.
+ * @param     Linear    pointer to the linearization structure
+ * @return    none
+ */
+void calculate_LinearInverse(WiperLinear_structTd* Linear)
+{
+  uint16_t* ToLinear = Linear->ToLinear;
+  uint8_t Segment = 0;
+  uint8_t Point = 0;
+
+  for(Point = 0; Point < WIPERLINEAR_NUM_POINTS; Point++)
+  {
+    int32_t Position = get_LinearPointValue(Point);
+    int32_t Raw = 0;
+
+    /** @internal     1.  Find the segment that contains the position */
+    while(Segment < WIPERLINEAR_NUM_POINTS - 2 && ToLinear[Segment + 1] < Position)
+    {
+      Segment++;
+    }
+
+    /** @internal     2.  Interpolate the wiper value inside the segment */
+    int32_t Low = ToLinear[Segment];
+    int32_t High = ToLinear[Segment + 1];
+    if(Position <= Low)
+    {
+      Raw = (int32_t)Segment << WIPERLINEAR_SEGMENT_SHIFT;
+    }
+    else if(Position >= High)
+    {
+      Raw = (int32_t)(Segment + 1) << WIPERLINEAR_SEGMENT_SHIFT;
+    }
+    else
+    {
+      Raw = ((int32_t)Segment << WIPERLINEAR_SEGMENT_SHIFT)
+            + ((Position - Low) << WIPERLINEAR_SEGMENT_SHIFT) / (High - Low);
+    }
+
+    if(Raw > WIPERLINEAR_MAX_VALUE)
+    {
+      Raw = WIPERLINEAR_MAX_VALUE;
+    }
+    Linear->ToRaw[Point] = (uint16_t)Raw;
+  }
+}
+
+/* Description in .h */
+uint16_t WiperLinear_convert_RawToLinear(WiperLinear_structTd* Linear, uint16_t Raw)
+{
+  if(Linear->State != WIPERLINEAR_CALIBRATED)
+  {
+    return Raw;
+  }
+  return interpolate_LinearTable(Linear->ToLinear, Raw);
+}
+
+/* Description in .h */
+uint16_t WiperLinear_convert_LinearToRaw(WiperLinear_structTd* Linear, uint16_t Position)
+{
+  if(Linear->State != WIPERLINEAR_CALIBRATED)
+  {
+    return Position;
+  }
+  return interpolate_LinearTable(Linear->ToRaw, Position);
+}
+
+/**
+ * @brief     Interpolate a value in a table. The segment is the upper part
+ *            of the value, the position inside the segment the lower part.
+ * @param     Table     table with @ref WIPERLINEAR_NUM_POINTS points
+ * @param     Value     value to convert
+ * @return    converted value
+ */
+uint16_t interpolate_LinearTable(uint16_t* Table, uint16_t Value)
+{
+  uint16_t Segment = Value >> WIPERLINEAR_SEGMENT_SHIFT;
+  int32_t Fraction = Value & ((1 << WIPERLINEAR_SEGMENT_SHIFT) - 1);
+
+  if(Segment >= WIPERLINEAR_NUM_POINTS - 1)
+  {
+    return Table[WIPERLINEAR_NUM_POINTS - 1];
+  }
+
+  int32_t Low = Table[Segment];
+  int32_t High = Table[Segment + 1];
+  return (uint16_t)(Low + (((High - Low) * Fraction) >> WIPERLINEAR_SEGMENT_SHIFT));
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @brief     Use these functions to get values from the linearization
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+WiperLinear_State_enumTd WiperLinear_get_State(WiperLinear_structTd* Linear)
+{
+  return Linear->State;
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "WiperLinear_Source" */
+/**@}*//* end of defgroup "WiperLinear" */
+/**@}*//* end of defgroup "WiperMotorFader" */
+/**@}*//* end of defgroup "MotorFader" */
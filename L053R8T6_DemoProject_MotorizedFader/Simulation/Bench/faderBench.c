@@ -0,0 +1,1402 @@
+/***************************************************************************//**
+ * @defgroup        FaderBench    Fader benchmark
+ * @brief           Runs the fader modules against the simulated plant and
+ *                  measures the step response of the control loop.
+ *
+ * The faders are set up like in main.c (two faders, TIM6 control timer at
+ * 3 kHz, S-curve motion profile). Each scenario moves fader 0 from a start to
+ * a target wiper value and measures on the noise free wiper value:
+ * - Rise time from 10 % to 90 % of the step (ms)
+ * - Overshoot behind the target (counts)
+ * - Settle time until the fader stays within @ref BENCH_SETTLE_BAND (ms)
+ * - Steady state error: mean error of the last @ref BENCH_STEADY_MS (counts)
+ * - CPU time per control update on the host (ns, mean and max). This is not
+ *   the time on the Cortex-M0+, but shows relative changes.
+ *
+ * The friction scenarios calibrate the friction model of fader 0 first, the
+ * cascade scenarios use the cascade controller instead of the PID. The
+ * scheduled scenarios use the PID with gain schedule and back-calculation.
+ * The dither scenarios repeat the friction scenarios with 2 dither bits and
+ * the PWM carrier set by MotorizedFader_init_PWMCarrier() (same 500 steps).
+ *
+ * The feature scenarios measure the same step of fader 0 and check the
+ * feature on the way:
+ * - autotune: the PID of fader 0 is auto tuned first. Fails if the tuning
+ *   does not finish.
+ * - filter: box, median and 1 Euro filter instead of the EMA.
+ * - touch: a finger holds fader 0 during the move
+ *   (@ref BENCH_FINGER_START_MS, @ref BENCH_FINGER_MS) and releases it.
+ *   Fails if the motor is driven while the touch is detected.
+ * - park: both faders are calibrated. Fails if they are not settled and
+ *   the shared STBY pin is not low at the end.
+ * - gang: a finger moves fader 1 from start to target, fader 0 follows in
+ *   an absolute gang.
+ * - haptics: fader 0 is touched, the haptic spring pulls it to the target.
+ * - stall: fader 0 is blocked without touch at the start of the move.
+ *   Fails if the stall detector does not back off.
+ * Gang and stall use the friction model of fader 0, as the start force and
+ * stop range alone do not settle (see fixed_step_*).
+ *
+ * A scenario passes if fader 0 stays within @ref BENCH_SETTLE_BAND for the
+ * last @ref BENCH_STEADY_MS and its feature check passes. Scenarios with a
+ * known failure are expected not to settle; they show the limits of a
+ * setup (e.g. start force and stop range without friction model) and are
+ * reported as xfail. Their metrics still must not get worse. If one of them
+ * settles, it is reported so the known failure can be removed.
+ *
+ * Every scenario runs in its own process, as the modules keep their state
+ * in static structures. The plant noise is seeded, so the results are the
+ * same for each run of the same code.
+ *
+ * # Usage
+ * - faderBench: print the results
+ * - faderBench --baseline FILE: compare with a stored baseline. Returns 1
+ *   if a scenario failed or a control metric got worse than the
+ *   tolerance. CPU time is only reported, as it depends on the host.
+ * - faderBench --write-baseline FILE: store the results as new baseline
+ * - faderBench --capacity [RATE_HZ [FACTOR]]: measure the control interrupt
+ *   with 1 to @ref BENCH_MAX_FADERS moving faders and estimate how many
+ *   faders fit at the control rate (default 3000 Hz), with and without
+ *   staggered control updates. FACTOR scales the host time to the target
+ *   (default 1: the host itself).
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      FaderBench
+ * @{
+ *
+ * @file            faderBench.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "halStub.h"
+#include "faderPlant.h"
+#include "motorizedFader.h"
+
+/**
+ * @brief     Number of faders in the step scenarios (as in main.c).
+ */
+#define BENCH_NUM_FADERS      2
+
+/**
+ * @brief     Largest number of simulated faders. Limited by the PWM channels
+ *            of the simulated timers.
+ */
+#define BENCH_MAX_FADERS      8
+
+#if BENCH_MAX_FADERS > NUMBER_OF_MOTORIZED_FADERS
+#error "BENCH_MAX_FADERS is bigger than NUMBER_OF_MOTORIZED_FADERS"
+#endif
+
+/**
+ * @brief     Time step of the main loop and the ADC. The control timer runs
+ *            every @ref BENCH_CONTROL_STEPS steps.
+ */
+#define BENCH_STEP_US         111
+
+/**
+ * @brief     Steps per control period (333 us).
+ */
+#define BENCH_CONTROL_STEPS   3
+
+/**
+ * @brief     Time to settle at the start position before the step.
+ */
+#define BENCH_WARMUP_MS       500
+
+/**
+ * @brief     Time recorded after the step.
+ */
+#define BENCH_DURATION_MS     1500
+
+/**
+ * @brief     Longest time for a calibration.
+ */
+#define BENCH_CALIBRATION_MS  40000
+
+/**
+ * @brief     Settle band around the target (counts).
+ */
+#define BENCH_SETTLE_BAND     10
+
+/**
+ * @brief     Time at the end used for the steady state error.
+ */
+#define BENCH_STEADY_MS       200
+
+/**
+ * @brief     Largest length of a scenario name.
+ */
+#define BENCH_NAME_LENGTH     32
+
+/**
+ * @brief     Time after the step when the finger of the touch and gang
+ *            scenarios touches and the stall scenario blocks fader 0.
+ */
+#define BENCH_FINGER_START_MS 0
+
+/**
+ * @brief     Time the finger stays on the fader, moves the gang leader or
+ *            blocks fader 0.
+ */
+#define BENCH_FINGER_MS       300
+
+/**
+ * @brief     TSC value of a touched fader (untouched:
+ *            @ref SIMHAL_TSC_UNTOUCHED).
+ */
+#define BENCH_TSC_TOUCHED     800
+
+/**
+ * @brief     Time after the first detection of a touch until the motor has
+ *            to be off. The motor is switched off in the next control
+ *            period.
+ */
+#define BENCH_TOUCH_REACTION_MS 1
+
+/**
+ * @brief     Largest length of a failure text.
+ */
+#define BENCH_FAILURE_LENGTH  64
+
+/**
+ * @brief     Time measured in each capacity run.
+ */
+#define BENCH_CAPACITY_MS     1000
+
+/**
+ * @brief     Time between two moves in the capacity runs.
+ */
+#define BENCH_CAPACITY_MOVE_MS  250
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     How the control loop runs
+ */
+typedef enum
+{
+  BENCH_FIXED_RATE,     /**< Control timer interrupt */
+  BENCH_FIXED_FRICTION, /**< Control timer with calibrated friction model */
+  BENCH_FIXED_CASCADE,  /**< Control timer with cascade controller */
+  BENCH_FIXED_SCHEDULED,/**< Control timer with gain scheduled PID */
+  BENCH_FIXED_DITHER,   /**< Control timer with calibrated friction model
+                             and dithered PID result */
+  BENCH_FIXED_AUTOTUNE, /**< Control timer with auto tuned PID */
+  BENCH_FIXED_BOX,      /**< Control timer with box filter */
+  BENCH_FIXED_MEDIAN,   /**< Control timer with median filter */
+  BENCH_FIXED_ONEEURO,  /**< Control timer with 1 Euro filter */
+  BENCH_FIXED_TOUCH,    /**< Control timer, fader 0 is held and released */
+  BENCH_FIXED_PARK,     /**< Control timer with calibrated friction model
+                             of both faders, parked at the end */
+  BENCH_FIXED_GANG,     /**< Control timer with calibrated friction model,
+                             fader 0 follows fader 1 */
+  BENCH_FIXED_HAPTICS,  /**< Control timer, haptic spring of fader 0 */
+  BENCH_FIXED_STALL,    /**< Control timer with calibrated friction model,
+                             fader 0 is blocked */
+  BENCH_LOOP            /**< MotorizedFader_update_All() without timer */
+}Bench_Mode_enumTd;
+
+/**
+ * @brief     One step scenario
+ */
+typedef struct
+{
+  char      Name[BENCH_NAME_LENGTH];
+  Bench_Mode_enumTd Mode;
+  uint16_t  Start;      /**< Wiper value before the step */
+  uint16_t  Target;     /**< Wiper value of the step */
+  const char* KnownFailure; /**< Why the scenario does not settle. NULL:
+                             it has to settle */
+}Bench_Scenario_structTd;
+
+/**
+ * @brief     Results of a scenario
+ */
+typedef struct
+{
+  char      Name[BENCH_NAME_LENGTH];
+  double    RiseMs;
+  double    Overshoot;
+  double    SettleMs;
+  double    SteadyError;
+  double    CPUMeanNs;
+  double    CPUMaxNs;
+  int       Valid;
+  int       Settled;    /**< Fader 0 stayed within the settle band for the
+                             steady time */
+  char      Failure[BENCH_FAILURE_LENGTH]; /**< Failed feature check. Empty
+                             if passed */
+}Bench_Result_structTd;
+
+/**
+ * @brief     Simulated hardware and faders
+ */
+typedef struct
+{
+  FaderPlant_structTd Plants[BENCH_MAX_FADERS];
+  MotorizedFader_structTd Faders[BENCH_MAX_FADERS];
+  ADC_HandleTypeDef   hadc;
+  DMA_HandleTypeDef   hdma;
+  TSC_HandleTypeDef   htsc;
+  TIM_HandleTypeDef   htim2;
+  TIM_HandleTypeDef   htim3;
+  TIM_HandleTypeDef   htim6;
+  TIM_HandleTypeDef   htim21;
+  TIM_HandleTypeDef   htim22;
+  Bench_Mode_enumTd   Mode;
+  uint16_t  NumFaders;
+  uint32_t  Steps;
+  double    CPUSumNs;
+  double    CPUMaxNs;
+  uint32_t  CPUCount;
+  uint32_t  TouchDriven;  /**< Steps with driven motor while the touch of
+                               fader 0 was detected */
+  uint32_t  TouchSteps;   /**< Steps with detected touch of fader 0 */
+  bool      StallSeen;    /**< The stall detector of fader 0 backed off */
+}Bench_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+/**
+ * @brief     Scenarios of the benchmark
+ */
+const Bench_Scenario_structTd BenchScenarios[] =
+{
+  {"fixed_step_small",      BENCH_FIXED_RATE,     2000, 2250, "start force sticks and slips, the fader creeps"},
+  {"fixed_step_medium",     BENCH_FIXED_RATE,     1000, 2600, NULL},
+  {"fixed_step_large",      BENCH_FIXED_RATE,      300, 3800, "start force overshoots, rests in the stop range"},
+  {"fixed_step_down",       BENCH_FIXED_RATE,     3800,  600, "start force overshoots, rests in the stop range"},
+  {"friction_step_small",   BENCH_FIXED_FRICTION, 2000, 2250, NULL},
+  {"friction_step_medium",  BENCH_FIXED_FRICTION, 1000, 2600, NULL},
+  {"friction_step_down",    BENCH_FIXED_FRICTION, 3800,  600, NULL},
+  {"cascade_step_small",    BENCH_FIXED_CASCADE,  2000, 2250, NULL},
+  {"cascade_step_medium",   BENCH_FIXED_CASCADE,  1000, 2600, NULL},
+  {"cascade_step_large",    BENCH_FIXED_CASCADE,   300, 3800, NULL},
+  {"cascade_step_down",     BENCH_FIXED_CASCADE,  3800,  600, NULL},
+  {"scheduled_step_small",  BENCH_FIXED_SCHEDULED,2000, 2250, NULL},
+  {"scheduled_step_medium", BENCH_FIXED_SCHEDULED,1000, 2600, NULL},
+  {"scheduled_step_large",  BENCH_FIXED_SCHEDULED, 300, 3800, NULL},
+  {"scheduled_step_down",   BENCH_FIXED_SCHEDULED,3800,  600, NULL},
+  {"dither_step_small",     BENCH_FIXED_DITHER,   2000, 2250, NULL},
+  {"dither_step_medium",    BENCH_FIXED_DITHER,   1000, 2600, NULL},
+  {"dither_step_down",      BENCH_FIXED_DITHER,   3800,  600, NULL},
+  {"autotune_step_medium",  BENCH_FIXED_AUTOTUNE, 1000, 2600, NULL},
+  {"filter_box_medium",     BENCH_FIXED_BOX,      1000, 2600, NULL},
+  {"filter_median_medium",  BENCH_FIXED_MEDIAN,   1000, 2600, NULL},
+  {"filter_oneeuro_medium", BENCH_FIXED_ONEEURO,  1000, 2600, NULL},
+  {"touch_release_medium",  BENCH_FIXED_TOUCH,    1000, 2600, NULL},
+  {"park_step_medium",      BENCH_FIXED_PARK,     1000, 2600, NULL},
+  {"gang_follow_medium",    BENCH_FIXED_GANG,     1000, 2600, NULL},
+  {"haptics_spring_small",  BENCH_FIXED_HAPTICS,  2000, 2250, NULL},
+  {"stall_block_medium",    BENCH_FIXED_STALL,    1000, 2600, NULL},
+  {"loop_step_medium",      BENCH_LOOP,           1000, 2600, "PID in the main loop rests in the stop range"},
+};
+
+#define BENCH_NUM_SCENARIOS   (sizeof(BenchScenarios) / sizeof(BenchScenarios[0]))
+
+Bench_structTd Bench;
+
+/**
+ * @brief     Print the trajectory of each step (set with --trace)
+ */
+bool BenchTrace = false;
+
+/***************************************************************************//**
+ * @name      Simulation
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the host time for the CPU measurement.
+ * @return    time in nanoseconds
+ */
+double get_BenchHostTimeNs(void)
+{
+  struct timespec Time;
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return (double)Time.tv_sec * 1e9 + (double)Time.tv_nsec;
+}
+
+/**
+ * @brief     Initialize the simulated hardware and the faders like main.c.
+ *            The first two faders use the pins of main.c, the others use
+ *            free pins of port B and C and the PWM channels of TIM21, TIM22
+ *            and TIM3.
+ * @param     Mode      how the control loop runs
+ * @param     NumFaders number of faders (1 - @ref BENCH_MAX_FADERS)
+ * @param     Groups    stagger groups of the control updates. 1: all faders
+ *                      in each period.
+ * @return    none
+ */
+void init_Bench(Bench_Mode_enumTd Mode, uint16_t NumFaders, uint8_t Groups)
+{
+  uint16_t Index = 0;
+  uint32_t TSCChannels[BENCH_MAX_FADERS] = {TSC_GROUP1_IO2, TSC_GROUP3_IO3,
+      TSC_GROUP2_IO2, TSC_GROUP4_IO2, TSC_GROUP5_IO2, TSC_GROUP6_IO2,
+      TSC_GROUP7_IO2, TSC_GROUP8_IO2};
+  TIM_HandleTypeDef* Timers[BENCH_MAX_FADERS] = {&Bench.htim2, &Bench.htim2,
+      &Bench.htim21, &Bench.htim21, &Bench.htim22, &Bench.htim22,
+      &Bench.htim3, &Bench.htim3};
+  uint32_t Channels[BENCH_MAX_FADERS] = {TIM_CHANNEL_1, TIM_CHANNEL_2,
+      TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_1, TIM_CHANNEL_2,
+      TIM_CHANNEL_1, TIM_CHANNEL_2};
+  WiperFilter_Type_enumTd Filter = WIPERFILTER_EMA;
+  if(Mode == BENCH_FIXED_BOX || Mode == BENCH_FIXED_MEDIAN || Mode == BENCH_FIXED_ONEEURO)
+  {
+    Filter = (Mode == BENCH_FIXED_BOX) ? WIPERFILTER_BOX : (Mode == BENCH_FIXED_MEDIAN) ? WIPERFILTER_MEDIAN : WIPERFILTER_ONEEURO;
+  }
+
+  /** @internal     1.  Peripherals as configured in Cube MX */
+  memset(&Bench, 0, sizeof(Bench));
+  SimHAL_reset();
+  Bench.Mode = Mode;
+  Bench.NumFaders = (NumFaders > BENCH_MAX_FADERS) ? BENCH_MAX_FADERS : NumFaders;
+  Bench.hdma.Init.Mode = DMA_CIRCULAR;
+  Bench.hadc.DMA_Handle = &Bench.hdma;
+  Bench.htim2.Instance = TIM2;
+  Bench.htim2.Instance->ARR = 500 - 1;
+  Bench.htim3.Instance = TIM3;
+  Bench.htim3.Instance->ARR = 500 - 1;
+  Bench.htim21.Instance = TIM21;
+  Bench.htim21.Instance->ARR = 500 - 1;
+  Bench.htim22.Instance = TIM22;
+  Bench.htim22.Instance->ARR = 500 - 1;
+  Bench.htim6.Instance = TIM6;
+  Bench.htim6.Instance->PSC = 32 - 1;
+  Bench.htim6.Instance->ARR = 333 - 1;
+
+  /** @internal     2.  Faders with the values of main.c */
+  for(Index = 0; Index < Bench.NumFaders; Index++)
+  {
+    MotorizedFader_structTd* Fader = &Bench.Faders[Index];
+    FaderPlant_init(&Bench.Plants[Index], 12345 + Index);
+
+    MotorizedFader_init_Structure(Fader);
+    MotorizedFader_init_StartForce(Fader, 120);
+    MotorizedFader_init_StopRange(Fader, 25);
+    MotorizedFader_init_Wiper(Fader, &Bench.hadc);
+    MotorizedFader_init_TouchTSC(Fader, &Bench.htsc, TSCChannels[Index]);
+    MotorizedFader_init_TouchAdaptive(Fader, 100, 50, 2);
+    if(Index < 2)
+    {
+      MotorizedFader_init_MotorPinIn1(Fader, GPIOA, (Index == 0) ? GPIO_PIN_8 : GPIO_PIN_10);
+      MotorizedFader_init_MotorPinIn2(Fader, GPIOA, (Index == 0) ? GPIO_PIN_9 : GPIO_PIN_11);
+      MotorizedFader_init_MotorPinSTBY(Fader, GPIOA, GPIO_PIN_12);
+    }
+    else
+    {
+      MotorizedFader_init_MotorPinIn1(Fader, GPIOB, (uint16_t)(1U << (2 * (Index - 2))));
+      MotorizedFader_init_MotorPinIn2(Fader, GPIOB, (uint16_t)(1U << (2 * (Index - 2) + 1)));
+      MotorizedFader_init_MotorPinSTBY(Fader, GPIOC, (uint16_t)(1U << (Index / 2)));
+    }
+    MotorizedFader_init_MotorPWM(Fader, Timers[Index], Channels[Index]);
+    MotorizedFader_init_WiperFilter(Fader, Filter, 2);
+    MotorizedFader_init_PID(Fader);
+    MotorizedFader_init_PIDMaxCCR(Fader, 500);
+    MotorizedFader_init_PIDKpKiKd(Fader, 0.15, 0.0001, 0.025);
+    MotorizedFader_init_PIDLowPass(Fader, 0.1);
+    MotorizedFader_init_PIDSampleTimeInMs(Fader, 3);
+  }
+  MotorizedFader_init_TouchDischargeTimeMsAll(2);
+  MotorizedFader_init_ADCTrigger(&Bench.htim2, TIM_CHANNEL_4, 8000000, ADC_SAMPLETIME_3CYCLES_5);
+
+  /** @internal     3.  Control timer, motion profile, friction model and
+   *                    settle detection only with fixed rate */
+  if(Mode != BENCH_LOOP)
+  {
+    TimerService_init(&Bench.htim6);
+    MotorizedFader_init_ControlTimer(&Bench.htim6);
+    if(Groups > 1)
+    {
+      MotorizedFader_init_ControlStagger(Groups);
+    }
+    for(Index = 0; Index < Bench.NumFaders; Index++)
+    {
+      MotorizedFader_structTd* Fader = &Bench.Faders[Index];
+      MotorizedFader_init_MotionProfile(Fader, MOTIONPROFILE_SCURVE, 4);
+      MotorizedFader_init_MotionLimits(Fader, 12000, 150000);
+      MotorizedFader_init_Friction(Fader, 4);
+      MotorizedFader_init_Settle(Fader, 12, 3, 150, MOTORIZEDFADER_PARK_STANDBY);
+      if(Mode == BENCH_FIXED_CASCADE)
+      {
+        MotorizedFader_init_Cascade(Fader, 0.05, 30, 3, 20000);
+        MotorizedFader_init_CascadeEstimator(Fader, 0.25, 0);
+      }
+      if(Mode == BENCH_FIXED_SCHEDULED)
+      {
+        MotorizedFader_init_PIDKpKiKd(Fader, 1.5, 0.0001, 0.025);
+        MotorizedFader_init_PIDGainSchedule(Fader, 0.15, 0.0001, 0.025, 100, 400);
+        MotorizedFader_init_PIDBackCalculation(Fader, 0.02);
+      }
+      if(Mode == BENCH_FIXED_DITHER)
+      {
+        MotorizedFader_init_MotorDither(Fader, 2);
+      }
+    }
+
+    /** @internal     4.  Features of the feature scenarios on fader 0 */
+    MotorizedFader_structTd* Fader = &Bench.Faders[0];
+    if(Mode == BENCH_FIXED_AUTOTUNE)
+    {
+      MotorizedFader_init_Autotune(Fader, 240, 8, PIDAUTOTUNE_RULE_SOME_OVERSHOOT);
+    }
+    if(Mode == BENCH_FIXED_GANG && Bench.NumFaders >= 2)
+    {
+      MotorizedFader_structTd* GangFaders[2] = {&Bench.Faders[0], &Bench.Faders[1]};
+      MotorizedFader_set_Gang(0, MOTORIZEDFADER_GANG_ABSOLUTE, GangFaders, 2);
+    }
+    if(Mode == BENCH_FIXED_HAPTICS)
+    {
+      MotorizedFader_init_Haptics(Fader, 400, 2.0);
+    }
+    if(Mode == BENCH_FIXED_STALL)
+    {
+      MotorizedFader_init_Stall(Fader, 200, 3, 150);
+      MotorizedFader_init_StallBackoff(Fader, 0, 300, 3);
+    }
+  }
+  if(Mode == BENCH_FIXED_DITHER)
+  {
+    MotorizedFader_init_PWMCarrier(&Bench.htim2, 32000000, 64000, true);
+  }
+
+  MotorizedFader_start_All();
+}
+
+/**
+ * @brief     Simulate one step: plant, ADC, control timer, main loop and
+ *            TSC. The motor outputs are passed to the plants afterwards.
+ * @return    none
+ */
+void update_Bench(void)
+{
+  uint16_t Index = 0;
+  TIM_HandleTypeDef* htim6 = &Bench.htim6;
+
+  /** @internal     1.  Move the plants and the time */
+  for(Index = 0; Index < Bench.NumFaders; Index++)
+  {
+    FaderPlant_update(&Bench.Plants[Index], BENCH_STEP_US);
+  }
+  SimHAL_set_TimeUs(SimHAL_get_TimeUs() + BENCH_STEP_US);
+  Bench.Steps++;
+
+  /** @internal     2.  Fill both halves of the circular DMA buffer and call
+   *                    the ADC interrupts */
+  if(Bench.hadc.Buffer != NULL && Bench.hadc.Length >= 2U * Bench.NumFaders)
+  {
+    uint16_t* Buffer = Bench.hadc.Buffer;
+    for(Index = 0; Index < Bench.NumFaders; Index++)
+    {
+      Buffer[Index] = FaderPlant_get_WiperSample(&Bench.Plants[Index]);
+    }
+    MotorizedFader_manage_WiperHalfInterrupt(&Bench.hadc);
+    for(Index = 0; Index < Bench.NumFaders; Index++)
+    {
+      Buffer[Bench.NumFaders + Index] = FaderPlant_get_WiperSample(&Bench.Plants[Index]);
+    }
+    MotorizedFader_manage_WiperInterrupt(&Bench.hadc);
+  }
+
+  /** @internal     3.  Control timer: the counter follows the time, the
+   *                    interrupt extends the time base of the timer service
+   *                    and runs the control loop, timed on the host */
+  if(Bench.Mode != BENCH_LOOP)
+  {
+    htim6->Instance->CNT = (Bench.Steps % BENCH_CONTROL_STEPS) * BENCH_STEP_US;
+  }
+  if(Bench.Mode != BENCH_LOOP && (Bench.Steps % BENCH_CONTROL_STEPS) == 0)
+  {
+    htim6->Instance->CNT = 0;
+    htim6->Instance->SR = 0;
+    TimerService_manage_Interrupt(htim6);
+    double Start = get_BenchHostTimeNs();
+    MotorizedFader_manage_ControlTimerInterrupt(htim6);
+    double Duration = get_BenchHostTimeNs() - Start;
+    Bench.CPUSumNs += Duration;
+    Bench.CPUCount++;
+    if(Duration > Bench.CPUMaxNs)
+    {
+      Bench.CPUMaxNs = Duration;
+    }
+  }
+
+  /** @internal     4.  Main loop: timer service (PID sample timer in loop
+   *                    mode, TSC discharge wait) and faders. Without
+   *                    control timer the faders contain the control loop,
+   *                    so they are timed instead. */
+  TimerService_update();
+  double Start = get_BenchHostTimeNs();
+  MotorizedFader_update_All();
+  double Duration = get_BenchHostTimeNs() - Start;
+  if(Bench.Mode == BENCH_LOOP)
+  {
+    Bench.CPUSumNs += Duration;
+    Bench.CPUCount++;
+    if(Duration > Bench.CPUMaxNs)
+    {
+      Bench.CPUMaxNs = Duration;
+    }
+  }
+
+  /** @internal     5.  The TSC acquisition is finished within one step */
+  if(Bench.htsc.Running != 0)
+  {
+    MotorizedFader_manage_TSCInterrupt();
+  }
+
+  /** @internal     6.  Pass the motor driver outputs to the plants */
+  for(Index = 0; Index < Bench.NumFaders; Index++)
+  {
+    TB6612FNGMotorDriver_structTd* Motor = &Bench.Faders[Index].Motor;
+    bool In1 = SimHAL_get_Pin(Motor->GPIOIn1, Motor->PinIn1);
+    bool In2 = SimHAL_get_Pin(Motor->GPIOIn2, Motor->PinIn2);
+    bool Standby = SimHAL_get_Pin(Motor->GPIOSTBY, Motor->PinSTBY);
+    double CCR = (double)__HAL_TIM_GET_COMPARE(Motor->htim, Motor->channel);
+    double Duty = CCR / (double)(Motor->htim->Instance->ARR + 1);
+    FaderPlant_set_Drive(&Bench.Plants[Index], In1, In2, Standby, (Duty > 1.0) ? 1.0 : Duty);
+  }
+}
+
+/**
+ * @brief     Simulate for a time.
+ * @param     TimeMs    time in milliseconds
+ * @return    none
+ */
+void run_Bench(uint32_t TimeMs)
+{
+  uint32_t Steps = (TimeMs * 1000) / BENCH_STEP_US;
+  uint32_t Step = 0;
+  for(Step = 0; Step < Steps; Step++)
+  {
+    update_Bench();
+  }
+}
+
+/**
+ * @brief     Run the friction calibration of a fader.
+ * @param     Index     index of the fader
+ * @return    true if the calibration finished
+ */
+bool calibrate_BenchFriction(uint16_t Index)
+{
+  MotorizedFader_structTd* Fader = &Bench.Faders[Index];
+  uint32_t TimeMs = 0;
+
+  MotorizedFader_start_FrictionCalibration(Fader);
+  for(TimeMs = 0; TimeMs < BENCH_CALIBRATION_MS; TimeMs++)
+  {
+    run_Bench(1);
+    FrictionModel_State_enumTd State = MotorizedFader_get_FrictionState(Fader);
+    if(BenchTrace && (TimeMs % 20) == 0)
+    {
+      printf("calibration %u %d %.1f %u\n", (unsigned)TimeMs, (int)State,
+             FaderPlant_get_WiperValue(&Bench.Plants[Index]),
+             (unsigned)__HAL_TIM_GET_COMPARE(Fader->Motor.htim, Fader->Motor.channel));
+    }
+    if(State == FRICTIONMODEL_CALIBRATED)
+    {
+      return true;
+    }
+    if(State == FRICTIONMODEL_FAILED)
+    {
+      break;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief     Auto tune the PID of fader 0 around the middle of the fader.
+ * @return    true if the auto tuning finished
+ */
+bool tune_BenchPID(void)
+{
+  MotorizedFader_structTd* Fader = &Bench.Faders[0];
+  uint32_t TimeMs = 0;
+
+  MotorizedFader_start_Autotune(Fader, 2048, 2600);
+  for(TimeMs = 0; TimeMs < BENCH_CALIBRATION_MS; TimeMs++)
+  {
+    run_Bench(1);
+    PIDAutotune_State_enumTd State = MotorizedFader_get_AutotuneState(Fader);
+    if(State == PIDAUTOTUNE_DONE)
+    {
+      return true;
+    }
+    if(State == PIDAUTOTUNE_FAILED)
+    {
+      break;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief     Put a finger on a fader or take it away.
+ * @param     Index     index of the fader
+ * @param     Touched   true if the TSC detects the finger
+ * @param     Held      true if the finger holds the knob
+ * @return    none
+ */
+void set_BenchFinger(uint16_t Index, bool Touched, bool Held)
+{
+  SimHAL_set_TSCValue(Bench.Faders[Index].TouchSense.TSCGroup, Touched ? BENCH_TSC_TOUCHED : SIMHAL_TSC_UNTOUCHED);
+  FaderPlant_set_Held(&Bench.Plants[Index], Held);
+}
+
+/**
+ * @brief     Check if the motor of a fader is driven.
+ * @param     Index     index of the fader
+ * @return    true if the driver is enabled, one direction is selected and
+ *            the CCR is not 0
+ */
+bool check_BenchMotorDriven(uint16_t Index)
+{
+  TB6612FNGMotorDriver_structTd* Motor = &Bench.Faders[Index].Motor;
+  bool In1 = SimHAL_get_Pin(Motor->GPIOIn1, Motor->PinIn1);
+  bool In2 = SimHAL_get_Pin(Motor->GPIOIn2, Motor->PinIn2);
+  bool Standby = SimHAL_get_Pin(Motor->GPIOSTBY, Motor->PinSTBY);
+  return Standby && In1 != In2 && __HAL_TIM_GET_COMPARE(Motor->htim, Motor->channel) != 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Simulation"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Scenarios
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Move the finger of the feature scenarios. Called before each
+ *            step of the recording.
+ * @param     Scenario  running scenario
+ * @param     TimeUs    time since the step
+ * @return    none
+ */
+void act_BenchScenario(const Bench_Scenario_structTd* Scenario, uint32_t TimeUs)
+{
+  uint32_t StartUs = BENCH_FINGER_START_MS * 1000;
+  uint32_t EndUs = StartUs + BENCH_FINGER_MS * 1000;
+  bool Finger = (TimeUs >= StartUs && TimeUs < EndUs);
+
+  switch(Scenario->Mode)
+  {
+  /** @internal     1.  Touch: the finger holds fader 0 where it is */
+  case BENCH_FIXED_TOUCH:
+    set_BenchFinger(0, Finger, Finger);
+    break;
+
+  /** @internal     2.  Gang: the finger moves fader 1 from start to target
+   *                    and releases it there */
+  case BENCH_FIXED_GANG:
+    set_BenchFinger(1, Finger, Finger);
+    if(Finger == true)
+    {
+      double Progress = (double)(TimeUs - StartUs + BENCH_STEP_US) / (EndUs - StartUs);
+      Progress = (Progress > 1.0) ? 1.0 : Progress;
+      FaderPlant_set_WiperValue(&Bench.Plants[1], (uint16_t)(Scenario->Start + (Scenario->Target - Scenario->Start) * Progress));
+    }
+    break;
+
+  /** @internal     3.  Haptics: the finger touches fader 0 without holding
+   *                    it, the spring moves it */
+  case BENCH_FIXED_HAPTICS:
+    set_BenchFinger(0, true, false);
+    break;
+
+  /** @internal     4.  Stall: fader 0 is blocked, the TSC does not notice */
+  case BENCH_FIXED_STALL:
+    FaderPlant_set_Held(&Bench.Plants[0], Finger);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief     Watch the features of fader 0 after each step of the
+ *            recording.
+ * @param     Scenario  running scenario
+ * @return    none
+ */
+void observe_BenchScenario(const Bench_Scenario_structTd* Scenario)
+{
+  MotorizedFader_structTd* Fader = &Bench.Faders[0];
+
+  /** @internal     1.  Touch: the motor has to be off shortly after the touch
+   *                    is detected */
+  if(Scenario->Mode == BENCH_FIXED_TOUCH && MotorizedFader_get_TSCState(Fader) == TSCBUTTON_TOUCHED)
+  {
+    Bench.TouchSteps++;
+    if(Bench.TouchSteps * BENCH_STEP_US > BENCH_TOUCH_REACTION_MS * 1000 && check_BenchMotorDriven(0) == true)
+    {
+      Bench.TouchDriven++;
+    }
+  }
+
+  /** @internal     2.  Stall: the detector backs off */
+  if(MotorizedFader_get_StallState(Fader) != STALLDETECTOR_RUNNING)
+  {
+    Bench.StallSeen = true;
+  }
+}
+
+/**
+ * @brief     Check the feature of a scenario at the end of the recording.
+ * @param     Scenario  finished scenario
+ * @param     Result    the text of a failed check is written to Failure
+ * @return    none
+ */
+void check_BenchFeature(const Bench_Scenario_structTd* Scenario, Bench_Result_structTd* Result)
+{
+  const char* Failure = NULL;
+
+  switch(Scenario->Mode)
+  {
+  case BENCH_FIXED_TOUCH:
+    if(Bench.TouchSteps == 0)
+    {
+      Failure = "touch not detected";
+    }
+    else if(Bench.TouchDriven != 0)
+    {
+      Failure = "motor driven while touched";
+    }
+    break;
+
+  case BENCH_FIXED_PARK:
+    if(MotorizedFader_get_SettleState(&Bench.Faders[0]) != SETTLEDETECTOR_SETTLED ||
+       MotorizedFader_get_SettleState(&Bench.Faders[1]) != SETTLEDETECTOR_SETTLED ||
+       SimHAL_get_Pin(GPIOA, GPIO_PIN_12) == true)
+    {
+      Failure = "not parked in standby";
+    }
+    break;
+
+  case BENCH_FIXED_STALL:
+    if(Bench.StallSeen == false)
+    {
+      Failure = "stall not detected";
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  if(Failure != NULL)
+  {
+    snprintf(Result->Failure, BENCH_FAILURE_LENGTH, "%s", Failure);
+  }
+}
+
+/**
+ * @brief     Run one scenario and measure the step response.
+ * @param     Scenario  scenario to run
+ * @return    results
+ */
+Bench_Result_structTd run_BenchScenario(const Bench_Scenario_structTd* Scenario)
+{
+  Bench_Result_structTd Result;
+  memset(&Result, 0, sizeof(Result));
+  snprintf(Result.Name, BENCH_NAME_LENGTH, "%s", Scenario->Name);
+
+  uint16_t Index = 0;
+  double Start = Scenario->Start;
+  double Target = Scenario->Target;
+  double Step = Target - Start;
+  double Direction = (Step >= 0) ? 1.0 : -1.0;
+
+  /** @internal     1.  Setup, calibrate and tune if required */
+  init_Bench(Scenario->Mode, BENCH_NUM_FADERS, 1);
+  bool Friction = (Scenario->Mode == BENCH_FIXED_FRICTION || Scenario->Mode == BENCH_FIXED_DITHER ||
+                   Scenario->Mode == BENCH_FIXED_PARK || Scenario->Mode == BENCH_FIXED_GANG ||
+                   Scenario->Mode == BENCH_FIXED_STALL);
+  if(Friction == true && calibrate_BenchFriction(0) == false)
+  {
+    snprintf(Result.Failure, BENCH_FAILURE_LENGTH, "friction calibration");
+    return Result;
+  }
+  if(Scenario->Mode == BENCH_FIXED_PARK && calibrate_BenchFriction(1) == false)
+  {
+    snprintf(Result.Failure, BENCH_FAILURE_LENGTH, "friction calibration");
+    return Result;
+  }
+  if(Scenario->Mode == BENCH_FIXED_AUTOTUNE && tune_BenchPID() == false)
+  {
+    snprintf(Result.Failure, BENCH_FAILURE_LENGTH, "auto tuning");
+    return Result;
+  }
+
+  /** @internal     2.  Place the faders at the start and hold it there until
+   *                    the TSC is released and the PIDs are settled */
+  for(Index = 0; Index < BENCH_NUM_FADERS; Index++)
+  {
+    FaderPlant_set_WiperValue(&Bench.Plants[Index], Scenario->Start);
+    MotorizedFader_set_Target(&Bench.Faders[Index], Scenario->Start);
+  }
+  run_Bench(BENCH_WARMUP_MS);
+
+  /** @internal     3.  Step fader 0 and record the noise free wiper value
+   *                    every step. In the gang scenario the finger moves
+   *                    fader 1 instead, with haptics the spring moves it. */
+  Bench.CPUSumNs = 0;
+  Bench.CPUMaxNs = 0;
+  Bench.CPUCount = 0;
+  if(Scenario->Mode == BENCH_FIXED_HAPTICS)
+  {
+    MotorizedFader_set_HapticSpring(&Bench.Faders[0], Scenario->Target, 2.0);
+  }
+  else if(Scenario->Mode != BENCH_FIXED_GANG)
+  {
+    MotorizedFader_set_Target(&Bench.Faders[0], Scenario->Target);
+  }
+
+  uint32_t Steps = (BENCH_DURATION_MS * 1000) / BENCH_STEP_US;
+  uint32_t SteadySteps = (BENCH_STEADY_MS * 1000) / BENCH_STEP_US;
+  uint32_t StepIndex = 0;
+  int32_t RiseStart = -1;
+  int32_t RiseEnd = -1;
+  int32_t LastOutside = 0;
+  double SteadySum = 0;
+
+  for(StepIndex = 1; StepIndex <= Steps; StepIndex++)
+  {
+    act_BenchScenario(Scenario, (StepIndex - 1) * BENCH_STEP_US);
+    update_Bench();
+    observe_BenchScenario(Scenario);
+    double Value = FaderPlant_get_WiperValue(&Bench.Plants[0]);
+    if(BenchTrace)
+    {
+      printf("trace %.3f %.1f %d %u %d\n", StepIndex * BENCH_STEP_US / 1000.0, Value,
+             MotorizedFader_get_WiperValue(&Bench.Faders[0]),
+             (unsigned)__HAL_TIM_GET_COMPARE(&Bench.htim2, TIM_CHANNEL_1),
+             SimHAL_get_Pin(GPIOA, GPIO_PIN_8) - SimHAL_get_Pin(GPIOA, GPIO_PIN_9));
+    }
+    double Progress = (Value - Start) * Direction;
+
+    if(RiseStart < 0 && Progress >= 0.1 * fabs(Step))
+    {
+      RiseStart = StepIndex;
+    }
+    if(RiseEnd < 0 && Progress >= 0.9 * fabs(Step))
+    {
+      RiseEnd = StepIndex;
+    }
+    if(Progress - fabs(Step) > Result.Overshoot)
+    {
+      Result.Overshoot = Progress - fabs(Step);
+    }
+    if(fabs(Value - Target) > BENCH_SETTLE_BAND)
+    {
+      LastOutside = StepIndex;
+    }
+    if(StepIndex > Steps - SteadySteps)
+    {
+      SteadySum += fabs(Value - Target);
+    }
+  }
+
+  /** @internal     4.  Convert steps to time. Settled: within the band for
+   *                    the whole steady time. */
+  double StepMs = BENCH_STEP_US / 1000.0;
+  Result.RiseMs = (RiseStart >= 0 && RiseEnd >= 0) ? (RiseEnd - RiseStart) * StepMs : BENCH_DURATION_MS;
+  Result.SettleMs = LastOutside * StepMs;
+  Result.SteadyError = SteadySum / SteadySteps;
+  Result.Settled = (LastOutside <= (int32_t)(Steps - SteadySteps));
+  check_BenchFeature(Scenario, &Result);
+  if(Bench.CPUCount != 0)
+  {
+    Result.CPUMeanNs = Bench.CPUSumNs / Bench.CPUCount;
+    Result.CPUMaxNs = Bench.CPUMaxNs;
+  }
+  Result.Valid = 1;
+  return Result;
+}
+
+/**
+ * @brief     Run a scenario in a child process, as the modules can not be
+ *            initialized twice.
+ * @param     Scenario  scenario to run
+ * @return    results. Valid is 0 if the scenario failed.
+ */
+Bench_Result_structTd run_BenchScenarioIsolated(const Bench_Scenario_structTd* Scenario)
+{
+  Bench_Result_structTd Result;
+  int Pipe[2];
+
+  memset(&Result, 0, sizeof(Result));
+  snprintf(Result.Name, BENCH_NAME_LENGTH, "%s", Scenario->Name);
+  if(pipe(Pipe) != 0)
+  {
+    return Result;
+  }
+
+  fflush(stdout);
+  pid_t Child = fork();
+  if(Child == 0)
+  {
+    close(Pipe[0]);
+    Bench_Result_structTd ChildResult = run_BenchScenario(Scenario);
+    ssize_t Written = write(Pipe[1], &ChildResult, sizeof(ChildResult));
+    close(Pipe[1]);
+    fflush(stdout);
+    _exit(Written == (ssize_t)sizeof(ChildResult) ? 0 : 1);
+  }
+
+  close(Pipe[1]);
+  if(Child > 0)
+  {
+    if(read(Pipe[0], &Result, sizeof(Result)) != (ssize_t)sizeof(Result))
+    {
+      Result.Valid = 0;
+    }
+    waitpid(Child, NULL, 0);
+  }
+  close(Pipe[0]);
+  return Result;
+}
+
+/**
+ * @brief     Get the status of a scenario.
+ * @param     Scenario  scenario
+ * @param     Result    its results
+ * @return    "ok", "FAIL" (not settled or a feature check failed), "xfail"
+ *            (known failure, not settled) or "xpass" (known failure, but
+ *            settled)
+ */
+const char* get_BenchStatus(const Bench_Scenario_structTd* Scenario, const Bench_Result_structTd* Result)
+{
+  if(Result->Valid == 0 || Result->Failure[0] != '\0')
+  {
+    return "FAIL";
+  }
+  if(Scenario->KnownFailure != NULL)
+  {
+    return (Result->Settled != 0) ? "xpass" : "xfail";
+  }
+  return (Result->Settled != 0) ? "ok" : "FAIL";
+}
+
+/** @} ************************************************************************/
+/* end of name "Scenarios"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Capacity
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Move all faders between two targets and measure the control
+ *            interrupt. The settle detector is off, so the PID of each fader
+ *            runs in each update (worst case).
+ * @param     NumFaders number of faders
+ * @param     Groups    stagger groups of the control updates
+ * @return    results. CPUMeanNs and CPUMaxNs are the interrupt time.
+ */
+Bench_Result_structTd run_BenchCapacity(uint16_t NumFaders, uint8_t Groups)
+{
+  Bench_Result_structTd Result;
+  uint16_t Index = 0;
+  uint32_t TimeMs = 0;
+
+  memset(&Result, 0, sizeof(Result));
+  snprintf(Result.Name, BENCH_NAME_LENGTH, "capacity_%u_%u", (unsigned)NumFaders, (unsigned)Groups);
+
+  /** @internal     1.  Setup without settle detection */
+  init_Bench(BENCH_FIXED_RATE, NumFaders, Groups);
+  for(Index = 0; Index < Bench.NumFaders; Index++)
+  {
+    MotorizedFader_init_Settle(&Bench.Faders[Index], 0, 0, 0, MOTORIZEDFADER_PARK_COAST);
+  }
+  run_Bench(BENCH_WARMUP_MS);
+
+  /** @internal     2.  Move all faders and measure the interrupt */
+  Bench.CPUSumNs = 0;
+  Bench.CPUMaxNs = 0;
+  Bench.CPUCount = 0;
+  for(TimeMs = 0; TimeMs < BENCH_CAPACITY_MS; TimeMs += BENCH_CAPACITY_MOVE_MS)
+  {
+    uint16_t Target = ((TimeMs / BENCH_CAPACITY_MOVE_MS) % 2 == 0) ? 3400 : 600;
+    for(Index = 0; Index < Bench.NumFaders; Index++)
+    {
+      MotorizedFader_set_Target(&Bench.Faders[Index], Target);
+    }
+    run_Bench(BENCH_CAPACITY_MOVE_MS);
+  }
+
+  if(Bench.CPUCount != 0)
+  {
+    Result.CPUMeanNs = Bench.CPUSumNs / Bench.CPUCount;
+    Result.CPUMaxNs = Bench.CPUMaxNs;
+    Result.Valid = 1;
+  }
+  return Result;
+}
+
+/**
+ * @brief     Run a capacity measurement in a child process.
+ * @param     NumFaders number of faders
+ * @param     Groups    stagger groups of the control updates
+ * @return    results. Valid is 0 if the run failed.
+ */
+Bench_Result_structTd run_BenchCapacityIsolated(uint16_t NumFaders, uint8_t Groups)
+{
+  Bench_Result_structTd Result;
+  int Pipe[2];
+
+  memset(&Result, 0, sizeof(Result));
+  if(pipe(Pipe) != 0)
+  {
+    return Result;
+  }
+
+  fflush(stdout);
+  pid_t Child = fork();
+  if(Child == 0)
+  {
+    close(Pipe[0]);
+    Bench_Result_structTd ChildResult = run_BenchCapacity(NumFaders, Groups);
+    ssize_t Written = write(Pipe[1], &ChildResult, sizeof(ChildResult));
+    close(Pipe[1]);
+    _exit(Written == (ssize_t)sizeof(ChildResult) ? 0 : 1);
+  }
+
+  close(Pipe[1]);
+  if(Child > 0)
+  {
+    if(read(Pipe[0], &Result, sizeof(Result)) != (ssize_t)sizeof(Result))
+    {
+      Result.Valid = 0;
+    }
+    waitpid(Child, NULL, 0);
+  }
+  close(Pipe[0]);
+  return Result;
+}
+
+/**
+ * @brief     Measure the control interrupt with 1 to @ref BENCH_MAX_FADERS
+ *            faders and estimate the number of faders at a control rate.
+ *            The mean interrupt time is fitted as fixed part plus time per
+ *            updated fader. With stagger groups, only the faders of one
+ *            group are updated per period, so the groups multiply the
+ *            capacity and divide the update rate of each fader.
+ * @param     RateHz    control rate
+ * @param     Factor    time on the target per time on the host. Get it from
+ *                      the interrupt time on the target (see
+ *                      MotorizedFader_get_ControlLoadMax()) divided by cpu_ns
+ *                      of the same number of faders.
+ * @return    0 on success
+ */
+int report_BenchCapacity(uint32_t RateHz, double Factor)
+{
+  const uint8_t Groups[] = {1, 2, 4};
+  double SumX = 0, SumY = 0, SumXX = 0, SumXY = 0;
+  uint16_t NumFaders = 0;
+  uint32_t Index = 0;
+
+  /** @internal     1.  Interrupt time without and with stagger groups */
+  printf("%-8s %7s %9s %9s %7s\n", "faders", "groups", "cpu_ns", "cpu_max", "load");
+  for(NumFaders = 1; NumFaders <= BENCH_MAX_FADERS; NumFaders++)
+  {
+    for(Index = 0; Index < sizeof(Groups); Index++)
+    {
+      if(Groups[Index] > NumFaders)
+      {
+        continue;
+      }
+      Bench_Result_structTd Result = run_BenchCapacityIsolated(NumFaders, Groups[Index]);
+      if(Result.Valid == 0)
+      {
+        printf("%-8u %7u failed\n", (unsigned)NumFaders, (unsigned)Groups[Index]);
+        return 1;
+      }
+      Result.CPUMeanNs *= Factor;
+      Result.CPUMaxNs *= Factor;
+      printf("%-8u %7u %9.0f %9.0f %6.1f%%\n", (unsigned)NumFaders, (unsigned)Groups[Index],
+             Result.CPUMeanNs, Result.CPUMaxNs, Result.CPUMeanNs * RateHz / 1e7);
+      if(Groups[Index] == 1)
+      {
+        SumX += NumFaders;
+        SumY += Result.CPUMeanNs;
+        SumXX += (double)NumFaders * NumFaders;
+        SumXY += NumFaders * Result.CPUMeanNs;
+      }
+    }
+  }
+
+  /** @internal     2.  Least squares fit of the interrupt time */
+  double Count = BENCH_MAX_FADERS;
+  double PerFader = (Count * SumXY - SumX * SumY) / (Count * SumXX - SumX * SumX);
+  double Fixed = (SumY - PerFader * SumX) / Count;
+  double PeriodNs = 1e9 / RateHz;
+  printf("fit: %.0f ns fixed + %.0f ns per updated fader\n", Fixed, PerFader);
+  if(PerFader <= 0 || Fixed >= PeriodNs)
+  {
+    printf("no capacity estimate\n");
+    return 1;
+  }
+
+  /** @internal     3.  Faders per period for each number of groups */
+  for(Index = 0; Index < sizeof(Groups); Index++)
+  {
+    uint32_t PerPeriod = (uint32_t)((PeriodNs - Fixed) / PerFader);
+    printf("capacity at %u Hz, groups %u: %u faders, each updated at %u Hz\n",
+           (unsigned)RateHz, (unsigned)Groups[Index], (unsigned)(PerPeriod * Groups[Index]),
+           (unsigned)(RateHz / Groups[Index]));
+  }
+  return 0;
+}
+
+/** @} ************************************************************************/
+/* end of name "Capacity"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Baseline
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Write the results as baseline.
+ * @param     FileName  baseline file
+ * @param     Results   results of all scenarios
+ * @return    0 on success
+ */
+int write_BenchBaseline(const char* FileName, Bench_Result_structTd* Results)
+{
+  FILE* File = fopen(FileName, "w");
+  uint32_t Index = 0;
+
+  if(File == NULL)
+  {
+    perror(FileName);
+    return 1;
+  }
+  fprintf(File, "# scenario rise_ms overshoot settle_ms steady_error cpu_mean_ns status\n");
+  for(Index = 0; Index < BENCH_NUM_SCENARIOS; Index++)
+  {
+    Bench_Result_structTd* Result = &Results[Index];
+    fprintf(File, "%s %.2f %.2f %.2f %.3f %.0f %s\n", Result->Name, Result->RiseMs,
+            Result->Overshoot, Result->SettleMs, Result->SteadyError, Result->CPUMeanNs,
+            get_BenchStatus(&BenchScenarios[Index], Result));
+  }
+  fclose(File);
+  return 0;
+}
+
+/**
+ * @brief     Check if a metric got worse than the tolerance. Smaller values
+ *            are better for all metrics.
+ * @param     Name      scenario name
+ * @param     Metric    metric name
+ * @param     Value     new value
+ * @param     Baseline  stored value
+ * @param     Absolute  absolute tolerance
+ * @return    1 if the metric regressed
+ */
+int check_BenchRegression(const char* Name, const char* Metric, double Value, double Baseline, double Absolute)
+{
+  double Limit = Baseline * 1.1 + Absolute;
+  if(Value > Limit)
+  {
+    printf("REGRESSION %s %s: %.2f (baseline %.2f)\n", Name, Metric, Value, Baseline);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief     Compare the results with a baseline.
+ * @param     FileName  baseline file
+ * @param     Results   results of all scenarios
+ * @return    number of regressions, -1 if the file can not be read
+ */
+int compare_BenchBaseline(const char* FileName, Bench_Result_structTd* Results)
+{
+  FILE* File = fopen(FileName, "r");
+  char Line[256];
+  int Regressions = 0;
+
+  if(File == NULL)
+  {
+    perror(FileName);
+    return -1;
+  }
+
+  while(fgets(Line, sizeof(Line), File) != NULL)
+  {
+    char Name[BENCH_NAME_LENGTH];
+    double Rise = 0, Overshoot = 0, Settle = 0, Steady = 0, CPU = 0;
+    uint32_t Index = 0;
+
+    if(Line[0] == '#' || sscanf(Line, "%31s %lf %lf %lf %lf %lf", Name, &Rise, &Overshoot, &Settle, &Steady, &CPU) != 6)
+    {
+      continue;
+    }
+
+    for(Index = 0; Index < BENCH_NUM_SCENARIOS; Index++)
+    {
+      Bench_Result_structTd* Result = &Results[Index];
+      if(strcmp(Result->Name, Name) != 0)
+      {
+        continue;
+      }
+      if(Result->Valid == 0)
+      {
+        printf("REGRESSION %s: scenario failed\n", Name);
+        Regressions++;
+        continue;
+      }
+      Regressions += check_BenchRegression(Name, "rise_ms", Result->RiseMs, Rise, 1.0);
+      Regressions += check_BenchRegression(Name, "overshoot", Result->Overshoot, Overshoot, 2.0);
+      Regressions += check_BenchRegression(Name, "settle_ms", Result->SettleMs, Settle, 5.0);
+      Regressions += check_BenchRegression(Name, "steady_error", Result->SteadyError, Steady, 0.5);
+      if(CPU > 0 && Result->CPUMeanNs > 1.5 * CPU)
+      {
+        printf("note %s: cpu_mean_ns %.0f (baseline %.0f), host dependent\n", Name, Result->CPUMeanNs, CPU);
+      }
+    }
+  }
+
+  fclose(File);
+  return Regressions;
+}
+
+/** @} ************************************************************************/
+/* end of name "Baseline"
+ ******************************************************************************/
+
+
+int main(int argc, char** argv)
+{
+  Bench_Result_structTd Results[BENCH_NUM_SCENARIOS];
+  uint32_t Index = 0;
+  int Failed = 0;
+
+  /** @internal     1.  Print the trajectory of one scenario:
+   *                    time (ms), wiper value, measured wiper value, CCR
+   *                    and direction */
+  if(argc == 3 && strcmp(argv[1], "--trace") == 0)
+  {
+    for(Index = 0; Index < BENCH_NUM_SCENARIOS; Index++)
+    {
+      if(strcmp(BenchScenarios[Index].Name, argv[2]) == 0)
+      {
+        BenchTrace = true;
+        return run_BenchScenario(&BenchScenarios[Index]).Valid ? 0 : 1;
+      }
+    }
+    printf("unknown scenario %s\n", argv[2]);
+    return 1;
+  }
+
+  /** @internal     2.  Capacity for many faders at a control rate */
+  if(argc >= 2 && argc <= 4 && strcmp(argv[1], "--capacity") == 0)
+  {
+    long RateHz = (argc >= 3) ? strtol(argv[2], NULL, 10) : 3000;
+    double Factor = (argc == 4) ? strtod(argv[3], NULL) : 1.0;
+    if(RateHz <= 0 || Factor <= 0)
+    {
+      printf("invalid rate or factor\n");
+      return 1;
+    }
+    return report_BenchCapacity((uint32_t)RateHz, Factor);
+  }
+
+  /** @internal     3.  Run all scenarios. Failed scenarios fail the run,
+   *                    known failures only if they get worse (baseline). */
+  printf("%-22s %9s %9s %9s %9s %9s %9s  %s\n", "scenario", "rise_ms", "overshoot",
+         "settle_ms", "ss_error", "cpu_ns", "cpu_max", "status");
+  for(Index = 0; Index < BENCH_NUM_SCENARIOS; Index++)
+  {
+    const Bench_Scenario_structTd* Scenario = &BenchScenarios[Index];
+    Bench_Result_structTd* Result = &Results[Index];
+    *Result = run_BenchScenarioIsolated(Scenario);
+    const char* Status = get_BenchStatus(Scenario, Result);
+    if(Result->Valid == 0)
+    {
+      printf("%-22s failed: %s\n", Result->Name, (Result->Failure[0] != '\0') ? Result->Failure : "no result");
+      Failed = 1;
+      continue;
+    }
+    printf("%-22s %9.2f %9.2f %9.2f %9.3f %9.0f %9.0f  %s", Result->Name, Result->RiseMs,
+           Result->Overshoot, Result->SettleMs, Result->SteadyError, Result->CPUMeanNs,
+           Result->CPUMaxNs, Status);
+    if(Result->Failure[0] != '\0')
+    {
+      printf(" (%s)", Result->Failure);
+    }
+    else if(strcmp(Status, "FAIL") == 0)
+    {
+      printf(" (not settled)");
+    }
+    else if(Scenario->KnownFailure != NULL)
+    {
+      printf(" (%s)", Scenario->KnownFailure);
+    }
+    printf("\n");
+    if(strcmp(Status, "FAIL") == 0)
+    {
+      Failed = 1;
+    }
+  }
+  for(Index = 0; Index < BENCH_NUM_SCENARIOS; Index++)
+  {
+    if(strcmp(get_BenchStatus(&BenchScenarios[Index], &Results[Index]), "xpass") == 0)
+    {
+      printf("note %s: settles now, remove its known failure\n", Results[Index].Name);
+    }
+  }
+
+  /** @internal     4.  Write or compare the baseline */
+  if(argc == 3 && strcmp(argv[1], "--write-baseline") == 0)
+  {
+    return write_BenchBaseline(argv[2], Results) | Failed;
+  }
+  if(argc == 3 && strcmp(argv[1], "--baseline") == 0)
+  {
+    int Regressions = compare_BenchBaseline(argv[2], Results);
+    if(Regressions != 0)
+    {
+      printf("%d regression(s) against %s\n", Regressions, argv[2]);
+      return 1;
+    }
+    if(Failed != 0)
+    {
+      printf("failed scenarios, see status\n");
+      return 1;
+    }
+    printf("no regressions against %s\n", argv[2]);
+  }
+  return Failed;
+}
+
+/**@}*//* end of defgroup "FaderBench" */
+/**@}*//* end of defgroup "FaderSimulation" */
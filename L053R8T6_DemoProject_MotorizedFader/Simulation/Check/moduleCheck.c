@@ -0,0 +1,906 @@
+/***************************************************************************//**
+ * @defgroup        ModuleCheck    Module check
+ * @brief           Checks the timing modules against the simulated time base.
+ *
+ * The time base is TIM6 as in main.c (1 us ticks, 333 us period). The check
+ * moves the counter in irregular steps and calls the update interrupt on
+ * each wrap, so TimerService_get_TimeUs() is the simulated time.
+ *
+ * Timer service:
+ * - time_base: the time is continuous over many update events and over the
+ *   32 bit wrap.
+ * - wheel_levels: one shot timers on each level and at the level borders.
+ * - wheel_beyond: delays longer than the wheel wait in the last level.
+ * - periodic: periodic timers do not drift, each expiry is checked.
+ * - callback: timers stop and start timers (and themselves) in callbacks.
+ * - random: many timers with random delays, some are stopped early.
+ *
+ * Task scheduler (the tasks move the simulated time by their execution
+ * time):
+ * - sched_order: priority first, earliest deadline within a priority.
+ * - sched_overrun: runs that end after the deadline are counted.
+ * - sched_skip: releases that pass during a long run are skipped and
+ *   counted.
+ * - sched_load: the load stays right after the wrap of the time base.
+ *
+ * PID controller:
+ * - pid_fixed: PIDFixed_calculate() follows PID_calculate() (double) on the
+ *   same sample sequences (steps, ramps, noise, saturation) with two sets
+ *   of gains. The outputs may differ by at most @ref CHECK_PID_DEVIATION.
+ *
+ * A timer must never expire before its time and at most
+ * @ref CHECK_LATE_US after it: two ticks for rounding up the start and the
+ * delay and one step of the simulated main loop.
+ *
+ * # Usage
+ * - moduleCheck: run all checks. Returns 1 if a check failed.
+ * - moduleCheck NAME: run one check.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      ModuleCheck
+ * @{
+ *
+ * @file            moduleCheck.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "halStub.h"
+#include "timerService.h"
+#include "taskScheduler.h"
+#include "pidController.h"
+#include "pidControllerFixed.h"
+
+/**
+ * @brief     Longest step of the simulated main loop.
+ */
+#define CHECK_MAX_STEP_US     300
+
+/**
+ * @brief     Largest time between the expiry of a timer and its callback.
+ */
+#define CHECK_LATE_US         (2 * TIMERSERVICE_TICK_US + CHECK_MAX_STEP_US)
+
+/**
+ * @brief     Number of timers of the random check.
+ */
+#define CHECK_RANDOM_TIMERS   64
+
+/**
+ * @brief     Number of tasks of the scheduler checks.
+ */
+#define CHECK_TASKS           4
+
+/**
+ * @brief     Largest difference between the outputs of the fixed-point and
+ *            the double PID (output units, e.g. CCR).
+ */
+#define CHECK_PID_DEVIATION   0.1
+
+/**
+ * @brief     Number of calculations of each PID sequence.
+ */
+#define CHECK_PID_STEPS       3000
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Timer under test and what happened to it
+ */
+typedef struct Check_Timer_struct
+{
+  TimerService_Timer_structTd Timer;
+  uint32_t  StartUs;        /**< Time of the (re-)start */
+  uint32_t  DelayUs;        /**< Delay or period */
+  uint32_t  Count;          /**< Expiries since the start */
+  uint32_t  Total;          /**< All expiries */
+  uint32_t  LateUsMax;      /**< Longest time after the expiry */
+  bool      Early;          /**< Expired before its time */
+  uint32_t  StopAfter;      /**< Stop itself after this count. 0: never */
+  uint32_t  Restarts;       /**< Start itself again this often */
+  struct Check_Timer_struct* Stop;  /**< Stopped by the callback */
+  struct Check_Timer_struct* Start; /**< Started by the callback */
+}Check_Timer_structTd;
+
+/**
+ * @brief     Task under test
+ */
+typedef struct
+{
+  TaskScheduler_Task_structTd Task;
+  uint32_t  CostUs;         /**< Execution time */
+  char      Tag;            /**< Written to the run order */
+}Check_Task_structTd;
+
+/**
+ * @brief     Gains of the PID comparison
+ */
+typedef struct
+{
+  double    Kp;
+  double    Ki;
+  double    Kd;
+  double    Tau;            /**< Low pass of the D-Term */
+  uint32_t  SampleTimeMs;
+  int32_t   OutputMax;      /**< Output limits are +-OutputMax */
+}Check_PIDGains_structTd;
+
+/**
+ * @brief     Sample sequences of the PID comparison
+ */
+typedef enum
+{
+  CHECK_PID_STEPS_RANDOM = 0, /**< Random steps over the ADC range */
+  CHECK_PID_RAMP,             /**< Triangle over the ADC range */
+  CHECK_PID_NOISE,            /**< Small noise around the set point */
+  CHECK_PID_SATURATION,       /**< Errors of +-30000, output at the limits */
+  CHECK_PID_SEQUENCES
+}Check_PIDSequence_enumTd;
+
+/**
+ * @brief     One check
+ */
+typedef struct
+{
+  const char* Name;
+  bool (*Function)(void);
+}Check_Case_structTd;
+
+/**
+ * @brief     Simulated time base
+ */
+typedef struct
+{
+  TIM_HandleTypeDef htim6;
+  uint32_t  TimeUs;         /**< Simulated time, wraps like the service */
+  uint32_t  Random;         /**< State of the random numbers */
+  const char* Name;         /**< Running check */
+  char      Order[16];      /**< Tags of the tasks in the order they ran */
+  uint8_t   NumOrder;       /**< Length of the order */
+}Check_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+Check_structTd Check;
+
+/***************************************************************************//**
+ * @name      Simulation
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Report a failed condition.
+ * @param     Condition   false is a failure
+ * @param     Text        what was expected
+ * @param     Value       printed with the text
+ * @return    Condition
+ */
+bool expect_Check(bool Condition, const char* Text, long Value)
+{
+  if(Condition == false)
+  {
+    printf("%-16s failed: %s (%ld)\n", Check.Name, Text, Value);
+  }
+  return Condition;
+}
+
+/**
+ * @brief     Get a pseudo random number (seeded, same for each run).
+ * @param     Range     numbers from 0 to Range - 1
+ * @return    random number
+ */
+uint32_t get_CheckRandom(uint32_t Range)
+{
+  Check.Random = Check.Random * 1664525 + 1013904223;
+  return (Check.Random >> 8) % Range;
+}
+
+/**
+ * @brief     Move the simulated time. The counter of TIM6 wraps at ARR and
+ *            calls the update interrupt.
+ * @param     StepUs    time step in microseconds
+ * @return    none
+ */
+void advance_CheckTime(uint32_t StepUs)
+{
+  TIM_TypeDef* Instance = Check.htim6.Instance;
+
+  Check.TimeUs += StepUs;
+  SimHAL_set_TimeUs(SimHAL_get_TimeUs() + StepUs);
+  Instance->CNT += StepUs;
+  while(Instance->CNT > Instance->ARR)
+  {
+    Instance->CNT -= Instance->ARR + 1;
+    TimerService_manage_Interrupt(&Check.htim6);
+  }
+}
+
+/**
+ * @brief     Run the main loop for a time: irregular steps, each followed
+ *            by TimerService_update().
+ * @param     TimeUs    time in microseconds
+ * @return    none
+ */
+void run_CheckLoop(uint32_t TimeUs)
+{
+  uint32_t EndUs = Check.TimeUs + TimeUs;
+
+  while((int32_t)(EndUs - Check.TimeUs) > 0)
+  {
+    advance_CheckTime(1 + get_CheckRandom(CHECK_MAX_STEP_US));
+    TimerService_update();
+  }
+}
+
+/**
+ * @brief     Callback of the timers under test. Records the time of the
+ *            expiry and stops or starts other timers.
+ * @param     Context   pointer to the Check_Timer_structTd
+ * @return    none
+ */
+void record_CheckTimer(void* Context)
+{
+  Check_Timer_structTd* Timer = Context;
+
+  /** @internal     1.  Time after the expected expiry of this count */
+  Timer->Count++;
+  Timer->Total++;
+  uint32_t DueUs = Timer->StartUs + Timer->Count * Timer->DelayUs;
+  int32_t LateUs = (int32_t)(Check.TimeUs - DueUs);
+  if(LateUs < 0)
+  {
+    Timer->Early = true;
+  }
+  else if((uint32_t)LateUs > Timer->LateUsMax)
+  {
+    Timer->LateUsMax = (uint32_t)LateUs;
+  }
+
+  /** @internal     2.  Actions of the callback */
+  if(Timer->Stop != NULL)
+  {
+    TimerService_stop(&Timer->Stop->Timer);
+  }
+  if(Timer->Start != NULL)
+  {
+    Timer->Start->StartUs = Check.TimeUs;
+    Timer->Start->Count = 0;
+    TimerService_start_Once(&Timer->Start->Timer, Timer->Start->DelayUs, record_CheckTimer, Timer->Start);
+  }
+  if(Timer->StopAfter != 0 && Timer->Count == Timer->StopAfter)
+  {
+    TimerService_stop(&Timer->Timer);
+  }
+  if(Timer->Restarts != 0)
+  {
+    Timer->Restarts--;
+    Timer->StartUs = Check.TimeUs;
+    Timer->Count = 0;
+    TimerService_start_Once(&Timer->Timer, Timer->DelayUs, record_CheckTimer, Timer);
+  }
+}
+
+/**
+ * @brief     Start a timer under test now.
+ * @param     Timer     timer under test
+ * @param     DelayUs   delay or period
+ * @param     Periodic  true: periodic timer
+ * @return    none
+ */
+void start_CheckTimer(Check_Timer_structTd* Timer, uint32_t DelayUs, bool Periodic)
+{
+  memset(Timer, 0, sizeof(Check_Timer_structTd));
+  Timer->StartUs = Check.TimeUs;
+  Timer->DelayUs = DelayUs;
+  if(Periodic == true)
+  {
+    TimerService_start_Periodic(&Timer->Timer, DelayUs, record_CheckTimer, Timer);
+  }
+  else
+  {
+    TimerService_start_Once(&Timer->Timer, DelayUs, record_CheckTimer, Timer);
+  }
+}
+
+/**
+ * @brief     Check the timing of a timer.
+ * @param     Timer     timer under test
+ * @param     Total     expected number of expiries
+ * @return    true if as expected
+ */
+bool verify_CheckTimer(Check_Timer_structTd* Timer, uint32_t Total)
+{
+  bool Passed = true;
+  Passed &= expect_Check(Timer->Total == Total, "number of expiries", (long)Timer->Total);
+  Passed &= expect_Check(Timer->Early == false, "expired early, delay", (long)Timer->DelayUs);
+  Passed &= expect_Check(Timer->LateUsMax <= CHECK_LATE_US, "late (us)", (long)Timer->LateUsMax);
+  return Passed;
+}
+
+/** @} ************************************************************************/
+/* end of name "Simulation"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Timer Service
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     The time base follows the simulated time over the 32 bit wrap.
+ * @return    true if passed
+ */
+bool check_TimeBase(void)
+{
+  bool Passed = true;
+  uint64_t Steps = 0;
+
+  /** @internal     1.  A bit more than 2^32 us in steps of 1 ms. The wheel
+   *                    is updated to keep up. */
+  for(Steps = 0; Steps < 4300000 && Passed == true; Steps++)
+  {
+    advance_CheckTime(1000 + (uint32_t)(Steps % 7));
+    TimerService_update();
+    Passed &= expect_Check(TimerService_get_TimeUs() == Check.TimeUs, "time base differs at step", (long)Steps);
+  }
+  Passed &= expect_Check(Check.TimeUs < 100000000, "time did not wrap", (long)Check.TimeUs);
+  return Passed;
+}
+
+/**
+ * @brief     One shot timers on each level and at the level borders.
+ * @return    true if passed
+ */
+bool check_WheelLevels(void)
+{
+  static const uint32_t Ticks[] = {1, 2, 15, 16, 17, 31, 255, 256, 257, 4095,
+                                   4096, 4097, 20000, 65535};
+  enum { NUM_TIMERS = sizeof(Ticks) / sizeof(Ticks[0]) };
+  Check_Timer_structTd Timers[NUM_TIMERS];
+  bool Passed = true;
+  uint8_t Index = 0;
+
+  /** @internal     1.  Start each timer at another phase of the tick */
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    run_CheckLoop(1 + get_CheckRandom(TIMERSERVICE_TICK_US));
+    start_CheckTimer(&Timers[Index], Ticks[Index] * TIMERSERVICE_TICK_US, false);
+  }
+  run_CheckLoop(65536 * TIMERSERVICE_TICK_US);
+
+  /** @internal     2.  Each expired once and stopped */
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    Passed &= verify_CheckTimer(&Timers[Index], 1);
+    Passed &= expect_Check(TimerService_check_Running(&Timers[Index].Timer) == false, "still running, index", Index);
+    Passed &= expect_Check(TimerService_check_Elapsed(&Timers[Index].Timer) == true, "flag not set, index", Index);
+  }
+  Passed &= expect_Check(TimerService_get_RunningTimers() == 0, "timers left in the wheel", TimerService_get_RunningTimers());
+  return Passed;
+}
+
+/**
+ * @brief     Delays longer than the wheel (65536 ticks).
+ * @return    true if passed
+ */
+bool check_WheelBeyond(void)
+{
+  static const uint32_t Ticks[] = {65536, 65537, 100000, 200000};
+  enum { NUM_TIMERS = sizeof(Ticks) / sizeof(Ticks[0]) };
+  Check_Timer_structTd Timers[NUM_TIMERS];
+  bool Passed = true;
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    start_CheckTimer(&Timers[Index], Ticks[Index] * TIMERSERVICE_TICK_US, false);
+    run_CheckLoop(1 + get_CheckRandom(10000));
+  }
+  run_CheckLoop(210000 * TIMERSERVICE_TICK_US);
+
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    Passed &= verify_CheckTimer(&Timers[Index], 1);
+  }
+  Passed &= expect_Check(TimerService_get_RunningTimers() == 0, "timers left in the wheel", TimerService_get_RunningTimers());
+  return Passed;
+}
+
+/**
+ * @brief     Periodic timers restart without drift. Each expiry is compared
+ *            with start + n * period.
+ * @return    true if passed
+ */
+bool check_Periodic(void)
+{
+  static const uint32_t PeriodsUs[] = {100, 300, 1000, 3300, 25000, 1700000};
+  enum { NUM_TIMERS = sizeof(PeriodsUs) / sizeof(PeriodsUs[0]) };
+  const uint32_t DurationUs = 10000000;
+  Check_Timer_structTd Timers[NUM_TIMERS];
+  bool Passed = true;
+  uint8_t Index = 0;
+
+  /** @internal     1.  Start at the same time and run 10 s */
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    start_CheckTimer(&Timers[Index], PeriodsUs[Index], true);
+  }
+  run_CheckLoop(DurationUs);
+
+  /** @internal     2.  All expiries in time. The loop ends up to one step
+   *                    after the duration, so the last period may or may not
+   *                    be counted. */
+  for(Index = 0; Index < NUM_TIMERS; Index++)
+  {
+    Check_Timer_structTd* Timer = &Timers[Index];
+    uint32_t Expected = (Check.TimeUs - Timer->StartUs) / PeriodsUs[Index];
+    if(Timer->Total + 1 == Expected)
+    {
+      Expected--;
+    }
+    Passed &= verify_CheckTimer(Timer, Expected);
+    Passed &= expect_Check(TimerService_check_Running(&Timer->Timer) == true, "periodic timer stopped, index", Index);
+    TimerService_stop(&Timer->Timer);
+  }
+  Passed &= expect_Check(TimerService_get_RunningTimers() == 0, "timers left in the wheel", TimerService_get_RunningTimers());
+  return Passed;
+}
+
+/**
+ * @brief     Stop and start timers in callbacks.
+ * @return    true if passed
+ */
+bool check_Callback(void)
+{
+  Check_Timer_structTd First;
+  Check_Timer_structTd Second;
+  Check_Timer_structTd Self;
+  Check_Timer_structTd Restart;
+  Check_Timer_structTd Starter;
+  Check_Timer_structTd Started;
+  bool Passed = true;
+
+  /** @internal     1.  Two timers of the same slot stop each other: only
+   *                    the first one expires */
+  start_CheckTimer(&First, 5000, false);
+  start_CheckTimer(&Second, 5000, false);
+  First.Stop = &Second;
+  Second.Stop = &First;
+
+  /** @internal     2.  A periodic timer stops itself after 3 expiries */
+  start_CheckTimer(&Self, 700, true);
+  Self.StopAfter = 3;
+
+  /** @internal     3.  A one shot timer starts itself again 5 times */
+  start_CheckTimer(&Restart, 1100, false);
+  Restart.Restarts = 5;
+
+  /** @internal     4.  A timer starts another one with one tick delay. It
+   *                    must not expire in the slot of the starter. */
+  memset(&Started, 0, sizeof(Started));
+  Started.DelayUs = TIMERSERVICE_TICK_US;
+  start_CheckTimer(&Starter, 2000, false);
+  Starter.Start = &Started;
+
+  run_CheckLoop(20000);
+
+  Passed &= expect_Check(First.Total + Second.Total == 1, "timers of the same slot expired", (long)(First.Total + Second.Total));
+  Passed &= expect_Check(First.Early == false && Second.Early == false, "stopping timer expired early", 0);
+  Passed &= verify_CheckTimer(&Self, 3);
+  Passed &= verify_CheckTimer(&Restart, 6);
+  Passed &= verify_CheckTimer(&Starter, 1);
+  Passed &= verify_CheckTimer(&Started, 1);
+  Passed &= expect_Check(TimerService_get_RunningTimers() == 0, "timers left in the wheel", TimerService_get_RunningTimers());
+  return Passed;
+}
+
+/**
+ * @brief     Many timers with random delays on all levels. Every second
+ *            timer is stopped at a random time, maybe before it expired.
+ * @return    true if passed
+ */
+bool check_Random(void)
+{
+  Check_Timer_structTd Timers[CHECK_RANDOM_TIMERS];
+  uint32_t StopUs[CHECK_RANDOM_TIMERS];
+  uint32_t StopTotal[CHECK_RANDOM_TIMERS];
+  bool Stopped[CHECK_RANDOM_TIMERS];
+  uint32_t StartUs = Check.TimeUs;
+  bool Passed = true;
+  uint16_t Index = 0;
+
+  /** @internal     1.  Start the timers within 100 ms */
+  for(Index = 0; Index < CHECK_RANDOM_TIMERS; Index++)
+  {
+    run_CheckLoop(1 + get_CheckRandom(100000 / CHECK_RANDOM_TIMERS));
+    start_CheckTimer(&Timers[Index], 1 + get_CheckRandom(8000000), false);
+    StopUs[Index] = (Index % 2 == 1) ? get_CheckRandom(8000000) : UINT32_MAX;
+    Stopped[Index] = false;
+  }
+
+  /** @internal     2.  Run 10 s, stop the timers on their stop time */
+  while(Check.TimeUs - StartUs < 10000000)
+  {
+    run_CheckLoop(1000);
+    for(Index = 0; Index < CHECK_RANDOM_TIMERS; Index++)
+    {
+      if(Stopped[Index] == false && Check.TimeUs - Timers[Index].StartUs >= StopUs[Index])
+      {
+        Stopped[Index] = true;
+        StopTotal[Index] = Timers[Index].Total;
+        TimerService_stop(&Timers[Index].Timer);
+      }
+    }
+  }
+
+  /** @internal     3.  Stopped timers keep their count of the stop time */
+  for(Index = 0; Index < CHECK_RANDOM_TIMERS; Index++)
+  {
+    Passed &= verify_CheckTimer(&Timers[Index], (Stopped[Index] == true) ? StopTotal[Index] : 1);
+  }
+  Passed &= expect_Check(TimerService_get_RunningTimers() == 0, "timers left in the wheel", TimerService_get_RunningTimers());
+  return Passed;
+}
+
+/** @} ************************************************************************/
+/* end of name "Timer Service"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      PID Controller
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get the sample of a PID sequence.
+ * @param     Sequence  sample sequence
+ * @param     Step      number of the calculation
+ * @param     Previous  sample of the previous step
+ * @return    sample
+ */
+int32_t get_CheckPIDSample(Check_PIDSequence_enumTd Sequence, uint32_t Step, int32_t Previous)
+{
+  switch(Sequence)
+  {
+  case CHECK_PID_STEPS_RANDOM:
+    return (Step % 150 == 0) ? (int32_t)get_CheckRandom(4096) : Previous;
+  case CHECK_PID_RAMP:
+    return (int32_t)(((Step * 5) % 8190 < 4095) ? (Step * 5) % 8190 : 8190 - (Step * 5) % 8190);
+  case CHECK_PID_NOISE:
+    return 2048 - 16 + (int32_t)get_CheckRandom(33);
+  default:
+    return ((Step / 200) % 2 == 0) ? 2048 + 30000 : 2048 - 30000;
+  }
+}
+
+/**
+ * @brief     Run one sample sequence through the fixed-point and the double
+ *            PID with the same gains.
+ * @param     Gains     gains, sample time and output limits
+ * @param     Sequence  sample sequence
+ * @return    largest difference of the raw outputs
+ */
+double run_CheckPID(const Check_PIDGains_structTd* Gains, Check_PIDSequence_enumTd Sequence)
+{
+  PID_structTd PID;
+  PIDFixed_structTd Fixed;
+  double Deviation = 0.0;
+  int32_t Sample = 2048;
+  uint32_t Step = 0;
+
+  /** @internal     1.  Same settings for both, target in the middle of the
+   *                    ADC range */
+  memset(&PID, 0, sizeof(PID));
+  memset(&Fixed, 0, sizeof(Fixed));
+  PID_init(&PID);
+  PID_set_OutputMinMax(&PID, -Gains->OutputMax, Gains->OutputMax);
+  PID_set_KpKiKd(&PID, Gains->Kp, Gains->Ki, Gains->Kd);
+  PID_set_LowPass(&PID, Gains->Tau);
+  PID_set_SampleTimeInMs(&PID, Gains->SampleTimeMs);
+  PID_set_Target(&PID, 2048);
+
+  PIDFixed_init(&Fixed);
+  PIDFixed_set_OutputMinMax(&Fixed, -Gains->OutputMax, Gains->OutputMax);
+  PIDFixed_set_KpKiKd(&Fixed, Gains->Kp, Gains->Ki, Gains->Kd);
+  PIDFixed_set_LowPass(&Fixed, Gains->Tau);
+  PIDFixed_set_SampleTimeInMs(&Fixed, Gains->SampleTimeMs);
+  PIDFixed_set_Target(&Fixed, 2048);
+
+  /** @internal     2.  Calculate both with each sample and keep the largest
+   *                    difference */
+  for(Step = 0; Step < CHECK_PID_STEPS; Step++)
+  {
+    Sample = get_CheckPIDSample(Sequence, Step, Sample);
+    PID_calculate(&PID, Sample);
+    PIDFixed_calculate(&Fixed, Sample);
+    double Difference = fabs((double)PIDFixed_get_OutputRaw(&Fixed) / PIDFIXED_Q_ONE - PID_get_OutputRaw(&PID));
+    Deviation = (Difference > Deviation) ? Difference : Deviation;
+  }
+  return Deviation;
+}
+
+/**
+ * @brief     The fixed-point PID follows the double PID on all sequences with
+ *            the gains of the bench and with stiff gains.
+ * @return    true if passed
+ */
+bool check_PIDFixed(void)
+{
+  static const Check_PIDGains_structTd Gains[] =
+  {
+    {0.15, 0.0001, 0.025, 0.1, 3, 500},
+    {1.5,  0.01,   0.2,   1.0, 1, 1000},
+  };
+  bool Passed = true;
+  uint32_t Index = 0;
+  uint32_t Sequence = 0;
+
+  for(Index = 0; Index < sizeof(Gains) / sizeof(Gains[0]); Index++)
+  {
+    for(Sequence = 0; Sequence < CHECK_PID_SEQUENCES; Sequence++)
+    {
+      double Deviation = run_CheckPID(&Gains[Index], (Check_PIDSequence_enumTd)Sequence);
+      Passed &= expect_Check(Deviation <= CHECK_PID_DEVIATION, "deviation in 1/1000", (long)(Deviation * 1000));
+    }
+  }
+  return Passed;
+}
+
+/** @} ************************************************************************/
+/* end of name "PID Controller"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Task Scheduler
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Function of the tasks under test. Records the order and moves
+ *            the time by the execution time.
+ * @param     Context   pointer to the Check_Task_structTd
+ * @return    none
+ */
+void run_CheckTask(void* Context)
+{
+  Check_Task_structTd* Task = Context;
+
+  if(Check.NumOrder < sizeof(Check.Order) - 1)
+  {
+    Check.Order[Check.NumOrder] = Task->Tag;
+    Check.NumOrder++;
+  }
+  advance_CheckTime(Task->CostUs);
+}
+
+/**
+ * @brief     Add a task under test. The scheduler is initialized before.
+ * @param     Task        task under test
+ * @param     Tag         written to the run order
+ * @param     CostUs      execution time
+ * @param     PeriodUs    period
+ * @param     DeadlineUs  deadline (0: period)
+ * @param     Priority    priority
+ * @return    none
+ */
+void add_CheckTask(Check_Task_structTd* Task, char Tag, uint32_t CostUs, uint32_t PeriodUs, uint32_t DeadlineUs, uint8_t Priority)
+{
+  Task->CostUs = CostUs;
+  Task->Tag = Tag;
+  TaskScheduler_add_Task(&Task->Task, "check", run_CheckTask, Task, PeriodUs, DeadlineUs, Priority);
+}
+
+/**
+ * @brief     Run the scheduler for a time. The time moves by IdleUs if no
+ *            task is released (instead of the sleep).
+ * @param     TimeUs    time in microseconds
+ * @param     IdleUs    time step without task
+ * @return    none
+ */
+void run_CheckScheduler(uint64_t TimeUs, uint32_t IdleUs)
+{
+  uint64_t ElapsedUs = 0;
+
+  while(ElapsedUs < TimeUs)
+  {
+    uint32_t StartUs = Check.TimeUs;
+    if(TaskScheduler_run_Once() == false)
+    {
+      advance_CheckTime(IdleUs);
+    }
+    ElapsedUs += Check.TimeUs - StartUs;
+  }
+}
+
+/**
+ * @brief     Released tasks run by priority, tasks of the same priority by
+ *            their deadline.
+ * @return    true if passed
+ */
+bool check_SchedulerOrder(void)
+{
+  Check_Task_structTd Tasks[CHECK_TASKS];
+  bool Passed = true;
+
+  /** @internal     1.  All are released at once and take no time */
+  TaskScheduler_init(false);
+  add_CheckTask(&Tasks[0], 'a', 0, 1000, 0, 2);
+  add_CheckTask(&Tasks[1], 'b', 0, 1000, 0, 0);
+  add_CheckTask(&Tasks[2], 'c', 0, 1000, 800, 1);
+  add_CheckTask(&Tasks[3], 'd', 0, 1000, 500, 1);
+  Check.NumOrder = 0;
+  memset(Check.Order, 0, sizeof(Check.Order));
+  while(TaskScheduler_run_Once() == true)
+  {
+  }
+  Passed &= expect_Check(strcmp(Check.Order, "bdca") == 0, Check.Order, Check.NumOrder);
+
+  /** @internal     2.  Each runs once per period */
+  run_CheckScheduler(100000, 10);
+  uint8_t Index = 0;
+  for(Index = 0; Index < CHECK_TASKS; Index++)
+  {
+    const TaskScheduler_Stats_structTd* Stats = TaskScheduler_get_Statistics(&Tasks[Index].Task);
+    Passed &= expect_Check(Stats->Runs >= 100 && Stats->Runs <= 101, "runs", (long)Stats->Runs);
+    Passed &= expect_Check(Stats->Overruns == 0 && Stats->Skipped == 0, "overruns or skipped, task", Index);
+  }
+  return Passed;
+}
+
+/**
+ * @brief     A task that takes longer than its deadline overruns each time,
+ *            the task with lower priority is delayed but keeps its deadline.
+ * @return    true if passed
+ */
+bool check_SchedulerOverrun(void)
+{
+  Check_Task_structTd Slow;
+  Check_Task_structTd Fast;
+  bool Passed = true;
+
+  TaskScheduler_init(false);
+  add_CheckTask(&Slow, 's', 400, 1000, 300, 0);
+  add_CheckTask(&Fast, 'f', 100, 1000, 0, 1);
+  run_CheckScheduler(100000, 10);
+
+  const TaskScheduler_Stats_structTd* SlowStats = TaskScheduler_get_Statistics(&Slow.Task);
+  const TaskScheduler_Stats_structTd* FastStats = TaskScheduler_get_Statistics(&Fast.Task);
+  Passed &= expect_Check(SlowStats->Runs >= 100 && SlowStats->Overruns == SlowStats->Runs, "overruns of the slow task", (long)SlowStats->Overruns);
+  Passed &= expect_Check(SlowStats->MaxUs == 400 && SlowStats->LastUs == 400, "execution time of the slow task", (long)SlowStats->MaxUs);
+  Passed &= expect_Check(FastStats->Runs >= 100 && FastStats->Overruns == 0, "overruns of the fast task", (long)FastStats->Overruns);
+  Passed &= expect_Check(SlowStats->Skipped == 0 && FastStats->Skipped == 0, "skipped", (long)(SlowStats->Skipped + FastStats->Skipped));
+  return Passed;
+}
+
+/**
+ * @brief     A task that runs longer than two periods skips the two releases
+ *            in between and does not run several times in a row.
+ * @return    true if passed
+ */
+bool check_SchedulerSkip(void)
+{
+  Check_Task_structTd Long;
+  bool Passed = true;
+
+  TaskScheduler_init(false);
+  add_CheckTask(&Long, 'l', 2500, 1000, 0, 0);
+  run_CheckScheduler(300000, 10);
+
+  const TaskScheduler_Stats_structTd* Stats = TaskScheduler_get_Statistics(&Long.Task);
+  Passed &= expect_Check(Stats->Runs >= 100, "runs", (long)Stats->Runs);
+  Passed &= expect_Check(Stats->Skipped == 2 * Stats->Runs, "skipped", (long)Stats->Skipped);
+  Passed &= expect_Check(Stats->Overruns == Stats->Runs, "overruns", (long)Stats->Overruns);
+  Passed &= expect_Check(Stats->TotalUs == (uint64_t)Stats->Runs * 2500, "total time", (long)Stats->TotalUs);
+  return Passed;
+}
+
+/**
+ * @brief     The load of a task with 25 % of its period is 250 permille, also
+ *            after 75 min without reset (the time base wraps after 71.6 min).
+ * @return    true if passed
+ */
+bool check_SchedulerLoad(void)
+{
+  Check_Task_structTd Quarter;
+  bool Passed = true;
+
+  TaskScheduler_init(false);
+  add_CheckTask(&Quarter, 'q', 250, 1000, 0, 0);
+  run_CheckScheduler(60000000, 250);
+  uint16_t Load = TaskScheduler_get_LoadPermille();
+  Passed &= expect_Check(Load >= 249 && Load <= 251, "load after 1 min", Load);
+
+  run_CheckScheduler(74ULL * 60000000, 250);
+  Load = TaskScheduler_get_LoadPermille();
+  Passed &= expect_Check(Load >= 249 && Load <= 251, "load after 75 min", Load);
+
+  TaskScheduler_reset_Statistics();
+  Passed &= expect_Check(TaskScheduler_get_LoadPermille() == 0, "load after reset", TaskScheduler_get_LoadPermille());
+  return Passed;
+}
+
+/** @} ************************************************************************/
+/* end of name "Task Scheduler"
+ ******************************************************************************/
+
+
+/**
+ * @brief     All checks, in the order they run. The time goes on from one
+ *            check to the next, so the later checks run after the wrap of
+ *            the time base.
+ */
+const Check_Case_structTd CheckCases[] =
+{
+  {"time_base",     check_TimeBase},
+  {"wheel_levels",  check_WheelLevels},
+  {"wheel_beyond",  check_WheelBeyond},
+  {"periodic",      check_Periodic},
+  {"callback",      check_Callback},
+  {"random",        check_Random},
+  {"sched_order",   check_SchedulerOrder},
+  {"sched_overrun", check_SchedulerOverrun},
+  {"sched_skip",    check_SchedulerSkip},
+  {"sched_load",    check_SchedulerLoad},
+  {"pid_fixed",     check_PIDFixed},
+};
+
+int main(int argc, char** argv)
+{
+  uint32_t NumCases = sizeof(CheckCases) / sizeof(CheckCases[0]);
+  uint32_t Index = 0;
+  int Failed = 0;
+  bool Found = false;
+
+  /** @internal     1.  TIM6 as in main.c */
+  memset(&Check, 0, sizeof(Check));
+  SimHAL_reset();
+  Check.Random = 12345;
+  Check.htim6.Instance = TIM6;
+  Check.htim6.Instance->PSC = 32 - 1;
+  Check.htim6.Instance->ARR = 333 - 1;
+  TimerService_init(&Check.htim6);
+  HAL_TIM_Base_Start_IT(&Check.htim6);
+
+  /** @internal     2.  Run all checks or the one named */
+  for(Index = 0; Index < NumCases; Index++)
+  {
+    if(argc == 2 && strcmp(argv[1], CheckCases[Index].Name) != 0)
+    {
+      continue;
+    }
+    Found = true;
+    Check.Name = CheckCases[Index].Name;
+    if(CheckCases[Index].Function() == true)
+    {
+      printf("%-16s ok\n", Check.Name);
+    }
+    else
+    {
+      Failed = 1;
+    }
+  }
+  if(Found == false)
+  {
+    printf("unknown check %s\n", argv[1]);
+    return 1;
+  }
+  return Failed;
+}
+
+/**@}*//* end of defgroup "ModuleCheck" */
+/**@}*//* end of defgroup "FaderSimulation" */
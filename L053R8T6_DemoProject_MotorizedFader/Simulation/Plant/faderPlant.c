@@ -0,0 +1,365 @@
+/***************************************************************************//**
+ * @defgroup        FaderPlant_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      FaderPlant
+ * @{
+ *
+ * @addtogroup      FaderPlant_Source
+ * @{
+ *
+ * @file            faderPlant.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include "faderPlant.h"
+#include <math.h>
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+double convert_PlantPositionToWiper(FaderPlant_structTd* Plant, double Position);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void FaderPlant_init(FaderPlant_structTd* Plant, uint32_t Seed)
+{
+  FaderPlant_Params_structTd* Params = &Plant->Params;
+
+  /** @internal     1.  Motor and belt. Full duty gives about 1 m/s, the
+   *                    belt resonance is about 65 Hz. */
+  Params->SupplyVoltage = 9.0;
+  Params->Resistance = 20.0;
+  Params->MotorConstant = 5.0;
+  Params->MotorMass = 0.02;
+  Params->KnobMass = 0.03;
+  Params->BeltStiffness = 2000.0;
+  Params->BeltDamping = 2.0;
+
+  /** @internal     2.  Friction. Breakaway at about CCR 110 up and 95 down,
+   *                    Coulomb friction at about CCR 80 and 70. */
+  Params->StaticFriction[FADERPLANT_UP] = 0.50;
+  Params->StaticFriction[FADERPLANT_DOWN] = 0.42;
+  Params->CoulombFriction[FADERPLANT_UP] = 0.36;
+  Params->CoulombFriction[FADERPLANT_DOWN] = 0.32;
+  Params->ViscousFriction = 0.5;
+  Params->FrictionRipple = 0.15;
+
+  /** @internal     3.  Wiper */
+  Params->Travel = 0.1;
+  Params->TrackOffset = 20.0;
+  Params->TrackSpan = 4050.0;
+  Params->TrackBend = 0.03;
+  Params->Noise = 1.5;
+  Params->NoiseMotor = 2.0;
+
+  /** @internal     4.  State: at the bottom, motor disconnected */
+  Plant->MotorPosition = 0;
+  Plant->MotorVelocity = 0;
+  Plant->KnobPosition = 0;
+  Plant->KnobVelocity = 0;
+  Plant->Voltage = 0;
+  Plant->Driven = false;
+  Plant->Held = false;
+  Plant->Random = (Seed != 0) ? Seed : 1;
+}
+
+/* Description in .h */
+void FaderPlant_set_WiperValue(FaderPlant_structTd* Plant, uint16_t Value)
+{
+  double Low = 0;
+  double High = Plant->Params.Travel;
+  uint8_t Index = 0;
+
+  /** @internal     1.  The track is monotonic, so the position is found by
+   *                    bisection */
+  for(Index = 0; Index < 40; Index++)
+  {
+    double Middle = (Low + High) / 2;
+    if(convert_PlantPositionToWiper(Plant, Middle) < Value)
+    {
+      Low = Middle;
+    }
+    else
+    {
+      High = Middle;
+    }
+  }
+
+  Plant->KnobPosition = Low;
+  Plant->MotorPosition = Low;
+  Plant->KnobVelocity = 0;
+  Plant->MotorVelocity = 0;
+}
+
+/* Description in .h */
+void FaderPlant_set_Held(FaderPlant_structTd* Plant, bool Held)
+{
+  Plant->Held = Held;
+  if(Held == true)
+  {
+    Plant->KnobVelocity = 0;
+  }
+}
+
+/**
+ * @brief     Calculate the noise free wiper value of a knob position.
+ * @param     Plant     pointer to the plant structure
+ * @param     Position  knob position (m)
+ * @return    wiper value
+ */
+double convert_PlantPositionToWiper(FaderPlant_structTd* Plant, double Position)
+{
+  FaderPlant_Params_structTd* Params = &Plant->Params;
+  double Relative = Position / Params->Travel;
+  double Track = Relative + Params->TrackBend * sin(2.0 * M_PI * Relative);
+  return Params->TrackOffset + Params->TrackSpan * Track;
+}
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+void update_PlantStep(FaderPlant_structTd* Plant, double Step);
+double update_PlantKnob(FaderPlant_structTd* Plant, double BeltForce, double Step);
+double get_PlantFriction(FaderPlant_structTd* Plant, double* Friction, FaderPlant_Direction_enumTd Direction);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+void FaderPlant_set_Drive(FaderPlant_structTd* Plant, bool In1, bool In2, bool Standby, double Duty)
+{
+  double Voltage = Duty * Plant->Params.SupplyVoltage;
+
+  /** @internal     1.  TB6612FNG truth table: IN1 high and IN2 low is CW
+   *                    (up), IN1 low and IN2 high is CCW (down), both high
+   *                    is short brake, both low or standby is stop. */
+  Plant->Driven = (Standby == true && (In1 == true || In2 == true));
+  if(In1 == true && In2 == false)
+  {
+    Plant->Voltage = Voltage;
+  }
+  else if(In1 == false && In2 == true)
+  {
+    Plant->Voltage = -Voltage;
+  }
+  else
+  {
+    Plant->Voltage = 0;
+  }
+}
+
+/* Description in .h */
+void FaderPlant_update(FaderPlant_structTd* Plant, uint32_t TimeUs)
+{
+  uint32_t Time = 0;
+  for(Time = 0; Time < TimeUs; Time += FADERPLANT_STEP_US)
+  {
+    update_PlantStep(Plant, FADERPLANT_STEP_US * 1e-6);
+  }
+}
+
+/**
+ * @brief     Integrate motor, belt and knob for one step (semi implicit
+ *            Euler).
+ * @param     Plant     pointer to the plant structure
+ * @param     Step      integration step (s)
+ * @return    none
+ */
+void update_PlantStep(FaderPlant_structTd* Plant, double Step)
+{
+  FaderPlant_Params_structTd* Params = &Plant->Params;
+
+  /** @internal     1.  Belt force from stretch and stretch velocity */
+  double Stretch = Plant->MotorPosition - Plant->KnobPosition;
+  double StretchVelocity = Plant->MotorVelocity - Plant->KnobVelocity;
+  double BeltForce = Params->BeltStiffness * Stretch + Params->BeltDamping * StretchVelocity;
+
+  /** @internal     2.  Motor force from the current */
+  double Current = 0;
+  if(Plant->Driven == true)
+  {
+    Current = (Plant->Voltage - Params->MotorConstant * Plant->MotorVelocity) / Params->Resistance;
+  }
+  double MotorForce = Params->MotorConstant * Current;
+
+  /** @internal     3.  Move the motor side */
+  Plant->MotorVelocity += (MotorForce - BeltForce) / Params->MotorMass * Step;
+  Plant->MotorPosition += Plant->MotorVelocity * Step;
+
+  /** @internal     4.  Move the knob */
+  Plant->KnobVelocity = update_PlantKnob(Plant, BeltForce, Step);
+  Plant->KnobPosition += Plant->KnobVelocity * Step;
+
+  /** @internal     5.  End stops */
+  if(Plant->KnobPosition < 0)
+  {
+    Plant->KnobPosition = 0;
+    Plant->KnobVelocity = 0;
+  }
+  else if(Plant->KnobPosition > Params->Travel)
+  {
+    Plant->KnobPosition = Params->Travel;
+    Plant->KnobVelocity = 0;
+  }
+}
+
+/**
+ * @brief     Calculate the new knob velocity with stick slip friction. A
+ *            sticking knob starts to move, if the belt force is bigger than
+ *            the static friction. A moving knob sticks, when the velocity
+ *            changes its sign.
+ * @param     Plant     pointer to the plant structure
+ * @param     BeltForce force of the belt on the knob (N)
+ * @param     Step      integration step (s)
+ * @return    new knob velocity (m/s)
+ */
+double update_PlantKnob(FaderPlant_structTd* Plant, double BeltForce, double Step)
+{
+  FaderPlant_Params_structTd* Params = &Plant->Params;
+  double Velocity = Plant->KnobVelocity;
+
+  if(Plant->Held == true)
+  {
+    return 0;
+  }
+
+  /** @internal     1.  Sticking: break away or stay */
+  if(Velocity == 0)
+  {
+    FaderPlant_Direction_enumTd Direction = (BeltForce >= 0) ? FADERPLANT_UP : FADERPLANT_DOWN;
+    double Static = get_PlantFriction(Plant, Params->StaticFriction, Direction);
+    if(fabs(BeltForce) <= Static)
+    {
+      return 0;
+    }
+    double Coulomb = get_PlantFriction(Plant, Params->CoulombFriction, Direction);
+    double Force = BeltForce - ((Direction == FADERPLANT_UP) ? Coulomb : -Coulomb);
+    return Force / Params->KnobMass * Step;
+  }
+
+  /** @internal     2.  Moving: Coulomb and viscous friction against the
+   *                    velocity */
+  FaderPlant_Direction_enumTd Direction = (Velocity > 0) ? FADERPLANT_UP : FADERPLANT_DOWN;
+  double Friction = get_PlantFriction(Plant, Params->CoulombFriction, Direction) + Params->ViscousFriction * fabs(Velocity);
+  double Force = BeltForce - ((Velocity > 0) ? Friction : -Friction);
+  double NewVelocity = Velocity + Force / Params->KnobMass * Step;
+
+  /** @internal     3.  Stick, if the friction stopped the knob */
+  if((NewVelocity > 0) != (Velocity > 0))
+  {
+    NewVelocity = 0;
+  }
+  return NewVelocity;
+}
+
+/**
+ * @brief     Get a friction value at the current knob position.
+ * @param     Plant     pointer to the plant structure
+ * @param     Friction  friction table (static or Coulomb)
+ * @param     Direction of the force or movement
+ * @return    friction (N)
+ */
+double get_PlantFriction(FaderPlant_structTd* Plant, double* Friction, FaderPlant_Direction_enumTd Direction)
+{
+  double Relative = Plant->KnobPosition / Plant->Params.Travel;
+  double Ripple = 1.0 + Plant->Params.FrictionRipple * sin(3.0 * M_PI * Relative);
+  return Friction[Direction] * Ripple;
+}
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/** @cond *//* Function Prototypes */
+double get_PlantGaussian(FaderPlant_structTd* Plant);
+/** @endcond *//* Function Prototypes */
+
+/* Description in .h */
+uint16_t FaderPlant_get_WiperSample(FaderPlant_structTd* Plant)
+{
+  FaderPlant_Params_structTd* Params = &Plant->Params;
+
+  /** @internal     1.  Noise is bigger while the motor is switched on */
+  double Sigma = Params->Noise;
+  if(Plant->Driven == true && Plant->Voltage != 0)
+  {
+    Sigma = Sigma + Params->NoiseMotor;
+  }
+
+  /** @internal     2.  Add the noise and round to the ADC resolution */
+  double Value = FaderPlant_get_WiperValue(Plant) + Sigma * get_PlantGaussian(Plant);
+  if(Value < 0)
+  {
+    Value = 0;
+  }
+  if(Value > FADERPLANT_MAX_VALUE)
+  {
+    Value = FADERPLANT_MAX_VALUE;
+  }
+  return (uint16_t)(Value + 0.5);
+}
+
+/* Description in .h */
+double FaderPlant_get_WiperValue(FaderPlant_structTd* Plant)
+{
+  return convert_PlantPositionToWiper(Plant, Plant->KnobPosition);
+}
+
+/* Description in .h */
+double FaderPlant_get_LinearPosition(FaderPlant_structTd* Plant)
+{
+  return Plant->KnobPosition / Plant->Params.Travel * FADERPLANT_MAX_VALUE;
+}
+
+/**
+ * @brief     Get a normal distributed random value (Box-Muller with a
+ *            xorshift generator).
+ * @param     Plant     pointer to the plant structure
+ * @return    random value with sigma 1
+ */
+double get_PlantGaussian(FaderPlant_structTd* Plant)
+{
+  double Uniform[2];
+  uint8_t Index = 0;
+
+  for(Index = 0; Index < 2; Index++)
+  {
+    uint32_t Random = Plant->Random;
+    Random ^= Random << 13;
+    Random ^= Random >> 17;
+    Random ^= Random << 5;
+    Plant->Random = Random;
+    Uniform[Index] = ((double)Random + 1.0) / 4294967297.0;
+  }
+
+  return sqrt(-2.0 * log(Uniform[0])) * cos(2.0 * M_PI * Uniform[1]);
+}
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderPlant_Source" */
+/**@}*//* end of defgroup "FaderPlant" */
+/**@}*//* end of defgroup "FaderSimulation" */
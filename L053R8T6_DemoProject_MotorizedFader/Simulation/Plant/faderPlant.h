@@ -0,0 +1,220 @@
+/***************************************************************************//**
+ * @defgroup        FaderPlant    Fader plant
+ * @brief           Simulated motorized fader: DC motor, belt, knob with
+ *                  friction and a noisy, non linear wiper.
+ *
+ * # Model
+ * - Motor: The TB6612FNG drives the motor with the average PWM voltage.
+ *   In the PWM off phase the motor is short braked, so the current is
+ *   (duty * supply - back EMF) / R. The inductance is ignored, as its time
+ *   constant is far below the control period. In stop mode (IN1 = IN2 = low)
+ *   or standby the current is 0.
+ * - Belt: The motor pulley (motor mass) and the knob (knob mass) are coupled
+ *   by a spring with damping.
+ * - Knob: Static friction while it sticks, Coulomb and viscous friction
+ *   while it moves. Static and Coulomb friction differ for up and down and
+ *   change along the travel (ripple). The knob stops at both ends.
+ * - Wiper: The track is not linear (bend) and does not reach 0 and 4095
+ *   (offset). Gaussian noise is added, more while the motor is switched on.
+ *
+ * All forces and positions are in N and m. The motor constant is given at
+ * the belt (N/A and V/(m/s)). All random values come from a seeded
+ * generator, so each run with the same seed gives the same result.
+ *
+ * @defgroup        FaderPlant_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      FaderPlant
+ * @{
+ *
+ * @addtogroup      FaderPlant_Header
+ * @{
+ *
+ * @file            faderPlant.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef SIM_FADERPLANT_H_
+#define SIM_FADERPLANT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief     Integration step of the plant.
+ */
+#define FADERPLANT_STEP_US      5
+
+/**
+ * @brief     Largest wiper value (12 bit ADC).
+ */
+#define FADERPLANT_MAX_VALUE    4095
+
+/***************************************************************************//**
+ * @name      Structures and Enumerations
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Directions of the knob, used as index of the friction values
+ */
+typedef enum
+{
+  FADERPLANT_UP,
+  FADERPLANT_DOWN,
+  FADERPLANT_NUM_DIRECTIONS
+}FaderPlant_Direction_enumTd;
+
+/**
+ * @brief     Parameters of the plant
+ */
+typedef struct
+{
+  double  SupplyVoltage;    /**< Motor supply (V) */
+  double  Resistance;       /**< Motor resistance (Ohm) */
+  double  MotorConstant;    /**< Force per current and back EMF per speed at
+                                 the belt (N/A = V/(m/s)) */
+  double  MotorMass;        /**< Motor and pulley inertia at the belt (kg) */
+  double  KnobMass;         /**< Knob and slider (kg) */
+  double  BeltStiffness;    /**< N/m */
+  double  BeltDamping;      /**< N/(m/s) */
+  double  StaticFriction[FADERPLANT_NUM_DIRECTIONS];  /**< N */
+  double  CoulombFriction[FADERPLANT_NUM_DIRECTIONS]; /**< N */
+  double  ViscousFriction;  /**< N/(m/s) */
+  double  FrictionRipple;   /**< Relative change of the friction along the
+                                 travel */
+  double  Travel;           /**< m */
+  double  TrackOffset;      /**< Wiper value at the bottom */
+  double  TrackSpan;        /**< Wiper value from bottom to top */
+  double  TrackBend;        /**< Amplitude of the non linearity (< 0.15) */
+  double  Noise;            /**< Noise of the wiper (counts, sigma) */
+  double  NoiseMotor;       /**< Additional noise while the motor is on */
+}FaderPlant_Params_structTd;
+
+/**
+ * @brief     Main structure of the plant. Declare one object for each fader.
+ */
+typedef struct
+{
+  FaderPlant_Params_structTd Params;
+
+  double    MotorPosition;  /**< m */
+  double    MotorVelocity;  /**< m/s */
+  double    KnobPosition;   /**< m */
+  double    KnobVelocity;   /**< m/s */
+  double    Voltage;        /**< Average motor voltage (V) */
+  bool      Driven;         /**< true if the motor is connected */
+  bool      Held;           /**< true while a finger holds the knob */
+  uint32_t  Random;         /**< State of the random generator */
+}FaderPlant_structTd;
+
+/** @} ************************************************************************/
+/* end of name "Structures and Enumerations"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Initialize
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Initialize the plant with the default parameters (similar to a
+ *            100 mm fader with 9 V supply) at the bottom.
+ * @param     Plant     pointer to the plant structure
+ * @param     Seed      seed of the random generator (not 0)
+ * @return    none
+ */
+void FaderPlant_init(FaderPlant_structTd* Plant, uint32_t Seed);
+
+/**
+ * @brief     Move the knob to a wiper value without dynamics. Motor and knob
+ *            stand still afterwards.
+ * @param     Plant     pointer to the plant structure
+ * @param     Value     noise free wiper value
+ * @return    none
+ */
+void FaderPlant_set_WiperValue(FaderPlant_structTd* Plant, uint16_t Value);
+
+/**
+ * @brief     Hold the knob (finger on the fader) or release it.
+ * @param     Plant     pointer to the plant structure
+ * @param     Held      true to hold the knob at its position
+ * @return    none
+ */
+void FaderPlant_set_Held(FaderPlant_structTd* Plant, bool Held);
+
+/** @} ************************************************************************/
+/* end of name "Initialize"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Process
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Set the motor driver outputs.
+ * @param     Plant     pointer to the plant structure
+ * @param     In1       state of the IN1 pin
+ * @param     In2       state of the IN2 pin
+ * @param     Standby   state of the STBY pin (true = driver enabled)
+ * @param     Duty      PWM duty cycle (0 - 1)
+ * @return    none
+ */
+void FaderPlant_set_Drive(FaderPlant_structTd* Plant, bool In1, bool In2, bool Standby, double Duty);
+
+/**
+ * @brief     Simulate the plant for a time.
+ * @param     Plant     pointer to the plant structure
+ * @param     TimeUs    time in microseconds
+ * @return    none
+ */
+void FaderPlant_update(FaderPlant_structTd* Plant, uint32_t TimeUs);
+
+/** @} ************************************************************************/
+/* end of name "Process"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Get Functions
+ * @{
+ ******************************************************************************/
+
+/**
+ * @brief     Get a noisy ADC sample of the wiper.
+ * @param     Plant     pointer to the plant structure
+ * @return    wiper sample (0 - 4095)
+ */
+uint16_t FaderPlant_get_WiperSample(FaderPlant_structTd* Plant);
+
+/**
+ * @brief     Get the noise free wiper value of the knob position.
+ * @param     Plant     pointer to the plant structure
+ * @return    wiper value
+ */
+double FaderPlant_get_WiperValue(FaderPlant_structTd* Plant);
+
+/**
+ * @brief     Get the knob position as linear value.
+ * @param     Plant     pointer to the plant structure
+ * @return    position (0 - 4095 over the travel)
+ */
+double FaderPlant_get_LinearPosition(FaderPlant_structTd* Plant);
+
+/** @} ************************************************************************/
+/* end of name "Get Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "FaderPlant_Header" */
+/**@}*//* end of defgroup "FaderPlant" */
+/**@}*//* end of defgroup "FaderSimulation" */
+
+#endif /* SIM_FADERPLANT_H_ */
@@ -0,0 +1,219 @@
+/***************************************************************************//**
+ * @defgroup        SimHAL_Source    Source
+ * @brief           Study this part for details.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      SimHAL
+ * @{
+ *
+ * @addtogroup      SimHAL_Source
+ * @{
+ *
+ * @file            halStub.c
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#include "halStub.h"
+#include <string.h>
+
+GPIO_TypeDef SimGPIOA;
+GPIO_TypeDef SimGPIOB;
+GPIO_TypeDef SimGPIOC;
+RCC_TypeDef SimRCC;
+TIM_TypeDef SimTIM2;
+TIM_TypeDef SimTIM3;
+TIM_TypeDef SimTIM6;
+TIM_TypeDef SimTIM21;
+TIM_TypeDef SimTIM22;
+
+typedef struct
+{
+  uint64_t  TimeUs;                           /**< Simulated time */
+  uint32_t  PCLK;                             /**< APB clock in Hz */
+  uint32_t  TSCValues[SIMHAL_NUM_TSC_GROUPS]; /**< TSC value of each group */
+}SimHAL_internal_structTd;
+
+SimHAL_internal_structTd SimHALInternal;
+
+/***************************************************************************//**
+ * @name      Control
+ * @{
+ ******************************************************************************/
+
+/* Description in .h */
+void SimHAL_reset(void)
+{
+  uint32_t Group = 0;
+
+  memset(&SimGPIOA, 0, sizeof(GPIO_TypeDef));
+  memset(&SimGPIOB, 0, sizeof(GPIO_TypeDef));
+  memset(&SimGPIOC, 0, sizeof(GPIO_TypeDef));
+  memset(&SimRCC, 0, sizeof(RCC_TypeDef));
+  memset(&SimTIM2, 0, sizeof(TIM_TypeDef));
+  memset(&SimTIM3, 0, sizeof(TIM_TypeDef));
+  memset(&SimTIM6, 0, sizeof(TIM_TypeDef));
+  memset(&SimTIM21, 0, sizeof(TIM_TypeDef));
+  memset(&SimTIM22, 0, sizeof(TIM_TypeDef));
+
+  SimHALInternal.TimeUs = 0;
+  SimHALInternal.PCLK = 32000000;
+  for(Group = 0; Group < SIMHAL_NUM_TSC_GROUPS; Group++)
+  {
+    SimHALInternal.TSCValues[Group] = SIMHAL_TSC_UNTOUCHED;
+  }
+}
+
+/* Description in .h */
+void SimHAL_set_TimeUs(uint64_t TimeUs)
+{
+  SimHALInternal.TimeUs = TimeUs;
+}
+
+/* Description in .h */
+uint64_t SimHAL_get_TimeUs(void)
+{
+  return SimHALInternal.TimeUs;
+}
+
+/* Description in .h */
+void SimHAL_set_TSCValue(uint32_t Group, uint32_t Value)
+{
+  if(Group < SIMHAL_NUM_TSC_GROUPS)
+  {
+    SimHALInternal.TSCValues[Group] = Value;
+  }
+}
+
+/* Description in .h */
+bool SimHAL_get_Pin(GPIO_TypeDef* GPIOx, uint16_t Pin)
+{
+  return ((GPIOx->ODR & Pin) != 0);
+}
+
+/** @} ************************************************************************/
+/* end of name "Control"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      HAL Functions
+ * @{
+ ******************************************************************************/
+
+uint32_t HAL_GetTick(void)
+{
+  return (uint32_t)(SimHALInternal.TimeUs / 1000);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if(PinState == GPIO_PIN_SET)
+  {
+    GPIOx->ODR |= GPIO_Pin;
+  }
+  else
+  {
+    GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+  }
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+  return SimHALInternal.PCLK;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+  return SimHALInternal.PCLK;
+}
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry)
+{
+  /* No interrupts to wait for: return right away */
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim)
+{
+  htim->Instance->CNT = 0;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+  (void)htim;
+  (void)Channel;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef* htim, uint32_t Channel)
+{
+  (void)htim;
+  (void)Channel;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef* htim, uint32_t EventSource)
+{
+  /* The update event restarts the counter with the preloaded values */
+  if(EventSource == TIM_EVENTSOURCE_UPDATE)
+  {
+    htim->Instance->CNT = 0;
+  }
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length)
+{
+  /* The wipers pass a uint16_t buffer casted to uint32_t* */
+  hadc->Buffer = (uint16_t*)pData;
+  hadc->Length = Length;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TSC_IOConfig(TSC_HandleTypeDef* htsc, TSC_IOConfigTypeDef* config)
+{
+  htsc->ChannelIOs = config->ChannelIOs;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TSC_IODischarge(TSC_HandleTypeDef* htsc, FunctionalState choice)
+{
+  (void)htsc;
+  (void)choice;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TSC_Start_IT(TSC_HandleTypeDef* htsc)
+{
+  htsc->Running = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TSC_Stop_IT(TSC_HandleTypeDef* htsc)
+{
+  htsc->Running = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_TSC_GroupGetValue(TSC_HandleTypeDef* htsc, uint32_t gx_index)
+{
+  (void)htsc;
+  uint32_t Value = 0;
+  if(gx_index < SIMHAL_NUM_TSC_GROUPS)
+  {
+    Value = SimHALInternal.TSCValues[gx_index];
+  }
+  return Value;
+}
+
+/** @} ************************************************************************/
+/* end of name "HAL Functions"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "SimHAL_Source" */
+/**@}*//* end of defgroup "SimHAL" */
+/**@}*//* end of defgroup "FaderSimulation" */
@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * @defgroup        SimHALControl   Simulated HAL control
+ * @brief           Use these functions to drive the simulated peripherals
+ *                  from the simulation.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      SimHAL
+ * @{
+ *
+ * @addtogroup      SimHALControl
+ * @{
+ *
+ * @file            halStub.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef SIM_HALSTUB_H_
+#define SIM_HALSTUB_H_
+
+#include "stm32l0xx_hal.h"
+#include <stdbool.h>
+
+/**
+ * @brief     Number of TSC groups of the simulated TSC.
+ */
+#define SIMHAL_NUM_TSC_GROUPS   8
+
+/**
+ * @brief     Value of an untouched TSC group. The demo uses thresholds of
+ *            450.
+ */
+#define SIMHAL_TSC_UNTOUCHED    1000
+
+/**
+ * @brief     Reset all simulated peripherals. Time starts at 0, the clock is
+ *            32 MHz and all TSC groups return the untouched value.
+ * @return    none
+ */
+void SimHAL_reset(void);
+
+/**
+ * @brief     Set the simulated time. HAL_GetTick() returns it in ms.
+ * @param     TimeUs    time in microseconds
+ * @return    none
+ */
+void SimHAL_set_TimeUs(uint64_t TimeUs);
+
+/**
+ * @brief     Get the simulated time.
+ * @return    time in microseconds
+ */
+uint64_t SimHAL_get_TimeUs(void);
+
+/**
+ * @brief     Set the value the TSC returns for a group. The TSC button is
+ *            touched, if the value is below its threshold.
+ * @param     Group     TSC group index
+ * @param     Value     acquisition value
+ * @return    none
+ */
+void SimHAL_set_TSCValue(uint32_t Group, uint32_t Value);
+
+/**
+ * @brief     Get the state of an output pin.
+ * @param     GPIOx     port
+ * @param     Pin       pin mask
+ * @return    true if the pin is set
+ */
+bool SimHAL_get_Pin(GPIO_TypeDef* GPIOx, uint16_t Pin);
+
+/**@}*//* end of defgroup "SimHALControl" */
+/**@}*//* end of defgroup "SimHAL" */
+/**@}*//* end of defgroup "FaderSimulation" */
+
+#endif /* SIM_HALSTUB_H_ */
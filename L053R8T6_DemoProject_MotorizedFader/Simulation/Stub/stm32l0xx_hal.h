@@ -0,0 +1,333 @@
+/***************************************************************************//**
+ * @defgroup        SimHAL    Simulated HAL
+ * @brief           Replaces the STM32L0 HAL for the host simulation. Only the
+ *                  types, macros and functions used by the fader modules are
+ *                  available.
+ *
+ * The peripherals do not run by themselves. Registers are plain variables:
+ * the motor driver writes CCR values and pins, the simulation reads them and
+ * feeds ADC samples, TSC values and timer interrupts back into the modules.
+ * Use the functions in halStub.h to access the simulated peripherals.
+ *
+ * @defgroup        SimHAL_Header    Header
+ * @brief           Study this part for a quick overview.
+ *
+ * @addtogroup      FaderSimulation
+ * @{
+ *
+ * @addtogroup      SimHAL
+ * @{
+ *
+ * @addtogroup      SimHAL_Header
+ * @{
+ *
+ * @file            stm32l0xx_hal.h
+ *
+ * @date            Oct 19, 2026
+ * @author          Mario Niehren
+ ******************************************************************************/
+
+#ifndef SIM_STM32L0XX_HAL_H_
+#define SIM_STM32L0XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/***************************************************************************//**
+ * @name      Common
+ * @{
+ ******************************************************************************/
+
+typedef enum
+{
+  RESET = 0,
+  SET = !RESET
+}FlagStatus, ITStatus;
+
+typedef enum
+{
+  DISABLE = 0,
+  ENABLE = !DISABLE
+}FunctionalState;
+
+typedef enum
+{
+  HAL_OK = 0,
+  HAL_ERROR,
+  HAL_BUSY,
+  HAL_TIMEOUT
+}HAL_StatusTypeDef;
+
+uint32_t HAL_GetTick(void);
+
+/** @} ************************************************************************/
+/* end of name "Common"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      GPIO
+ * @{
+ ******************************************************************************/
+
+typedef enum
+{
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET
+}GPIO_PinState;
+
+typedef struct
+{
+  uint32_t ODR;   /**< Output data register */
+}GPIO_TypeDef;
+
+extern GPIO_TypeDef SimGPIOA;
+extern GPIO_TypeDef SimGPIOB;
+extern GPIO_TypeDef SimGPIOC;
+#define GPIOA   (&SimGPIOA)
+#define GPIOB   (&SimGPIOB)
+#define GPIOC   (&SimGPIOC)
+
+#define GPIO_PIN_0    ((uint16_t)0x0001)
+#define GPIO_PIN_1    ((uint16_t)0x0002)
+#define GPIO_PIN_2    ((uint16_t)0x0004)
+#define GPIO_PIN_3    ((uint16_t)0x0008)
+#define GPIO_PIN_4    ((uint16_t)0x0010)
+#define GPIO_PIN_5    ((uint16_t)0x0020)
+#define GPIO_PIN_6    ((uint16_t)0x0040)
+#define GPIO_PIN_7    ((uint16_t)0x0080)
+#define GPIO_PIN_8    ((uint16_t)0x0100)
+#define GPIO_PIN_9    ((uint16_t)0x0200)
+#define GPIO_PIN_10   ((uint16_t)0x0400)
+#define GPIO_PIN_11   ((uint16_t)0x0800)
+#define GPIO_PIN_12   ((uint16_t)0x1000)
+#define GPIO_PIN_13   ((uint16_t)0x2000)
+#define GPIO_PIN_14   ((uint16_t)0x4000)
+#define GPIO_PIN_15   ((uint16_t)0x8000)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/** @} ************************************************************************/
+/* end of name "GPIO"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      RCC
+ * @{
+ ******************************************************************************/
+
+typedef struct
+{
+  uint32_t CFGR;  /**< Clock configuration register */
+}RCC_TypeDef;
+
+extern RCC_TypeDef SimRCC;
+#define RCC   (&SimRCC)
+
+#define RCC_CFGR_PPRE1_2    (0x4UL << 8)
+#define RCC_CFGR_PPRE2_2    (0x4UL << 11)
+
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+/** @} ************************************************************************/
+/* end of name "RCC"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      PWR
+ * @{
+ ******************************************************************************/
+
+#define PWR_MAINREGULATOR_ON    0x00000000U
+#define PWR_SLEEPENTRY_WFI      ((uint8_t)0x01)
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry);
+
+/** @} ************************************************************************/
+/* end of name "PWR"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      Timer
+ * @{
+ ******************************************************************************/
+
+typedef struct
+{
+  uint32_t CNT;   /**< Counter */
+  uint32_t PSC;   /**< Prescaler */
+  uint32_t ARR;   /**< Auto reload register */
+  uint32_t CCR1;  /**< Compare register channel 1 */
+  uint32_t CCR2;  /**< Compare register channel 2 */
+  uint32_t CCR3;  /**< Compare register channel 3 */
+  uint32_t CCR4;  /**< Compare register channel 4 */
+  uint32_t SR;    /**< Status register */
+}TIM_TypeDef;
+
+extern TIM_TypeDef SimTIM2;
+extern TIM_TypeDef SimTIM3;
+extern TIM_TypeDef SimTIM6;
+extern TIM_TypeDef SimTIM21;
+extern TIM_TypeDef SimTIM22;
+#define TIM2    (&SimTIM2)
+#define TIM3    (&SimTIM3)
+#define TIM6    (&SimTIM6)
+#define TIM21   (&SimTIM21)
+#define TIM22   (&SimTIM22)
+
+typedef struct
+{
+  TIM_TypeDef* Instance;
+}TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1     0x00000000U
+#define TIM_CHANNEL_2     0x00000004U
+#define TIM_CHANNEL_3     0x00000008U
+#define TIM_CHANNEL_4     0x0000000CU
+
+#define TIM_FLAG_UPDATE   0x00000001U
+
+#define TIM_EVENTSOURCE_UPDATE  0x00000001U
+
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+  (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)) = (__COMPARE__))
+#define __HAL_TIM_SetCompare    __HAL_TIM_SET_COMPARE
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) \
+  (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)))
+#define __HAL_TIM_GET_COUNTER(__HANDLE__)     ((__HANDLE__)->Instance->CNT)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)  ((__HANDLE__)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+  ((__HANDLE__)->Instance->ARR = (__AUTORELOAD__))
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PRESC__) \
+  ((__HANDLE__)->Instance->PSC = (__PRESC__))
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__) \
+  ((((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__)) ? SET : RESET)
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef* htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef* htim, uint32_t EventSource);
+
+/** @} ************************************************************************/
+/* end of name "Timer"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      ADC and DMA
+ * @{
+ ******************************************************************************/
+
+#define ADC_SAMPLETIME_1CYCLE_5     0x00000000U
+#define ADC_SAMPLETIME_3CYCLES_5    0x00000001U
+#define ADC_SAMPLETIME_7CYCLES_5    0x00000002U
+#define ADC_SAMPLETIME_12CYCLES_5   0x00000003U
+#define ADC_SAMPLETIME_19CYCLES_5   0x00000004U
+#define ADC_SAMPLETIME_39CYCLES_5   0x00000005U
+#define ADC_SAMPLETIME_79CYCLES_5   0x00000006U
+#define ADC_SAMPLETIME_160CYCLES_5  0x00000007U
+
+#define DMA_NORMAL      0x00000000U
+#define DMA_CIRCULAR    0x00000020U
+
+typedef struct
+{
+  uint32_t Mode;  /**< DMA_NORMAL or DMA_CIRCULAR */
+}DMA_InitTypeDef;
+
+typedef struct
+{
+  DMA_InitTypeDef Init;
+}DMA_HandleTypeDef;
+
+typedef struct
+{
+  DMA_HandleTypeDef* DMA_Handle;
+  uint16_t* Buffer;     /**< Simulation: buffer of the last start */
+  uint32_t  Length;     /**< Simulation: length of the last start */
+}ADC_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length);
+
+/** @} ************************************************************************/
+/* end of name "ADC and DMA"
+ ******************************************************************************/
+
+
+/***************************************************************************//**
+ * @name      TSC
+ * @{
+ ******************************************************************************/
+
+typedef struct
+{
+  uint32_t ShieldIOs;
+  uint32_t SamplingIOs;
+}TSC_InitTypeDef;
+
+typedef struct
+{
+  TSC_InitTypeDef Init;
+  uint8_t   Running;    /**< Simulation: acquisition started */
+  uint32_t  ChannelIOs; /**< Simulation: channels of the last IO config */
+}TSC_HandleTypeDef;
+
+typedef struct
+{
+  uint32_t ChannelIOs;
+  uint32_t ShieldIOs;
+  uint32_t SamplingIOs;
+}TSC_IOConfigTypeDef;
+
+#define TSC_GROUP1_IO1    0x00000001U
+#define TSC_GROUP1_IO2    0x00000002U
+#define TSC_GROUP1_IO3    0x00000004U
+#define TSC_GROUP1_IO4    0x00000008U
+#define TSC_GROUP2_IO1    0x00000010U
+#define TSC_GROUP2_IO2    0x00000020U
+#define TSC_GROUP2_IO3    0x00000040U
+#define TSC_GROUP2_IO4    0x00000080U
+#define TSC_GROUP3_IO1    0x00000100U
+#define TSC_GROUP3_IO2    0x00000200U
+#define TSC_GROUP3_IO3    0x00000400U
+#define TSC_GROUP3_IO4    0x00000800U
+#define TSC_GROUP4_IO1    0x00001000U
+#define TSC_GROUP4_IO2    0x00002000U
+#define TSC_GROUP4_IO3    0x00004000U
+#define TSC_GROUP4_IO4    0x00008000U
+#define TSC_GROUP5_IO1    0x00010000U
+#define TSC_GROUP5_IO2    0x00020000U
+#define TSC_GROUP5_IO3    0x00040000U
+#define TSC_GROUP5_IO4    0x00080000U
+#define TSC_GROUP6_IO1    0x00100000U
+#define TSC_GROUP6_IO2    0x00200000U
+#define TSC_GROUP6_IO3    0x00400000U
+#define TSC_GROUP6_IO4    0x00800000U
+#define TSC_GROUP7_IO1    0x01000000U
+#define TSC_GROUP7_IO2    0x02000000U
+#define TSC_GROUP7_IO3    0x04000000U
+#define TSC_GROUP7_IO4    0x08000000U
+#define TSC_GROUP8_IO1    0x10000000U
+#define TSC_GROUP8_IO2    0x20000000U
+#define TSC_GROUP8_IO3    0x40000000U
+#define TSC_GROUP8_IO4    0x80000000U
+
+HAL_StatusTypeDef HAL_TSC_IOConfig(TSC_HandleTypeDef* htsc, TSC_IOConfigTypeDef* config);
+HAL_StatusTypeDef HAL_TSC_IODischarge(TSC_HandleTypeDef* htsc, FunctionalState choice);
+HAL_StatusTypeDef HAL_TSC_Start_IT(TSC_HandleTypeDef* htsc);
+HAL_StatusTypeDef HAL_TSC_Stop_IT(TSC_HandleTypeDef* htsc);
+uint32_t HAL_TSC_GroupGetValue(TSC_HandleTypeDef* htsc, uint32_t gx_index);
+
+/** @} ************************************************************************/
+/* end of name "TSC"
+ ******************************************************************************/
+
+/**@}*//* end of defgroup "SimHAL_Header" */
+/**@}*//* end of defgroup "SimHAL" */
+/**@}*//* end of defgroup "FaderSimulation" */
+
+#endif /* SIM_STM32L0XX_HAL_H_ */